@@ -47,7 +47,7 @@ THE SOFTWARE.
 
 // Increment the ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION when new runtime API functions are added.
 // If the corresponding ROCDECODE_RUNTIME_API_TABLE_MAJOR_VERSION increases reset the ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION to zero.
-#define ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION 1
+#define ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION 10
 
 // rocDecode API interface
 typedef rocDecStatus (ROCDECAPI *PfnRocDecCreateVideoParser)(RocdecVideoParser *parser_handle, RocdecParserParams *params);
@@ -66,6 +66,20 @@ typedef rocDecStatus (ROCDECAPI *PfnRocDecGetBitstreamCodecType)(RocdecBitstream
 typedef rocDecStatus (ROCDECAPI *PfnRocDecGetBitstreamBitDepth)(RocdecBitstreamReader bs_reader_handle, int *bit_depth);
 typedef rocDecStatus (ROCDECAPI *PfnRocDecGetBitstreamPicData)(RocdecBitstreamReader bs_reader_handle, uint8_t **pic_data, int *pic_size, int64_t *pts);
 typedef rocDecStatus (ROCDECAPI *PfnRocDecDestroyBitstreamReader)(RocdecBitstreamReader bs_reader_handle);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecGetBitstreamNalUnitIndex)(RocdecBitstreamReader bs_reader_handle, const RocdecNalUnitInfo **nal_units, int *num_nal_units);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecGetParserStats)(RocdecVideoParser parser_handle, RocdecParserStats *stats);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecParserMarkFrameForReuse)(RocdecVideoParser parser_handle, int pic_idx);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecParserReset)(RocdecVideoParser parser_handle, uint32_t flags);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecParserSetDisplayStartPts)(RocdecVideoParser parser_handle, RocdecTimeStamp pts);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecCreateBitstreamReaderWithParams)(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path, RocdecBitstreamReaderParams *params);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecGetBitstreamReaderStats)(RocdecBitstreamReader bs_reader_handle, RocdecBitstreamReaderStats *stats);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecCreateBitstreamReaderFromMemory)(RocdecBitstreamReader *bs_reader_handle, const uint8_t *data, size_t size, RocdecBitstreamReaderParams *params);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecCreateBitstreamReaderFromCallback)(RocdecBitstreamReader *bs_reader_handle, PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, RocdecBitstreamReaderParams *params);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecBuildBitstreamIndex)(RocdecBitstreamReader bs_reader_handle);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecSaveBitstreamIndex)(RocdecBitstreamReader bs_reader_handle, const char *index_file_path);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecLoadBitstreamIndex)(RocdecBitstreamReader bs_reader_handle, const char *index_file_path);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecGetBitstreamIndex)(RocdecBitstreamReader bs_reader_handle, const RocdecBitstreamPicIndexEntry **entries, int *num_entries);
+typedef rocDecStatus (ROCDECAPI *PfnRocDecSeekBitstream)(RocdecBitstreamReader bs_reader_handle, int pic_idx, uint32_t flags, int *seek_pic_idx);
 
 // rocDecode API dispatch table
 struct RocDecodeDispatchTable {
@@ -91,6 +105,38 @@ struct RocDecodeDispatchTable {
     PfnRocDecDestroyBitstreamReader pfn_rocdec_destroy_bitstream_reader;
     // PLEASE DO NOT EDIT ABOVE!
     // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 2
+    PfnRocDecGetBitstreamNalUnitIndex pfn_rocdec_get_bitstream_nal_unit_index;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 3
+    PfnRocDecGetParserStats pfn_rocdec_get_parser_stats;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 4
+    PfnRocDecParserMarkFrameForReuse pfn_rocdec_parser_mark_frame_for_reuse;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 5
+    PfnRocDecParserReset pfn_rocdec_parser_reset;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 6
+    PfnRocDecParserSetDisplayStartPts pfn_rocdec_parser_set_display_start_pts;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 7
+    PfnRocDecCreateBitstreamReaderWithParams pfn_rocdec_create_bitstream_reader_with_params;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 8
+    PfnRocDecGetBitstreamReaderStats pfn_rocdec_get_bitstream_reader_stats;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 9
+    PfnRocDecCreateBitstreamReaderFromMemory pfn_rocdec_create_bitstream_reader_from_memory;
+    PfnRocDecCreateBitstreamReaderFromCallback pfn_rocdec_create_bitstream_reader_from_callback;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 10
+    PfnRocDecBuildBitstreamIndex pfn_rocdec_build_bitstream_index;
+    PfnRocDecSaveBitstreamIndex pfn_rocdec_save_bitstream_index;
+    PfnRocDecLoadBitstreamIndex pfn_rocdec_load_bitstream_index;
+    PfnRocDecGetBitstreamIndex pfn_rocdec_get_bitstream_index;
+    PfnRocDecSeekBitstream pfn_rocdec_seek_bitstream;
+    // PLEASE DO NOT EDIT ABOVE!
+    // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 11
 
     // ******************************************************************************************* //
     //                                            READ BELOW
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #pragma once
 
 #include "rocdecode.h"
+#include "rocparser.h"
 
 /*!
  * \file
@@ -42,6 +43,82 @@ extern "C" {
 /*********************************************************************************/
 typedef void *RocdecBitstreamReader;
 
+/**
+ * \brief Read callback of the bitstream reader, used in rocDecCreateBitstreamReaderFromCallback API
+ * \ PFNBITSTREAMREADCALLBACK(user_data, buf, size) reads up to size bytes of the stream into buf. The callback may return fewer
+ * \ bytes than requested, e.g. what arrived from the network so far.
+ * \ Return values: > 0: number of bytes read, 0: end of stream, < 0: read error (treated as end of stream)
+ */
+typedef int(ROCDECAPI *PFNBITSTREAMREADCALLBACK)(void *, uint8_t *, int);
+
+/*********************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \struct RocdecBitstreamReaderParams
+//! Creation parameters of the bitstream reader
+//! Used in rocDecCreateBitstreamReaderWithParams API
+/*********************************************************************************/
+typedef struct _RocdecBitstreamReaderParams {
+    uint32_t memory_mapped_input : 1;   /**< IN: Map the input file into memory instead of reading it through a ring buffer. The picture data
+                                             returned by rocDecGetBitstreamPicData then points into the mapping and must not be modified. Falls
+                                             back to the ring buffer if the file can not be mapped, e.g. for a pipe                           */
+    uint32_t use_huge_pages : 1;        /**< IN: Back the ring buffer with huge pages: reserved huge pages if available, else transparent huge
+                                             pages                                                                                          */
+    uint32_t read_ahead : 1;            /**< IN: Read the file on a background thread that keeps the ring buffer filled ahead of the parsing
+                                             position, so rocDecGetBitstreamPicData does not block on storage. Ignored in memory mapped mode   */
+    uint32_t reserved : 29;             /**< Reserved for future use - set to zero                                                          */
+    uint32_t ring_size;                 /**< IN: Size of the ring buffer in bytes, 0 for the default of 16 MB. The ring is allocated on the first
+                                             read and doubled when a NAL unit, OBU or IVF frame does not fit in it. Clamped to the range
+                                             64 KB - 2 GB                                                                                   */
+    uint32_t read_ahead_depth;          /**< IN: Number of chunks the read-ahead thread reads ahead of the parsing position, 0 for the default
+                                             of 2 (double buffering). A chunk is 1 MB or a quarter of the ring buffer, whichever is smaller.
+                                             The ring buffer size bounds the depth                                                          */
+    uint32_t reserved_1[5];             /**< Reserved for future use - set to zero                                                          */
+} RocdecBitstreamReaderParams;
+
+/*********************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \struct RocdecBitstreamReaderStats
+//! Bitstream reader statistics, accumulated since the reader was created
+//! Used in rocDecGetBitstreamReaderStats API
+/*********************************************************************************/
+typedef struct _RocdecBitstreamReaderStats {
+    uint64_t num_fetches;               /**< OUT: Number of times the parsing position reached the end of the data read from the file       */
+    uint64_t num_read_ahead_hits;       /**< OUT: Number of fetches served from data the read-ahead thread had already read                */
+    uint64_t num_read_ahead_stalls;     /**< OUT: Number of fetches that waited for the read-ahead thread                                   */
+    uint64_t blocked_time_us;           /**< OUT: Time in microseconds the calling thread was blocked on file reads, or waiting for the
+                                             read-ahead thread                                                                              */
+    uint32_t read_ahead_depth;          /**< OUT: Read-ahead depth in bytes, 0 if the read-ahead thread is not used                         */
+    uint32_t reserved_0;                /**< Reserved for future use - set to zero                                                          */
+    uint64_t reserved[11];              /**< Reserved for future use - set to zero                                                          */
+} RocdecBitstreamReaderStats;
+
+/*********************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \struct RocdecBitstreamPicIndexEntry
+//! Location and type of a picture in the stream
+//! Used in rocDecGetBitstreamIndex API
+/*********************************************************************************/
+typedef struct _RocdecBitstreamPicIndexEntry {
+    uint64_t offset;                    /**< OUT: Byte offset of the picture in the stream. For IVF, the offset of the frame header      */
+    uint32_t size;                      /**< OUT: Size of the picture in the stream in bytes. For IVF, including the 12 byte frame header */
+    uint8_t pic_type;                   /**< OUT: RocdecParsedPicType of the picture. For HEVC, the type of the first slice segment; for AV1,
+                                             the type of the first frame header of the temporal unit                                     */
+    uint8_t key_frame_flag;             /**< OUT: 1 if decoding can start at the picture: IDR (AVC), IRAP (HEVC), shown key frame (AV1)  */
+    uint8_t param_sets_flag;            /**< OUT: 1 if the picture carries parameter sets: SPS or PPS (AVC), VPS, SPS or PPS (HEVC),
+                                             sequence header (AV1)                                                                       */
+    uint8_t reserved;                   /**< Reserved for future use - set to zero                                                      */
+} RocdecBitstreamPicIndexEntry;
+
+/*********************************************************************************/
+//! \enum RocdecBitstreamSeekFlags
+//! Bitstream reader seek flags
+//! Used in rocDecSeekBitstream API
+/*********************************************************************************/
+typedef enum {
+    ROCDEC_SEEK_RANDOM_ACCESS_POINT = 0x01,  /**< Seek to the nearest key frame at or before the picture instead of the picture itself.
+                                                  The first picture of the stream is used if there is none                           */
+} RocdecBitstreamSeekFlags;
+
 /************************************************************************************************/
 //! \ingroup group_roc_bitstream_reader
 //! \fn rocDecStatus ROCDECAPI rocDecCreateBitstreamReader(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path)
@@ -49,6 +126,32 @@ typedef void *RocdecBitstreamReader;
 /************************************************************************************************/
 extern rocDecStatus ROCDECAPI rocDecCreateBitstreamReader(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path);
 
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderWithParams(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path, RocdecBitstreamReaderParams *params)
+//! Create video bitstream reader object with the given creation parameters and initialize
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderWithParams(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path, RocdecBitstreamReaderParams *params);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromMemory(RocdecBitstreamReader *bs_reader_handle, const uint8_t *data, size_t size, RocdecBitstreamReaderParams *params)
+//! Create video bitstream reader object that reads an AVC/HEVC/AV1 elementary stream or an AV1 IVF stream held in memory. The
+//! buffer is not copied: it must stay valid and unchanged until the reader is destroyed, and the picture data returned by
+//! rocDecGetBitstreamPicData points into it. params is optional; memory_mapped_input, ring_size, use_huge_pages and read_ahead
+//! do not apply.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromMemory(RocdecBitstreamReader *bs_reader_handle, const uint8_t *data, size_t size, RocdecBitstreamReaderParams *params);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromCallback(RocdecBitstreamReader *bs_reader_handle, PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, RocdecBitstreamReaderParams *params)
+//! Create video bitstream reader object that pulls the stream through pfn_read, called with user_data. The stream is read once, front
+//! to back, into the ring buffer: the first bytes are already read at creation to detect the stream type. params is optional;
+//! memory_mapped_input does not apply. With read_ahead, pfn_read is called on the read-ahead thread.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromCallback(RocdecBitstreamReader *bs_reader_handle, PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, RocdecBitstreamReaderParams *params);
+
 /************************************************************************************************/
 //! \ingroup group_roc_bitstream_reader
 //! \fn rocDecStatus ROCDECAPI rocDecGetBitstreamCodecType(RocdecBitstreamReader bs_reader_handle, rocDecVideoCodec *codec_type)
@@ -69,7 +172,7 @@ extern rocDecStatus ROCDECAPI rocDecGetBitstreamBitDepth(RocdecBitstreamReader b
 //! Read one unit of picture data from the bitstream. The unit can be a frame or field for AVC/HEVC, 
 //! a temporal unit for AV1, or a frame (including superframe) for VP9. The picture data unit is pointed
 //! by pic_data. The size of the unit is specified by pic_size. The presentation time stamp, if available,
-//! is given by pts.
+//! is given by pts. The picture data is owned by the reader and is valid until the next rocDecGetBitstreamPicData call.
 /************************************************************************************************/
 extern rocDecStatus ROCDECAPI rocDecGetBitstreamPicData(RocdecBitstreamReader bs_reader_handle, uint8_t **pic_data, int *pic_size, int64_t *pts);
 
@@ -80,6 +183,63 @@ extern rocDecStatus ROCDECAPI rocDecGetBitstreamPicData(RocdecBitstreamReader bs
 /************************************************************************************************/
 extern rocDecStatus ROCDECAPI rocDecDestroyBitstreamReader(RocdecBitstreamReader bs_reader_handle);
 
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecGetBitstreamNalUnitIndex(RocdecBitstreamReader bs_reader_handle, const RocdecNalUnitInfo **nal_units, int *num_nal_units)
+//! Get the NAL unit index of the picture data returned by the last rocDecGetBitstreamPicData call. The index is valid until the
+//! next rocDecGetBitstreamPicData call and can be passed to rocDecParseVideoData with the ROCDEC_PKT_NAL_INDEX packet flag so
+//! that the parser does not scan the picture data for start codes again. num_nal_units is 0 for AV1 streams.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecGetBitstreamNalUnitIndex(RocdecBitstreamReader bs_reader_handle, const RocdecNalUnitInfo **nal_units, int *num_nal_units);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecGetBitstreamReaderStats(RocdecBitstreamReader bs_reader_handle, RocdecBitstreamReaderStats *stats)
+//! Get the statistics of the bitstream reader object
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecGetBitstreamReaderStats(RocdecBitstreamReader bs_reader_handle, RocdecBitstreamReaderStats *stats);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecBuildBitstreamIndex(RocdecBitstreamReader bs_reader_handle)
+//! Build the picture index of the stream in one pass over the whole stream. The reader then continues from the picture it was at.
+//! Not supported for a reader created with rocDecCreateBitstreamReaderFromCallback.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecBuildBitstreamIndex(RocdecBitstreamReader bs_reader_handle);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecSaveBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path)
+//! Save the picture index to a sidecar file, to be loaded with rocDecLoadBitstreamIndex instead of building it again
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecSaveBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecLoadBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path)
+//! Load the picture index from a sidecar file saved with rocDecSaveBitstreamIndex. The file is rejected if it was saved for a
+//! stream of another type or size.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecLoadBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecGetBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const RocdecBitstreamPicIndexEntry **entries, int *num_entries)
+//! Get the picture index, in decode order. The index is valid until it is built or loaded again. num_entries is 0 if there is
+//! no index.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecGetBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const RocdecBitstreamPicIndexEntry **entries, int *num_entries);
+
+/************************************************************************************************/
+//! \ingroup group_roc_bitstream_reader
+//! \fn rocDecStatus ROCDECAPI rocDecSeekBitstream(RocdecBitstreamReader bs_reader_handle, int pic_idx, uint32_t flags, int *seek_pic_idx)
+//! Move the reader to picture pic_idx of the index, so that the next rocDecGetBitstreamPicData call returns it. flags is a
+//! combination of RocdecBitstreamSeekFlags. The index of the picture moved to is returned in seek_pic_idx, which is optional.
+//! The index must be built or loaded first. To decode from a key frame without parameter sets (param_sets_flag of the index
+//! entry is 0), reset the parser with ROCDEC_PARSER_RESET_KEEP_PARAM_SETS after it has parsed the parameter sets.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecSeekBitstream(RocdecBitstreamReader bs_reader_handle, int pic_idx, uint32_t flags, int *seek_pic_idx);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -141,6 +141,19 @@ typedef enum rocDecodeStatus_enum {
     rocDecodeStatus_Displaying = 10,     // Decode is completed, displaying in progress
 } rocDecDecodeStatus;
 
+/**************************************************************************************************************/
+//! \enum rocDecDecoderBackend
+//! \ingroup group_amd_rocdecode
+//! Decoder backend enums
+//! These enums are used in RocDecoderCreateInfo and RocdecDecodeCaps structures
+/**************************************************************************************************************/
+typedef enum rocDecDecoderBackend_enum {
+    rocDecDecoderBackend_Default = 0, /**< VA-API, or the backend set by the ROCDEC_DECODER_BACKEND environment variable ("vaapi" or "null") */
+    rocDecDecoderBackend_Vaapi = 1,   /**< VA-API hardware decoder */
+    rocDecDecoderBackend_Null = 2,    /**< Software null decoder: pictures are validated and recorded, not decoded, and complete immediately.
+                                           No GPU is needed. The decoded surfaces can not be mapped with rocDecGetVideoFrame. */
+} rocDecDecoderBackend;
+
 /**************************************************************************************************************/
 //! \struct RocdecDecodeCaps;
 //! \ingroup group_amd_rocdecode
@@ -151,7 +164,8 @@ typedef struct _RocdecDecodeCaps {
     rocDecVideoCodec codec_type;           /**< IN: rocDecVideoCodec_XXX */
     rocDecVideoChromaFormat chroma_format; /**< IN: rocDecVideoChromaFormat_XXX */
     uint32_t bit_depth_minus_8;            /**< IN: The Value "BitDepth minus 8" */
-    uint32_t reserved_1[3];                /**< Reserved for future use - set to zero */
+    rocDecDecoderBackend decoder_backend;  /**< IN: rocDecDecoderBackend_XXX */
+    uint32_t reserved_1[2];                /**< Reserved for future use - set to zero */
     uint8_t is_supported;                  /**< OUT: 1 if codec supported, 0 if not supported */
     uint8_t num_decoders;                  /**< OUT: Number of Decoders that can support IN params */
     uint16_t output_format_mask;           /**< OUT: each bit represents corresponding rocDecVideoSurfaceFormat enum */
@@ -200,7 +214,8 @@ typedef struct _RocDecoderCreateInfo {
         int16_t bottom;
     } target_rect;          /**< IN: (for future use) target rectangle in the output frame (for aspect ratio conversion)
                                     if a null rectangle is specified, {0,0,target_width,target_height} will be used*/
-    uint32_t reserved_2[4]; /**< Reserved for future use - set to zero */
+    rocDecDecoderBackend decoder_backend;   /**< IN: rocDecDecoderBackend_XXX */
+    uint32_t reserved_2[3]; /**< Reserved for future use - set to zero */
 } RocDecoderCreateInfo;
 
 /*********************************************************************************************************/
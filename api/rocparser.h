@@ -145,13 +145,31 @@ typedef struct {
 typedef enum {
     ROCDEC_PKT_ENDOFSTREAM = 0x01,   /**< Set when this is the last packet for this stream                              */
     ROCDEC_PKT_TIMESTAMP = 0x02,     /**< Timestamp is valid                                                            */
-    ROCDEC_PKT_DISCONTINUITY = 0x04, /**< Set when a discontinuity has to be signalled                                  */
+    ROCDEC_PKT_DISCONTINUITY = 0x04, /**< Set when a discontinuity has to be signalled. The parser is reset as with
+                                            rocDecParserReset(ROCDEC_PARSER_RESET_FLUSH | ROCDEC_PARSER_RESET_KEEP_PARAM_SETS)
+                                            before the packet is parsed: the pending pictures are still displayed          */
     ROCDEC_PKT_ENDOFPICTURE = 0x08,  /**< Set when the packet contains exactly one frame or one field                   */
     ROCDEC_PKT_NOTIFY_EOS = 0x10,    /**< If this flag is set along with ROCDEC_PKT_ENDOFSTREAM, an additional (dummy)
                                             display callback will be invoked with null value of ROCDECPARSERDISPINFO which
                                             should be interpreted as end of the stream.                                   */
+    ROCDEC_PKT_NAL_INDEX = 0x20,     /**< Set when nal_units and num_nal_units of the packet are valid                  */
 } RocdecVideoPacketFlags;
 
+/*****************************************************************************/
+//! \ingroup group_rocdec_struct
+//! \struct RocdecNalUnitInfo
+//! Location and header fields of an AVC/HEVC NAL unit in a packet payload
+//! Used in RocdecSourceDataPacket structure and rocDecGetBitstreamNalUnitIndex API
+/*****************************************************************************/
+typedef struct _RocdecNalUnitInfo {
+    uint32_t offset;        /**< Byte offset of the start code prefix (0x000001) in the payload                  */
+    uint32_t size;          /**< Size in bytes from the start code prefix up to the next start code prefix       */
+    uint8_t nal_unit_type;  /**< nal_unit_type of the NAL unit header                                           */
+    uint8_t layer_id;       /**< nuh_layer_id for HEVC, 0 for AVC                                              */
+    uint8_t temporal_id;    /**< TemporalId (nuh_temporal_id_plus1 - 1) for HEVC, 0 for AVC                     */
+    uint8_t reserved;       /**< Reserved for future use, set to 0                                             */
+} RocdecNalUnitInfo;
+
 /*****************************************************************************/
 //! \ingroup group_rocdec_struct
 //! \struct RocdecSourceDataPacket
@@ -164,6 +182,9 @@ typedef struct _RocdecSourceDataPacket {
     uint32_t payload_size;  /**< IN: number of bytes in the payload (may be zero if EOS flag is set) */
     const uint8_t *payload; /**< IN: Pointer to packet payload data (may be NULL if EOS flag is set) */
     RocdecTimeStamp pts;    /**< IN: Presentation time stamp (10MHz clock), only valid if ROCDEC_PKT_TIMESTAMP flag is set */
+    const RocdecNalUnitInfo *nal_units; /**< IN: AVC/HEVC NAL unit index of the payload, only valid if ROCDEC_PKT_NAL_INDEX flag is set.
+                                                 The parser scans the payload for NAL units itself when the flag is not set. */
+    uint32_t num_nal_units; /**< IN: Number of entries in nal_units, only valid if ROCDEC_PKT_NAL_INDEX flag is set */
 } RocdecSourceDataPacket;
 
 /**********************************************************************************/
@@ -181,6 +202,40 @@ typedef struct _RocdecParserDispInfo {
     RocdecTimeStamp pts;    /**< OUT: Presentation time stamp                                                              */
 } RocdecParserDispInfo;
 
+/**********************************************************************************/
+//! \ingroup group_rocdec_struct
+//! \enum RocdecParsedPicType
+//! Coding type of a parsed picture
+/**********************************************************************************/
+typedef enum {
+    ROCDEC_PIC_TYPE_UNKNOWN = 0,    /**< Picture type could not be determined                                        */
+    ROCDEC_PIC_TYPE_I = 1,          /**< Intra picture: only I/SI slices (AVC/HEVC), key or intra-only frame (VP9/AV1) */
+    ROCDEC_PIC_TYPE_P = 2,          /**< Inter picture without B slices (AVC/HEVC), inter frame (VP9/AV1)             */
+    ROCDEC_PIC_TYPE_B = 3,          /**< Picture with at least one B slice (AVC/HEVC)                                 */
+} RocdecParsedPicType;
+
+/**********************************************************************************/
+/*! \brief Parsed picture info struct
+    * \ingroup group_rocdec_struct
+    * \struct RocdecParsedPicInfo
+    * \Used in rocDecParseVideoData API with PFNVIDPARSEDPICCALLBACK pfn_parsed_picture in header only mode
+    */
+/**********************************************************************************/
+typedef struct _RocdecParsedPicInfo {
+    int picture_index;              /**< OUT: Index of the picture in the decode buffer pool, same as RocdecParserDispInfo::picture_index */
+    RocdecParsedPicType pic_type;   /**< OUT: Picture coding type                                                                       */
+    int32_t pic_order_cnt;          /**< OUT: PicOrderCnt for AVC/HEVC, order_hint for AV1, decode order count for VP9                 */
+    uint32_t bitstream_size;        /**< OUT: Size of the picture bitstream in bytes                                                    */
+    uint32_t num_slices;            /**< OUT: Number of slices (AVC/HEVC) or tiles (AV1) of the picture, 1 for VP9                      */
+    int32_t qp;                     /**< OUT: Slice QP of the first slice for AVC/HEVC, base_q_idx for VP9/AV1                          */
+    uint8_t ref_pic_flag;           /**< OUT: 1 if the picture is used for reference; 0 otherwise                                       */
+    uint8_t key_frame_flag;         /**< OUT: 1 if decoding can start at the picture: IDR (AVC), IRAP (HEVC), key frame (VP9/AV1)      */
+    uint8_t field_pic_flag;         /**< OUT: 1 if the picture is a field; 0 otherwise                                                  */
+    uint8_t bottom_field_flag;      /**< OUT: 1 if the field is a bottom field; 0 otherwise                                             */
+    RocdecTimeStamp pts;            /**< OUT: Presentation time stamp of the packet the picture is parsed from                          */
+    uint32_t reserved[8];           /**< Reserved for future use - set to zero                                                          */
+} RocdecParsedPicInfo;
+
 /**
  * @brief RocdecOperatingPointInfo struct
  * @ingroup group_rocdec_struct
@@ -216,12 +271,24 @@ typedef struct _RocdecSeiMessage {
 //! Used in rocDecParseVideoData API with PFNVIDSEIMSGCALLBACK pfn_get_sei_msg
 /**********************************************************************************/
 typedef struct _RocdecSeiMessageInfo {
-    void *sei_data;                /**< OUT: SEI Message Data      */
+    void *sei_data;                /**< OUT: SEI Message Data. The payloads of all messages back to back. NULL when an SEI filter is set */
     RocdecSeiMessage *sei_message; /**< OUT: SEI Message Info      */
     uint32_t sei_message_count;    /**< OUT: SEI Message Count     */
     uint32_t picIdx;               /**< OUT: SEI Message Pic Index */
+    void **sei_message_payload;    /**< OUT: Pointer to the payload of each message. Only valid during the callback: payloads without
+                                        emulation prevention bytes point into the packet passed to rocDecParseVideoData */
 } RocdecSeiMessageInfo;
 
+/**********************************************************************************/
+//! \ingroup group_rocdec_struct
+//! \struct RocdecSeiFilter
+//! Used in RocdecParserParams to select the SEI payload types delivered with PFNVIDSEIMSGCALLBACK pfn_get_sei_msg
+/**********************************************************************************/
+typedef struct _RocdecSeiFilter {
+    uint32_t payload_type_mask[8]; /**< IN: Bit (n % 32) of payload_type_mask[n / 32] set: deliver SEI payload type n (0-255) */
+    uint32_t reserved[8];          /**< Reserved for future use - set to 0 */
+} RocdecSeiFilter;
+
 /**
  * @brief Parser callbacks
  * \ The parser will call these synchronously from within rocDecParseVideoData(), whenever there is sequence change or a picture
@@ -236,12 +303,14 @@ typedef struct _RocdecSeiMessageInfo {
  * \ PFNVIDDISPLAYCALLBACK  : 0: fail, >=1: succeeded
  * \ PFNVIDOPPOINTCALLBACK  : <0: fail, >=0: succeeded (bit 0-9: OperatingPoint, bit 10-10: outputAllLayers, bit 11-30: reserved)
  * \ PFNVIDSEIMSGCALLBACK   : 0: fail, >=1: succeeded
+ * \ PFNVIDPARSEDPICCALLBACK: 0: fail, >=1: succeeded
  */
 typedef int(ROCDECAPI *PFNVIDSEQUENCECALLBACK)(void *, RocdecVideoFormat *);
 typedef int(ROCDECAPI *PFNVIDDECODECALLBACK)(void *, RocdecPicParams *);
 typedef int(ROCDECAPI *PFNVIDDISPLAYCALLBACK)(void *, RocdecParserDispInfo *);
 // typedef int (ROCDECAPI *PFNVIDOPPOINTCALLBACK)(void *, RocdecOperatingPointInfo*);        // reserved for future (AV1 specific)
 typedef int(ROCDECAPI *PFNVIDSEIMSGCALLBACK)(void *, RocdecSeiMessageInfo *);
+typedef int(ROCDECAPI *PFNVIDPARSEDPICCALLBACK)(void *, RocdecParsedPicInfo *);
 
 /**
  * \brief The AMD rocDecode library.
@@ -255,17 +324,66 @@ typedef struct _RocdecParserParams {
     uint32_t error_threshold;                     /**< IN: % Error threshold (0-100) for calling pfn_decode_picture (100=always IN: call pfn_decode_picture even if picture bitstream is fully corrupted) */
     uint32_t max_display_delay;                   /**< IN: Max display queue delay (improves pipelining of decode with display) 0 = no delay (recommended values: 2..4) */
     uint32_t annex_b : 1;                         /**< IN: AV1 annexB stream                                                   */
-    uint32_t reserved : 31;                       /**< Reserved for future use - set to zero                                   */
-    uint32_t reserved_1[4];                       /**< IN: Reserved for future use - set to 0                                  */
+    uint32_t header_only : 1;                     /**< IN: Header only mode. Pictures are parsed and tracked in the DPB but not sent to the decoder:
+                                                       pfn_parsed_picture is called instead of pfn_decode_picture                */
+    uint32_t explicit_frame_release : 1;          /**< IN: Displayed pictures are not reused by the parser until they are released with
+                                                       rocDecParserMarkFrameForReuse, which may be called from any thread     */
+    uint32_t skip_non_ref_pics : 1;               /**< IN: Drop the pictures that are not referenced by later pictures before they are decoded.
+                                                       The dropped pictures are not displayed                                  */
+    uint32_t keyframe_only : 1;                   /**< IN: Decode only the key pictures (HEVC IRAP, AVC IDR, VP9/AV1 key frames) and display them
+                                                       without delay. The other pictures are dropped after their type is known */
+    uint32_t byte_stream_input : 1;               /**< IN: AVC/HEVC: Packets are arbitrary chunks of an Annex B byte stream. The parser assembles the
+                                                       access units itself. An access unit takes the PTS of the packet in which it starts.
+                                                       Set ROCDEC_PKT_ENDOFPICTURE on a packet that ends an access unit to parse it without
+                                                       waiting for the first slice of the next picture */
+    uint32_t zero_reorder_output : 1;             /**< IN: Display each picture right after it is submitted for decode, ignoring max_display_delay, when
+                                                       the stream needs no reordering: HEVC sps_max_num_reorder_pics == 0, AVC VUI max_num_reorder_frames
+                                                       == 0 (or an intra profile), VP9/AV1 always as shown frames are in output order */
+    uint32_t reserved : 25;                       /**< Reserved for future use - set to zero                                   */
+    uint32_t max_temporal_id_plus1;               /**< IN: [Optional] HEVC/AV1: Highest temporal layer to decode plus 1. NAL units and OBUs of higher
+                                                       temporal layers are discarded before they are parsed. 0 = decode all layers */
+    uint32_t operating_point;                     /**< IN: [Optional] AV1: Operating point to decode. OBUs that are not part of it are discarded.
+                                                       0 = default (usually all layers). Operating point 0 is used if it is out of range */
+    uint32_t reserved_1[2];                       /**< IN: Reserved for future use - set to 0                                  */
     void *user_data;                              /**< IN: User data for callbacks                                             */
     PFNVIDSEQUENCECALLBACK pfn_sequence_callback; /**< IN: Called before decoding frames and/or whenever there is a fmt change */
     PFNVIDDECODECALLBACK pfn_decode_picture;      /**< IN: Called when a picture is ready to be decoded (decode order)         */
     PFNVIDDISPLAYCALLBACK pfn_display_picture;    /**< IN: Called whenever a picture is ready to be displayed (display order)  */
     PFNVIDSEIMSGCALLBACK pfn_get_sei_msg;         /**< IN: Called when all SEI messages are parsed for particular frame        */
-    void *reserved_2[5];                          /**< Reserved for future use - set to NULL                                   */
+    PFNVIDPARSEDPICCALLBACK pfn_parsed_picture;   /**< IN: [Optional] Called when a picture is parsed in header only mode (decode order) */
+    RocdecSeiFilter *sei_filter;                  /**< IN: [Optional] SEI payload types to deliver. Other payloads are skipped without
+                                                       copying. All types are delivered if NULL. Copied by rocDecCreateVideoParser */
+    void *reserved_2[3];                          /**< Reserved for future use - set to NULL                                   */
     RocdecVideoFormatEx *ext_video_info;          /**< IN: [Optional] sequence header data from system layer                   */
 } RocdecParserParams;
 
+/*****************************************************************************/
+//! \ingroup group_rocdec_struct
+//! \struct RocdecParserStats
+//! Parser statistics, accumulated since the parser was created
+//! Used in rocDecGetParserStats API
+/*****************************************************************************/
+typedef struct _RocdecParserStats {
+    uint64_t num_param_set_cache_hits;      /**< OUT: Number of parameter sets not parsed again because they are identical to the stored set with the same id */
+    uint64_t num_param_set_cache_misses;    /**< OUT: Number of parameter sets parsed in full                                                                 */
+    uint64_t num_skipped_non_ref_pics;      /**< OUT: Number of non-reference pictures dropped with skip_non_ref_pics                                         */
+    uint64_t num_suppressed_pics;           /**< OUT: Number of pictures not displayed because their PTS is before the display start PTS                     */
+    uint64_t reserved[12];                  /**< Reserved for future use - set to zero                                                                        */
+} RocdecParserStats;
+
+/***************************************************************/
+//! \enum RocdecParserResetFlags
+//! Parser reset flags
+//! Used in rocDecParserReset API
+/***************************************************************/
+typedef enum {
+    ROCDEC_PARSER_RESET_FLUSH = 0x01,           /**< Output the pending pictures through pfn_display_picture before the reset.
+                                                     They are discarded otherwise                                             */
+    ROCDEC_PARSER_RESET_KEEP_PARAM_SETS = 0x02, /**< Keep the parameter sets and the reported video format. The stream can be
+                                                     resumed at a random access point without repeated parameter sets and
+                                                     without a new sequence callback                                         */
+} RocdecParserResetFlags;
+
 /************************************************************************************************/
 //! \ingroup group_rocparser
 //! \fn rocDecodeStatus ROCDECAPI rocDecCreateVideoParser(RocdecVideoParser *parser_handle, RocdecParserParams *params)
@@ -288,10 +406,33 @@ extern rocDecStatus ROCDECAPI rocDecParseVideoData(RocdecVideoParser parser_hand
 /************************************************************************************************/
 //! \ingroup group_rocparser
 //! \fn rocDecStatus ROCDECAPI rocDecParserMarkFrameForReuse(RocdecVideoParser parser_handle, int pic_idx)
-//! Mark frame with index pic_idx in parser's buffer pool for reuse (means the frame has been consumed) 
+//! Mark frame with index pic_idx in parser's buffer pool for reuse (means the frame has been consumed).
+//! Only has effect if RocdecParserParams::explicit_frame_release is set. Can be called from a different thread than the
+//! one calling rocDecParseVideoData; each displayed picture must be released once.
 /************************************************************************************************/
 extern rocDecStatus ROCDECAPI rocDecParserMarkFrameForReuse(RocdecVideoParser parser_handle, int pic_idx);
 
+/************************************************************************************************/
+//! \ingroup group_rocparser
+//! \fn rocDecStatus ROCDECAPI rocDecParserReset(RocdecVideoParser parser_handle, uint32_t flags)
+//! Reset the video parser object to the state after creation, for example after a seek. The DPB and the output queue are
+//! flushed or discarded and the POC/order hint state is reset. flags is a combination of RocdecParserResetFlags.
+//! Frames held by the application with RocdecParserParams::explicit_frame_release stay reserved until they are released.
+//! The next packet must start at a random access point.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecParserReset(RocdecVideoParser parser_handle, uint32_t flags);
+
+/************************************************************************************************/
+//! \ingroup group_rocparser
+//! \fn rocDecStatus ROCDECAPI rocDecParserSetDisplayStartPts(RocdecVideoParser parser_handle, RocdecTimeStamp pts)
+//! Suppress the display of the pictures with a PTS less than pts, e.g. the pre-roll pictures from the key frame before a
+//! seek target. Suppressed reference pictures are decoded but not passed to pfn_display_picture and their surfaces are
+//! reused right away. Non-reference pictures in packets with a PTS less than pts are not decoded. The suppression ends
+//! with the first displayed picture with a PTS equal to or greater than pts. A new call replaces the previous setting.
+//! Must not be called concurrently with rocDecParseVideoData.
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecParserSetDisplayStartPts(RocdecVideoParser parser_handle, RocdecTimeStamp pts);
+
 /************************************************************************************************/
 //! \ingroup group_rocparser
 //! \fn rocDecStatus ROCDECAPI rocDecDestroyVideoParser(RocdecVideoParser parser_handle)
@@ -299,6 +440,13 @@ extern rocDecStatus ROCDECAPI rocDecParserMarkFrameForReuse(RocdecVideoParser pa
 /************************************************************************************************/
 extern rocDecStatus ROCDECAPI rocDecDestroyVideoParser(RocdecVideoParser parser_handle);
 
+/************************************************************************************************/
+//! \ingroup group_rocparser
+//! \fn rocDecStatus ROCDECAPI rocDecGetParserStats(RocdecVideoParser parser_handle, RocdecParserStats *stats)
+//! Get the statistics of the video parser object
+/************************************************************************************************/
+extern rocDecStatus ROCDECAPI rocDecGetParserStats(RocdecVideoParser parser_handle, RocdecParserStats *stats);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
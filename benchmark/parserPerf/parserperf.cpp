@@ -0,0 +1,513 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <memory>
+#include <cstring>
+#include "es_reader.h"
+#include "parser_handle.h"
+#include "nal_unit_index.h"
+#include "emulation_prevention.h"
+#include "bit_reader.h"
+#include "avc_defines.h"
+#include "hevc_defines.h"
+
+/*! \brief Picture data of one packet returned by the bitstream reader, with the NAL unit index of the reader
+ */
+typedef struct {
+    std::vector<uint8_t> data;
+    std::vector<RocdecNalUnitInfo> nal_units;
+} PicPacket;
+
+/*! \brief Per thread state of a parse run
+ */
+typedef struct {
+    RocParserHandle *parser;
+    uint64_t num_decoded_pics;
+    uint64_t num_displayed_pics;
+} ParserContext;
+
+typedef struct {
+    std::string name;
+    double time_ms;       // wall time of all threads and loops
+    uint64_t num_bytes;   // bytes processed by all threads and loops
+    uint64_t num_pics;    // pictures processed by all threads and loops
+} StageResult;
+
+static int ROCDECAPI HandleVideoSequence(void *user_data, RocdecVideoFormat *video_format) {
+    return video_format->min_num_decode_surfaces;
+}
+
+// No-op decoder: the picture parameters are ready at this point
+static int ROCDECAPI HandlePictureDecode(void *user_data, RocdecPicParams *pic_params) {
+    static_cast<ParserContext *>(user_data)->num_decoded_pics++;
+    return 1;
+}
+
+// Synthetic consumer: the frame is released right away
+static int ROCDECAPI HandlePictureDisplay(void *user_data, RocdecParserDispInfo *disp_info) {
+    ParserContext *p_ctx = static_cast<ParserContext *>(user_data);
+    if (disp_info) {
+        p_ctx->num_displayed_pics++;
+        p_ctx->parser->MarkFrameForReuse(disp_info->picture_index);
+    }
+    return 1;
+}
+
+void ShowHelpAndExit(const char *option = NULL) {
+    std::cout << "Options:" << std::endl
+    << "-i Input File Path (AVC/HEVC/AV1 elementary stream or AV1 IVF) - required" << std::endl
+    << "-t Number of threads (>= 1), each thread runs its own parser on the same stream - optional; default: 1" << std::endl
+    << "-l Number of loops over the stream per stage (>= 1) - optional; default: 10" << std::endl
+    << "-m Memory mapped input for the bitstream reader - optional; default: read through the ring buffer" << std::endl
+    << "-r Ring buffer size of the bitstream reader in KB - optional; default: 16384" << std::endl
+    << "-hp Huge pages for the ring buffer of the bitstream reader - optional; default: regular pages" << std::endl
+    << "-ra Read-ahead depth of the bitstream reader in chunks (>= 1), reads the file on a background thread - optional; default: off" << std::endl
+    << "-ix Picture index file of the bitstream reader: loaded if it exists, else the index is built and saved to it - optional" << std::endl;
+    exit(0);
+}
+
+const char *GetCodecName(rocDecVideoCodec codec_id) {
+    switch (codec_id) {
+        case rocDecVideoCodec_AVC: return "AVC";
+        case rocDecVideoCodec_HEVC: return "HEVC";
+        case rocDecVideoCodec_AV1: return "AV1";
+        case rocDecVideoCodec_VP9: return "VP9";
+        default: return "Unknown";
+    }
+}
+
+/*! \brief Function to run a stage on n_thread threads and measure the wall time
+ * \param [in] name Name of the stage
+ * \param [in] n_thread Number of threads
+ * \param [in] stage_func Stage function, called once per thread. Returns the number of pictures processed.
+ * \param [in] num_bytes Number of bytes processed by one call of the stage function
+ * \return Stage result
+ */
+StageResult RunStage(const std::string &name, int n_thread, std::function<uint64_t()> stage_func, uint64_t num_bytes) {
+    std::vector<std::thread> threads;
+    std::vector<uint64_t> num_pics(n_thread, 0);
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < n_thread; i++) {
+        threads.emplace_back([&, i]() { num_pics[i] = stage_func(); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    StageResult result = {name, std::chrono::duration<double, std::milli>(end_time - start_time).count(), num_bytes * n_thread, 0};
+    for (auto n : num_pics) {
+        result.num_pics += n;
+    }
+    return result;
+}
+
+/*! \brief Function to parse the packets with no-op callbacks
+ * \param [in] codec_id Codec of the stream
+ * \param [in] packets Packets of the stream
+ * \param [in] num_loops Number of times to parse the stream, with a new parser each time
+ * \param [in] use_nal_index Pass the NAL unit index of the bitstream reader with the packets, so the parser does not scan for start codes
+ * \return Number of decoded pictures
+ */
+uint64_t ParseStream(rocDecVideoCodec codec_id, const std::vector<PicPacket> &packets, int num_loops, bool use_nal_index) {
+    uint64_t num_pics = 0;
+    for (int loop = 0; loop < num_loops; loop++) {
+        ParserContext ctx = {};
+        RocdecParserParams params = {};
+        params.codec_type = codec_id;
+        params.max_num_decode_surfaces = 1;  // increased by the parser as needed
+        params.clock_rate = 1000;
+        params.max_display_delay = 0;
+        params.explicit_frame_release = 1;
+        params.user_data = &ctx;
+        params.pfn_sequence_callback = HandleVideoSequence;
+        params.pfn_decode_picture = HandlePictureDecode;
+        params.pfn_display_picture = HandlePictureDisplay;
+        RocParserHandle parser(&params);
+        ctx.parser = &parser;
+
+        int64_t pts = 0;
+        for (auto &packet : packets) {
+            RocdecSourceDataPacket pkt = {};
+            pkt.payload = packet.data.data();
+            pkt.payload_size = packet.data.size();
+            pkt.pts = pts++;
+            pkt.flags = ROCDEC_PKT_TIMESTAMP;
+            if (use_nal_index && !packet.nal_units.empty()) {
+                pkt.nal_units = packet.nal_units.data();
+                pkt.num_nal_units = packet.nal_units.size();
+                pkt.flags |= ROCDEC_PKT_NAL_INDEX;
+            }
+            if (parser.ParseVideoData(&pkt) != ROCDEC_SUCCESS) {
+                std::cerr << "ERROR: parser failed at packet " << pts - 1 << std::endl;
+                break;
+            }
+        }
+        RocdecSourceDataPacket pkt = {};
+        pkt.flags = ROCDEC_PKT_ENDOFSTREAM;
+        parser.ParseVideoData(&pkt);
+        parser.DestroyParser();
+        num_pics += ctx.num_decoded_pics;
+    }
+    return num_pics;
+}
+
+// The bit-at-a-time helpers the parsers used before Parser::BitReader, kept as the reference of the bit reader stage
+namespace LegacyBitReader {
+    inline uint32_t GetBit(const uint8_t *data, size_t &bit_idx) {
+        uint32_t ret = (data[bit_idx / 8] >> (7 - bit_idx % 8) & 1);
+        bit_idx++;
+        return ret;
+    }
+
+    inline uint32_t ReadBits(const uint8_t *data, size_t &start_bit_idx, size_t bits_to_read) {
+        if (bits_to_read > 32) {
+            return 0;
+        }
+        uint32_t result = 0;
+        for (size_t i = 0; i < bits_to_read; i++) {
+            result = result << 1;
+            result |= GetBit(data, start_bit_idx);
+        }
+        return result;
+    }
+
+    inline uint32_t ReadUe(const uint8_t *data, size_t &start_bit_idx) {
+        size_t start_bit_idx_org = start_bit_idx;
+        while (GetBit(data, start_bit_idx) == 0) {}
+        size_t zero_bits_count = start_bit_idx - start_bit_idx_org - 1;
+        if (zero_bits_count > 30) {
+            return 0;
+        }
+        return (0x1 << zero_bits_count) - 1 + ReadBits(data, start_bit_idx, zero_bits_count);
+    }
+
+    inline int32_t ReadSe(const uint8_t *data, size_t &start_bit_idx) {
+        uint32_t ue = ReadUe(data, start_bit_idx);
+        return ue & 1 ? static_cast<int32_t>((ue + 1) / 2) : -static_cast<int32_t>(ue / 2);
+    }
+}
+
+#define BIT_READER_PAYLOAD_SIZE 64 // bytes of a slice NAL unit read by the bit reader stage, enough for the slice header
+#define BIT_READER_PADDING 8       // 0xFF bytes after each payload, so that an Exp-Golomb code always ends within the buffer
+
+/*! \brief Function to collect the RBSP of the SPS and the beginning of the slice NAL units, padded with BIT_READER_PADDING 0xFF bytes
+ * \param [in] codec_id Codec of the stream, AVC or HEVC
+ * \param [in] packets Packets of the stream
+ * \return The payloads
+ */
+std::vector<std::vector<uint8_t>> GetBitReaderPayloads(rocDecVideoCodec codec_id, const std::vector<PicPacket> &packets) {
+    std::vector<std::vector<uint8_t>> payloads;
+    int nal_header_size = codec_id == rocDecVideoCodec_AVC ? 1 : 2;
+    for (auto &packet : packets) {
+        for (auto &nal_unit : packet.nal_units) {
+            bool is_sps, is_slice;
+            if (codec_id == rocDecVideoCodec_AVC) {
+                is_sps = nal_unit.nal_unit_type == kAvcNalTypeSeq_Parameter_Set;
+                is_slice = nal_unit.nal_unit_type == kAvcNalTypeSlice_Non_IDR || nal_unit.nal_unit_type == kAvcNalTypeSlice_IDR;
+            } else {
+                is_sps = nal_unit.nal_unit_type == NAL_UNIT_SPS;
+                is_slice = nal_unit.nal_unit_type <= NAL_UNIT_RESERVED_VCL31;
+            }
+            int ebsp_size = static_cast<int>(nal_unit.size) - 3 - nal_header_size;
+            if ((!is_sps && !is_slice) || ebsp_size <= 0) {
+                continue;
+            }
+            if (is_slice && ebsp_size > BIT_READER_PAYLOAD_SIZE) {
+                ebsp_size = BIT_READER_PAYLOAD_SIZE;
+            }
+            std::vector<uint8_t> rbsp(ebsp_size + BIT_READER_PADDING, 0xFF);
+            size_t rbsp_size = Parser::EbspToRbsp(packet.data.data() + nal_unit.offset + 3 + nal_header_size, ebsp_size, rbsp.data());
+            if (rbsp_size == static_cast<size_t>(-1)) {
+                continue;
+            }
+            rbsp.resize(rbsp_size);
+            // Skip payloads with more than 30 zero bits in a row: the two readers consume different bits for such invalid codes
+            int zero_run = 0, max_zero_run = 0;
+            for (size_t i = 0; i < rbsp_size * 8; i++) {
+                zero_run = (rbsp[i / 8] >> (7 - i % 8)) & 1 ? 0 : zero_run + 1;
+                max_zero_run = zero_run > max_zero_run ? zero_run : max_zero_run;
+            }
+            if (max_zero_run > 30) {
+                continue;
+            }
+            rbsp.insert(rbsp.end(), BIT_READER_PADDING, 0xFF);
+            payloads.push_back(std::move(rbsp));
+        }
+    }
+    return payloads;
+}
+
+/*! \brief Function to read the payloads as a repeated u(1), ue(v), u(4), se(v) sequence, the mix of a header syntax
+ * \param [in] payloads Payloads of GetBitReaderPayloads
+ * \param [in] use_legacy_reader Read with the LegacyBitReader helpers instead of Parser::BitReader
+ * \return Checksum of the values read
+ */
+uint64_t ReadPayloadBits(const std::vector<std::vector<uint8_t>> &payloads, bool use_legacy_reader) {
+    uint64_t checksum = 0;
+    Parser::BitReader bit_reader;
+    for (auto &payload : payloads) {
+        size_t end_bit_offset = (payload.size() - BIT_READER_PADDING) * 8;
+        if (use_legacy_reader) {
+            size_t bit_offset = 0;
+            while (bit_offset < end_bit_offset) {
+                checksum += LegacyBitReader::GetBit(payload.data(), bit_offset);
+                checksum += LegacyBitReader::ReadUe(payload.data(), bit_offset);
+                checksum += LegacyBitReader::ReadBits(payload.data(), bit_offset, 4);
+                checksum += LegacyBitReader::ReadSe(payload.data(), bit_offset);
+            }
+        } else {
+            bit_reader.Init(payload.data(), payload.size());
+            while (bit_reader.GetBitOffset() < end_bit_offset) {
+                checksum += bit_reader.GetBit();
+                checksum += bit_reader.ReadUe();
+                checksum += bit_reader.ReadBits(4);
+                checksum += bit_reader.ReadSe();
+            }
+        }
+    }
+    return checksum;
+}
+
+int main(int argc, char **argv) {
+    std::string input_file_path;
+    std::string index_file_path;
+    int n_thread = 1;
+    int num_loops = 10;
+    RocdecBitstreamReaderParams reader_params = {};
+
+    // Parse command-line arguments
+    if (argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_file_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-t")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-t");
+            }
+            n_thread = atoi(argv[i]);
+            if (n_thread <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-l")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-l");
+            }
+            num_loops = atoi(argv[i]);
+            if (num_loops <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-m")) {
+            reader_params.memory_mapped_input = 1;
+            continue;
+        }
+        if (!strcmp(argv[i], "-r")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-r");
+            }
+            int ring_size_kb = atoi(argv[i]);
+            if (ring_size_kb <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            reader_params.ring_size = ring_size_kb * 1024;
+            continue;
+        }
+        if (!strcmp(argv[i], "-hp")) {
+            reader_params.use_huge_pages = 1;
+            continue;
+        }
+        if (!strcmp(argv[i], "-ra")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-ra");
+            }
+            int read_ahead_depth = atoi(argv[i]);
+            if (read_ahead_depth <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            reader_params.read_ahead = 1;
+            reader_params.read_ahead_depth = read_ahead_depth;
+            continue;
+        }
+        if (!strcmp(argv[i], "-ix")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-ix");
+            }
+            index_file_path = argv[i];
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+
+    try {
+        // Read the stream into memory. The reader locates the picture boundaries and indexes the NAL units.
+        std::vector<PicPacket> packets;
+        uint64_t stream_size = 0;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<RocVideoESParser> reader = std::make_unique<RocVideoESParser>(input_file_path.c_str(), &reader_params);
+        rocDecVideoCodec codec_id = reader->GetCodecId();
+        if (codec_id != rocDecVideoCodec_AVC && codec_id != rocDecVideoCodec_HEVC && codec_id != rocDecVideoCodec_AV1) {
+            std::cerr << "ERROR: unsupported stream type: " << input_file_path << std::endl;
+            return 1;
+        }
+        // Index pass, timed separately from the reader stage
+        double index_time_ms = 0;
+        bool index_loaded = false;
+        int num_index_entries = 0, num_key_frames = 0;
+        if (!index_file_path.empty()) {
+            auto index_start_time = std::chrono::high_resolution_clock::now();
+            index_loaded = std::ifstream(index_file_path).good() && reader->LoadIndex(index_file_path.c_str()) == ROCDEC_SUCCESS;
+            if (!index_loaded && (reader->BuildIndex() != ROCDEC_SUCCESS || reader->SaveIndex(index_file_path.c_str()) != ROCDEC_SUCCESS)) {
+                std::cerr << "ERROR: failed to build the picture index of " << input_file_path << std::endl;
+                return 1;
+            }
+            index_time_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - index_start_time).count();
+            const RocdecBitstreamPicIndexEntry *index_entries;
+            reader->GetIndex(&index_entries, &num_index_entries);
+            for (int i = 0; i < num_index_entries; i++) {
+                num_key_frames += index_entries[i].key_frame_flag;
+            }
+        }
+        while (true) {
+            uint8_t *p_pic_data;
+            int pic_size = 0;
+            int64_t pts;
+            if (reader->GetPicData(&p_pic_data, &pic_size, &pts) != ROCDEC_SUCCESS || pic_size <= 0) {
+                break;
+            }
+            const RocdecNalUnitInfo *nal_units;
+            int num_nal_units;
+            reader->GetNalUnitIndex(&nal_units, &num_nal_units);
+            packets.push_back({std::vector<uint8_t>(p_pic_data, p_pic_data + pic_size), std::vector<RocdecNalUnitInfo>(nal_units, nal_units + num_nal_units)});
+            stream_size += pic_size;
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        RocdecBitstreamReaderStats reader_stats;
+        reader->GetStats(&reader_stats);
+        reader.reset();
+        if (packets.empty()) {
+            std::cerr << "ERROR: no picture data in " << input_file_path << std::endl;
+            return 1;
+        }
+        std::vector<StageResult> results;
+        results.push_back({"bitstream reader", std::chrono::duration<double, std::milli>(end_time - start_time).count() - index_time_ms, stream_size, packets.size()});
+
+        bool is_annex_b = codec_id == rocDecVideoCodec_AVC || codec_id == rocDecVideoCodec_HEVC;
+        if (is_annex_b) {
+            results.push_back(RunStage("start code scan", n_thread, [&]() {
+                std::vector<RocdecNalUnitInfo> nal_units;
+                uint64_t num_pics = 0;
+                for (int loop = 0; loop < num_loops; loop++) {
+                    for (auto &packet : packets) {
+                        Parser::BuildNalUnitIndex(packet.data.data(), packet.data.size(), codec_id, nal_units);
+                        num_pics++;
+                    }
+                }
+                return num_pics;
+            }, stream_size * num_loops));
+            results.push_back(RunStage("RBSP conversion", n_thread, [&]() {
+                std::vector<uint8_t> rbsp;
+                uint64_t num_pics = 0;
+                for (int loop = 0; loop < num_loops; loop++) {
+                    for (auto &packet : packets) {
+                        for (auto &nal_unit : packet.nal_units) {
+                            if (rbsp.size() < nal_unit.size) {
+                                rbsp.resize(nal_unit.size);
+                            }
+                            Parser::EbspToRbsp(packet.data.data() + nal_unit.offset, nal_unit.size, rbsp.data());
+                        }
+                        num_pics++;
+                    }
+                }
+                return num_pics;
+            }, stream_size * num_loops));
+            // The same SPS and slice header bits with the bit-at-a-time helpers and with Parser::BitReader
+            std::vector<std::vector<uint8_t>> payloads = GetBitReaderPayloads(codec_id, packets);
+            uint64_t payload_size = 0;
+            for (auto &payload : payloads) {
+                payload_size += payload.size() - BIT_READER_PADDING;
+            }
+            if (ReadPayloadBits(payloads, true) != ReadPayloadBits(payloads, false)) {
+                std::cerr << "ERROR: the bit reader and the legacy bit reader read different values" << std::endl;
+            }
+            for (bool use_legacy_reader : {true, false}) {
+                results.push_back(RunStage(use_legacy_reader ? "bit reader (legacy)" : "bit reader", n_thread, [&]() {
+                    uint64_t checksum = 0;
+                    for (int loop = 0; loop < num_loops; loop++) {
+                        checksum += ReadPayloadBits(payloads, use_legacy_reader);
+                    }
+                    return checksum ? packets.size() * num_loops : 0; // the checksum keeps the reads from being optimized away
+                }, payload_size * num_loops));
+            }
+            results.push_back(RunStage("header parse + DPB", n_thread, [&]() { return ParseStream(codec_id, packets, num_loops, true); }, stream_size * num_loops));
+        }
+        results.push_back(RunStage("full parse", n_thread, [&]() { return ParseStream(codec_id, packets, num_loops, false); }, stream_size * num_loops));
+
+        std::cout << "info: Input file: " << input_file_path << std::endl;
+        std::cout << "info: Codec: " << GetCodecName(codec_id) << ", packets: " << packets.size() << ", bytes: " << stream_size << std::endl;
+        std::cout << "info: Threads: " << n_thread << ", loops per stage: " << num_loops << std::endl;
+        std::cout << "info: Bitstream reader fetches: " << reader_stats.num_fetches << ", blocked: " << reader_stats.blocked_time_us / 1000.0 << " ms";
+        if (reader_stats.read_ahead_depth) {
+            std::cout << ", read-ahead depth: " << reader_stats.read_ahead_depth << " bytes, hits: " << reader_stats.num_read_ahead_hits << ", stalls: " << reader_stats.num_read_ahead_stalls;
+        }
+        std::cout << std::endl;
+        if (!index_file_path.empty()) {
+            std::cout << "info: Picture index: " << num_index_entries << " pictures, " << num_key_frames << " key frames, " << (index_loaded ? "loaded from " : "built and saved to ")
+                      << index_file_path << " in " << index_time_ms << " ms" << std::endl;
+        }
+        std::cout << std::left << std::setw(22) << "stage" << std::right << std::setw(14) << "time (ms)" << std::setw(14) << "MB/s" << std::setw(16) << "pictures/s" << std::endl;
+        for (auto &result : results) {
+            double time_s = result.time_ms / 1000.0;
+            std::cout << std::left << std::setw(22) << result.name << std::right << std::fixed << std::setprecision(2) << std::setw(14) << result.time_ms
+                      << std::setw(14) << (time_s > 0 ? result.num_bytes / 1e6 / time_s : 0) << std::setw(16) << (time_s > 0 ? result.num_pics / time_s : 0) << std::endl;
+        }
+        if (is_annex_b) {
+            std::cout << "info: bit reader stages read the RBSP of the SPS and of the first " << BIT_READER_PAYLOAD_SIZE << " bytes of the slice NAL units" << std::endl;
+            std::cout << "info: header parse + DPB is parsed with the NAL unit index of the bitstream reader, without the parser's start code scan" << std::endl;
+        }
+    } catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -73,4 +73,46 @@ rocDecStatus ROCDECAPI rocDecGetBitstreamPicData(RocdecBitstreamReader bs_reader
 rocDecStatus ROCDECAPI rocDecDestroyBitstreamReader(RocdecBitstreamReader bs_reader_handle) {
     return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_destroy_bitstream_reader(bs_reader_handle);
 }
+rocDecStatus ROCDECAPI rocDecGetBitstreamNalUnitIndex(RocdecBitstreamReader bs_reader_handle, const RocdecNalUnitInfo **nal_units, int *num_nal_units) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_get_bitstream_nal_unit_index(bs_reader_handle, nal_units, num_nal_units);
+}
+rocDecStatus ROCDECAPI rocDecGetParserStats(RocdecVideoParser parser_handle, RocdecParserStats *stats) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_get_parser_stats(parser_handle, stats);
+}
+rocDecStatus ROCDECAPI rocDecParserMarkFrameForReuse(RocdecVideoParser parser_handle, int pic_idx) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_parser_mark_frame_for_reuse(parser_handle, pic_idx);
+}
+rocDecStatus ROCDECAPI rocDecParserReset(RocdecVideoParser parser_handle, uint32_t flags) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_parser_reset(parser_handle, flags);
+}
+rocDecStatus ROCDECAPI rocDecParserSetDisplayStartPts(RocdecVideoParser parser_handle, RocdecTimeStamp pts) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_parser_set_display_start_pts(parser_handle, pts);
+}
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderWithParams(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path, RocdecBitstreamReaderParams *params) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_create_bitstream_reader_with_params(bs_reader_handle, input_file_path, params);
+}
+rocDecStatus ROCDECAPI rocDecGetBitstreamReaderStats(RocdecBitstreamReader bs_reader_handle, RocdecBitstreamReaderStats *stats) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_get_bitstream_reader_stats(bs_reader_handle, stats);
+}
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromMemory(RocdecBitstreamReader *bs_reader_handle, const uint8_t *data, size_t size, RocdecBitstreamReaderParams *params) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_create_bitstream_reader_from_memory(bs_reader_handle, data, size, params);
+}
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromCallback(RocdecBitstreamReader *bs_reader_handle, PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, RocdecBitstreamReaderParams *params) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_create_bitstream_reader_from_callback(bs_reader_handle, pfn_read, user_data, params);
+}
+rocDecStatus ROCDECAPI rocDecBuildBitstreamIndex(RocdecBitstreamReader bs_reader_handle) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_build_bitstream_index(bs_reader_handle);
+}
+rocDecStatus ROCDECAPI rocDecSaveBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_save_bitstream_index(bs_reader_handle, index_file_path);
+}
+rocDecStatus ROCDECAPI rocDecLoadBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_load_bitstream_index(bs_reader_handle, index_file_path);
+}
+rocDecStatus ROCDECAPI rocDecGetBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const RocdecBitstreamPicIndexEntry **entries, int *num_entries) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_get_bitstream_index(bs_reader_handle, entries, num_entries);
+}
+rocDecStatus ROCDECAPI rocDecSeekBitstream(RocdecBitstreamReader bs_reader_handle, int pic_idx, uint32_t flags, int *seek_pic_idx) {
+    return rocdecode::GetRocDecodeDispatchTable()->pfn_rocdec_seek_bitstream(bs_reader_handle, pic_idx, flags, seek_pic_idx);
+}
 
@@ -50,6 +50,20 @@ rocDecStatus ROCDECAPI rocDecGetBitstreamCodecType(RocdecBitstreamReader bs_read
 rocDecStatus ROCDECAPI rocDecGetBitstreamBitDepth(RocdecBitstreamReader bs_reader_handle, int *bit_depth);
 rocDecStatus ROCDECAPI rocDecGetBitstreamPicData(RocdecBitstreamReader bs_reader_handle, uint8_t **pic_data, int *pic_size, int64_t *pts);
 rocDecStatus ROCDECAPI rocDecDestroyBitstreamReader(RocdecBitstreamReader bs_reader_handle);
+rocDecStatus ROCDECAPI rocDecGetBitstreamNalUnitIndex(RocdecBitstreamReader bs_reader_handle, const RocdecNalUnitInfo **nal_units, int *num_nal_units);
+rocDecStatus ROCDECAPI rocDecGetParserStats(RocdecVideoParser parser_handle, RocdecParserStats *stats);
+rocDecStatus ROCDECAPI rocDecParserMarkFrameForReuse(RocdecVideoParser parser_handle, int pic_idx);
+rocDecStatus ROCDECAPI rocDecParserReset(RocdecVideoParser parser_handle, uint32_t flags);
+rocDecStatus ROCDECAPI rocDecParserSetDisplayStartPts(RocdecVideoParser parser_handle, RocdecTimeStamp pts);
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderWithParams(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path, RocdecBitstreamReaderParams *params);
+rocDecStatus ROCDECAPI rocDecGetBitstreamReaderStats(RocdecBitstreamReader bs_reader_handle, RocdecBitstreamReaderStats *stats);
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromMemory(RocdecBitstreamReader *bs_reader_handle, const uint8_t *data, size_t size, RocdecBitstreamReaderParams *params);
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromCallback(RocdecBitstreamReader *bs_reader_handle, PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, RocdecBitstreamReaderParams *params);
+rocDecStatus ROCDECAPI rocDecBuildBitstreamIndex(RocdecBitstreamReader bs_reader_handle);
+rocDecStatus ROCDECAPI rocDecSaveBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path);
+rocDecStatus ROCDECAPI rocDecLoadBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path);
+rocDecStatus ROCDECAPI rocDecGetBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const RocdecBitstreamPicIndexEntry **entries, int *num_entries);
+rocDecStatus ROCDECAPI rocDecSeekBitstream(RocdecBitstreamReader bs_reader_handle, int pic_idx, uint32_t flags, int *seek_pic_idx);
 }
 
 namespace rocdecode {
@@ -72,6 +86,20 @@ void UpdateDispatchTable(RocDecodeDispatchTable* ptr_dispatch_table) {
     ptr_dispatch_table->pfn_rocdec_get_bitstream_bit_depth = rocdecode::rocDecGetBitstreamBitDepth;
     ptr_dispatch_table->pfn_rocdec_get_bitstream_pic_data = rocdecode::rocDecGetBitstreamPicData;
     ptr_dispatch_table->pfn_rocdec_destroy_bitstream_reader = rocdecode::rocDecDestroyBitstreamReader;
+    ptr_dispatch_table->pfn_rocdec_get_bitstream_nal_unit_index = rocdecode::rocDecGetBitstreamNalUnitIndex;
+    ptr_dispatch_table->pfn_rocdec_get_parser_stats = rocdecode::rocDecGetParserStats;
+    ptr_dispatch_table->pfn_rocdec_parser_mark_frame_for_reuse = rocdecode::rocDecParserMarkFrameForReuse;
+    ptr_dispatch_table->pfn_rocdec_parser_reset = rocdecode::rocDecParserReset;
+    ptr_dispatch_table->pfn_rocdec_parser_set_display_start_pts = rocdecode::rocDecParserSetDisplayStartPts;
+    ptr_dispatch_table->pfn_rocdec_create_bitstream_reader_with_params = rocdecode::rocDecCreateBitstreamReaderWithParams;
+    ptr_dispatch_table->pfn_rocdec_get_bitstream_reader_stats = rocdecode::rocDecGetBitstreamReaderStats;
+    ptr_dispatch_table->pfn_rocdec_create_bitstream_reader_from_memory = rocdecode::rocDecCreateBitstreamReaderFromMemory;
+    ptr_dispatch_table->pfn_rocdec_create_bitstream_reader_from_callback = rocdecode::rocDecCreateBitstreamReaderFromCallback;
+    ptr_dispatch_table->pfn_rocdec_build_bitstream_index = rocdecode::rocDecBuildBitstreamIndex;
+    ptr_dispatch_table->pfn_rocdec_save_bitstream_index = rocdecode::rocDecSaveBitstreamIndex;
+    ptr_dispatch_table->pfn_rocdec_load_bitstream_index = rocdecode::rocDecLoadBitstreamIndex;
+    ptr_dispatch_table->pfn_rocdec_get_bitstream_index = rocdecode::rocDecGetBitstreamIndex;
+    ptr_dispatch_table->pfn_rocdec_seek_bitstream = rocdecode::rocDecSeekBitstream;
 }
 
 #if ROCDECODE_ROCPROFILER_REGISTER > 0
@@ -167,14 +195,37 @@ ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_get_bitstream_bit_depth
 ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_get_bitstream_pic_data, 14)
 ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_destroy_bitstream_reader, 15)
 // ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 2
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_get_bitstream_nal_unit_index, 16)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 3
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_get_parser_stats, 17)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 4
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_parser_mark_frame_for_reuse, 18)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 5
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_parser_reset, 19)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 6
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_parser_set_display_start_pts, 20)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 7
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_create_bitstream_reader_with_params, 21)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 8
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_get_bitstream_reader_stats, 22)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 9
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_create_bitstream_reader_from_memory, 23)
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_create_bitstream_reader_from_callback, 24)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 10
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_build_bitstream_index, 25)
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_save_bitstream_index, 26)
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_load_bitstream_index, 27)
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_get_bitstream_index, 28)
+ROCDECODE_ENFORCE_ABI(RocDecodeDispatchTable, pfn_rocdec_seek_bitstream, 29)
+// ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 11
 
 // If ROCDECODE_ENFORCE_ABI entries are added for each new function pointer in the table,
 // the number below will be one greater than the number in the last ROCDECODE_ENFORCE_ABI line. For example:
 //  ROCDECODE_ENFORCE_ABI(<table>, <functor>, 15)
 //  ROCDECODE_ENFORCE_ABI_VERSIONING(<table>, 16) <- 15 + 1 = 16
-ROCDECODE_ENFORCE_ABI_VERSIONING(RocDecodeDispatchTable, 16)
+ROCDECODE_ENFORCE_ABI_VERSIONING(RocDecodeDispatchTable, 30)
 
-static_assert(ROCDECODE_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 1,
+static_assert(ROCDECODE_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && ROCDECODE_RUNTIME_API_TABLE_STEP_VERSION == 10,
               "If you encounter this error, add the new ROCDECODE_ENFORCE_ABI(...) code for the updated function pointers, "
               "and then modify this check to ensure it evaluates to true.");
 #endif
\ No newline at end of file
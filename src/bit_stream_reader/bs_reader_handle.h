@@ -28,7 +28,9 @@ THE SOFTWARE.
 
 class RocBitstreamReaderHandle {
 public:
-    explicit RocBitstreamReaderHandle(const char *input_file_path) : bs_reader_(std::make_shared<RocVideoESParser>(input_file_path)) {};
+    explicit RocBitstreamReaderHandle(const char *input_file_path, const RocdecBitstreamReaderParams *params) : bs_reader_(std::make_shared<RocVideoESParser>(input_file_path, params)) {};
+    explicit RocBitstreamReaderHandle(const uint8_t *data, size_t size, const RocdecBitstreamReaderParams *params) : bs_reader_(std::make_shared<RocVideoESParser>(data, size, params)) {};
+    explicit RocBitstreamReaderHandle(PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, const RocdecBitstreamReaderParams *params) : bs_reader_(std::make_shared<RocVideoESParser>(pfn_read, user_data, params)) {};
     ~RocBitstreamReaderHandle() { ClearErrors(); }
     bool NoError() { return error_.empty(); }
     const char* ErrorMsg() { return error_.c_str(); }
@@ -36,6 +38,13 @@ public:
     rocDecStatus GetBitstreamCodecType(rocDecVideoCodec *codec_type) { *codec_type = bs_reader_->GetCodecId(); return ROCDEC_SUCCESS; }
     rocDecStatus GetBitstreamBitDepth(int *bit_depth) { *bit_depth = bs_reader_->GetBitDepth(); return ROCDEC_SUCCESS; }
     rocDecStatus GetBitstreamPicData(uint8_t **pic_data, int *pic_size, int64_t *pts) { return static_cast<rocDecStatus>(bs_reader_->GetPicData(pic_data, pic_size, pts)); }
+    rocDecStatus GetBitstreamNalUnitIndex(const RocdecNalUnitInfo **nal_units, int *num_nal_units) { bs_reader_->GetNalUnitIndex(nal_units, num_nal_units); return ROCDEC_SUCCESS; }
+    rocDecStatus GetBitstreamReaderStats(RocdecBitstreamReaderStats *stats) { bs_reader_->GetStats(stats); return ROCDEC_SUCCESS; }
+    rocDecStatus BuildBitstreamIndex() { return bs_reader_->BuildIndex(); }
+    rocDecStatus SaveBitstreamIndex(const char *index_file_path) { return bs_reader_->SaveIndex(index_file_path); }
+    rocDecStatus LoadBitstreamIndex(const char *index_file_path) { return bs_reader_->LoadIndex(index_file_path); }
+    rocDecStatus GetBitstreamIndex(const RocdecBitstreamPicIndexEntry **entries, int *num_entries) { bs_reader_->GetIndex(entries, num_entries); return ROCDEC_SUCCESS; }
+    rocDecStatus SeekBitstream(int pic_idx, uint32_t flags, int *seek_pic_idx) { return bs_reader_->SeekToPicture(pic_idx, flags, seek_pic_idx); }
 
 private:
     std::shared_ptr<RocVideoESParser> bs_reader_ = nullptr;
@@ -21,27 +21,108 @@ THE SOFTWARE.
 */
 
 #include <string.h>
+#include <errno.h>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "es_reader.h"
 #include "hevc_defines.h"
 #include "avc_defines.h"
 #include "av1_defines.h"
 #include "roc_video_parser.h"
 
-RocVideoESParser::RocVideoESParser(const char *input_file_path) {
-    p_stream_file_.open(input_file_path, std::ifstream::in | std::ifstream::binary);
-    if (!p_stream_file_) {
-        ERR("Failed to open the bitstream file.");
+RocVideoESParser::RocVideoESParser(const char *input_file_path, const RocdecBitstreamReaderParams *params) {
+    InitReader(params);
+    if (params->memory_mapped_input && MapInputFile(input_file_path)) {
+        bs_ring_ = mapped_data_;
+        ring_size_ = BS_RING_MAX_SIZE + 1;
+    } else {
+        p_stream_file_.open(input_file_path, std::ifstream::in | std::ifstream::binary);
+        if (!p_stream_file_) {
+            ERR("Failed to open the bitstream file.");
+        }
+        if (params->read_ahead) {
+            // The read-ahead thread reads with its own descriptor. Without one, read on the calling thread.
+            read_ahead_fd_ = open(input_file_path, O_RDONLY);
+            read_ahead_ = read_ahead_fd_ >= 0;
+        }
     }
+    struct stat file_stat;
+    if (stat(input_file_path, &file_stat) == 0 && S_ISREG(file_stat.st_mode)) {
+        stream_size_ = file_stat.st_size;
+    }
+    stream_type_ = ProbeStreamType();
+    bit_depth_ = 8;
+}
+
+RocVideoESParser::RocVideoESParser(const uint8_t *data, size_t size, const RocdecBitstreamReaderParams *params) {
+    InitReader(params);
+    // The buffer is read like a memory mapped file that is not unmapped
+    mapped_data_ = const_cast<uint8_t*>(data);
+    mapped_size_ = size;
+    stream_size_ = size;
+    bs_ring_ = mapped_data_;
+    ring_size_ = BS_RING_MAX_SIZE + 1;
+    stream_type_ = ProbeStreamType();
+    bit_depth_ = 8;
+}
+
+RocVideoESParser::RocVideoESParser(PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, const RocdecBitstreamReaderParams *params) {
+    InitReader(params);
+    pfn_read_ = pfn_read;
+    read_user_data_ = user_data;
+    read_ahead_ = params->read_ahead;
+    stream_type_ = ProbeStreamType();
+    bit_depth_ = 8;
+}
+
+void RocVideoESParser::InitReader(const RocdecBitstreamReaderParams *params) {
+    pfn_read_ = nullptr;
+    read_user_data_ = nullptr;
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+    mapped_base_ = 0;
+    owns_mapped_data_ = false;
+    ring_buf_ = nullptr;
+    ring_alloc_size_ = 0;
+    use_huge_pages_ = params->use_huge_pages;
+    bs_ring_ = nullptr;
+    ring_size_ = params->ring_size ? params->ring_size : BS_RING_SIZE;
+    if (ring_size_ < BS_RING_MIN_SIZE) {
+        ring_size_ = BS_RING_MIN_SIZE;
+    } else if (ring_size_ > BS_RING_MAX_SIZE) {
+        ring_size_ = BS_RING_MAX_SIZE;
+    }
+    read_ahead_ = false;
+    read_ahead_fd_ = -1;
+    read_ahead_chunk_size_ = ring_size_ / 4 < READ_AHEAD_CHUNK_SIZE ? ring_size_ / 4 : READ_AHEAD_CHUNK_SIZE;
+    uint64_t depth = static_cast<uint64_t>(params->read_ahead_depth ? params->read_ahead_depth : READ_AHEAD_DEPTH) * read_ahead_chunk_size_;
+    read_ahead_depth_ = depth < ring_size_ - 1 ? static_cast<uint32_t>(depth) : ring_size_ - 1;
+    ra_write_ptr_ = 0;
+    ra_read_ptr_ = 0;
+    ra_fetched_ptr_ = 0;
+    ra_end_of_file_ = false;
+    ra_stop_ = false;
+    ra_worker_waiting_ = false;
+    ra_reader_waiting_ = false;
+    num_fetches_ = 0;
+    num_read_ahead_hits_ = 0;
+    num_read_ahead_stalls_ = 0;
+    blocked_time_us_ = 0;
     end_of_file_ = false;
     end_of_stream_ = false;
     read_ptr_ = 0;
     write_ptr_ = 0;
     curr_byte_offset_ = read_ptr_;
-    pic_data_.assign(INIT_PIC_DATA_SIZE, 0);
     pic_data_size_ = 0;
+    pic_in_ring_ = true;
+    pic_start_offset_ = 0;
     curr_pic_end_ = 0;
     next_pic_start_ = 0;
     num_pictures_ = 0;
+    num_pic_nal_units_ = 0;
     num_start_code_ = 0;
     curr_start_code_offset_ = 0;
     next_start_code_offset_ = 0;
@@ -50,15 +131,152 @@ RocVideoESParser::RocVideoESParser(const char *input_file_path) {
     num_td_obus_ = 0;
     num_temp_units_ = 0;
     ivf_file_header_read_ = false;
-
-    stream_type_ = ProbeStreamType();
-    bit_depth_ = 8;
+    stream_size_ = 0;
+    write_stream_offset_ = 0;
+    pic_stream_offset_ = 0;
+    curr_pic_idx_ = 0;
+    building_index_ = false;
+    memset(hevc_pps_extra_bits_, 0, sizeof(hevc_pps_extra_bits_));
+    av1_reduced_still_picture_header_ = false;
 }
 
 RocVideoESParser::~RocVideoESParser() {
+    StopReadAhead();
+    if (read_ahead_fd_ >= 0) {
+        close(read_ahead_fd_);
+    }
     if (p_stream_file_) {
         p_stream_file_.close();
     }
+    if (owns_mapped_data_) {
+        munmap(mapped_data_, mapped_size_);
+    }
+    if (ring_buf_) {
+        munmap(ring_buf_, ring_alloc_size_);
+    }
+}
+
+bool RocVideoESParser::AllocateRing() {
+    size_t alloc_size = ring_size_;
+    void *buf = MAP_FAILED;
+    if (use_huge_pages_) {
+        // Explicit huge pages need a reserved pool. Without one, ask for transparent huge pages below.
+        size_t huge_alloc_size = (alloc_size + HUGE_PAGE_SIZE - 1) & ~static_cast<size_t>(HUGE_PAGE_SIZE - 1);
+        buf = mmap(nullptr, huge_alloc_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (buf != MAP_FAILED) {
+            alloc_size = huge_alloc_size;
+        }
+    }
+    if (buf == MAP_FAILED) {
+        buf = mmap(nullptr, alloc_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buf == MAP_FAILED) {
+            ERR("Failed to allocate the bitstream ring buffer.");
+            return false;
+        }
+        if (use_huge_pages_) {
+            madvise(buf, alloc_size, MADV_HUGEPAGE);
+        }
+    }
+    ring_buf_ = static_cast<uint8_t*>(buf);
+    ring_alloc_size_ = alloc_size;
+    bs_ring_ = ring_buf_;
+    return true;
+}
+
+void RocVideoESParser::SpillPicData() {
+    if (pic_data_size_ > static_cast<int>(pic_data_.size())) {
+        pic_data_.resize(pic_data_size_);
+    }
+    if (pic_start_offset_ + pic_data_size_ > static_cast<int>(ring_size_)) {
+        int part = ring_size_ - pic_start_offset_;
+        memcpy(pic_data_.data(), &bs_ring_[pic_start_offset_], part);
+        memcpy(&pic_data_[part], &bs_ring_[0], pic_data_size_ - part);
+    } else {
+        memcpy(pic_data_.data(), &bs_ring_[pic_start_offset_], pic_data_size_);
+    }
+    pic_in_ring_ = false;
+    SetReadPointer(pic_start_offset_ + pic_data_size_);
+}
+
+bool RocVideoESParser::GrowRing() {
+    uint32_t old_ring_size = ring_size_;
+    if (old_ring_size >= BS_RING_MAX_SIZE) {
+        ERR("A NAL unit, OBU or IVF frame does not fit in the largest bitstream ring buffer.");
+        return false;
+    }
+    // The read-ahead thread writes into the ring: stop it. The full ring leaves it nothing read past write_ptr_.
+    StopReadAhead();
+    ra_stop_ = false;
+    uint8_t *old_ring_buf = ring_buf_;
+    size_t old_ring_alloc_size = ring_alloc_size_;
+    ring_size_ = old_ring_size < BS_RING_MAX_SIZE / 2 ? old_ring_size * 2 : BS_RING_MAX_SIZE;
+    if (!AllocateRing()) {
+        ring_size_ = old_ring_size;
+        ring_buf_ = old_ring_buf;
+        ring_alloc_size_ = old_ring_alloc_size;
+        bs_ring_ = ring_buf_;
+        return false;
+    }
+    // The data from the read pointer to the old ring end keeps its offsets. The wrapped around part moves behind it.
+    memcpy(&bs_ring_[read_ptr_], &old_ring_buf[read_ptr_], (write_ptr_ >= read_ptr_ ? write_ptr_ : old_ring_size) - read_ptr_);
+    if (write_ptr_ < read_ptr_) {
+        uint32_t part = ring_size_ - old_ring_size < write_ptr_ ? ring_size_ - old_ring_size : write_ptr_;
+        memcpy(&bs_ring_[old_ring_size], old_ring_buf, part);
+        memcpy(bs_ring_, &old_ring_buf[part], write_ptr_ - part);
+    }
+    munmap(old_ring_buf, old_ring_alloc_size);
+    write_ptr_ = GetGrownRingOffset(write_ptr_, old_ring_size);
+    curr_byte_offset_ = GetGrownRingOffset(curr_byte_offset_, old_ring_size);
+    curr_start_code_offset_ = GetGrownRingOffset(curr_start_code_offset_, old_ring_size);
+    next_start_code_offset_ = GetGrownRingOffset(next_start_code_offset_, old_ring_size);
+    obu_byte_offset_ = GetGrownRingOffset(obu_byte_offset_, old_ring_size);
+    pic_start_offset_ = GetGrownRingOffset(pic_start_offset_, old_ring_size);
+    ra_write_ptr_ = write_ptr_;
+    ra_read_ptr_ = read_ptr_;
+    ra_fetched_ptr_ = write_ptr_;
+    return true;
+}
+
+int RocVideoESParser::GetGrownRingOffset(int offset, uint32_t old_ring_size) {
+    return offset < static_cast<int>(read_ptr_) ? (offset + old_ring_size) % ring_size_ : offset;
+}
+
+bool RocVideoESParser::MapInputFile(const char *input_file_path) {
+    int fd = open(input_file_path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void *data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps a reference to the file
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    // The file is read front to back once: read ahead aggressively and free the pages behind the read position early
+    madvise(data, file_stat.st_size, MADV_SEQUENTIAL);
+    mapped_data_ = static_cast<uint8_t*>(data);
+    mapped_size_ = file_stat.st_size;
+    owns_mapped_data_ = true;
+    return true;
+}
+
+void RocVideoESParser::MoveMappedWindow(int offset) {
+    if (mapped_data_ == nullptr || offset <= 0) {
+        return;
+    }
+    mapped_base_ += offset;
+    bs_ring_ += offset;
+    read_ptr_ -= offset;
+    write_ptr_ -= offset;
+    curr_byte_offset_ -= offset;
+    curr_start_code_offset_ -= offset;
+    next_start_code_offset_ -= offset;
+    obu_byte_offset_ -= offset;
+    pic_start_offset_ -= offset;
 }
 
 int RocVideoESParser::GetDataSizeInRB() {
@@ -67,28 +285,92 @@ int RocVideoESParser::GetDataSizeInRB() {
     } else if (read_ptr_ < write_ptr_) {
         return write_ptr_ - read_ptr_;
     } else {
-        return BS_RING_SIZE - read_ptr_ + write_ptr_;
+        return ring_size_ - read_ptr_ + write_ptr_;
+    }
+}
+
+int RocVideoESParser::GetDataSizeFrom(int offset) {
+    return (write_ptr_ - offset + ring_size_) % ring_size_;
+}
+
+uint64_t RocVideoESParser::GetStreamOffset(int offset) {
+    if (mapped_data_) {
+        return mapped_base_ + offset;
+    } else {
+        return write_stream_offset_ - GetDataSizeFrom(offset);
     }
 }
 
 int RocVideoESParser::FetchBitStream()
 {
     int free_space;
-    int read_size;
-    int total_read_size = 0;
 
-    // A full ring has BS_RING_SIZE - 1 bytes
-    free_space = BS_RING_SIZE - 1 - GetDataSizeInRB();
+    if (mapped_data_) {
+        // Extend the window into the mapped file
+        size_t remaining_size = mapped_size_ - mapped_base_ - write_ptr_;
+        size_t window_growth = MMAP_WINDOW_SIZE;
+        if (window_growth > remaining_size) {
+            window_growth = remaining_size;
+        }
+        if (window_growth > BS_RING_MAX_SIZE - write_ptr_) {
+            window_growth = BS_RING_MAX_SIZE - write_ptr_;
+        }
+        write_ptr_ += window_growth;
+        if (mapped_base_ + write_ptr_ == mapped_size_) {
+            end_of_file_ = true;
+        }
+        return static_cast<int>(window_growth);
+    }
+
+    if (!ring_buf_) {
+        if (!AllocateRing()) {
+            return 0;
+        }
+    }
+    // A full ring has ring_size_ - 1 bytes
+    free_space = ring_size_ - 1 - GetDataSizeInRB();
+    if (free_space == 0 && pic_in_ring_ && pic_data_size_ > 0) {
+        // The picture being assembled holds the ring: continue it in the linear buffer
+        SpillPicData();
+        free_space = ring_size_ - 1 - GetDataSizeInRB();
+    }
     if (free_space == 0) {
-        return 0;
+        // A single NAL unit, OBU or IVF frame fills the ring
+        if (!GrowRing()) {
+            return 0;
+        }
+        free_space = ring_size_ - 1 - GetDataSizeInRB();
     }
-    
+    if (read_ahead_ && !read_ahead_thread_.joinable()) {
+        // Started at the first read, and again after a seek or a ring growth
+        read_ahead_thread_ = std::thread(&RocVideoESParser::ReadAheadWorker, this, write_stream_offset_);
+    }
+
+    num_fetches_++;
+    auto start_time = std::chrono::steady_clock::now();
+    int read_size;
+    if (read_ahead_) {
+        read_size = FetchReadAheadData();
+    } else if (pfn_read_) {
+        read_size = ReadBitStreamFromCallback(free_space);
+    } else {
+        read_size = ReadBitStreamFromFile(free_space);
+    }
+    write_stream_offset_ += read_size;
+    blocked_time_us_ += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+    return read_size;
+}
+
+int RocVideoESParser::ReadBitStreamFromFile(int free_space) {
+    int read_size;
+    int total_read_size = 0;
+
     // First fill the ending part of the ring
     if (write_ptr_ >= read_ptr_) {
-        int fill_space = BS_RING_SIZE - (write_ptr_ == 0 ? 1 : write_ptr_);
+        int fill_space = ring_size_ - (write_ptr_ == 0 ? 1 : write_ptr_);
         read_size = p_stream_file_.read(reinterpret_cast<char*>(&bs_ring_[write_ptr_]), fill_space).gcount();
         if (read_size > 0) {
-            write_ptr_ = (write_ptr_ + read_size) % BS_RING_SIZE; // when we still have more bytes to fill, write_ptr_ becomes 0 to continue to the next step.
+            write_ptr_ = (write_ptr_ + read_size) % ring_size_; // when we still have more bytes to fill, write_ptr_ becomes 0 to continue to the next step.
         }
         if (read_size < fill_space) {
             end_of_file_ = true;
@@ -107,7 +389,7 @@ int RocVideoESParser::FetchBitStream()
     if (read_ptr_ > 0) {
         read_size = p_stream_file_.read(reinterpret_cast<char*>(&bs_ring_[write_ptr_]), free_space).gcount();
         if (read_size > 0) {
-            write_ptr_ = (write_ptr_ + read_size) % BS_RING_SIZE;
+            write_ptr_ = (write_ptr_ + read_size) % ring_size_;
         }
         if (read_size < free_space) {
             end_of_file_ = true;
@@ -117,32 +399,184 @@ int RocVideoESParser::FetchBitStream()
     return total_read_size;
 }
 
+int RocVideoESParser::ReadBitStreamFromCallback(int free_space) {
+    if (end_of_file_) {
+        return 0;
+    }
+    // One call per fetch into the contiguous free part of the ring. The callback may return less, e.g. what arrived so far.
+    int read_size = write_ptr_ >= read_ptr_ ? ring_size_ - write_ptr_ : read_ptr_ - write_ptr_;
+    if (read_size > free_space) {
+        read_size = free_space;
+    }
+    read_size = pfn_read_(read_user_data_, &bs_ring_[write_ptr_], read_size);
+    if (read_size <= 0) {
+        if (read_size < 0) {
+            ERR("The read callback failed to read the bitstream.");
+        }
+        end_of_file_ = true;
+        return 0;
+    }
+    write_ptr_ = (write_ptr_ + read_size) % ring_size_;
+    return read_size;
+}
+
+int RocVideoESParser::FetchReadAheadData() {
+    if (ra_write_ptr_ == write_ptr_ && !ra_end_of_file_) {
+        num_read_ahead_stalls_++;
+        std::unique_lock<std::mutex> lock(ra_mutex_);
+        ra_reader_waiting_ = true;
+        ra_cond_.wait(lock, [this] { return ra_write_ptr_ != write_ptr_ || ra_end_of_file_; });
+        ra_reader_waiting_ = false;
+    } else if (ra_write_ptr_ != write_ptr_) {
+        num_read_ahead_hits_++;
+    }
+    // Check the end of file flag first: all the data read before the flag was set is then visible in ra_write_ptr_
+    bool end_of_file = ra_end_of_file_;
+    uint32_t ra_write_ptr = ra_write_ptr_;
+    int read_size = (ra_write_ptr - write_ptr_ + ring_size_) % ring_size_;
+    write_ptr_ = ra_write_ptr;
+    ra_fetched_ptr_ = write_ptr_;
+    WakeReadAheadWorker();
+    if (end_of_file && read_size == 0) {
+        end_of_file_ = true;
+    }
+    return read_size;
+}
+
+int RocVideoESParser::GetReadAheadSize() {
+    uint32_t write_ptr = ra_write_ptr_;
+    uint32_t data_size = (write_ptr - ra_read_ptr_ + ring_size_) % ring_size_;
+    uint32_t ahead_size = (write_ptr - ra_fetched_ptr_ + ring_size_) % ring_size_;
+    if (ahead_size >= read_ahead_depth_) {
+        return 0;
+    }
+    uint32_t read_size = read_ahead_depth_ - ahead_size;
+    // Stay within the free part of the ring and do not wrap around in one read
+    if (read_size > ring_size_ - 1 - data_size) {
+        read_size = ring_size_ - 1 - data_size;
+    }
+    if (read_size > ring_size_ - write_ptr) {
+        read_size = ring_size_ - write_ptr;
+    }
+    if (read_size > read_ahead_chunk_size_) {
+        read_size = read_ahead_chunk_size_;
+    }
+    // Read whole chunks, unless at the ring end or if the parsing thread has caught up, so that the thread is not woken up
+    // each time a few bytes are freed
+    if (read_size < read_ahead_chunk_size_ && read_size < ring_size_ - write_ptr && ahead_size > 0) {
+        return 0;
+    }
+    return static_cast<int>(read_size);
+}
+
+void RocVideoESParser::ReadAheadWorker(uint64_t file_offset) {
+    while (!ra_stop_) {
+        int read_size = GetReadAheadSize();
+        if (read_size == 0) {
+            std::unique_lock<std::mutex> lock(ra_mutex_);
+            ra_worker_waiting_ = true;
+            ra_cond_.wait(lock, [this] { return ra_stop_ || GetReadAheadSize() > 0; });
+            ra_worker_waiting_ = false;
+            continue;
+        }
+        uint32_t write_ptr = ra_write_ptr_;
+        ssize_t bytes_read;
+        if (pfn_read_) {
+            bytes_read = pfn_read_(read_user_data_, &bs_ring_[write_ptr], read_size);
+        } else {
+            bytes_read = pread(read_ahead_fd_, &bs_ring_[write_ptr], read_size, static_cast<off_t>(file_offset));
+            if (bytes_read < 0 && errno == EINTR) {
+                continue;
+            }
+        }
+        if (bytes_read <= 0) {
+            if (bytes_read < 0) {
+                ERR("Failed to read the bitstream.");
+            }
+            ra_end_of_file_ = true;
+            WakeReadAheadReader();
+            break;
+        }
+        file_offset += bytes_read;
+        ra_write_ptr_ = (write_ptr + bytes_read) % ring_size_;
+        WakeReadAheadReader();
+    }
+}
+
+void RocVideoESParser::WakeReadAheadWorker() {
+    // The waiting flag is set before the parked worker checks the ring offsets a last time, so either that check sees the new
+    // offsets or the flag is seen here. The worker is only woken up if it can read now.
+    if (ra_worker_waiting_ && GetReadAheadSize() > 0) {
+        std::lock_guard<std::mutex> lock(ra_mutex_);
+        ra_cond_.notify_all();
+    }
+}
+
+void RocVideoESParser::WakeReadAheadReader() {
+    if (ra_reader_waiting_) {
+        std::lock_guard<std::mutex> lock(ra_mutex_);
+        ra_cond_.notify_all();
+    }
+}
+
+void RocVideoESParser::StopReadAhead() {
+    if (read_ahead_thread_.joinable()) {
+        ra_stop_ = true;
+        {
+            std::lock_guard<std::mutex> lock(ra_mutex_);
+            ra_cond_.notify_all();
+        }
+        read_ahead_thread_.join();
+    }
+}
+
+void RocVideoESParser::GetStats(RocdecBitstreamReaderStats *stats) {
+    memset(stats, 0, sizeof(RocdecBitstreamReaderStats));
+    stats->num_fetches = num_fetches_;
+    stats->num_read_ahead_hits = num_read_ahead_hits_;
+    stats->num_read_ahead_stalls = num_read_ahead_stalls_;
+    stats->blocked_time_us = blocked_time_us_;
+    stats->read_ahead_depth = read_ahead_ ? read_ahead_depth_ : 0;
+}
+
 bool RocVideoESParser::GetByte(int offset, uint8_t *data) {
-    offset = offset % BS_RING_SIZE;
-    if (offset == write_ptr_) {
+    offset = offset % ring_size_;
+    // The offset may be more than one byte past the write pointer, and a fetch may add fewer bytes than that
+    while ((offset - read_ptr_ + ring_size_) % ring_size_ >= static_cast<uint32_t>(GetDataSizeInRB())) {
+        uint32_t ring_size = ring_size_;
         if (FetchBitStream() == 0) {
             end_of_stream_ = true;
             return false;
         }
+        if (ring_size_ != ring_size) {
+            offset = GetGrownRingOffset(offset, ring_size);
+        }
     }
     *data = bs_ring_[offset];
     return true;
 }
 
 bool RocVideoESParser::ReadBytes(int offset, int size, uint8_t *data) {
-    offset = offset % BS_RING_SIZE;
+    offset = offset % ring_size_;
     if (size > GetDataSizeInRB()) {
+        uint32_t ring_size = ring_size_;
         if (FetchBitStream() == 0) {
             end_of_stream_ = true;
             return false;
         }
+        // The read-ahead thread may deliver the data in several pieces
+        while (size > GetDataSizeInRB() && FetchBitStream() > 0) {
+        }
+        if (ring_size_ != ring_size) {
+            offset = GetGrownRingOffset(offset, ring_size);
+        }
         if (size > GetDataSizeInRB()) {
             ERR("Could not read the requested bytes from ring buffer. Either ring buffer size is too small or not enough bytes left.");
             return false;
         }
     }
-    if (offset + size > BS_RING_SIZE) {
-        int part = BS_RING_SIZE - offset;
+    if (offset + size > static_cast<int>(ring_size_)) {
+        int part = ring_size_ - offset;
         memcpy(data, &bs_ring_[offset], part);
         memcpy(&data[part], &bs_ring_[0], size - part);
     } else {
@@ -152,7 +586,12 @@ bool RocVideoESParser::ReadBytes(int offset, int size, uint8_t *data) {
 }
 
 void RocVideoESParser::SetReadPointer(int value) {
-    read_ptr_ = value % BS_RING_SIZE;
+    read_ptr_ = value % ring_size_;
+    if (read_ahead_) {
+        // Give the space behind the read pointer to the read-ahead thread
+        ra_read_ptr_ = read_ptr_;
+        WakeReadAheadWorker();
+    }
 }
 
 bool RocVideoESParser::FindStartCode() {
@@ -163,30 +602,44 @@ bool RocVideoESParser::FindStartCode() {
 
     // Search for the next start code
     while (!end_of_stream_) {
-        for (i = 0; i < 3; i++) {
-            if (GetByte(curr_byte_offset_ + i, three_bytes + i) == false) {
+        // Scan the filled part of the ring up to the write pointer or the ring end in one go. The few bytes around
+        // the write pointer and the wrap around point are checked byte by byte, which also fetches more data.
+        int contiguous_size = (curr_byte_offset_ <= static_cast<int>(write_ptr_) ? write_ptr_ : ring_size_) - curr_byte_offset_;
+        if (contiguous_size >= 3) {
+            int start_code_pos = Parser::ScanStartCode(&bs_ring_[curr_byte_offset_], contiguous_size);
+            if (start_code_pos == contiguous_size) {
+                // The last two bytes may be the beginning of a start code
+                curr_byte_offset_ += contiguous_size - 2;
+                continue;
+            }
+            curr_byte_offset_ += start_code_pos;
+        } else {
+            for (i = 0; i < 3; i++) {
+                if (GetByte(curr_byte_offset_ + i, three_bytes + i) == false) {
+                    break;
+                }
+            }
+            if (i < 3) {
                 break;
             }
-        }
-        if (i < 3) {
-            break;
+            if (three_bytes[0] != 0 || three_bytes[1] != 0 || three_bytes[2] != 0x01) {
+                curr_byte_offset_ = (curr_byte_offset_ + 1) % ring_size_;
+                continue;
+            }
         }
 
-        if (three_bytes[0] == 0 && three_bytes[1] == 0 && three_bytes[2] == 0x01) {
-            num_start_code_++;
-            next_start_code_offset_ = curr_byte_offset_;
-            // Move the pointer 3 bytes forward
-            curr_byte_offset_ = (curr_byte_offset_ + 3) % BS_RING_SIZE;
+        num_start_code_++;
+        next_start_code_offset_ = curr_byte_offset_;
+        // Move the pointer 3 bytes forward
+        curr_byte_offset_ = (curr_byte_offset_ + 3) % ring_size_;
 
-            // For the very first NAL unit, search for the next start code (or reach the end of frame)
-            if (num_start_code_ == 1) {
-                curr_start_code_offset_ = next_start_code_offset_;
-                continue;
-            } else {
-                break;
-            }
+        // For the very first NAL unit, search for the next start code (or reach the end of frame)
+        if (num_start_code_ == 1) {
+            curr_start_code_offset_ = next_start_code_offset_;
+            continue;
+        } else {
+            break;
         }
-        curr_byte_offset_ = (curr_byte_offset_ + 1) % BS_RING_SIZE;
     }
     return num_start_code_ ? true : false;
 }
@@ -196,19 +649,34 @@ void RocVideoESParser::CopyNalUnitFromRing() {
     int nal_size;
     nal_start = curr_start_code_offset_;
     nal_end_plus_1 = curr_start_code_offset_ != next_start_code_offset_ ? next_start_code_offset_ : write_ptr_;
-    if (nal_end_plus_1 >= nal_start) {
-        nal_size = nal_end_plus_1 - nal_start;
-        if ((pic_data_size_ + nal_size) > pic_data_.size()) {
-            pic_data_.resize(pic_data_.size() + nal_size);
+    nal_size = (nal_end_plus_1 - nal_start + ring_size_) % ring_size_;
+    // The header bytes may wrap around the ring end
+    uint8_t nal_header[5];
+    int header_size = nal_size < static_cast<int>(sizeof(nal_header)) ? nal_size : static_cast<int>(sizeof(nal_header));
+    for (int i = 0; i < header_size; i++) {
+        nal_header[i] = bs_ring_[(nal_start + i) % ring_size_];
+    }
+    RocdecNalUnitInfo nal_unit = Parser::MakeNalUnitInfo(nal_header, 0, nal_size, stream_type_ == kStreamTypeAvcElementary ? rocDecVideoCodec_AVC : rocDecVideoCodec_HEVC);
+    nal_unit.offset = pic_data_size_;
+    nal_unit_index_.push_back(nal_unit);
+
+    if (pic_in_ring_) {
+        // The NAL units of a picture follow each other in the ring: only extend the span
+        if (pic_data_size_ == 0) {
+            pic_start_offset_ = nal_start;
+            pic_stream_offset_ = GetStreamOffset(nal_start);
         }
+        pic_data_size_ += nal_size;
+        return;
+    }
+    if ((pic_data_size_ + nal_size) > static_cast<int>(pic_data_.size())) {
+        pic_data_.resize(pic_data_size_ + nal_size);
+    }
+    if (nal_end_plus_1 >= nal_start) {
         memcpy(&pic_data_[pic_data_size_], &bs_ring_[nal_start], nal_size);
     } else { // wrap around
-        nal_size = BS_RING_SIZE - nal_start + nal_end_plus_1;
-        if ((pic_data_size_ + nal_size) > pic_data_.size()) {
-            pic_data_.resize(pic_data_.size() + nal_size);
-        }
-        memcpy(&pic_data_[pic_data_size_], &bs_ring_[nal_start], BS_RING_SIZE - nal_start);
-        memcpy(&pic_data_[pic_data_size_ + BS_RING_SIZE - nal_start], &bs_ring_[0], nal_end_plus_1);
+        memcpy(&pic_data_[pic_data_size_], &bs_ring_[nal_start], ring_size_ - nal_start);
+        memcpy(&pic_data_[pic_data_size_ + ring_size_ - nal_start], &bs_ring_[0], nal_end_plus_1);
     }
     pic_data_size_ += nal_size;
     SetReadPointer(nal_end_plus_1);
@@ -264,8 +732,8 @@ void RocVideoESParser::CheckAvcNalForSlice(int start_code_offset, int *slice_fla
             for (int i = 0; i < 4; i++) {
                 GetByte(start_code_offset + 4 + i, &slice_bytes[i]);
             }
-            size_t offset = 0;
-            int first_mb_in_slice = Parser::ExpGolomb::ReadUe(slice_bytes, offset);
+            Parser::BitReader bit_reader(slice_bytes, sizeof(slice_bytes));
+            int first_mb_in_slice = bit_reader.ReadUe();
             *first_slice_flag = first_mb_in_slice == 0;
             break;
         }
@@ -285,26 +753,45 @@ int RocVideoESParser::GetPicDataAvcHevc(uint8_t **p_pic_data, int *pic_size) {
     curr_pic_end_ = 0;
     // Check if we have already got some NAL units for the current picture from processing of the last picture
     if (next_pic_start_ > 0 && next_pic_start_ < pic_data_size_) {
-        memcpy(&pic_data_[0], &pic_data_[next_pic_start_], pic_data_size_ - next_pic_start_);
+        if (pic_in_ring_) {
+            // The carried over NAL units stay in the ring, only the span start moves
+            pic_start_offset_ = (pic_start_offset_ + next_pic_start_) % ring_size_;
+            SetReadPointer(pic_start_offset_);
+        } else {
+            memmove(&pic_data_[0], &pic_data_[next_pic_start_], pic_data_size_ - next_pic_start_);
+        }
         pic_data_size_ = pic_data_size_ - next_pic_start_;
+        pic_stream_offset_ += next_pic_start_;
         curr_pic_end_ = pic_data_size_;
+        // Move the index entries of the carried over NAL units to the front
+        nal_unit_index_.erase(nal_unit_index_.begin(), nal_unit_index_.begin() + num_pic_nal_units_);
+        for (auto &nal_unit : nal_unit_index_) {
+            nal_unit.offset -= next_pic_start_;
+        }
         next_pic_start_ = 0;
     } else {
         pic_data_size_ = 0;
         next_pic_start_ = 0;
+        nal_unit_index_.clear();
+        // Give the space of the last picture back to the ring
+        pic_in_ring_ = true;
+        pic_start_offset_ = next_start_code_offset_;
+        SetReadPointer(pic_start_offset_);
     }
+    MoveMappedWindow(read_ptr_);
 
     while (!end_of_stream_) {
         if (!FindStartCode()) {
             ERR("No start code in the bitstream.");
             break;
         }
-        CopyNalUnitFromRing();
+        // Check the NAL unit before it is appended: in copy mode that gives its space back to the ring
         if ( stream_type_ == kStreamTypeAvcElementary) {
             CheckAvcNalForSlice(curr_start_code_offset_, &slice_nal_flag, &first_slice_flag);
         } else {
             CheckHevcNalForSlice(curr_start_code_offset_, &slice_nal_flag, &first_slice_flag);
         }
+        CopyNalUnitFromRing();
         if (slice_nal_flag) {
             num_slices++;
             curr_pic_end_ = pic_data_size_; // update the current picture data end
@@ -328,13 +815,20 @@ int RocVideoESParser::GetPicDataAvcHevc(uint8_t **p_pic_data, int *pic_size) {
         }
     }
 
-    *p_pic_data = pic_data_.data();
     if (num_slices) {
         num_pictures_++;
         *pic_size = curr_pic_end_;
     } else {
         *pic_size = 0;
     }
+    if (pic_in_ring_ && pic_start_offset_ + *pic_size > static_cast<int>(ring_size_)) {
+        SpillPicData();
+    }
+    *p_pic_data = GetPicDataPtr();
+    num_pic_nal_units_ = 0;
+    while (num_pic_nal_units_ < static_cast<int>(nal_unit_index_.size()) && static_cast<int>(nal_unit_index_[num_pic_nal_units_].offset) < *pic_size) {
+        num_pic_nal_units_++;
+    }
     return 0;
 }
 
@@ -350,10 +844,10 @@ bool RocVideoESParser::ReadObuHeaderAndSize(int *obu_type) {
     }
     *obu_type = (header_byte >> 3) & 0x0F;
     obu_extension_flag = (header_byte >> 2) & 0x01;
-    curr_byte_offset_ = (curr_byte_offset_ + 1) % BS_RING_SIZE;
+    curr_byte_offset_ = (curr_byte_offset_ + 1) % ring_size_;
     obu_size_++;
     if (obu_extension_flag) {
-        curr_byte_offset_ = (curr_byte_offset_ + 1) % BS_RING_SIZE;
+        curr_byte_offset_ = (curr_byte_offset_ + 1) % ring_size_;
         obu_size_++;
     }
     // Parse size
@@ -371,30 +865,37 @@ bool RocVideoESParser::ReadObuHeaderAndSize(int *obu_type) {
         }
     }
     obu_size_ += len + value;
-    curr_byte_offset_ = (curr_byte_offset_ + len + value) % BS_RING_SIZE;
+    curr_byte_offset_ = (curr_byte_offset_ + len + value) % ring_size_;
 
     return true;
 }
 
 bool RocVideoESParser::CopyObuFromRing() {
-    if (obu_size_ > GetDataSizeInRB()) {
+    if (obu_size_ > GetDataSizeFrom(obu_byte_offset_)) {
         if (FetchBitStream() == 0) {
             end_of_stream_ = true;
             return false;
         }
-        if (obu_size_ > GetDataSizeInRB()) {
+        while (obu_size_ > GetDataSizeFrom(obu_byte_offset_) && FetchBitStream() > 0) {
+        }
+        if (obu_size_ > GetDataSizeFrom(obu_byte_offset_)) {
             return false;
         }
     }
+    int obu_end_offset = (obu_byte_offset_ + obu_size_) % ring_size_;
+    if (pic_in_ring_) {
+        // The OBUs of a temporal unit follow each other in the ring: only extend the span
+        pic_data_size_ += obu_size_;
+        return true;
+    }
     if ((pic_data_size_ + obu_size_) > pic_data_.size()) {
-        pic_data_.resize(pic_data_.size() + obu_size_);
+        pic_data_.resize(pic_data_size_ + obu_size_);
     }
-    int obu_end_offset = (obu_byte_offset_ + obu_size_) % BS_RING_SIZE;
     if (obu_end_offset >= obu_byte_offset_) {
         memcpy(&pic_data_[pic_data_size_], &bs_ring_[obu_byte_offset_], obu_size_);
     } else {
-        memcpy(&pic_data_[pic_data_size_], &bs_ring_[obu_byte_offset_], BS_RING_SIZE - obu_byte_offset_);
-        memcpy(&pic_data_[pic_data_size_ + BS_RING_SIZE - obu_byte_offset_], &bs_ring_[0], obu_end_offset);
+        memcpy(&pic_data_[pic_data_size_], &bs_ring_[obu_byte_offset_], ring_size_ - obu_byte_offset_);
+        memcpy(&pic_data_[pic_data_size_ + ring_size_ - obu_byte_offset_], &bs_ring_[0], obu_end_offset);
     }
     pic_data_size_ += obu_size_;
     SetReadPointer(obu_end_offset);
@@ -404,6 +905,12 @@ bool RocVideoESParser::CopyObuFromRing() {
 int RocVideoESParser::GetPicDataAv1(uint8_t **p_pic_data, int *pic_size) {
     int obu_type;
     pic_data_size_ = 0;
+    pic_in_ring_ = true;
+    // Give the space of the last temporal unit back to the ring
+    SetReadPointer(curr_byte_offset_);
+    MoveMappedWindow(read_ptr_);
+    pic_start_offset_ = read_ptr_;
+    pic_stream_offset_ = GetStreamOffset(pic_start_offset_);
 
     while (!end_of_stream_) {
         if (!ReadObuHeaderAndSize(&obu_type)) {
@@ -418,7 +925,10 @@ int RocVideoESParser::GetPicDataAv1(uint8_t **p_pic_data, int *pic_size) {
         }
     }
 
-    *p_pic_data = pic_data_.data();
+    if (pic_in_ring_ && pic_start_offset_ + pic_data_size_ > static_cast<int>(ring_size_)) {
+        SpillPicData();
+    }
+    *p_pic_data = GetPicDataPtr();
     *pic_size = pic_data_size_;
     num_temp_units_++;
     return 0;
@@ -465,48 +975,372 @@ bool RocVideoESParser::CheckIvfFileHeader(uint8_t *stream) {
 int RocVideoESParser::GetPicDataIvfAv1(uint8_t **p_pic_data, int *pic_size) {
     uint8_t frame_header[12];
     pic_data_size_ = 0;
+    // Give the space of the last frame back to the ring
+    SetReadPointer(curr_byte_offset_);
+    MoveMappedWindow(read_ptr_);
+    pic_stream_offset_ = GetStreamOffset(curr_byte_offset_);
     if (ReadBytes(curr_byte_offset_, 12, frame_header)) {
-        curr_byte_offset_ = (curr_byte_offset_ + 12) % BS_RING_SIZE;
+        curr_byte_offset_ = (curr_byte_offset_ + 12) % ring_size_;
         SetReadPointer(curr_byte_offset_);
         int frame_size = frame_header[0] | (frame_header[1] << 8) | (frame_header[2] << 16) | (frame_header[3] << 24);
-        if (frame_size > pic_data_.size()) {
-            pic_data_.resize(frame_size);
+        // The frame may be larger than one fetch
+        while (frame_size > GetDataSizeInRB() && FetchBitStream() > 0) {
         }
-        if (ReadBytes(curr_byte_offset_, frame_size, pic_data_.data())) {
-            pic_data_size_ = frame_size;
-            curr_byte_offset_ = (curr_byte_offset_ + frame_size) % BS_RING_SIZE;
-            SetReadPointer(curr_byte_offset_);
+        if (curr_byte_offset_ + frame_size <= static_cast<int>(ring_size_)) {
+            // The frame is contiguous in the ring: return it in place
+            pic_in_ring_ = true;
+            if (frame_size <= GetDataSizeInRB()) {
+                // The read pointer stays at the frame start until the next call
+                pic_start_offset_ = curr_byte_offset_;
+                pic_data_size_ = frame_size;
+                curr_byte_offset_ = (curr_byte_offset_ + frame_size) % ring_size_;
+            }
+        } else {
+            pic_in_ring_ = false;
+            if (frame_size > static_cast<int>(pic_data_.size())) {
+                pic_data_.resize(frame_size);
+            }
+            if (ReadBytes(curr_byte_offset_, frame_size, pic_data_.data())) {
+                pic_data_size_ = frame_size;
+                curr_byte_offset_ = (curr_byte_offset_ + frame_size) % ring_size_;
+                SetReadPointer(curr_byte_offset_);
+            }
         }
     }
-    *p_pic_data = pic_data_.data();
+    *p_pic_data = GetPicDataPtr();
     *pic_size = pic_data_size_;
     return 0;
 }
 
 int RocVideoESParser::GetPicData(uint8_t **p_pic_data, int *pic_size, int64_t *pts) {
+    int ret = 0;
     *pts = 0;
     switch (stream_type_) {
         case kStreamTypeAvcElementary:
         case kStreamTypeHevcElementary:
-            return GetPicDataAvcHevc(p_pic_data, pic_size);
+            ret = GetPicDataAvcHevc(p_pic_data, pic_size);
+            break;
         case kStreamTypeAv1Elementary:
-            return GetPicDataAv1(p_pic_data, pic_size);
+            ret = GetPicDataAv1(p_pic_data, pic_size);
+            break;
         case kStreamTypeAv1Ivf: {
             if (!ivf_file_header_read_) {
                 uint8_t file_header[32];
                 ReadBytes(curr_byte_offset_, 32, file_header);
-                curr_byte_offset_ = (curr_byte_offset_ + 32) % BS_RING_SIZE;
+                curr_byte_offset_ = (curr_byte_offset_ + 32) % ring_size_;
                 SetReadPointer(curr_byte_offset_);
                 ivf_file_header_read_ = true;
             }
-            return GetPicDataIvfAv1(p_pic_data, pic_size);
+            ret = GetPicDataIvfAv1(p_pic_data, pic_size);
+            break;
         }
         default: {
-            *p_pic_data = pic_data_.data();
+            *p_pic_data = GetPicDataPtr();
             *pic_size = 0;
-            return 0;
+            break;
+        }
+    }
+    if (*pic_size > 0) {
+        if (building_index_) {
+            AddPicIndexEntry(*p_pic_data, *pic_size);
         }
+        curr_pic_idx_++;
     }
+    return ret;
+}
+
+void RocVideoESParser::ResetReadPosition(uint64_t stream_offset, int pic_idx) {
+    StopReadAhead();
+    ra_stop_ = false;
+    ra_end_of_file_ = false;
+    ra_write_ptr_ = 0;
+    ra_read_ptr_ = 0;
+    ra_fetched_ptr_ = 0;
+    if (mapped_data_) {
+        mapped_base_ = stream_offset;
+        bs_ring_ = mapped_data_ + stream_offset;
+    } else {
+        p_stream_file_.clear();
+        p_stream_file_.seekg(stream_offset, std::ios::beg);
+        write_stream_offset_ = stream_offset;
+    }
+    end_of_file_ = false;
+    end_of_stream_ = false;
+    read_ptr_ = 0;
+    write_ptr_ = 0;
+    curr_byte_offset_ = 0;
+    pic_data_size_ = 0;
+    pic_in_ring_ = true;
+    pic_start_offset_ = 0;
+    pic_stream_offset_ = stream_offset;
+    curr_pic_end_ = 0;
+    next_pic_start_ = 0;
+    nal_unit_index_.clear();
+    num_pic_nal_units_ = 0;
+    num_start_code_ = 0;
+    curr_start_code_offset_ = 0;
+    next_start_code_offset_ = 0;
+    obu_byte_offset_ = 0;
+    obu_size_ = 0;
+    // All the temporal units but the first one end with the temporal delimiter of the next one
+    num_td_obus_ = pic_idx > 0 ? 2 : 0;
+    // Only the stream start has the IVF file header
+    ivf_file_header_read_ = stream_offset > 0;
+    num_pictures_ = pic_idx;
+    num_temp_units_ = pic_idx;
+    curr_pic_idx_ = pic_idx;
+}
+
+void RocVideoESParser::AddPicIndexEntry(uint8_t *p_pic_data, int pic_size) {
+    RocdecBitstreamPicIndexEntry entry = {};
+    entry.offset = pic_stream_offset_;
+    entry.size = pic_size;
+    entry.pic_type = ROCDEC_PIC_TYPE_UNKNOWN;
+    switch (stream_type_) {
+        case kStreamTypeAvcElementary:
+        case kStreamTypeHevcElementary:
+            GetAvcHevcPicIndexInfo(p_pic_data, &entry);
+            break;
+        case kStreamTypeAv1Elementary:
+            GetAv1PicIndexInfo(p_pic_data, pic_size, &entry);
+            break;
+        case kStreamTypeAv1Ivf:
+            entry.size += 12; // frame header
+            GetAv1PicIndexInfo(p_pic_data, pic_size, &entry);
+            break;
+        default:
+            break;
+    }
+    pic_index_.push_back(entry);
+}
+
+void RocVideoESParser::GetAvcHevcPicIndexInfo(uint8_t *p_pic_data, RocdecBitstreamPicIndexEntry *entry) {
+    Parser::BitReader bit_reader;
+    int nal_header_size = stream_type_ == kStreamTypeAvcElementary ? 1 : 2;
+    for (int i = 0; i < num_pic_nal_units_; i++) {
+        const RocdecNalUnitInfo &nal_unit = nal_unit_index_[i];
+        int payload_offset = 3 + nal_header_size; // start code prefix and NAL unit header
+        if (static_cast<int>(nal_unit.size) <= payload_offset) {
+            continue;
+        }
+        bit_reader.Init(&p_pic_data[nal_unit.offset + payload_offset], nal_unit.size - payload_offset, true);
+        if (stream_type_ == kStreamTypeAvcElementary) {
+            switch (nal_unit.nal_unit_type) {
+                case kAvcNalTypeSeq_Parameter_Set:
+                case kAvcNalTypePic_Parameter_Set:
+                    entry->param_sets_flag = 1;
+                    break;
+                case kAvcNalTypeSlice_IDR:
+                case kAvcNalTypeSlice_Non_IDR:
+                case kAvcNalTypeSlice_Data_Partition_A: {
+                    if (nal_unit.nal_unit_type == kAvcNalTypeSlice_IDR) {
+                        entry->key_frame_flag = 1;
+                    }
+                    bit_reader.ReadUe(); // first_mb_in_slice
+                    uint32_t slice_type = bit_reader.ReadUe() % 5;
+                    uint8_t pic_type = ROCDEC_PIC_TYPE_P; // P, SP
+                    if (slice_type == kAvcSliceTypeB) {
+                        pic_type = ROCDEC_PIC_TYPE_B;
+                    } else if (slice_type == kAvcSliceTypeI || slice_type == kAvcSliceTypeSI) {
+                        pic_type = ROCDEC_PIC_TYPE_I;
+                    }
+                    // The picture type is the highest slice type: I < P < B
+                    if (pic_type > entry->pic_type) {
+                        entry->pic_type = pic_type;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        } else {
+            uint8_t nal_unit_type = nal_unit.nal_unit_type;
+            if (nal_unit_type >= NAL_UNIT_VPS && nal_unit_type <= NAL_UNIT_PPS) {
+                entry->param_sets_flag = 1;
+                if (nal_unit_type == NAL_UNIT_PPS) {
+                    uint32_t pps_id = bit_reader.ReadUe();
+                    if (pps_id < HEVC_MAX_PPS_COUNT) {
+                        bit_reader.ReadUe(); // pps_seq_parameter_set_id
+                        bit_reader.SkipBits(2); // dependent_slice_segments_enabled_flag, output_flag_present_flag
+                        hevc_pps_extra_bits_[pps_id] = bit_reader.ReadBits(3);
+                    }
+                }
+            } else if (nal_unit_type <= NAL_UNIT_RESERVED_VCL31) {
+                if (nal_unit_type >= NAL_UNIT_CODED_SLICE_BLA_W_LP && nal_unit_type <= NAL_UNIT_CODED_SLICE_CRA_NUT) {
+                    entry->key_frame_flag = 1;
+                }
+                // The other slice segment headers need the SPS to be parsed: take the type of the first one
+                if (bit_reader.ReadBits(1) == 0) { // first_slice_segment_in_pic_flag
+                    continue;
+                }
+                if (nal_unit_type >= NAL_UNIT_CODED_SLICE_BLA_W_LP && nal_unit_type <= NAL_UNIT_RESERVED_IRAP_VCL23) {
+                    bit_reader.SkipBits(1); // no_output_of_prior_pics_flag
+                }
+                uint32_t pps_id = bit_reader.ReadUe();
+                if (pps_id < HEVC_MAX_PPS_COUNT) {
+                    bit_reader.SkipBits(hevc_pps_extra_bits_[pps_id]); // slice_reserved_flag
+                    uint32_t slice_type = bit_reader.ReadUe();
+                    if (slice_type == HEVC_SLICE_TYPE_B) {
+                        entry->pic_type = ROCDEC_PIC_TYPE_B;
+                    } else if (slice_type == HEVC_SLICE_TYPE_P) {
+                        entry->pic_type = ROCDEC_PIC_TYPE_P;
+                    } else if (slice_type == HEVC_SLICE_TYPE_I) {
+                        entry->pic_type = ROCDEC_PIC_TYPE_I;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void RocVideoESParser::GetAv1PicIndexInfo(uint8_t *p_pic_data, int pic_size, RocdecBitstreamPicIndexEntry *entry) {
+    bool frame_header_found = false;
+    int offset = 0;
+    while (offset < pic_size) {
+        uint8_t header_byte = p_pic_data[offset];
+        int obu_type = (header_byte >> 3) & 0x0F;
+        int obu_extension_flag = (header_byte >> 2) & 0x01;
+        int obu_has_size_field = (header_byte >> 1) & 0x01;
+        offset += 1 + obu_extension_flag;
+        uint32_t obu_size = 0;
+        if (obu_has_size_field) {
+            for (int len = 0; len < 8 && offset < pic_size; ++len) {
+                uint8_t data_byte = p_pic_data[offset++];
+                obu_size |= (data_byte & 0x7F) << (len * 7);
+                if ((data_byte & 0x80) == 0) {
+                    break;
+                }
+            }
+        } else if (offset < pic_size) {
+            obu_size = pic_size - offset;
+        }
+        if (obu_size == 0 || offset + obu_size > static_cast<uint32_t>(pic_size)) {
+            offset += obu_size;
+            continue;
+        }
+        uint8_t first_byte = p_pic_data[offset];
+        if (obu_type == kObuSequenceHeader) {
+            entry->param_sets_flag = 1;
+            av1_reduced_still_picture_header_ = (first_byte >> 3) & 0x01; // after seq_profile and still_picture
+        } else if ((obu_type == kObuFrameHeader || obu_type == kObuFrame) && !frame_header_found) {
+            frame_header_found = true;
+            if (av1_reduced_still_picture_header_) {
+                entry->pic_type = ROCDEC_PIC_TYPE_I;
+                entry->key_frame_flag = 1;
+            } else if ((first_byte >> 7) == 0) { // show_existing_frame is 0
+                int frame_type = (first_byte >> 5) & 0x03;
+                int show_frame = (first_byte >> 4) & 0x01;
+                entry->pic_type = frame_type == kKeyFrame || frame_type == kIntraOnlyFrame ? ROCDEC_PIC_TYPE_I : ROCDEC_PIC_TYPE_P;
+                entry->key_frame_flag = frame_type == kKeyFrame && show_frame;
+            }
+        }
+        offset += obu_size;
+    }
+}
+
+rocDecStatus RocVideoESParser::BuildIndex() {
+    if (pfn_read_ || stream_size_ == 0) {
+        return ROCDEC_NOT_SUPPORTED; // the stream can not be read again
+    }
+    uint8_t *pic_data;
+    int pic_size;
+    int64_t pts;
+    int curr_pic_idx = curr_pic_idx_;
+    pic_index_.clear();
+    ResetReadPosition(0, 0);
+    building_index_ = true;
+    do {
+        GetPicData(&pic_data, &pic_size, &pts);
+    } while (pic_size > 0);
+    building_index_ = false;
+    // Continue from the picture the reader was at. The reader is at the stream end already if that was the end.
+    if (curr_pic_idx < static_cast<int>(pic_index_.size())) {
+        ResetReadPosition(curr_pic_idx > 0 ? pic_index_[curr_pic_idx].offset : 0, curr_pic_idx);
+    }
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus RocVideoESParser::SaveIndex(const char *index_file_path) {
+    if (pic_index_.empty()) {
+        return ROCDEC_NOT_INITIALIZED;
+    }
+    std::ofstream index_file(index_file_path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!index_file) {
+        ERR("Failed to open the index file " + STR(index_file_path));
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    BitstreamIndexFileHeader header = {};
+    memcpy(header.signature, BS_INDEX_FILE_SIGNATURE, sizeof(header.signature));
+    header.version = BS_INDEX_FILE_VERSION;
+    header.stream_type = stream_type_;
+    header.entry_size = sizeof(RocdecBitstreamPicIndexEntry);
+    header.stream_size = stream_size_;
+    header.num_entries = pic_index_.size();
+    index_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    index_file.write(reinterpret_cast<const char*>(pic_index_.data()), pic_index_.size() * sizeof(RocdecBitstreamPicIndexEntry));
+    if (!index_file) {
+        ERR("Failed to write the index file " + STR(index_file_path));
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus RocVideoESParser::LoadIndex(const char *index_file_path) {
+    if (pfn_read_ || stream_size_ == 0) {
+        return ROCDEC_NOT_SUPPORTED;
+    }
+    std::ifstream index_file(index_file_path, std::ifstream::in | std::ifstream::binary);
+    if (!index_file) {
+        ERR("Failed to open the index file " + STR(index_file_path));
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    BitstreamIndexFileHeader header;
+    if (!index_file.read(reinterpret_cast<char*>(&header), sizeof(header)) || memcmp(header.signature, BS_INDEX_FILE_SIGNATURE, sizeof(header.signature)) != 0 ||
+        header.version != BS_INDEX_FILE_VERSION || header.entry_size != sizeof(RocdecBitstreamPicIndexEntry)) {
+        ERR("Invalid index file " + STR(index_file_path));
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    // Each picture has at least one byte, which also bounds the allocation below
+    if (header.stream_type != stream_type_ || header.stream_size != stream_size_ || header.num_entries == 0 || header.num_entries > stream_size_) {
+        ERR("The index file " + STR(index_file_path) + " was not saved for this stream.");
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    std::vector<RocdecBitstreamPicIndexEntry> pic_index(header.num_entries);
+    if (!index_file.read(reinterpret_cast<char*>(pic_index.data()), pic_index.size() * sizeof(RocdecBitstreamPicIndexEntry))) {
+        ERR("Failed to read the index file " + STR(index_file_path));
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    for (auto &entry : pic_index) {
+        if (entry.size == 0 || entry.offset + entry.size > stream_size_) {
+            ERR("Invalid index file " + STR(index_file_path));
+            return ROCDEC_INVALID_PARAMETER;
+        }
+    }
+    pic_index_.swap(pic_index);
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus RocVideoESParser::SeekToPicture(int pic_idx, uint32_t flags, int *seek_pic_idx) {
+    if (pfn_read_ || stream_size_ == 0) {
+        return ROCDEC_NOT_SUPPORTED;
+    }
+    if (pic_index_.empty()) {
+        return ROCDEC_NOT_INITIALIZED;
+    }
+    if (pic_idx < 0 || pic_idx >= static_cast<int>(pic_index_.size())) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    if (flags & ROCDEC_SEEK_RANDOM_ACCESS_POINT) {
+        while (pic_idx > 0 && !pic_index_[pic_idx].key_frame_flag) {
+            pic_idx--;
+        }
+    }
+    // Picture 0 is read from the stream start, which may have a file header or bytes before the first start code
+    ResetReadPosition(pic_idx > 0 ? pic_index_[pic_idx].offset : 0, pic_idx);
+    if (seek_pic_idx) {
+        *seek_pic_idx = pic_idx;
+    }
+    return ROCDEC_SUCCESS;
 }
 
 rocDecVideoCodec RocVideoESParser::GetCodecId() {
@@ -530,11 +1364,24 @@ int RocVideoESParser::ProbeStreamType() {
     int stream_size;
 
     stream_buf = static_cast<uint8_t*>(malloc(STREAM_PROBE_SIZE));
-    p_stream_file_.seekg (0, p_stream_file_.beg);
-    stream_size = p_stream_file_.read(reinterpret_cast<char*>(stream_buf), STREAM_PROBE_SIZE).gcount();
-    // When the file size is smaller than STREAM_PROBE_SIZE, the fail bit is set. If we don't clear the state, further operations will fail.
-    if (p_stream_file_.fail()) {
-        p_stream_file_.clear();
+    if (mapped_data_) {
+        stream_size = mapped_size_ < STREAM_PROBE_SIZE ? static_cast<int>(mapped_size_) : STREAM_PROBE_SIZE;
+        memcpy(stream_buf, mapped_data_, stream_size);
+    } else if (pfn_read_) {
+        // The stream can only be read once: fetch the probe bytes into the ring, where they are parsed later
+        while (GetDataSizeInRB() < STREAM_PROBE_SIZE && FetchBitStream() > 0) {
+        }
+        stream_size = GetDataSizeInRB() < STREAM_PROBE_SIZE ? GetDataSizeInRB() : STREAM_PROBE_SIZE;
+        if (stream_size > 0) {
+            memcpy(stream_buf, bs_ring_, stream_size);
+        }
+    } else {
+        p_stream_file_.seekg (0, p_stream_file_.beg);
+        stream_size = p_stream_file_.read(reinterpret_cast<char*>(stream_buf), STREAM_PROBE_SIZE).gcount();
+        // When the file size is smaller than STREAM_PROBE_SIZE, the fail bit is set. If we don't clear the state, further operations will fail.
+        if (p_stream_file_.fail()) {
+            p_stream_file_.clear();
+        }
     }
 
     for (int i = kStreamTypeAvcElementary; i < kStreamTypeNumSupported; i++) {
@@ -574,7 +1421,9 @@ int RocVideoESParser::ProbeStreamType() {
     if (stream_buf) {
         free(stream_buf);
     }
-    p_stream_file_.seekg (0, std::ios::beg);
+    if (!mapped_data_ && !pfn_read_) {
+        p_stream_file_.seekg (0, std::ios::beg);
+    }
     return stream_type;
 }
 
@@ -587,7 +1436,7 @@ int RocVideoESParser::CheckAvcEStream(uint8_t *p_stream, int stream_size) {
     int slice_present = 0;
     int idr_slice_present = 0;
     int first_slice_present = 0;
-    size_t offset = 0;
+    Parser::BitReader bit_reader;
 
     while (curr_offset < stream_size - 2) {
         if (p_stream[curr_offset] == 0 && p_stream[curr_offset + 1] == 0 && p_stream[curr_offset + 2] == 1) {
@@ -595,15 +1444,19 @@ int RocVideoESParser::CheckAvcEStream(uint8_t *p_stream, int stream_size) {
             uint8_t nal_header_byte = p_stream[curr_offset + 3];
             uint8_t nal_unit_type = nal_header_byte & 0x1F;
             uint8_t nal_rbsp[256];
-            memcpy(nal_rbsp, p_stream + curr_offset + 4, 256);
-            EbspToRbsp(nal_rbsp, 0, 256);
+            int ebsp_size = stream_size - curr_offset - 4;
+            ebsp_size = ebsp_size < 0 ? 0 : (ebsp_size > static_cast<int>(sizeof(nal_rbsp)) ? static_cast<int>(sizeof(nal_rbsp)) : ebsp_size);
+            int rbsp_size = static_cast<int>(Parser::EbspToRbsp(p_stream + curr_offset + 4, ebsp_size, nal_rbsp));
+            if (rbsp_size < 0) {
+                rbsp_size = 0;
+            }
             switch (nal_unit_type) {
                 case kAvcNalTypeSeq_Parameter_Set: {
-                    offset = 0;
-                    uint32_t profile_idc = Parser::ReadBits(nal_rbsp, offset, 8);
-                    Parser::ReadBits(nal_rbsp, offset, 8);
-                    uint32_t level_idc = Parser::ReadBits(nal_rbsp, offset, 8);
-                    uint32_t seq_parameter_set_id = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
+                    bit_reader.Init(nal_rbsp, rbsp_size);
+                    uint32_t profile_idc = bit_reader.ReadBits(8);
+                    bit_reader.ReadBits(8);
+                    uint32_t level_idc = bit_reader.ReadBits(8);
+                    uint32_t seq_parameter_set_id = bit_reader.ReadUe();
                     uint32_t chroma_format_idc;
                     if (profile_idc == 100 ||
                         profile_idc == 110 ||
@@ -618,12 +1471,12 @@ int RocVideoESParser::CheckAvcEStream(uint8_t *p_stream, int stream_size) {
                         profile_idc == 139 ||
                         profile_idc == 134 ||
                         profile_idc == 135) {
-                        chroma_format_idc = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                        chroma_format_idc = bit_reader.ReadUe();
                         if (chroma_format_idc == 3) {
-                            Parser::GetBit(p_stream, offset); // separate_colour_plane_flag
+                            bit_reader.GetBit(); // separate_colour_plane_flag
                         }
-                        uint32_t bit_depth_luma = Parser::ExpGolomb::ReadUe(p_stream, offset) + 8;
-                        uint32_t bit_depth_chroma = Parser::ExpGolomb::ReadUe(p_stream, offset) + 8;
+                        uint32_t bit_depth_luma = bit_reader.ReadUe() + 8;
+                        uint32_t bit_depth_chroma = bit_reader.ReadUe() + 8;
                         bit_depth_ = bit_depth_luma > bit_depth_chroma ? bit_depth_luma : bit_depth_chroma;
                     } else {
                         chroma_format_idc = 1;
@@ -637,9 +1490,9 @@ int RocVideoESParser::CheckAvcEStream(uint8_t *p_stream, int stream_size) {
                 }
 
                 case kAvcNalTypePic_Parameter_Set: {
-                    offset = 0;
-                    uint32_t pic_parameter_set_id = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
-                    uint32_t seq_parameter_set_id = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
+                    bit_reader.Init(nal_rbsp, rbsp_size);
+                    uint32_t pic_parameter_set_id = bit_reader.ReadUe();
+                    uint32_t seq_parameter_set_id = bit_reader.ReadUe();
                     if ( pic_parameter_set_id >= 0 && pic_parameter_set_id <= 255 && seq_parameter_set_id >= 0 && seq_parameter_set_id <= 31) {
                         pps_present = 1;
                     }
@@ -653,8 +1506,8 @@ int RocVideoESParser::CheckAvcEStream(uint8_t *p_stream, int stream_size) {
                 case kAvcNalTypeSlice_Data_Partition_B:
                 case kAvcNalTypeSlice_Data_Partition_C: {
                     slice_present = 1;
-                    offset = 0;
-                    uint32_t first_mb_in_slice = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
+                    bit_reader.Init(nal_rbsp, rbsp_size);
+                    uint32_t first_mb_in_slice = bit_reader.ReadUe();
                     if ( first_mb_in_slice == 0) {
                         first_slice_present = 1;
                     }
@@ -687,7 +1540,7 @@ int RocVideoESParser::CheckHevcEStream(uint8_t *p_stream, int stream_size) {
     int slice_present = 0;
     int rap_slice_present = 0;
     int first_slice_present = 0;
-    size_t offset = 0;
+    Parser::BitReader bit_reader;
 
     while (curr_offset < stream_size - 2) {
         if (p_stream[curr_offset] == 0 && p_stream[curr_offset + 1] == 0 && p_stream[curr_offset + 2] == 1) {
@@ -695,12 +1548,17 @@ int RocVideoESParser::CheckHevcEStream(uint8_t *p_stream, int stream_size) {
             uint8_t nal_header_byte = p_stream[curr_offset + 3];
             uint8_t nal_unit_type = (nal_header_byte >> 1) & 0x3F;
             uint8_t nal_rbsp[256];
-            memcpy(nal_rbsp, p_stream + curr_offset + 5, 256);
-            EbspToRbsp(nal_rbsp, 0, 256);
+            int ebsp_size = stream_size - curr_offset - 5;
+            ebsp_size = ebsp_size < 0 ? 0 : (ebsp_size > static_cast<int>(sizeof(nal_rbsp)) ? static_cast<int>(sizeof(nal_rbsp)) : ebsp_size);
+            int rbsp_size = static_cast<int>(Parser::EbspToRbsp(p_stream + curr_offset + 5, ebsp_size, nal_rbsp));
+            if (rbsp_size < 0) {
+                rbsp_size = 0;
+            }
             switch (nal_unit_type) {
                  case NAL_UNIT_VPS: {
-                    offset = 16;
-                    int vps_reserved_0xffff_16bits = Parser::ReadBits(nal_rbsp, offset, 16);
+                    bit_reader.Init(nal_rbsp, rbsp_size);
+                    bit_reader.SkipBits(16);
+                    int vps_reserved_0xffff_16bits = bit_reader.ReadBits(16);
                     if (vps_reserved_0xffff_16bits == 0xFFFF) {
                         vps_present = 1;
                     }
@@ -708,47 +1566,47 @@ int RocVideoESParser::CheckHevcEStream(uint8_t *p_stream, int stream_size) {
                 }
 
                 case NAL_UNIT_SPS: {
-                    offset = 0;
-                    Parser::ReadBits(nal_rbsp, offset, 4); // sps_video_parameter_set_id
-                    uint32_t max_sub_layer_minus1 = Parser::ReadBits(nal_rbsp, offset, 3);
-                    Parser::GetBit(nal_rbsp, offset); // sps_temporal_id_nesting_flag
+                    bit_reader.Init(nal_rbsp, rbsp_size);
+                    bit_reader.ReadBits(4); // sps_video_parameter_set_id
+                    uint32_t max_sub_layer_minus1 = bit_reader.ReadBits(3);
+                    bit_reader.GetBit(); // sps_temporal_id_nesting_flag
                     // profile_tier_level()
                     int sub_layer_profile_present_flag[6];
                     int sub_layer_level_present_flag[6];
-                    offset += 96;
+                    bit_reader.SkipBits(96);
                     for (int i = 0; i < max_sub_layer_minus1; i++) {
-                        sub_layer_profile_present_flag[i] = Parser::GetBit(nal_rbsp, offset);
-                        sub_layer_level_present_flag[i] = Parser::GetBit(nal_rbsp, offset);
+                        sub_layer_profile_present_flag[i] = bit_reader.GetBit();
+                        sub_layer_level_present_flag[i] = bit_reader.GetBit();
                     }
                     if (max_sub_layer_minus1 > 0) {
                         for (int i = max_sub_layer_minus1; i < 8; i++) {
-                            offset += 2;
+                            bit_reader.SkipBits(2);
                         }
                     }
                     for (int i = 0; i < max_sub_layer_minus1; i++) {
                         if (sub_layer_profile_present_flag[i]) {
-                            offset += 88;
+                            bit_reader.SkipBits(88);
                         }
                         if (sub_layer_level_present_flag[i]) {
-                            offset += 8;
+                            bit_reader.SkipBits(8);
                         }
                     }
-                    uint32_t sps_seq_parameter_set_id = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
-                    uint32_t chroma_format_idc = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
+                    uint32_t sps_seq_parameter_set_id = bit_reader.ReadUe();
+                    uint32_t chroma_format_idc = bit_reader.ReadUe();
                     if (chroma_format_idc == 3) {
-                        Parser::GetBit(nal_rbsp, offset); // separate_colour_plane_flag
+                        bit_reader.GetBit(); // separate_colour_plane_flag
                     }
-                    Parser::ExpGolomb::ReadUe(nal_rbsp, offset); // pic_width_in_luma_samples
-                    Parser::ExpGolomb::ReadUe(nal_rbsp, offset); // pic_height_in_luma_samples
-                    int conformance_window_flag = Parser::GetBit(nal_rbsp, offset);
+                    bit_reader.ReadUe(); // pic_width_in_luma_samples
+                    bit_reader.ReadUe(); // pic_height_in_luma_samples
+                    int conformance_window_flag = bit_reader.GetBit();
                     if (conformance_window_flag) {
-                        Parser::ExpGolomb::ReadUe(nal_rbsp, offset); // conf_win_left_offset
-                        Parser::ExpGolomb::ReadUe(nal_rbsp, offset); // conf_win_right_offset
-                        Parser::ExpGolomb::ReadUe(nal_rbsp, offset); // conf_win_top_offset
-                        Parser::ExpGolomb::ReadUe(nal_rbsp, offset); // conf_win_bottom_offset
+                        bit_reader.ReadUe(); // conf_win_left_offset
+                        bit_reader.ReadUe(); // conf_win_right_offset
+                        bit_reader.ReadUe(); // conf_win_top_offset
+                        bit_reader.ReadUe(); // conf_win_bottom_offset
                     }
-                    uint32_t bit_depth_luma = Parser::ExpGolomb::ReadUe(nal_rbsp, offset) + 8;
-                    uint32_t bit_depth_chroma = Parser::ExpGolomb::ReadUe(nal_rbsp, offset) + 8;
+                    uint32_t bit_depth_luma = bit_reader.ReadUe() + 8;
+                    uint32_t bit_depth_chroma = bit_reader.ReadUe() + 8;
                     bit_depth_ = bit_depth_luma > bit_depth_chroma ? bit_depth_luma : bit_depth_chroma;
                     if (sps_seq_parameter_set_id >= 0 && sps_seq_parameter_set_id <= 15 && chroma_format_idc >= 0 && chroma_format_idc <= 3 && bit_depth_ >= 8 && bit_depth_ <= 16) {
                         sps_present = 1;
@@ -758,9 +1616,9 @@ int RocVideoESParser::CheckHevcEStream(uint8_t *p_stream, int stream_size) {
                 }
 
                 case NAL_UNIT_PPS: {
-                    offset = 0;
-                    uint32_t pps_pic_parameter_set_id = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
-                    uint32_t pps_seq_parameter_set_id = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
+                    bit_reader.Init(nal_rbsp, rbsp_size);
+                    uint32_t pps_pic_parameter_set_id = bit_reader.ReadUe();
+                    uint32_t pps_seq_parameter_set_id = bit_reader.ReadUe();
                     if ( pps_pic_parameter_set_id >= 0 && pps_pic_parameter_set_id <= 63 && pps_seq_parameter_set_id >= 0 && pps_seq_parameter_set_id <= 15) {
                         pps_present = 1;
                     }
@@ -784,15 +1642,15 @@ int RocVideoESParser::CheckHevcEStream(uint8_t *p_stream, int stream_size) {
                 case NAL_UNIT_CODED_SLICE_RADL_R:
                 case NAL_UNIT_CODED_SLICE_RASL_N:
                 case NAL_UNIT_CODED_SLICE_RASL_R: {
-                    offset = 0;
-                    int first_slice_segment_in_pic_flag = Parser::GetBit(nal_rbsp, offset);
+                    bit_reader.Init(nal_rbsp, rbsp_size);
+                    int first_slice_segment_in_pic_flag = bit_reader.GetBit();
                     if (first_slice_segment_in_pic_flag) {
                         first_slice_present = 1;
                     }
                     if (nal_unit_type >= NAL_UNIT_CODED_SLICE_BLA_W_LP && nal_unit_type <= NAL_UNIT_RESERVED_IRAP_VCL23) {
-                        offset++;
+                        bit_reader.SkipBits(1);
                     }
-                    uint32_t slice_pic_parameter_set_id = Parser::ExpGolomb::ReadUe(nal_rbsp, offset);
+                    uint32_t slice_pic_parameter_set_id = bit_reader.ReadUe();
                     if ( slice_pic_parameter_set_id >= 0 && slice_pic_parameter_set_id <= 63) {
                         slice_present = 1;
                     } else {
@@ -821,49 +1679,9 @@ int RocVideoESParser::CheckHevcEStream(uint8_t *p_stream, int stream_size) {
     return score;
 }
 
-int RocVideoESParser::EbspToRbsp(uint8_t *streamBuffer, int begin_bytepos, int end_bytepos) {
-    int count = 0;
-    if (end_bytepos < begin_bytepos) {
-        return end_bytepos;
-    }
-    uint8_t *streamBuffer_i = streamBuffer + begin_bytepos;
-    uint8_t *streamBuffer_end = streamBuffer + end_bytepos;
-    int reduce_count = 0;
-    for (; streamBuffer_i != streamBuffer_end; ) {
-        //starting from begin_bytepos to avoid header information
-        //in NAL unit, 0x000000, 0x000001 or 0x000002 shall not occur at any uint8_t-aligned position
-        uint8_t tmp =* streamBuffer_i;
-        if (count == ZEROBYTES_SHORTSTARTCODE) {
-            if (tmp == 0x03) {
-                //check the 4th uint8_t after 0x000003, except when cabac_zero_word is used, in which case the last three bytes of this NAL unit must be 0x000003
-                if ((streamBuffer_i + 1 != streamBuffer_end) && (streamBuffer_i[1] > 0x03)) {
-                    return -1;
-                }
-                //if cabac_zero_word is used, the final uint8_t of this NAL unit(0x03) is discarded, and the last two bytes of RBSP must be 0x0000
-                if (streamBuffer_i + 1 == streamBuffer_end) {
-                    break;
-                }
-                memmove(streamBuffer_i, streamBuffer_i + 1, streamBuffer_end-streamBuffer_i - 1);
-                streamBuffer_end--;
-                reduce_count++;
-                count = 0;
-                tmp = *streamBuffer_i;
-            } else if (tmp < 0x03) {
-            }
-        }
-        if (tmp == 0x00) {
-            count++;
-        } else {
-            count = 0;
-        }
-        streamBuffer_i++;
-    }
-    return end_bytepos - begin_bytepos + reduce_count;
-}
-
-uint32_t RocVideoESParser::ReadUVLC(const uint8_t *p_stream, size_t &bit_offset) {
+uint32_t RocVideoESParser::ReadUVLC(Parser::BitReader &bit_reader) {
     int leading_zeros = 0;
-    while (!Parser::GetBit(p_stream, bit_offset)) {
+    while (!bit_reader.GetBit() && !bit_reader.IsOverrun()) {
         ++leading_zeros;
     }
     // Maximum 32 bits.
@@ -871,7 +1689,7 @@ uint32_t RocVideoESParser::ReadUVLC(const uint8_t *p_stream, size_t &bit_offset)
         return 0xFFFFFFFF;
     }
     uint32_t base = (1u << leading_zeros) - 1;
-    uint32_t value = Parser::ReadBits(p_stream, bit_offset, leading_zeros);
+    uint32_t value = bit_reader.ReadBits(leading_zeros);
     return base + value;
 }
 
@@ -885,34 +1703,34 @@ int RocVideoESParser::CheckAv1EStream(uint8_t *p_stream, int stream_size) {
     int frame_obu_present = 0;
     int tile_group_obu_present = 0;
     bool syntax_error = false;
-    size_t offset = 0;
+    Parser::BitReader bit_reader;
 
     while (curr_offset < stream_size) {
         // OBU header
         Av1ObuHeader obu_header;
-        offset = 0;
         obu_stream = p_stream + curr_offset;
+        bit_reader.Init(obu_stream, stream_size - curr_offset);
         obu_header.size = 1;
-        if (Parser::GetBit(obu_stream, offset) != 0) {
+        if (bit_reader.GetBit() != 0) {
             syntax_error = true;
             break;
         }
-        obu_header.obu_type = Parser::ReadBits(obu_stream, offset, 4);
-        obu_header.obu_extension_flag = Parser::GetBit(obu_stream, offset);
-        obu_header.obu_has_size_field = Parser::GetBit(obu_stream, offset);
+        obu_header.obu_type = bit_reader.ReadBits(4);
+        obu_header.obu_extension_flag = bit_reader.GetBit();
+        obu_header.obu_has_size_field = bit_reader.GetBit();
         if (!obu_header.obu_has_size_field) {
             syntax_error = true;
             break;
         }
-        if (Parser::GetBit(obu_stream, offset) != 0) {
+        if (bit_reader.GetBit() != 0) {
             syntax_error = true;
             break;
         }
         if (obu_header.obu_extension_flag) {
             obu_header.size += 1;
-            obu_header.temporal_id = Parser::ReadBits(obu_stream, offset, 3);
-            obu_header.spatial_id = Parser::ReadBits(obu_stream, offset, 2);
-            if (Parser::ReadBits(obu_stream, offset, 3) != 0) {
+            obu_header.temporal_id = bit_reader.ReadBits(3);
+            obu_header.spatial_id = bit_reader.ReadBits(2);
+            if (bit_reader.ReadBits(3) != 0) {
                 syntax_error = true;
                 break;
             }
@@ -939,10 +1757,10 @@ int RocVideoESParser::CheckAv1EStream(uint8_t *p_stream, int stream_size) {
 
             case kObuSequenceHeader: {
                 Av1SequenceHeader seq_header = {0};
-                offset = 0;
-                seq_header.seq_profile = Parser::ReadBits(obu_stream, offset, 3);
-                seq_header.still_picture = Parser::GetBit(obu_stream, offset);
-                seq_header.reduced_still_picture_header = Parser::GetBit(obu_stream, offset);
+                bit_reader.Init(obu_stream, obu_size);
+                seq_header.seq_profile = bit_reader.ReadBits(3);
+                seq_header.still_picture = bit_reader.GetBit();
+                seq_header.reduced_still_picture_header = bit_reader.GetBit();
 
                 if (seq_header.reduced_still_picture_header) {
                     seq_header.timing_info_present_flag = 0;
@@ -950,75 +1768,75 @@ int RocVideoESParser::CheckAv1EStream(uint8_t *p_stream, int stream_size) {
                     seq_header.initial_display_delay_present_flag = 0;
                     seq_header.operating_points_cnt_minus_1 = 0;
                     seq_header.operating_point_idc[0] = 0;
-                    seq_header.seq_level_idx[0] = Parser::ReadBits(obu_stream, offset, 5);
+                    seq_header.seq_level_idx[0] = bit_reader.ReadBits(5);
                     seq_header.seq_tier[0] = 0;
                     seq_header.decoder_model_present_for_this_op[0] = 0;
                     seq_header.initial_display_delay_present_for_this_op[0] = 0;
                 } else {
-                    seq_header.timing_info_present_flag = Parser::GetBit(obu_stream, offset);
+                    seq_header.timing_info_present_flag = bit_reader.GetBit();
                     if (seq_header.timing_info_present_flag) {
                         // timing_info()
-                        seq_header.timing_info.num_units_in_display_tick = Parser::ReadBits(obu_stream, offset, 32);
-                        seq_header.timing_info.time_scale = Parser::ReadBits(obu_stream, offset, 32);
-                        seq_header.timing_info.equal_picture_interval = Parser::GetBit(obu_stream, offset);
+                        seq_header.timing_info.num_units_in_display_tick = bit_reader.ReadBits(32);
+                        seq_header.timing_info.time_scale = bit_reader.ReadBits(32);
+                        seq_header.timing_info.equal_picture_interval = bit_reader.GetBit();
                         if (seq_header.timing_info.equal_picture_interval) {
-                            seq_header.timing_info.num_ticks_per_picture_minus_1 = ReadUVLC(obu_stream, offset);
+                            seq_header.timing_info.num_ticks_per_picture_minus_1 = ReadUVLC(bit_reader);
                         }
-                        seq_header.decoder_model_info_present_flag = Parser::GetBit(obu_stream, offset);
+                        seq_header.decoder_model_info_present_flag = bit_reader.GetBit();
                         if (seq_header.decoder_model_info_present_flag) {
-                            seq_header.decoder_model_info.buffer_delay_length_minus_1 = Parser::ReadBits(obu_stream, offset, 5);
-                            seq_header.decoder_model_info.num_units_in_decoding_tick = Parser::ReadBits(obu_stream, offset, 32);
-                            seq_header.decoder_model_info.buffer_removal_time_length_minus_1 = Parser::ReadBits(obu_stream, offset, 5);
-                            seq_header.decoder_model_info.frame_presentation_time_length_minus_1 = Parser::ReadBits(obu_stream, offset, 5);
+                            seq_header.decoder_model_info.buffer_delay_length_minus_1 = bit_reader.ReadBits(5);
+                            seq_header.decoder_model_info.num_units_in_decoding_tick = bit_reader.ReadBits(32);
+                            seq_header.decoder_model_info.buffer_removal_time_length_minus_1 = bit_reader.ReadBits(5);
+                            seq_header.decoder_model_info.frame_presentation_time_length_minus_1 = bit_reader.ReadBits(5);
                         }
                     } else {
                         seq_header.decoder_model_info_present_flag = 0;
                     }
-                    seq_header.initial_display_delay_present_flag = Parser::GetBit(obu_stream, offset);
-                    seq_header.operating_points_cnt_minus_1 = Parser::ReadBits(obu_stream, offset, 5);
+                    seq_header.initial_display_delay_present_flag = bit_reader.GetBit();
+                    seq_header.operating_points_cnt_minus_1 = bit_reader.ReadBits(5);
                     for (int i = 0; i < seq_header.operating_points_cnt_minus_1 + 1; i++) {
-                        seq_header.operating_point_idc[i] = Parser::ReadBits(obu_stream, offset, 12);
-                        seq_header.seq_level_idx[i] = Parser::ReadBits(obu_stream, offset, 5);
+                        seq_header.operating_point_idc[i] = bit_reader.ReadBits(12);
+                        seq_header.seq_level_idx[i] = bit_reader.ReadBits(5);
                         if (seq_header.seq_level_idx[i] > 7) {
-                            seq_header.seq_tier[i] = Parser::GetBit(obu_stream, offset);
+                            seq_header.seq_tier[i] = bit_reader.GetBit();
                         } else {
                             seq_header.seq_tier[i] = 0;
                         }
                         if (seq_header.decoder_model_info_present_flag) {
-                            seq_header.decoder_model_present_for_this_op[i] = Parser::GetBit(obu_stream, offset);
+                            seq_header.decoder_model_present_for_this_op[i] = bit_reader.GetBit();
                             if (seq_header.decoder_model_present_for_this_op[i]) {
-                                seq_header.operating_parameters_info[i].decoder_buffer_delay = Parser::ReadBits(obu_stream, offset, seq_header.decoder_model_info.buffer_delay_length_minus_1 + 1);
-                                seq_header.operating_parameters_info[i].encoder_buffer_delay = Parser::ReadBits(obu_stream, offset, seq_header.decoder_model_info.buffer_delay_length_minus_1 + 1);
-                                seq_header.operating_parameters_info[i].low_delay_mode_flag = Parser::GetBit(obu_stream, offset);
+                                seq_header.operating_parameters_info[i].decoder_buffer_delay = bit_reader.ReadBits(seq_header.decoder_model_info.buffer_delay_length_minus_1 + 1);
+                                seq_header.operating_parameters_info[i].encoder_buffer_delay = bit_reader.ReadBits(seq_header.decoder_model_info.buffer_delay_length_minus_1 + 1);
+                                seq_header.operating_parameters_info[i].low_delay_mode_flag = bit_reader.GetBit();
                             }
                         } else {
                             seq_header.decoder_model_present_for_this_op[i] = 0;
                         }
 
                         if (seq_header.initial_display_delay_present_flag) {
-                            seq_header.initial_display_delay_present_for_this_op[i] = Parser::GetBit(obu_stream, offset);
+                            seq_header.initial_display_delay_present_for_this_op[i] = bit_reader.GetBit();
                             if (seq_header.initial_display_delay_present_for_this_op[i]) {
-                                seq_header.initial_display_delay_minus_1[i] = Parser::ReadBits(obu_stream, offset, 4);
+                                seq_header.initial_display_delay_minus_1[i] = bit_reader.ReadBits(4);
                             }
                         }
                     }
                 }
-                seq_header.frame_width_bits_minus_1 = Parser::ReadBits(obu_stream, offset, 4);
-                seq_header.frame_height_bits_minus_1 = Parser::ReadBits(obu_stream, offset, 4);
-                seq_header.max_frame_width_minus_1 = Parser::ReadBits(obu_stream, offset, seq_header.frame_width_bits_minus_1 + 1);
-                seq_header.max_frame_height_minus_1 = Parser::ReadBits(obu_stream, offset, seq_header.frame_height_bits_minus_1 + 1);
+                seq_header.frame_width_bits_minus_1 = bit_reader.ReadBits(4);
+                seq_header.frame_height_bits_minus_1 = bit_reader.ReadBits(4);
+                seq_header.max_frame_width_minus_1 = bit_reader.ReadBits(seq_header.frame_width_bits_minus_1 + 1);
+                seq_header.max_frame_height_minus_1 = bit_reader.ReadBits(seq_header.frame_height_bits_minus_1 + 1);
                 if (seq_header.reduced_still_picture_header) {
                     seq_header.frame_id_numbers_present_flag = 0;
                 } else {
-                    seq_header.frame_id_numbers_present_flag = Parser::GetBit(obu_stream, offset);
+                    seq_header.frame_id_numbers_present_flag = bit_reader.GetBit();
                 }
                 if (seq_header.frame_id_numbers_present_flag) {
-                    seq_header.delta_frame_id_length_minus_2 = Parser::ReadBits(obu_stream, offset, 4);
-                    seq_header.additional_frame_id_length_minus_1 = Parser::ReadBits(obu_stream, offset, 3);
+                    seq_header.delta_frame_id_length_minus_2 = bit_reader.ReadBits(4);
+                    seq_header.additional_frame_id_length_minus_1 = bit_reader.ReadBits(3);
                 }
-                seq_header.use_128x128_superblock = Parser::GetBit(obu_stream, offset);
-                seq_header.enable_filter_intra = Parser::GetBit(obu_stream, offset);
-                seq_header.enable_intra_edge_filter = Parser::GetBit(obu_stream, offset);
+                seq_header.use_128x128_superblock = bit_reader.GetBit();
+                seq_header.enable_filter_intra = bit_reader.GetBit();
+                seq_header.enable_intra_edge_filter = bit_reader.GetBit();
 
                 if (seq_header.reduced_still_picture_header) {
                     seq_header.enable_interintra_compound = 0;
@@ -1032,49 +1850,49 @@ int RocVideoESParser::CheckAv1EStream(uint8_t *p_stream, int stream_size) {
                     seq_header.seq_force_integer_mv = SELECT_INTEGER_MV;
                     seq_header.order_hint_bits = 0;
                 } else {
-                    seq_header.enable_interintra_compound = Parser::GetBit(obu_stream, offset);
-                    seq_header.enable_masked_compound = Parser::GetBit(obu_stream, offset);
-                    seq_header.enable_warped_motion = Parser::GetBit(obu_stream, offset);
-                    seq_header.enable_dual_filter = Parser::GetBit(obu_stream, offset);
-                    seq_header.enable_order_hint = Parser::GetBit(obu_stream, offset);
+                    seq_header.enable_interintra_compound = bit_reader.GetBit();
+                    seq_header.enable_masked_compound = bit_reader.GetBit();
+                    seq_header.enable_warped_motion = bit_reader.GetBit();
+                    seq_header.enable_dual_filter = bit_reader.GetBit();
+                    seq_header.enable_order_hint = bit_reader.GetBit();
                     if (seq_header.enable_order_hint) {
-                        seq_header.enable_jnt_comp = Parser::GetBit(obu_stream, offset);
-                        seq_header.enable_ref_frame_mvs = Parser::GetBit(obu_stream, offset);
+                        seq_header.enable_jnt_comp = bit_reader.GetBit();
+                        seq_header.enable_ref_frame_mvs = bit_reader.GetBit();
                     } else {
                         seq_header.enable_jnt_comp = 0;
                         seq_header.enable_ref_frame_mvs = 0;
                     }
-                    seq_header.seq_choose_screen_content_tools = Parser::GetBit(obu_stream, offset);
+                    seq_header.seq_choose_screen_content_tools = bit_reader.GetBit();
                     if (seq_header.seq_choose_screen_content_tools) {
                         seq_header.seq_force_screen_content_tools = SELECT_SCREEN_CONTENT_TOOLS;
                     } else {
-                        seq_header.seq_force_screen_content_tools = Parser::GetBit(obu_stream, offset);
+                        seq_header.seq_force_screen_content_tools = bit_reader.GetBit();
                     }
                     if (seq_header.seq_force_screen_content_tools > 0) {
-                        seq_header.seq_choose_integer_mv = Parser::GetBit(obu_stream, offset);
+                        seq_header.seq_choose_integer_mv = bit_reader.GetBit();
                         if (seq_header.seq_choose_integer_mv) {
                             seq_header.seq_force_integer_mv = SELECT_INTEGER_MV;
                         } else {
-                            seq_header.seq_force_integer_mv = Parser::GetBit(obu_stream, offset);
+                            seq_header.seq_force_integer_mv = bit_reader.GetBit();
                         }
                     } else {
                         seq_header.seq_force_integer_mv = SELECT_INTEGER_MV;
                     }
 
                     if (seq_header.enable_order_hint) {
-                        seq_header.order_hint_bits_minus_1 = Parser::ReadBits(obu_stream, offset, 3);
+                        seq_header.order_hint_bits_minus_1 = bit_reader.ReadBits(3);
                         seq_header.order_hint_bits = seq_header.order_hint_bits_minus_1 + 1;
                     } else {
                         seq_header.order_hint_bits = 0;
                     }
                 }
-                seq_header.enable_superres = Parser::GetBit(obu_stream, offset);
-                seq_header.enable_cdef = Parser::GetBit(obu_stream, offset);
-                seq_header.enable_restoration = Parser::GetBit(obu_stream, offset);
+                seq_header.enable_superres = bit_reader.GetBit();
+                seq_header.enable_cdef = bit_reader.GetBit();
+                seq_header.enable_restoration = bit_reader.GetBit();
                 seq_header.color_config.bit_depth = 8;
-                seq_header.color_config.high_bitdepth = Parser::GetBit(obu_stream, offset);
+                seq_header.color_config.high_bitdepth = bit_reader.GetBit();
                 if (seq_header.seq_profile == 2 && seq_header.color_config.high_bitdepth) {
-                    seq_header.color_config.twelve_bit = Parser::GetBit(obu_stream, offset);
+                    seq_header.color_config.twelve_bit = bit_reader.GetBit();
                     seq_header.color_config.bit_depth = seq_header.color_config.twelve_bit ? 12 : 10;
                 } else if (seq_header.seq_profile <= 2) {
                     seq_header.color_config.bit_depth = seq_header.color_config.high_bitdepth ? 10 : 8;
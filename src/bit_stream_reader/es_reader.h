@@ -25,10 +25,23 @@ THE SOFTWARE.
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "rocdecode.h"
-
-#define BS_RING_SIZE (16 * 1024 * 1024)
-#define INIT_PIC_DATA_SIZE (2 * 1024 * 1024)
+#include "rocparser.h"
+#include "roc_bitstream_reader.h"
+#include "bit_reader.h"
+#include "nal_unit_index.h"
+
+#define BS_RING_SIZE (16 * 1024 * 1024) // default ring size
+#define BS_RING_MIN_SIZE (64 * 1024)
+#define BS_RING_MAX_SIZE 0x7FFF0000 // the ring offsets stay within int range
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define MMAP_WINDOW_SIZE (64 * 1024 * 1024) // growth step of the window into the mapped file
+#define READ_AHEAD_CHUNK_SIZE (1024 * 1024) // size of one pread of the read-ahead thread
+#define READ_AHEAD_DEPTH 2 // default number of chunks read ahead
 
 enum {
     kStreamTypeUnsupported = -1,
@@ -42,10 +55,44 @@ enum {
 #define STREAM_PROBE_SIZE 2 * 1024
 #define STREAM_TYPE_SCORE_THRESHOLD 50
 
+// Sidecar file of the picture index: the header followed by the RocdecBitstreamPicIndexEntry entries
+#define BS_INDEX_FILE_SIGNATURE "RBIX"
+#define BS_INDEX_FILE_VERSION 1
+#define HEVC_MAX_PPS_COUNT 64
+
+typedef struct {
+    char signature[4];
+    uint32_t version;
+    int32_t stream_type;
+    uint32_t entry_size; // sizeof(RocdecBitstreamPicIndexEntry)
+    uint64_t stream_size;
+    uint64_t num_entries;
+} BitstreamIndexFileHeader;
+
 class RocVideoESParser {
     public:
-        RocVideoESParser(const char *input_file_path);
-        RocVideoESParser();
+        /*! \brief RocVideoESParser constructor
+         * \param [in] input_file_path Path of the bitstream file
+         * \param [in] params Reader parameters. <tt>memory_mapped_input</tt> selects the memory mapped mode, which falls back to
+         *             reading into the ring buffer if the file can not be mapped. <tt>ring_size</tt> and <tt>use_huge_pages</tt>
+         *             configure the ring buffer, which is allocated on the first read. <tt>read_ahead</tt> starts the read-ahead
+         *             thread at the first read.
+         */
+        RocVideoESParser(const char *input_file_path, const RocdecBitstreamReaderParams *params);
+
+        /*! \brief RocVideoESParser constructor for a stream held in memory
+         * \param [in] data Pointer to the stream. The buffer must stay valid until the reader is destroyed; the picture data points into it.
+         * \param [in] size Size of the stream in bytes
+         * \param [in] params Reader parameters. The ring buffer and read-ahead parameters do not apply.
+         */
+        RocVideoESParser(const uint8_t *data, size_t size, const RocdecBitstreamReaderParams *params);
+
+        /*! \brief RocVideoESParser constructor for a stream pulled through a read callback
+         * \param [in] pfn_read Read callback
+         * \param [in] user_data User data passed to the read callback
+         * \param [in] params Reader parameters. <tt>memory_mapped_input</tt> does not apply.
+         */
+        RocVideoESParser(PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, const RocdecBitstreamReaderParams *params);
         ~RocVideoESParser();
 
         /*! \brief Function to probe the bitstream file and try to get the codec id
@@ -64,13 +111,68 @@ class RocVideoESParser {
          */
         int GetBitDepth() {return bit_depth_;};
 
+        /*! \brief Function to return the NAL unit index of the picture data returned by the last <tt>GetPicData</tt> call
+         * \param [out] nal_units Pointer to the NAL unit index. The index is valid until the next <tt>GetPicData</tt> call.
+         * \param [out] num_nal_units Number of NAL units in the index. 0 for AV1 streams.
+         */
+        void GetNalUnitIndex(const RocdecNalUnitInfo **nal_units, int *num_nal_units) { *nal_units = nal_unit_index_.data(); *num_nal_units = num_pic_nal_units_; };
+
+        /*! \brief Function to get the reader statistics
+         * \param [out] stats The statistics accumulated since the reader was created
+         */
+        void GetStats(RocdecBitstreamReaderStats *stats);
+
+        /*! \brief Function to build the picture index in one pass over the stream. The read position is restored afterwards.
+         * \return ROCDEC_SUCCESS, or ROCDEC_NOT_SUPPORTED if the stream can not be read again
+         */
+        rocDecStatus BuildIndex();
+
+        /*! \brief Function to save the picture index to a sidecar file
+         * \param [in] index_file_path Path of the index file
+         * \return ROCDEC_SUCCESS on success
+         */
+        rocDecStatus SaveIndex(const char *index_file_path);
+
+        /*! \brief Function to load the picture index from a sidecar file
+         * \param [in] index_file_path Path of the index file
+         * \return ROCDEC_SUCCESS on success, ROCDEC_INVALID_PARAMETER if the file does not belong to the stream
+         */
+        rocDecStatus LoadIndex(const char *index_file_path);
+
+        /*! \brief Function to get the picture index
+         * \param [out] entries Pointer to the index entries, valid until the index is built or loaded again
+         * \param [out] num_entries Number of entries
+         */
+        void GetIndex(const RocdecBitstreamPicIndexEntry **entries, int *num_entries) { *entries = pic_index_.data(); *num_entries = static_cast<int>(pic_index_.size()); };
+
+        /*! \brief Function to move the read position to a picture of the index
+         * \param [in] pic_idx Index of the picture
+         * \param [in] flags Combination of RocdecBitstreamSeekFlags
+         * \param [out] seek_pic_idx Index of the picture moved to, optional
+         * \return ROCDEC_SUCCESS on success, ROCDEC_INVALID_PARAMETER if pic_idx is not in the index
+         */
+        rocDecStatus SeekToPicture(int pic_idx, uint32_t flags, int *seek_pic_idx);
+
     private:
         std::ifstream p_stream_file_;
+        PFNBITSTREAMREADCALLBACK pfn_read_; // read callback, the stream source instead of the file if set
+        void *read_user_data_;
         int stream_type_;
         int bit_depth_;
 
+        // Memory mapped file, or a stream held in memory. The ring is then a window into the mapping that never wraps around: it starts
+        // at mapped_base_ and grows by MMAP_WINDOW_SIZE as it is consumed. The window is moved forward to the current picture at each picture boundary.
+        uint8_t *mapped_data_;
+        size_t mapped_size_;
+        size_t mapped_base_; // file offset of ring offset 0
+        bool owns_mapped_data_; // false for a stream held in memory by the caller
+
         // Bitstream ring buffer
-        uint8_t bs_ring_[BS_RING_SIZE];
+        uint8_t *ring_buf_; // ring storage when reading from the file, allocated by the first FetchBitStream call
+        size_t ring_alloc_size_; // ring_size_ rounded up to the huge page size when huge pages are used
+        bool use_huge_pages_;
+        uint8_t *bs_ring_;
+        uint32_t ring_size_;
         uint32_t read_ptr_; /// start position of unprocessed stream in the ring
         uint32_t write_ptr_;  /// end position of unprocessed stream in the ring
         bool end_of_file_;
@@ -86,18 +188,61 @@ class RocVideoESParser {
         int obu_size_; // including header
         int num_td_obus_; // number of temporal delimiter OBUs
 
-        // Picture data (linear buffer)
+        // Picture data. A picture is assembled as a span of pic_data_size_ bytes from ring offset pic_start_offset_: the read pointer is
+        // held at the span start until the next picture, and the span is returned in place. The span is copied to the linear buffer
+        // pic_data_ only if it wraps around the ring end or if the ring fills up before the picture is complete. The rest of such a
+        // picture is then assembled in pic_data_.
         std::vector<uint8_t> pic_data_;
         int pic_data_size_;
+        bool pic_in_ring_;
+        int pic_start_offset_;
         // AVC/HEVC
         int curr_pic_end_;
         int next_pic_start_;
         int num_pictures_;
+        std::vector<RocdecNalUnitInfo> nal_unit_index_; // index of the NAL units in pic_data_
+        int num_pic_nal_units_; // number of NAL units of the current picture in nal_unit_index_
         // AV1
         int num_temp_units_; // number of temporal units
 
         bool ivf_file_header_read_; // indicator if IVF file header has been checked
 
+        // Picture index. The stream offset of a ring offset is derived from write_stream_offset_, the stream offset of write_ptr_,
+        // or from mapped_base_ in memory mapped mode.
+        uint64_t stream_size_; // 0 if unknown
+        uint64_t write_stream_offset_;
+        uint64_t pic_stream_offset_; // stream offset of the picture returned by the last GetPicData call
+        int curr_pic_idx_; // index of the picture returned by the next GetPicData call
+        std::vector<RocdecBitstreamPicIndexEntry> pic_index_;
+        bool building_index_;
+        uint8_t hevc_pps_extra_bits_[HEVC_MAX_PPS_COUNT]; // num_extra_slice_header_bits of the PPS ids seen while indexing
+        bool av1_reduced_still_picture_header_;
+
+        // Read-ahead. A worker thread reads the file into the free part of the ring with pread, at most read_ahead_depth_ bytes
+        // ahead of write_ptr_. Only the ring offsets are shared and they are published through atomics: the worker owns
+        // ra_write_ptr_, the end of the data it has read, and the parsing thread mirrors read_ptr_ and write_ptr_ in
+        // ra_read_ptr_ and ra_fetched_ptr_. The mutex and condition variable only park a thread that has nothing to do.
+        bool read_ahead_;
+        int read_ahead_fd_;
+        uint32_t read_ahead_chunk_size_;
+        uint32_t read_ahead_depth_;
+        std::thread read_ahead_thread_;
+        std::atomic<uint32_t> ra_write_ptr_;
+        std::atomic<uint32_t> ra_read_ptr_;
+        std::atomic<uint32_t> ra_fetched_ptr_;
+        std::atomic<bool> ra_end_of_file_;
+        std::atomic<bool> ra_stop_;
+        std::atomic<bool> ra_worker_waiting_;
+        std::atomic<bool> ra_reader_waiting_;
+        std::mutex ra_mutex_;
+        std::condition_variable ra_cond_;
+
+        // Statistics
+        uint64_t num_fetches_;
+        uint64_t num_read_ahead_hits_;
+        uint64_t num_read_ahead_stalls_;
+        uint64_t blocked_time_us_;
+
         /*! \brief Function to retrieve the bitstream of a picture for AVC/HEVC
          * \param [out] p_pic_data Pointer to the picture data
          * \param [out] pic_size Size of the picture in bytes
@@ -116,16 +261,140 @@ class RocVideoESParser {
          */
         int GetPicDataIvfAv1(uint8_t **p_pic_data, int *pic_size);
 
-        /*! \brief Function to read bitstream from file and fill into the ring buffer.
+        /*! \brief Function to read bitstream from file and fill into the ring buffer. In memory mapped mode the window is extended instead.
+        * With read-ahead, the data already read by the read-ahead thread is taken over.
         * \return Number of bytes read from file.
         */
         int FetchBitStream();
 
+        /*! \brief Function to read bitstream from file on the calling thread and fill into the ring buffer
+         * \param [in] free_space Free space in the ring in bytes
+         * \return Number of bytes read from file
+         */
+        int ReadBitStreamFromFile(int free_space);
+
+        /*! \brief Function to read bitstream through the read callback on the calling thread and fill into the ring buffer
+         * \param [in] free_space Free space in the ring in bytes
+         * \return Number of bytes read, 0 at the end of the stream
+         */
+        int ReadBitStreamFromCallback(int free_space);
+
+        /*! \brief Function to initialize the reader state common to all the stream sources
+         * \param [in] params Reader parameters
+         */
+        void InitReader(const RocdecBitstreamReaderParams *params);
+
+        /*! \brief Function to allocate the ring buffer, backed by huge pages if requested
+         * \return True if the ring is allocated
+         */
+        bool AllocateRing();
+
+        /*! \brief Function to double the ring buffer when a single NAL unit, OBU or IVF frame fills it. The data keeps its offsets up
+         * to the old ring end, the wrapped around part moves behind it. The read-ahead thread is stopped; it restarts at the next read.
+         * \return True if the ring has grown, false if it has the maximum size or can not be allocated
+         */
+        bool GrowRing();
+
+        /*! \brief Function to get the offset in the grown ring of an offset in the ring before GrowRing
+         * \param [in] offset The ring offset before the growth
+         * \param [in] old_ring_size The ring size before the growth
+         * \return The ring offset after the growth
+         */
+        int GetGrownRingOffset(int offset, uint32_t old_ring_size);
+
+        /*! \brief Function to move the picture span from the ring to the linear picture data buffer. The read pointer is moved to
+         * the span end, so the space of the span is given back to the ring.
+         */
+        void SpillPicData();
+
+        /*! \brief Function to hand the data read by the read-ahead thread over to the parsing thread. Waits for the thread if it
+         * has not read anything new yet.
+         * \return Number of bytes added to the ring
+         */
+        int FetchReadAheadData();
+
+        /*! \brief Function to compute the size of the next read of the read-ahead thread
+         * \return Number of bytes to read, 0 if less than a chunk can be read while the parsing thread still has data to fetch
+         */
+        int GetReadAheadSize();
+
+        /*! \brief Read-ahead thread function
+         * \param [in] file_offset File offset to read from
+         */
+        void ReadAheadWorker(uint64_t file_offset);
+
+        /*! \brief Function to wake up the parked read-ahead thread after the parsing thread moved its ring offsets
+         */
+        void WakeReadAheadWorker();
+
+        /*! \brief Function to wake up the parked parsing thread after the read-ahead thread read more data
+         */
+        void WakeReadAheadReader();
+
+        /*! \brief Function to stop the read-ahead thread
+         */
+        void StopReadAhead();
+
+        /*! \brief Function to get the stream offset of a ring offset that is not behind the read pointer
+         * \param [in] offset The ring offset
+         * \return The stream offset
+         */
+        uint64_t GetStreamOffset(int offset);
+
+        /*! \brief Function to restart reading at a stream offset. The ring buffer is emptied and the read-ahead thread is stopped;
+         * it restarts at the next read.
+         * \param [in] stream_offset Stream offset of the first picture to read, 0 for the stream start
+         * \param [in] pic_idx Index of the picture at the stream offset
+         */
+        void ResetReadPosition(uint64_t stream_offset, int pic_idx);
+
+        /*! \brief Function to append the picture returned by GetPicData to the picture index
+         * \param [in] p_pic_data Pointer to the picture data
+         * \param [in] pic_size Size of the picture in bytes
+         */
+        void AddPicIndexEntry(uint8_t *p_pic_data, int pic_size);
+
+        /*! \brief Function to get the picture type, key frame flag and parameter set flag of an AVC/HEVC picture from its NAL units
+         * \param [in] p_pic_data Pointer to the picture data
+         * \param [out] entry The index entry
+         */
+        void GetAvcHevcPicIndexInfo(uint8_t *p_pic_data, RocdecBitstreamPicIndexEntry *entry);
+
+        /*! \brief Function to get the picture type, key frame flag and parameter set flag of an AV1 temporal unit from its OBUs
+         * \param [in] p_pic_data Pointer to the temporal unit data
+         * \param [in] pic_size Size of the temporal unit in bytes
+         * \param [out] entry The index entry
+         */
+        void GetAv1PicIndexInfo(uint8_t *p_pic_data, int pic_size, RocdecBitstreamPicIndexEntry *entry);
+
+        /*! \brief Function to map the input file into memory
+         * \param [in] input_file_path Path of the bitstream file
+         * \return True if the file is mapped
+         */
+        bool MapInputFile(const char *input_file_path);
+
+        /*! \brief Function to move the window into the mapped file forward so that it starts at the given ring offset.
+         * All the ring offsets are adjusted.
+         * \param [in] offset The ring offset that becomes offset 0
+         */
+        void MoveMappedWindow(int offset);
+
+        /*! \brief Function to get the pointer to the picture data returned by <tt>GetPicData</tt>
+         * \return Pointer to the picture data
+         */
+        uint8_t *GetPicDataPtr() { return pic_in_ring_ ? &bs_ring_[pic_start_offset_] : pic_data_.data(); };
+
         /*! \brief Function to check the remaining data size in the ring buffer
          * \return Number of bytes still available in the ring
          */
         int GetDataSizeInRB();
 
+        /*! \brief Function to check the data size in the ring buffer from the given offset to the write pointer
+         * \param [in] offset The ring offset
+         * \return Number of bytes available from the offset
+         */
+        int GetDataSizeFrom(int offset);
+
         /*! \brief Function to read one byte from the ring buffer without advancing the read pointer
          * \param [in] offset The byte offset to read
          * \param [out] data The byte read
@@ -165,7 +434,7 @@ class RocVideoESParser {
          */
         void CheckAvcNalForSlice(int start_code_offset, int *slice_flag, int *first_slice_flag);
 
-        /*! \brief Function to copy a NAL unit from the bitstream ring buffer to the linear picture data buffer
+        /*! \brief Function to append a NAL unit from the bitstream ring buffer to the picture data
          */
         void CopyNalUnitFromRing();
 
@@ -175,7 +444,7 @@ class RocVideoESParser {
         */
         bool ReadObuHeaderAndSize(int *obu_type);
     
-        /*! \brief Function to copy an OBU from the bitstream ring buffer to the linear picture data buffer
+        /*! \brief Function to append an OBU from the bitstream ring buffer to the picture data
          * \return true if success
          */
         bool CopyObuFromRing();
@@ -204,14 +473,6 @@ class RocVideoESParser {
          */
         int CheckHevcEStream(uint8_t *p_stream, int stream_size);
 
-        /*! \brief Function to convert from Encapsulated Byte Sequence Packets to Raw Byte Sequence Payload
-        * \param [inout] stream_buffer A pointer of <tt>uint8_t</tt> for the converted RBSP buffer.
-        * \param [in] begin_bytepos Start position in the EBSP buffer to convert
-        * \param [in] end_bytepos End position in the EBSP buffer to convert, generally it's size.
-        * \return Returns the size of the converted buffer
-        */
-        int EbspToRbsp(uint8_t *stream_buffer, int begin_bytepos, int end_bytepos);
-
         /*! \brief Function to check the likelihood of a stream to be an AV1 elementary stream.
          * \param [in] p_stream Pointer to the stream
          * \param [in] stream_size Size of the stream in bytes
@@ -227,10 +488,8 @@ class RocVideoESParser {
         int CheckIvfAv1Stream(uint8_t *p_stream, int stream_size);
 
         /*! \brief Function to read variable length unsigned n-bit number appearing directly in the bitstream. 4.10.3. uvlc().
-        * \param [in] p_stream Bit stream pointer
-        * \param [in] bit_offset Starting bit offset
-        * \param [out] bit_offset Updated bit offset
+        * \param [in/out] bit_reader Bit reader of the input stream
         * \return The unsigned value
         */
-        uint32_t ReadUVLC(const uint8_t *p_stream, size_t &bit_offset);
+        uint32_t ReadUVLC(Parser::BitReader &bit_reader);
 };
\ No newline at end of file
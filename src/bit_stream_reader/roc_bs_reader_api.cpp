@@ -24,13 +24,13 @@ THE SOFTWARE.
 #include "bs_reader_handle.h"
 
 namespace rocdecode {
-rocDecStatus ROCDECAPI rocDecCreateBitstreamReader(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path) {
-    if (bs_reader_handle == nullptr || input_file_path == nullptr) {
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderWithParams(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path, RocdecBitstreamReaderParams *params) {
+    if (bs_reader_handle == nullptr || input_file_path == nullptr || params == nullptr) {
         return ROCDEC_INVALID_PARAMETER;
     }
     RocdecBitstreamReader handle = nullptr;
     try {
-        handle = new RocBitstreamReaderHandle(input_file_path);
+        handle = new RocBitstreamReaderHandle(input_file_path, params);
     } 
     catch (const std::exception& e) {
         ERR( STR("Failed to create RocBitstreamReader handle, ") + STR(e.what()))
@@ -40,6 +40,45 @@ rocDecStatus ROCDECAPI rocDecCreateBitstreamReader(RocdecBitstreamReader *bs_rea
     return ROCDEC_SUCCESS;
 }
 
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromMemory(RocdecBitstreamReader *bs_reader_handle, const uint8_t *data, size_t size, RocdecBitstreamReaderParams *params) {
+    if (bs_reader_handle == nullptr || data == nullptr || size == 0) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    RocdecBitstreamReaderParams default_params = {};
+    RocdecBitstreamReader handle = nullptr;
+    try {
+        handle = new RocBitstreamReaderHandle(data, size, params ? params : &default_params);
+    }
+    catch (const std::exception& e) {
+        ERR( STR("Failed to create RocBitstreamReader handle, ") + STR(e.what()))
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    *bs_reader_handle = handle;
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReaderFromCallback(RocdecBitstreamReader *bs_reader_handle, PFNBITSTREAMREADCALLBACK pfn_read, void *user_data, RocdecBitstreamReaderParams *params) {
+    if (bs_reader_handle == nullptr || pfn_read == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    RocdecBitstreamReaderParams default_params = {};
+    RocdecBitstreamReader handle = nullptr;
+    try {
+        handle = new RocBitstreamReaderHandle(pfn_read, user_data, params ? params : &default_params);
+    }
+    catch (const std::exception& e) {
+        ERR( STR("Failed to create RocBitstreamReader handle, ") + STR(e.what()))
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    *bs_reader_handle = handle;
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus ROCDECAPI rocDecCreateBitstreamReader(RocdecBitstreamReader *bs_reader_handle, const char *input_file_path) {
+    RocdecBitstreamReaderParams params = {};
+    return rocdecode::rocDecCreateBitstreamReaderWithParams(bs_reader_handle, input_file_path, &params);
+}
+
 rocDecStatus ROCDECAPI rocDecGetBitstreamCodecType(RocdecBitstreamReader bs_reader_handle, rocDecVideoCodec *codec_type) {
     if (bs_reader_handle == nullptr || codec_type == nullptr) {
         return ROCDEC_INVALID_PARAMETER;
@@ -91,6 +130,125 @@ rocDecStatus ROCDECAPI rocDecGetBitstreamPicData(RocdecBitstreamReader bs_reader
     return ret;
 }
 
+rocDecStatus ROCDECAPI rocDecGetBitstreamNalUnitIndex(RocdecBitstreamReader bs_reader_handle, const RocdecNalUnitInfo **nal_units, int *num_nal_units) {
+    if (bs_reader_handle == nullptr || nal_units == nullptr || num_nal_units == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_bs_reader_handle = static_cast<RocBitstreamReaderHandle*>(bs_reader_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_bs_reader_handle->GetBitstreamNalUnitIndex(nal_units, num_nal_units);
+    }
+    catch (const std::exception& e) {
+        roc_bs_reader_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+rocDecStatus ROCDECAPI rocDecGetBitstreamReaderStats(RocdecBitstreamReader bs_reader_handle, RocdecBitstreamReaderStats *stats) {
+    if (bs_reader_handle == nullptr || stats == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_bs_reader_handle = static_cast<RocBitstreamReaderHandle*>(bs_reader_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_bs_reader_handle->GetBitstreamReaderStats(stats);
+    }
+    catch (const std::exception& e) {
+        roc_bs_reader_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+rocDecStatus ROCDECAPI rocDecBuildBitstreamIndex(RocdecBitstreamReader bs_reader_handle) {
+    if (bs_reader_handle == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_bs_reader_handle = static_cast<RocBitstreamReaderHandle*>(bs_reader_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_bs_reader_handle->BuildBitstreamIndex();
+    }
+    catch (const std::exception& e) {
+        roc_bs_reader_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+rocDecStatus ROCDECAPI rocDecSaveBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path) {
+    if (bs_reader_handle == nullptr || index_file_path == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_bs_reader_handle = static_cast<RocBitstreamReaderHandle*>(bs_reader_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_bs_reader_handle->SaveBitstreamIndex(index_file_path);
+    }
+    catch (const std::exception& e) {
+        roc_bs_reader_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+rocDecStatus ROCDECAPI rocDecLoadBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const char *index_file_path) {
+    if (bs_reader_handle == nullptr || index_file_path == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_bs_reader_handle = static_cast<RocBitstreamReaderHandle*>(bs_reader_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_bs_reader_handle->LoadBitstreamIndex(index_file_path);
+    }
+    catch (const std::exception& e) {
+        roc_bs_reader_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+rocDecStatus ROCDECAPI rocDecGetBitstreamIndex(RocdecBitstreamReader bs_reader_handle, const RocdecBitstreamPicIndexEntry **entries, int *num_entries) {
+    if (bs_reader_handle == nullptr || entries == nullptr || num_entries == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_bs_reader_handle = static_cast<RocBitstreamReaderHandle*>(bs_reader_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_bs_reader_handle->GetBitstreamIndex(entries, num_entries);
+    }
+    catch (const std::exception& e) {
+        roc_bs_reader_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+rocDecStatus ROCDECAPI rocDecSeekBitstream(RocdecBitstreamReader bs_reader_handle, int pic_idx, uint32_t flags, int *seek_pic_idx) {
+    if (bs_reader_handle == nullptr || pic_idx < 0) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_bs_reader_handle = static_cast<RocBitstreamReaderHandle*>(bs_reader_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_bs_reader_handle->SeekBitstream(pic_idx, flags, seek_pic_idx);
+    }
+    catch (const std::exception& e) {
+        roc_bs_reader_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
 rocDecStatus ROCDECAPI rocDecDestroyBitstreamReader(RocdecBitstreamReader bs_reader_handle) {
     if (bs_reader_handle == nullptr) {
         return ROCDEC_INVALID_PARAMETER;
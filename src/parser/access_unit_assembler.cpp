@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <string.h>
+#include <algorithm>
+#include "access_unit_assembler.h"
+#include "nal_unit_index.h"
+#include "start_code_scanner.h"
+
+namespace Parser {
+
+void AccessUnitAssembler::Clear() {
+    buffer_.clear();
+    au_start_ = 0;
+    scan_offset_ = 0;
+    nal_start_ = SIZE_MAX;
+    nal_checked_ = false;
+    nal_is_slice_ = false;
+    last_slice_end_ = 0;
+    num_slices_ = 0;
+    nal_units_.clear();
+    chunks_.clear();
+}
+
+void AccessUnitAssembler::Append(const uint8_t *data, size_t size, bool pts_valid, RocdecTimeStamp pts) {
+    // Move the pending access unit to the front of the buffer
+    if (au_start_ > 0) {
+        size_t remaining_size = buffer_.size() - au_start_;
+        if (remaining_size) {
+            memmove(buffer_.data(), buffer_.data() + au_start_, remaining_size);
+        }
+        buffer_.resize(remaining_size);
+        scan_offset_ -= au_start_;
+        if (nal_start_ != SIZE_MAX) {
+            nal_start_ -= au_start_;
+        }
+        last_slice_end_ = last_slice_end_ > au_start_ ? last_slice_end_ - au_start_ : 0;
+        for (auto &nal_unit : nal_units_) {
+            nal_unit.offset -= au_start_;
+        }
+        // Keep the chunk in which the pending access unit starts
+        size_t i = 0;
+        while (i + 1 < chunks_.size() && chunks_[i + 1].offset <= au_start_) {
+            i++;
+        }
+        chunks_.erase(chunks_.begin(), chunks_.begin() + i);
+        for (auto &chunk : chunks_) {
+            chunk.offset = chunk.offset > au_start_ ? chunk.offset - au_start_ : 0;
+        }
+        au_start_ = 0;
+    }
+    if (size == 0) {
+        return;
+    }
+    chunks_.push_back({buffer_.size(), pts_valid, pts});
+    buffer_.insert(buffer_.end(), data, data + size);
+}
+
+bool AccessUnitAssembler::CheckNalForSlice(bool *first_slice) {
+    // The flag is the first bit after the NAL unit header: first_slice_segment_in_pic_flag for HEVC and, as ue(v) of 0 is
+    // coded as a single 1 bit, first_mb_in_slice equal to 0 for AVC.
+    size_t header_size = codec_type_ == rocDecVideoCodec_HEVC ? 2 : 1;
+    if (nal_start_ + 3 + header_size >= buffer_.size()) {
+        return false;
+    }
+    const uint8_t *header = &buffer_[nal_start_ + 3];
+    if (codec_type_ == rocDecVideoCodec_HEVC) {
+        uint8_t nal_unit_type = (header[0] >> 1) & 0x3F;
+        nal_is_slice_ = nal_unit_type <= 9 || (nal_unit_type >= 16 && nal_unit_type <= 21);
+    } else {
+        uint8_t nal_unit_type = header[0] & 0x1F;
+        nal_is_slice_ = nal_unit_type >= 1 && nal_unit_type <= 5;
+    }
+    *first_slice = nal_is_slice_ && (header[header_size] & 0x80);
+    return true;
+}
+
+void AccessUnitAssembler::TakeAccessUnit(AccessUnit &au, size_t end) {
+    au.data = buffer_.data() + au_start_;
+    au.size = end - au_start_;
+    au_nal_units_.clear();
+    size_t num_au_nal_units = 0;
+    while (num_au_nal_units < nal_units_.size() && nal_units_[num_au_nal_units].offset < end) {
+        RocdecNalUnitInfo nal_unit = nal_units_[num_au_nal_units];
+        nal_unit.offset -= au_start_;
+        au_nal_units_.push_back(nal_unit);
+        num_au_nal_units++;
+    }
+    nal_units_.erase(nal_units_.begin(), nal_units_.begin() + num_au_nal_units);
+    au.nal_units = au_nal_units_.data();
+    au.num_nal_units = au_nal_units_.size();
+
+    au.pts_valid = false;
+    au.pts = 0;
+    for (auto &chunk : chunks_) {
+        if (chunk.offset > au_start_) {
+            break;
+        }
+        au.pts_valid = chunk.pts_valid;
+        au.pts = chunk.pts;
+    }
+    au_start_ = end;
+    num_slices_ = 0;
+}
+
+bool AccessUnitAssembler::GetAccessUnit(AccessUnit &au, bool flush) {
+    while (true) {
+        if (nal_start_ == SIZE_MAX) {
+            // Bytes before the first start code are dropped
+            size_t start_code_offset = scan_offset_ + ScanStartCode(buffer_.data() + scan_offset_, buffer_.size() - scan_offset_);
+            if (start_code_offset >= buffer_.size()) {
+                // A start code may be split between this chunk and the next one
+                scan_offset_ = buffer_.size() > 2 ? buffer_.size() - 2 : 0;
+                au_start_ = scan_offset_;
+                last_slice_end_ = au_start_;
+                break;
+            }
+            nal_start_ = start_code_offset;
+            nal_checked_ = false;
+            scan_offset_ = nal_start_ + 3;
+            au_start_ = nal_start_;
+            last_slice_end_ = au_start_;
+        }
+        if (!nal_checked_) {
+            bool first_slice;
+            if (!CheckNalForSlice(&first_slice)) {
+                break;
+            }
+            nal_checked_ = true;
+            if (nal_is_slice_) {
+                bool au_complete = first_slice && num_slices_ > 0;
+                if (au_complete) {
+                    TakeAccessUnit(au, last_slice_end_);
+                }
+                num_slices_++;
+                if (au_complete) {
+                    return true;
+                }
+            }
+        }
+        // The NAL unit ends at the next start code
+        size_t next_start_code_offset = scan_offset_ + ScanStartCode(buffer_.data() + scan_offset_, buffer_.size() - scan_offset_);
+        if (next_start_code_offset >= buffer_.size()) {
+            scan_offset_ = std::max(nal_start_ + 3, buffer_.size() - 2);
+            break;
+        }
+        nal_units_.push_back(MakeNalUnitInfo(buffer_.data(), nal_start_, next_start_code_offset - nal_start_, codec_type_));
+        if (nal_is_slice_) {
+            last_slice_end_ = next_start_code_offset;
+        }
+        nal_start_ = next_start_code_offset;
+        nal_checked_ = false;
+        scan_offset_ = nal_start_ + 3;
+    }
+
+    if (flush && nal_start_ != SIZE_MAX) {
+        // The last NAL unit ends at the end of the buffer
+        if (!nal_checked_) {
+            bool first_slice;
+            if (!CheckNalForSlice(&first_slice)) {
+                nal_is_slice_ = false;
+            }
+            if (nal_is_slice_ && first_slice && num_slices_ > 0) {
+                TakeAccessUnit(au, last_slice_end_);
+                nal_checked_ = true;
+                num_slices_++;
+                return true;
+            }
+            if (nal_is_slice_) {
+                num_slices_++;
+            }
+        }
+        nal_units_.push_back(MakeNalUnitInfo(buffer_.data(), nal_start_, buffer_.size() - nal_start_, codec_type_));
+        nal_start_ = SIZE_MAX;
+        scan_offset_ = buffer_.size();
+        TakeAccessUnit(au, buffer_.size());
+        return true;
+    }
+    return false;
+}
+
+}
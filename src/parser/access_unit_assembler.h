@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "rocparser.h"
+
+namespace Parser {
+    /*! \brief Assembler of AVC/HEVC access units from arbitrary chunks of an Annex B byte stream
+     *
+     * The chunks are appended to a reusable buffer and scanned for start codes once. An access unit ends before the first
+     * slice of the next picture (first_slice_segment_in_pic_flag or first_mb_in_slice equal to 0). Non-slice NAL units
+     * between the last slice of a picture and the first slice of the next one belong to the next access unit. A NAL unit
+     * index of each access unit is built along the way, so the parser does not have to scan it again.
+     */
+    class AccessUnitAssembler {
+    public:
+        typedef struct {
+            const uint8_t *data;                           // access unit data, valid until the next call of Append or Clear
+            uint32_t size;                                 // size of the access unit in bytes
+            const RocdecNalUnitInfo *nal_units;            // NAL unit index of the access unit
+            uint32_t num_nal_units;
+            bool pts_valid;                                // the chunk in which the access unit starts has a timestamp
+            RocdecTimeStamp pts;                           // timestamp of the chunk in which the access unit starts
+        } AccessUnit;
+
+        AccessUnitAssembler() : codec_type_(rocDecVideoCodec_HEVC) { Clear(); };
+
+        /*! \brief Function to set the codec of the stream
+         * \param [in] codec_type <tt>rocDecVideoCodec_AVC</tt> or <tt>rocDecVideoCodec_HEVC</tt>
+         */
+        void SetCodec(rocDecVideoCodec codec_type) { codec_type_ = codec_type; };
+
+        /*! \brief Function to append a chunk of the byte stream. The access units returned before are dropped from the buffer.
+         * \param [in] data Pointer to the chunk
+         * \param [in] size Size of the chunk in bytes
+         * \param [in] pts_valid The chunk has a timestamp
+         * \param [in] pts Timestamp of the chunk
+         */
+        void Append(const uint8_t *data, size_t size, bool pts_valid, RocdecTimeStamp pts);
+
+        /*! \brief Function to take the next complete access unit from the buffer
+         * \param [out] au The access unit
+         * \param [in] flush The buffered data ends an access unit, e.g. at the end of a picture or of the stream
+         * \return true if an access unit is returned
+         */
+        bool GetAccessUnit(AccessUnit &au, bool flush);
+
+        /*! \brief Function to drop all buffered data
+         */
+        void Clear();
+
+    private:
+        typedef struct {
+            size_t offset;          // offset of the first byte of the chunk in buffer_
+            bool pts_valid;
+            RocdecTimeStamp pts;
+        } ChunkInfo;
+
+        rocDecVideoCodec codec_type_;
+        std::vector<uint8_t> buffer_;
+        size_t au_start_;           // offset of the pending access unit in buffer_
+        size_t scan_offset_;        // offset to continue the start code search from
+        size_t nal_start_;          // offset of the start code of the NAL unit whose end is not known yet, SIZE_MAX if none
+        bool nal_checked_;          // the slice check of the NAL unit at nal_start_ is done
+        bool nal_is_slice_;
+        size_t last_slice_end_;     // end offset of the last complete slice NAL unit of the pending access unit
+        uint32_t num_slices_;       // number of slices of the pending access unit
+        std::vector<RocdecNalUnitInfo> nal_units_;  // complete NAL units from au_start_ on, offsets relative to buffer_
+        std::vector<RocdecNalUnitInfo> au_nal_units_;  // NAL unit index of the returned access unit
+        std::vector<ChunkInfo> chunks_;
+
+        /*! \brief Function to check if the NAL unit at nal_start_ is a slice and the first slice of a picture
+         * \param [out] first_slice First slice indicator
+         * \return false if the buffer does not hold enough bytes of the NAL unit yet
+         */
+        bool CheckNalForSlice(bool *first_slice);
+
+        /*! \brief Function to fill the returned access unit with the data from au_start_ to end and start a new one at end
+         * \param [out] au The access unit
+         * \param [in] end End offset of the access unit in buffer_
+         */
+        void TakeAccessUnit(AccessUnit &au, size_t end);
+    };
+}
@@ -25,6 +25,9 @@ THE SOFTWARE.
 
 Av1VideoParser::Av1VideoParser() {
     seen_frame_header_ = 0;
+    skip_curr_frame_ = false;
+    temporal_id_ = 0;
+    spatial_id_ = 0;
     tile_param_list_.assign(INIT_SLICE_LIST_NUM, {0});
     memset(&curr_pic_, 0, sizeof(Av1Picture));
     memset(&dpb_buffer_, 0, sizeof(DecodedPictureBuffer));
@@ -54,7 +57,29 @@ rocDecStatus Av1VideoParser::UnInitialize() {
     return ROCDEC_SUCCESS;
 }
 
+rocDecStatus Av1VideoParser::Reset(uint32_t flags) {
+    if ((flags & ROCDEC_PARSER_RESET_FLUSH) && FlushDpb() != PARSER_OK) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    // The reference frames and their order hints are refilled by the next key frame
+    InitDpb();
+    seen_frame_header_ = 0;
+    skip_curr_frame_ = false;
+    memset(&frame_header_, 0, sizeof(Av1FrameHeader));
+    memset(&tile_group_data_, 0, sizeof(Av1TileGroupDataInfo));
+    memset(&curr_pic_, 0, sizeof(Av1Picture));
+    tile_param_list_.assign(tile_param_list_.size(), {0});
+    if (!(flags & ROCDEC_PARSER_RESET_KEEP_PARAM_SETS)) {
+        memset(&seq_header_, 0, sizeof(Av1SequenceHeader));
+    }
+    return RocVideoParser::Reset(flags);
+}
+
 rocDecStatus Av1VideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) { 
+    // A discontinuity, e.g. after a splice or a seek: output the pending pictures, then drop the reference state
+    if ((p_data->flags & ROCDEC_PKT_DISCONTINUITY) && Reset(ROCDEC_PARSER_RESET_FLUSH | ROCDEC_PARSER_RESET_KEEP_PARAM_SETS) != ROCDEC_SUCCESS) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
     if (p_data->payload && p_data->payload_size) {
         curr_pts_ = p_data->pts;
         if (ParsePictureData(p_data->payload, p_data->payload_size) != PARSER_OK) {
@@ -80,6 +105,9 @@ ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
     curr_byte_offset_ = 0;
 
     while (ReadObuHeaderAndSize() != PARSER_EOF) {
+        if (IsObuDropped()) {
+            continue;
+        }
         switch (obu_header_.obu_type) {
             case kObuTemporalDelimiter: {
                 seen_frame_header_ = 0;
@@ -155,21 +183,27 @@ ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                 } else {
                     disp_idx = dpb_buffer_.frame_store[disp_idx].dec_buf_idx;
                 }
-                decode_buffer_pool_[disp_idx].use_status |= kFrameUsedForDisplay;
+                SetDecBufUseStatus(disp_idx, kFrameUsedForDisplay);
                 decode_buffer_pool_[disp_idx].pts = curr_pts_;
                 // Insert into output/display picture list
                 if (num_output_pics_ >= dec_buf_pool_size_) {
                     ERR("Display list size larger than decode buffer pool size!");
                     return PARSER_OUT_OF_RANGE;
                 } else {
-                    output_pic_list_[num_output_pics_] = disp_idx;
-                    num_output_pics_++;
+                    AddOutputPicture(disp_idx);
                 }
             }
             if ((ret = DecodeFrameWrapup()) != PARSER_OK) {
                 return ret;
             }
         } else if (tile_group_data_.num_tiles_parsed && tile_group_data_.num_tiles_parsed == tile_group_data_.num_tiles) {
+            if (IsNonRefPicDropped() && frame_header_.refresh_frame_flags == 0) {
+                // The frame does not update any reference frame: drop it
+                CountDroppedNonRefPic();
+                memset(&tile_group_data_, 0, sizeof(Av1TileGroupDataInfo));
+                memset(&frame_header_, 0, sizeof(Av1FrameHeader));
+                continue;
+            }
             if ((ret = FindFreeInDecBufPool()) != PARSER_OK) {
                 return ret;
             }
@@ -187,6 +221,10 @@ ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                 return ret;
             }
             CheckAndUpdateDecStatus();
+            // Keyframe only: output the frame right away
+            if (parser_params_.keyframe_only && (ret = FlushDpb()) != PARSER_OK) {
+                return ret;
+            }
         }
     };
     return PARSER_OK;
@@ -235,14 +273,7 @@ ParserResult Av1VideoParser::NotifyNewSequence(Av1SequenceHeader *p_seq_header,
     video_format_params_.seqhdr_data_length = 0;
 
     // callback function with RocdecVideoFormat params filled out
-    if (pfn_sequece_cb_(parser_params_.user_data, &video_format_params_) == 0) {
-        ERR("Sequence callback function failed.");
-        return PARSER_FAIL;
-    } else {
-        return PARSER_OK;
-    }
-    
-    return PARSER_OK;
+    return ReportVideoFormat();
 }
 
 ParserResult Av1VideoParser::SendPicForDecode() {
@@ -265,6 +296,16 @@ ParserResult Av1VideoParser::SendPicForDecode() {
     dec_pic_params_.ref_pic_flag = 1;
     dec_pic_params_.intra_pic_flag = p_frame_header->frame_is_intra;
 
+    if (parser_params_.header_only) {
+        RocdecParsedPicInfo pic_info = {};
+        pic_info.pic_type = p_frame_header->frame_is_intra ? ROCDEC_PIC_TYPE_I : ROCDEC_PIC_TYPE_P;
+        pic_info.pic_order_cnt = p_frame_header->order_hint;
+        pic_info.qp = p_frame_header->quantization_params.base_q_idx;
+        pic_info.ref_pic_flag = p_frame_header->refresh_frame_flags ? 1 : 0;
+        pic_info.key_frame_flag = (p_frame_header->frame_type == kKeyFrame && p_frame_header->show_frame) ? 1 : 0;
+        return OutputParsedPicture(&pic_info);
+    }
+
     // Set up the picture parameter buffer
     RocdecAv1PicParams *p_pic_param = &dec_pic_params_.pic_params.av1;
     p_pic_param->profile = p_seq_header->seq_profile;
@@ -572,9 +613,10 @@ ParserResult Av1VideoParser::DecodeFrameWrapup() {
     PrintDpb();
 #endif // DBGINFO
 
-    // Output decoded pictures from DPB if any are ready
+    // Output decoded pictures from DPB if any are ready. Shown frames are in output order, with zero_reorder_output they
+    // are displayed right away.
     if (pfn_display_picture_cb_ && num_output_pics_ > 0) {
-        if ((ret = OutputDecodedPictures(false)) != PARSER_OK) {
+        if ((ret = OutputDecodedPictures(parser_params_.zero_reorder_output)) != PARSER_OK) {
             return ret;
         }
     }
@@ -607,32 +649,24 @@ ParserResult Av1VideoParser::FlushDpb() {
 ParserResult Av1VideoParser::FindFreeInDecBufPool() {
     int dec_buf_index;
     // Find a free buffer in decode/display buffer pool to store the decoded image
-    for (dec_buf_index = 0; dec_buf_index < dec_buf_pool_size_; dec_buf_index++) {
-        if (decode_buffer_pool_[dec_buf_index].use_status == kNotUsed) {
-            break;
-        }
-    }
-    if (dec_buf_index == dec_buf_pool_size_) {
+    dec_buf_index = GetFreeDecBufIndex();
+    if (dec_buf_index < 0) {
         ERR("Could not find a free buffer in decode buffer pool for decoded image.");
         return PARSER_NOT_FOUND;
     }
     curr_pic_.dec_buf_idx = dec_buf_index;
-    decode_buffer_pool_[dec_buf_index].use_status |= kFrameUsedForDecode;
+    SetDecBufUseStatus(dec_buf_index, kFrameUsedForDecode);
     decode_buffer_pool_[dec_buf_index].pic_order_cnt = curr_pic_.order_hint;
     decode_buffer_pool_[dec_buf_index].pts = curr_pts_;
     // Find a free buffer in decode/display buffer pool to store FG output
     if (seq_header_.film_grain_params_present && frame_header_.film_grain_params.apply_grain) {
-        for (dec_buf_index = 0; dec_buf_index < dec_buf_pool_size_; dec_buf_index++) {
-            if (decode_buffer_pool_[dec_buf_index].use_status == kNotUsed) {
-                break;
-            }
-        }
-        if (dec_buf_index == dec_buf_pool_size_) {
+        dec_buf_index = GetFreeDecBufIndex();
+        if (dec_buf_index < 0) {
             ERR("Could not find a free buffer in decode buffer pool for FG output.");
             return PARSER_NOT_FOUND;
         }
         curr_pic_.fg_buf_idx = dec_buf_index;
-        decode_buffer_pool_[dec_buf_index].use_status |= kFrameUsedForDisplay;
+        SetDecBufUseStatus(dec_buf_index, kFrameUsedForDisplay);
         decode_buffer_pool_[dec_buf_index].pic_order_cnt = curr_pic_.order_hint;
         decode_buffer_pool_[dec_buf_index].pts = curr_pts_;
     } else {
@@ -664,15 +698,14 @@ ParserResult Av1VideoParser::FindFreeInDpbAndMark() {
         } else {
             disp_idx = curr_pic_.dec_buf_idx;
         }
-        decode_buffer_pool_[disp_idx].use_status |= kFrameUsedForDisplay;
+        SetDecBufUseStatus(disp_idx, kFrameUsedForDisplay);
         decode_buffer_pool_[disp_idx].pts = curr_pts_;
         // Insert into output/display picture list
         if (num_output_pics_ >= dec_buf_pool_size_) {
             ERR("Display list size larger than decode buffer pool size!");
             return PARSER_OUT_OF_RANGE;
         } else {
-            output_pic_list_[num_output_pics_] = disp_idx;
-            num_output_pics_++;
+            AddOutputPicture(disp_idx);
         }
     }
 
@@ -683,48 +716,95 @@ void Av1VideoParser::CheckAndUpdateDecStatus() {
     for (int i = 0; i < BUFFER_POOL_MAX_SIZE; i++) {
         if (dpb_buffer_.frame_store[i].use_status != kNotUsed && dpb_buffer_.dec_ref_count[i] == 0) {
             dpb_buffer_.frame_store[i].use_status = kNotUsed;
-            decode_buffer_pool_[dpb_buffer_.frame_store[i].dec_buf_idx].use_status &= ~kFrameUsedForDecode;
+            ClearDecBufUseStatus(dpb_buffer_.frame_store[i].dec_buf_idx, kFrameUsedForDecode);
         }
     }
 }
 
-ParserResult Av1VideoParser::ParseObuHeader(const uint8_t *p_stream) {
-    size_t offset = 0;
+ParserResult Av1VideoParser::ParseObuHeader(const uint8_t *p_stream, size_t size) {
+    Parser::BitReader bit_reader(p_stream, size);
     obu_header_.size = 1;
-    if (Parser::GetBit(p_stream, offset) != 0) {
+    if (bit_reader.GetBit() != 0) {
         ERR("Syntax error: obu_forbidden_bit must be set to 0.");
         return PARSER_INVALID_ARG;
     }
-    obu_header_.obu_type = Parser::ReadBits(p_stream, offset, 4);
-    obu_header_.obu_extension_flag = Parser::GetBit(p_stream, offset);
-    obu_header_.obu_has_size_field = Parser::GetBit(p_stream, offset);
+    obu_header_.obu_type = bit_reader.ReadBits(4);
+    obu_header_.obu_extension_flag = bit_reader.GetBit();
+    obu_header_.temporal_id = 0;
+    obu_header_.spatial_id = 0;
+    obu_header_.obu_has_size_field = bit_reader.GetBit();
     if (!obu_header_.obu_has_size_field) {
         ERR("Syntax error: Section 5.2: obu_has_size_field must be equal to 1.");
         return PARSER_INVALID_ARG;
     }
-    if (Parser::GetBit(p_stream, offset) != 0) {
+    if (bit_reader.GetBit() != 0) {
         ERR("Syntax error: obu_reserved_1bit must be set to 0.");
         return PARSER_INVALID_ARG;
     }
     if (obu_header_.obu_extension_flag) {
         obu_header_.size += 1;
-        obu_header_.temporal_id = Parser::ReadBits(p_stream, offset, 3);
-        obu_header_.spatial_id = Parser::ReadBits(p_stream, offset, 2);
-        if (Parser::ReadBits(p_stream, offset, 3) != 0) {
+        obu_header_.temporal_id = bit_reader.ReadBits(3);
+        obu_header_.spatial_id = bit_reader.ReadBits(2);
+        if (bit_reader.ReadBits(3) != 0) {
             ERR("Syntax error: extension_header_reserved_3bits must be set to 0.\n");
         return PARSER_INVALID_ARG;
         }
     }
+    temporal_id_ = obu_header_.temporal_id;
+    spatial_id_ = obu_header_.spatial_id;
     return PARSER_OK;
 }
 
+bool Av1VideoParser::IsObuDropped() {
+    if (parser_params_.keyframe_only) {
+        // Drop the frame header and tile group OBUs of all frames other than key frames
+        switch (obu_header_.obu_type) {
+            case kObuTemporalDelimiter:
+                skip_curr_frame_ = false;
+                break;
+            case kObuFrameHeader:
+            case kObuFrame:
+                skip_curr_frame_ = !IsKeyFrame(pic_data_buffer_ptr_ + obu_byte_offset_, obu_size_);
+                if (skip_curr_frame_) {
+                    return true;
+                }
+                break;
+            case kObuRedundantFrameHeader:
+            case kObuTileGroup:
+                if (skip_curr_frame_) {
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (!obu_header_.obu_extension_flag || obu_header_.obu_type == kObuSequenceHeader || obu_header_.obu_type == kObuTemporalDelimiter) {
+        return false;
+    }
+    if (parser_params_.max_temporal_id_plus1 && obu_header_.temporal_id + 1 > parser_params_.max_temporal_id_plus1) {
+        return true;
+    }
+    // 7.5: Drop the OBUs not in the selected operating point
+    uint32_t op = parser_params_.operating_point <= seq_header_.operating_points_cnt_minus_1 ? parser_params_.operating_point : 0;
+    uint32_t op_pt_idc = seq_header_.operating_point_idc[op];
+    if (op_pt_idc != 0) {
+        uint32_t in_temporal_layer = (op_pt_idc >> obu_header_.temporal_id) & 1;
+        uint32_t in_spatial_layer = (op_pt_idc >> (obu_header_.spatial_id + 8)) & 1;
+        if (!in_temporal_layer || !in_spatial_layer) {
+            return true;
+        }
+    }
+    return false;
+}
+
 ParserResult Av1VideoParser::ReadObuHeaderAndSize() {
     ParserResult ret = PARSER_OK;
     if (curr_byte_offset_ >= pic_data_size_) {
         return PARSER_EOF;
     }
     uint8_t *p_stream = pic_data_buffer_ptr_ + curr_byte_offset_;
-    if ((ret = ParseObuHeader(p_stream)) != PARSER_OK) {
+    if ((ret = ParseObuHeader(p_stream, pic_data_size_ - curr_byte_offset_)) != PARSER_OK) {
         return ret;
     }
     curr_byte_offset_ += obu_header_.size;
@@ -739,12 +819,12 @@ ParserResult Av1VideoParser::ReadObuHeaderAndSize() {
 
 void Av1VideoParser::ParseSequenceHeaderObu(uint8_t *p_stream, size_t size) {
     Av1SequenceHeader *p_seq_header = &seq_header_;
-    size_t offset = 0;  // current bit offset
+    Parser::BitReader bit_reader(p_stream, size);
 
     memset(p_seq_header, 0, sizeof(Av1SequenceHeader));
-    p_seq_header->seq_profile = Parser::ReadBits(p_stream, offset, 3);
-    p_seq_header->still_picture = Parser::GetBit(p_stream, offset);
-    p_seq_header->reduced_still_picture_header = Parser::GetBit(p_stream, offset);
+    p_seq_header->seq_profile = bit_reader.ReadBits(3);
+    p_seq_header->still_picture = bit_reader.GetBit();
+    p_seq_header->reduced_still_picture_header = bit_reader.GetBit();
 
     if (p_seq_header->reduced_still_picture_header) {
         p_seq_header->timing_info_present_flag = 0;
@@ -752,58 +832,58 @@ void Av1VideoParser::ParseSequenceHeaderObu(uint8_t *p_stream, size_t size) {
         p_seq_header->initial_display_delay_present_flag = 0;
         p_seq_header->operating_points_cnt_minus_1 = 0;
         p_seq_header->operating_point_idc[0] = 0;
-        p_seq_header->seq_level_idx[0] = Parser::ReadBits(p_stream, offset, 5);
+        p_seq_header->seq_level_idx[0] = bit_reader.ReadBits(5);
         p_seq_header->seq_tier[0] = 0;
         p_seq_header->decoder_model_present_for_this_op[0] = 0;
         p_seq_header->initial_display_delay_present_for_this_op[0] = 0;
     } else {
-        p_seq_header->timing_info_present_flag = Parser::GetBit(p_stream, offset);
+        p_seq_header->timing_info_present_flag = bit_reader.GetBit();
         if (p_seq_header->timing_info_present_flag) {
             // timing_info()
-            p_seq_header->timing_info.num_units_in_display_tick = Parser::ReadBits(p_stream, offset, 32);
-            p_seq_header->timing_info.time_scale = Parser::ReadBits(p_stream, offset, 32);
-            p_seq_header->timing_info.equal_picture_interval = Parser::GetBit(p_stream, offset);
+            p_seq_header->timing_info.num_units_in_display_tick = bit_reader.ReadBits(32);
+            p_seq_header->timing_info.time_scale = bit_reader.ReadBits(32);
+            p_seq_header->timing_info.equal_picture_interval = bit_reader.GetBit();
             if (p_seq_header->timing_info.equal_picture_interval) {
-                p_seq_header->timing_info.num_ticks_per_picture_minus_1 = ReadUVLC(p_stream, offset);
+                p_seq_header->timing_info.num_ticks_per_picture_minus_1 = ReadUVLC(bit_reader);
             }
 
-            p_seq_header->decoder_model_info_present_flag = Parser::GetBit(p_stream, offset);
+            p_seq_header->decoder_model_info_present_flag = bit_reader.GetBit();
             if (p_seq_header->decoder_model_info_present_flag) {
-                p_seq_header->decoder_model_info.buffer_delay_length_minus_1 = Parser::ReadBits(p_stream, offset, 5);
-                p_seq_header->decoder_model_info.num_units_in_decoding_tick = Parser::ReadBits(p_stream, offset, 32);
-                p_seq_header->decoder_model_info.buffer_removal_time_length_minus_1 = Parser::ReadBits(p_stream, offset, 5);
-                p_seq_header->decoder_model_info.frame_presentation_time_length_minus_1 = Parser::ReadBits(p_stream, offset, 5);
+                p_seq_header->decoder_model_info.buffer_delay_length_minus_1 = bit_reader.ReadBits(5);
+                p_seq_header->decoder_model_info.num_units_in_decoding_tick = bit_reader.ReadBits(32);
+                p_seq_header->decoder_model_info.buffer_removal_time_length_minus_1 = bit_reader.ReadBits(5);
+                p_seq_header->decoder_model_info.frame_presentation_time_length_minus_1 = bit_reader.ReadBits(5);
             }
         } else {
             p_seq_header->decoder_model_info_present_flag = 0;
         }
 
-        p_seq_header->initial_display_delay_present_flag = Parser::GetBit(p_stream, offset);
-        p_seq_header->operating_points_cnt_minus_1 = Parser::ReadBits(p_stream, offset, 5);
+        p_seq_header->initial_display_delay_present_flag = bit_reader.GetBit();
+        p_seq_header->operating_points_cnt_minus_1 = bit_reader.ReadBits(5);
         for (int i = 0; i < p_seq_header->operating_points_cnt_minus_1 + 1; i++) {
-            p_seq_header->operating_point_idc[i] = Parser::ReadBits(p_stream, offset, 12);
-            p_seq_header->seq_level_idx[i] = Parser::ReadBits(p_stream, offset, 5);
+            p_seq_header->operating_point_idc[i] = bit_reader.ReadBits(12);
+            p_seq_header->seq_level_idx[i] = bit_reader.ReadBits(5);
             if (p_seq_header->seq_level_idx[i] > 7) {
-                p_seq_header->seq_tier[i] = Parser::GetBit(p_stream, offset);
+                p_seq_header->seq_tier[i] = bit_reader.GetBit();
             } else {
                 p_seq_header->seq_tier[i] = 0;
             }
 
             if (p_seq_header->decoder_model_info_present_flag) {
-                p_seq_header->decoder_model_present_for_this_op[i] = Parser::GetBit(p_stream, offset);
+                p_seq_header->decoder_model_present_for_this_op[i] = bit_reader.GetBit();
                 if (p_seq_header->decoder_model_present_for_this_op[i]) {
-                    p_seq_header->operating_parameters_info[i].decoder_buffer_delay = Parser::ReadBits(p_stream, offset, p_seq_header->decoder_model_info.buffer_delay_length_minus_1 + 1);
-                    p_seq_header->operating_parameters_info[i].encoder_buffer_delay = Parser::ReadBits(p_stream, offset, p_seq_header->decoder_model_info.buffer_delay_length_minus_1 + 1);
-                    p_seq_header->operating_parameters_info[i].low_delay_mode_flag = Parser::GetBit(p_stream, offset);
+                    p_seq_header->operating_parameters_info[i].decoder_buffer_delay = bit_reader.ReadBits(p_seq_header->decoder_model_info.buffer_delay_length_minus_1 + 1);
+                    p_seq_header->operating_parameters_info[i].encoder_buffer_delay = bit_reader.ReadBits(p_seq_header->decoder_model_info.buffer_delay_length_minus_1 + 1);
+                    p_seq_header->operating_parameters_info[i].low_delay_mode_flag = bit_reader.GetBit();
                 }
             } else {
                 p_seq_header->decoder_model_present_for_this_op[i] = 0;
             }
 
             if (p_seq_header->initial_display_delay_present_flag) {
-                p_seq_header->initial_display_delay_present_for_this_op[i] = Parser::GetBit(p_stream, offset);
+                p_seq_header->initial_display_delay_present_for_this_op[i] = bit_reader.GetBit();
                 if (p_seq_header->initial_display_delay_present_for_this_op[i]) {
-                    p_seq_header->initial_display_delay_minus_1[i] = Parser::ReadBits(p_stream, offset, 4);
+                    p_seq_header->initial_display_delay_minus_1[i] = bit_reader.ReadBits(4);
                 }
             }
         }
@@ -811,22 +891,22 @@ void Av1VideoParser::ParseSequenceHeaderObu(uint8_t *p_stream, size_t size) {
 
     // Todo: Choose operating point.
 
-    p_seq_header->frame_width_bits_minus_1 = Parser::ReadBits(p_stream, offset, 4);
-    p_seq_header->frame_height_bits_minus_1 = Parser::ReadBits(p_stream, offset, 4);
-    p_seq_header->max_frame_width_minus_1 = Parser::ReadBits(p_stream, offset, p_seq_header->frame_width_bits_minus_1 + 1);
-    p_seq_header->max_frame_height_minus_1 = Parser::ReadBits(p_stream, offset, p_seq_header->frame_height_bits_minus_1 + 1);
+    p_seq_header->frame_width_bits_minus_1 = bit_reader.ReadBits(4);
+    p_seq_header->frame_height_bits_minus_1 = bit_reader.ReadBits(4);
+    p_seq_header->max_frame_width_minus_1 = bit_reader.ReadBits(p_seq_header->frame_width_bits_minus_1 + 1);
+    p_seq_header->max_frame_height_minus_1 = bit_reader.ReadBits(p_seq_header->frame_height_bits_minus_1 + 1);
     if (p_seq_header->reduced_still_picture_header) {
         p_seq_header->frame_id_numbers_present_flag = 0;
     } else {
-        p_seq_header->frame_id_numbers_present_flag = Parser::GetBit(p_stream, offset);
+        p_seq_header->frame_id_numbers_present_flag = bit_reader.GetBit();
     }
     if (p_seq_header->frame_id_numbers_present_flag) {
-        p_seq_header->delta_frame_id_length_minus_2 = Parser::ReadBits(p_stream, offset, 4);
-        p_seq_header->additional_frame_id_length_minus_1 = Parser::ReadBits(p_stream, offset, 3);
+        p_seq_header->delta_frame_id_length_minus_2 = bit_reader.ReadBits(4);
+        p_seq_header->additional_frame_id_length_minus_1 = bit_reader.ReadBits(3);
     }
-    p_seq_header->use_128x128_superblock = Parser::GetBit(p_stream, offset);
-    p_seq_header->enable_filter_intra = Parser::GetBit(p_stream, offset);
-    p_seq_header->enable_intra_edge_filter = Parser::GetBit(p_stream, offset);
+    p_seq_header->use_128x128_superblock = bit_reader.GetBit();
+    p_seq_header->enable_filter_intra = bit_reader.GetBit();
+    p_seq_header->enable_intra_edge_filter = bit_reader.GetBit();
 
     if (p_seq_header->reduced_still_picture_header) {
         p_seq_header->enable_interintra_compound = 0;
@@ -840,51 +920,51 @@ void Av1VideoParser::ParseSequenceHeaderObu(uint8_t *p_stream, size_t size) {
         p_seq_header->seq_force_integer_mv = SELECT_INTEGER_MV;
         p_seq_header->order_hint_bits = 0;
     } else {
-        p_seq_header->enable_interintra_compound = Parser::GetBit(p_stream, offset);
-        p_seq_header->enable_masked_compound = Parser::GetBit(p_stream, offset);
-        p_seq_header->enable_warped_motion = Parser::GetBit(p_stream, offset);
-        p_seq_header->enable_dual_filter = Parser::GetBit(p_stream, offset);
-        p_seq_header->enable_order_hint = Parser::GetBit(p_stream, offset);
+        p_seq_header->enable_interintra_compound = bit_reader.GetBit();
+        p_seq_header->enable_masked_compound = bit_reader.GetBit();
+        p_seq_header->enable_warped_motion = bit_reader.GetBit();
+        p_seq_header->enable_dual_filter = bit_reader.GetBit();
+        p_seq_header->enable_order_hint = bit_reader.GetBit();
         if (p_seq_header->enable_order_hint) {
-            p_seq_header->enable_jnt_comp = Parser::GetBit(p_stream, offset);
-            p_seq_header->enable_ref_frame_mvs = Parser::GetBit(p_stream, offset);
+            p_seq_header->enable_jnt_comp = bit_reader.GetBit();
+            p_seq_header->enable_ref_frame_mvs = bit_reader.GetBit();
         } else {
             p_seq_header->enable_jnt_comp = 0;
             p_seq_header->enable_ref_frame_mvs = 0;
         }
 
-        p_seq_header->seq_choose_screen_content_tools = Parser::GetBit(p_stream, offset);
+        p_seq_header->seq_choose_screen_content_tools = bit_reader.GetBit();
         if (p_seq_header->seq_choose_screen_content_tools) {
             p_seq_header->seq_force_screen_content_tools = SELECT_SCREEN_CONTENT_TOOLS;
         } else {
-            p_seq_header->seq_force_screen_content_tools = Parser::GetBit(p_stream, offset);
+            p_seq_header->seq_force_screen_content_tools = bit_reader.GetBit();
         }
         if (p_seq_header->seq_force_screen_content_tools > 0) {
-            p_seq_header->seq_choose_integer_mv = Parser::GetBit(p_stream, offset);
+            p_seq_header->seq_choose_integer_mv = bit_reader.GetBit();
             if (p_seq_header->seq_choose_integer_mv) {
                 p_seq_header->seq_force_integer_mv = SELECT_INTEGER_MV;
             } else {
-                p_seq_header->seq_force_integer_mv = Parser::GetBit(p_stream, offset);
+                p_seq_header->seq_force_integer_mv = bit_reader.GetBit();
             }
         } else {
             p_seq_header->seq_force_integer_mv = SELECT_INTEGER_MV;
         }
 
         if (p_seq_header->enable_order_hint) {
-            p_seq_header->order_hint_bits_minus_1 = Parser::ReadBits(p_stream, offset, 3);
+            p_seq_header->order_hint_bits_minus_1 = bit_reader.ReadBits(3);
             p_seq_header->order_hint_bits = p_seq_header->order_hint_bits_minus_1 + 1;
         } else {
             p_seq_header->order_hint_bits = 0;
         }
     }
 
-    p_seq_header->enable_superres = Parser::GetBit(p_stream, offset);
-    p_seq_header->enable_cdef = Parser::GetBit(p_stream, offset);
-    p_seq_header->enable_restoration = Parser::GetBit(p_stream, offset);
+    p_seq_header->enable_superres = bit_reader.GetBit();
+    p_seq_header->enable_cdef = bit_reader.GetBit();
+    p_seq_header->enable_restoration = bit_reader.GetBit();
 
-    ParseColorConfig(p_stream, offset, p_seq_header);
+    ParseColorConfig(bit_reader, p_seq_header);
 
-    p_seq_header->film_grain_params_present = Parser::GetBit(p_stream, offset);
+    p_seq_header->film_grain_params_present = bit_reader.GetBit();
     // Increase decode/display pool size for film grain synthesis output store
     if (p_seq_header->film_grain_params_present) {
         CheckAndAdjustDecBufPoolSize(BUFFER_POOL_MAX_SIZE * 2);
@@ -913,8 +993,34 @@ ParserResult Av1VideoParser::ParseFrameHeaderObu(uint8_t *p_stream, size_t size,
     return PARSER_OK;
 }
 
+bool Av1VideoParser::IsKeyFrame(const uint8_t *p_stream, size_t size) {
+    if (seq_header_.reduced_still_picture_header) {
+        return true;
+    }
+    Parser::BitReader bit_reader(p_stream, size);
+    if (bit_reader.GetBit()) {
+        return false; // show_existing_frame
+    }
+    uint32_t frame_type = bit_reader.ReadBits(2);
+    uint32_t show_frame = bit_reader.GetBit();
+    if (!show_frame) {
+        return false;
+    }
+    if (frame_type == kKeyFrame) {
+        return true;
+    }
+    if (frame_type != kIntraOnlyFrame) {
+        return false;
+    }
+    if (seq_header_.decoder_model_info_present_flag && !seq_header_.timing_info.equal_picture_interval) {
+        bit_reader.SkipBits(seq_header_.decoder_model_info.frame_presentation_time_length_minus_1 + 1); // temporal_point_info()
+    }
+    // An intra only frame without error resilience may use the contexts of a dropped frame
+    return bit_reader.GetBit(); // error_resilient_mode
+}
+
 ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t size, int *p_bytes_parsed) {
-    size_t offset = 0;  // current bit offset
+    Parser::BitReader bit_reader(p_stream, size);
     Av1SequenceHeader *p_seq_header = &seq_header_;
     Av1FrameHeader *p_frame_header = &frame_header_;
     uint32_t frame_id_len = 0;
@@ -932,16 +1038,16 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
         p_frame_header->show_frame = 1;
         p_frame_header->showable_frame = 0;
     } else {
-        p_frame_header->show_existing_frame = Parser::GetBit(p_stream, offset);
+        p_frame_header->show_existing_frame = bit_reader.GetBit();
         if (p_frame_header->show_existing_frame == 1) {
-            p_frame_header->frame_to_show_map_idx = Parser::ReadBits(p_stream, offset, 3);
+            p_frame_header->frame_to_show_map_idx = bit_reader.ReadBits(3);
             if (p_seq_header->decoder_model_info_present_flag && !p_seq_header->timing_info.equal_picture_interval) {
                 // temporal_point_info()
-                p_frame_header->temporal_point_info.frame_presentation_time = Parser::ReadBits(p_stream, offset, p_seq_header->decoder_model_info.frame_presentation_time_length_minus_1 + 1);
+                p_frame_header->temporal_point_info.frame_presentation_time = bit_reader.ReadBits(p_seq_header->decoder_model_info.frame_presentation_time_length_minus_1 + 1);
             }
             p_frame_header->refresh_frame_flags = 0;
             if (p_seq_header->frame_id_numbers_present_flag) {
-                p_frame_header->display_frame_id = Parser::ReadBits(p_stream, offset, frame_id_len);
+                p_frame_header->display_frame_id = bit_reader.ReadBits(frame_id_len);
             }
             p_frame_header->frame_type = dpb_buffer_.ref_frame_type[p_frame_header->frame_to_show_map_idx];
             if (p_frame_header->frame_type == kKeyFrame) {
@@ -953,22 +1059,22 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
             return PARSER_OK;
         }
 
-        p_frame_header->frame_type = Parser::ReadBits(p_stream, offset, 2);
+        p_frame_header->frame_type = bit_reader.ReadBits(2);
         p_frame_header->frame_is_intra = (p_frame_header->frame_type == kIntraOnlyFrame) || (p_frame_header->frame_type == kKeyFrame);
-        p_frame_header->show_frame = Parser::GetBit(p_stream, offset);
+        p_frame_header->show_frame = bit_reader.GetBit();
         if (p_frame_header->show_frame && p_seq_header->decoder_model_info_present_flag && !p_seq_header->timing_info.equal_picture_interval) {
             // temporal_point_info()
-            p_frame_header->temporal_point_info.frame_presentation_time = Parser::ReadBits(p_stream, offset, p_seq_header->decoder_model_info.frame_presentation_time_length_minus_1 + 1);
+            p_frame_header->temporal_point_info.frame_presentation_time = bit_reader.ReadBits(p_seq_header->decoder_model_info.frame_presentation_time_length_minus_1 + 1);
         }
         if (p_frame_header->show_frame) {
             p_frame_header->showable_frame = p_frame_header->frame_type != kKeyFrame;
         } else {
-            p_frame_header->showable_frame = Parser::GetBit(p_stream, offset);
+            p_frame_header->showable_frame = bit_reader.GetBit();
         }
         if (p_frame_header->frame_type == kSwitchFrame || (p_frame_header->frame_type == kKeyFrame && p_frame_header->show_frame)) {
             p_frame_header->error_resilient_mode = 1;
         } else {
-            p_frame_header->error_resilient_mode = Parser::GetBit(p_stream, offset);
+            p_frame_header->error_resilient_mode = bit_reader.GetBit();
         }
     }
 
@@ -982,16 +1088,16 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
         }
     }
 
-    p_frame_header->disable_cdf_update = Parser::GetBit(p_stream, offset);
+    p_frame_header->disable_cdf_update = bit_reader.GetBit();
     if (p_seq_header->seq_force_screen_content_tools == SELECT_SCREEN_CONTENT_TOOLS) {
-        p_frame_header->allow_screen_content_tools = Parser::GetBit(p_stream, offset);
+        p_frame_header->allow_screen_content_tools = bit_reader.GetBit();
     } else {
         p_frame_header->allow_screen_content_tools = p_seq_header->seq_force_screen_content_tools;
     }
 
     if (p_frame_header->allow_screen_content_tools) {
         if (p_seq_header->seq_force_integer_mv == SELECT_INTEGER_MV) {
-            p_frame_header->force_integer_mv = Parser::GetBit(p_stream, offset);
+            p_frame_header->force_integer_mv = bit_reader.GetBit();
         } else {
             p_frame_header->force_integer_mv = p_seq_header->seq_force_integer_mv;
         }
@@ -1004,7 +1110,7 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
 
     if (p_seq_header->frame_id_numbers_present_flag) {
         p_frame_header->prev_frame_id = p_frame_header->current_frame_id;
-        p_frame_header->current_frame_id = Parser::ReadBits(p_stream, offset, frame_id_len);
+        p_frame_header->current_frame_id = bit_reader.ReadBits(frame_id_len);
         MarkRefFrames(p_seq_header, p_frame_header, frame_id_len);
     } else {
         p_frame_header->current_frame_id = 0;
@@ -1015,18 +1121,18 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
     } else if (p_seq_header->reduced_still_picture_header) {
         p_frame_header->frame_size_override_flag = 0;
     } else {
-        p_frame_header->frame_size_override_flag = Parser::GetBit(p_stream, offset);
+        p_frame_header->frame_size_override_flag = bit_reader.GetBit();
     }
 
-    p_frame_header->order_hint = Parser::ReadBits(p_stream, offset, p_seq_header->order_hint_bits);
+    p_frame_header->order_hint = bit_reader.ReadBits(p_seq_header->order_hint_bits);
     if (p_frame_header->frame_is_intra || p_frame_header->error_resilient_mode) {
         p_frame_header->primary_ref_frame = PRIMARY_REF_NONE;
     } else {
-        p_frame_header->primary_ref_frame = Parser::ReadBits(p_stream, offset, 3);
+        p_frame_header->primary_ref_frame = bit_reader.ReadBits(3);
     }
 
     if (p_seq_header->decoder_model_info_present_flag) {
-        p_frame_header->buffer_removal_time_present_flag = Parser::GetBit(p_stream, offset);
+        p_frame_header->buffer_removal_time_present_flag = bit_reader.GetBit();
         if (p_frame_header->buffer_removal_time_present_flag) {
             for (int op_num = 0; op_num <= p_seq_header->operating_points_cnt_minus_1; op_num++) {
                 if (p_seq_header->decoder_model_present_for_this_op[op_num]) {
@@ -1034,7 +1140,7 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
                     uint32_t in_temporal_layer = (op_pt_idc >> temporal_id_) & 1;
                     uint32_t in_spatial_layer = (op_pt_idc >> (spatial_id_ + 8)) & 1;
                     if (op_pt_idc == 0 || (in_temporal_layer && in_spatial_layer)) {
-                        p_frame_header->buffer_removal_time[op_num] = Parser::ReadBits(p_stream, offset, p_seq_header->decoder_model_info.buffer_removal_time_length_minus_1 + 1);
+                        p_frame_header->buffer_removal_time[op_num] = bit_reader.ReadBits(p_seq_header->decoder_model_info.buffer_removal_time_length_minus_1 + 1);
                     }
                 }
             }
@@ -1048,12 +1154,12 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
     if (p_frame_header->frame_type == kSwitchFrame || (p_frame_header->frame_type == kKeyFrame && p_frame_header->show_frame)) {
         p_frame_header->refresh_frame_flags = all_frames;
     } else {
-        p_frame_header->refresh_frame_flags = Parser::ReadBits(p_stream, offset, 8);
+        p_frame_header->refresh_frame_flags = bit_reader.ReadBits(8);
     }
     if (!p_frame_header->frame_is_intra || p_frame_header->refresh_frame_flags != all_frames) {
         if (p_frame_header->error_resilient_mode && p_seq_header->enable_order_hint) {
             for (i = 0; i < NUM_REF_FRAMES; i++) {
-                p_frame_header->ref_order_hint[i] = Parser::ReadBits(p_stream, offset, p_seq_header->order_hint_bits);
+                p_frame_header->ref_order_hint[i] = bit_reader.ReadBits(p_seq_header->order_hint_bits);
                 if (p_frame_header->ref_order_hint[i] != dpb_buffer_.ref_order_hint[i]) {
                     dpb_buffer_.ref_valid[i] = 0;
                 }
@@ -1062,19 +1168,19 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
     }
 
     if (p_frame_header->frame_is_intra) {
-        FrameSize(p_stream, offset, p_seq_header, p_frame_header);
-        RenderSize(p_stream, offset, p_frame_header);
+        FrameSize(bit_reader, p_seq_header, p_frame_header);
+        RenderSize(bit_reader, p_frame_header);
         if (p_frame_header->allow_screen_content_tools && p_frame_header->frame_size.upscaled_width == p_frame_header->frame_size.frame_width) {
-            p_frame_header->allow_intrabc = Parser::GetBit(p_stream, offset);
+            p_frame_header->allow_intrabc = bit_reader.GetBit();
         }
     } else {
         if (!p_seq_header->enable_order_hint) {
             p_frame_header->frame_refs_short_signaling = 0;
         } else {
-            p_frame_header->frame_refs_short_signaling = Parser::GetBit(p_stream, offset);
+            p_frame_header->frame_refs_short_signaling = bit_reader.GetBit();
             if (p_frame_header->frame_refs_short_signaling) {
-                p_frame_header->last_frame_idx = Parser::ReadBits(p_stream, offset, 3);
-                p_frame_header->gold_frame_idx = Parser::ReadBits(p_stream, offset, 3);
+                p_frame_header->last_frame_idx = bit_reader.ReadBits(3);
+                p_frame_header->gold_frame_idx = bit_reader.ReadBits(3);
                 // 7.8. Set frame refs process
                 SetFrameRefs(p_seq_header, p_frame_header);
             }
@@ -1082,10 +1188,10 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
 
         for (int i = 0; i < REFS_PER_FRAME; i++) {
             if (!p_frame_header->frame_refs_short_signaling) {
-                p_frame_header->ref_frame_idx[i] = Parser::ReadBits(p_stream, offset, 3);
+                p_frame_header->ref_frame_idx[i] = bit_reader.ReadBits(3);
             }
             if (p_seq_header->frame_id_numbers_present_flag) {
-                p_frame_header->delta_frame_id_minus_1 = Parser::ReadBits(p_stream, offset, p_seq_header->delta_frame_id_length_minus_2 + 2);
+                p_frame_header->delta_frame_id_minus_1 = bit_reader.ReadBits(p_seq_header->delta_frame_id_length_minus_2 + 2);
                 uint32_t delta_frame_id = p_frame_header->delta_frame_id_minus_1 + 1;
                 p_frame_header->expected_frame_id[i] = ((p_frame_header->current_frame_id + (1 << frame_id_len) - delta_frame_id ) % (1 << frame_id_len));
                 if (p_frame_header->expected_frame_id[i] != dpb_buffer_.ref_frame_id[p_frame_header->ref_frame_idx[i]] || dpb_buffer_.ref_valid[p_frame_header->ref_frame_idx[i]] == 0) {
@@ -1096,30 +1202,30 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
         }
 
         if (p_frame_header->frame_size_override_flag && !p_frame_header->error_resilient_mode) {
-            FrameSizeWithRefs(p_stream, offset, p_seq_header, p_frame_header);
+            FrameSizeWithRefs(bit_reader, p_seq_header, p_frame_header);
         } else {
-            FrameSize(p_stream, offset, p_seq_header, p_frame_header);
-            RenderSize(p_stream, offset, p_frame_header);
+            FrameSize(bit_reader, p_seq_header, p_frame_header);
+            RenderSize(bit_reader, p_frame_header);
         }
 
         if (p_frame_header->force_integer_mv) {
             p_frame_header->allow_high_precision_mv = 0;
         } else {
-            p_frame_header->allow_high_precision_mv = Parser::GetBit(p_stream, offset);
+            p_frame_header->allow_high_precision_mv = bit_reader.GetBit();
         }
 
         // read_interpolation_filter()
-        p_frame_header->is_filter_switchable = Parser::GetBit(p_stream, offset);
+        p_frame_header->is_filter_switchable = bit_reader.GetBit();
         if (p_frame_header->is_filter_switchable == 1) {
             p_frame_header->interpolation_filter = kSwitchable;
         } else {
-            p_frame_header->interpolation_filter = Parser::ReadBits(p_stream, offset, 2);
+            p_frame_header->interpolation_filter = bit_reader.ReadBits(2);
         }
-        p_frame_header->is_motion_mode_switchable = Parser::GetBit(p_stream, offset);
+        p_frame_header->is_motion_mode_switchable = bit_reader.GetBit();
         if (p_frame_header->error_resilient_mode || !p_seq_header->enable_ref_frame_mvs) {
             p_frame_header->use_ref_frame_mvs = 0;
         } else {
-            p_frame_header->use_ref_frame_mvs = Parser::GetBit(p_stream, offset);
+            p_frame_header->use_ref_frame_mvs = bit_reader.GetBit();
         }
 
         for (i = 0; i < REFS_PER_FRAME; i++) {
@@ -1143,7 +1249,7 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
     if (p_seq_header->reduced_still_picture_header || p_frame_header->disable_cdf_update) {
         p_frame_header->disable_frame_end_update_cdf = 1;
     } else {
-        p_frame_header->disable_frame_end_update_cdf = Parser::GetBit(p_stream, offset);
+        p_frame_header->disable_frame_end_update_cdf = bit_reader.GetBit();
     }
 
     if (p_frame_header->primary_ref_frame == PRIMARY_REF_NONE) {
@@ -1161,11 +1267,11 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
         //motion_field_estimation());
     }
 
-    TileInfo(p_stream, offset, p_seq_header, p_frame_header);
-    QuantizationParams(p_stream, offset, p_seq_header, p_frame_header);
-    SegmentationParams(p_stream, offset, p_frame_header);
-    DeltaQParams(p_stream, offset, p_frame_header);
-    DeltaLFParams(p_stream, offset, p_frame_header);
+    TileInfo(bit_reader, p_seq_header, p_frame_header);
+    QuantizationParams(bit_reader, p_seq_header, p_frame_header);
+    SegmentationParams(bit_reader, p_frame_header);
+    DeltaQParams(bit_reader, p_frame_header);
+    DeltaLFParams(bit_reader, p_frame_header);
 
     if (p_frame_header->primary_ref_frame == PRIMARY_REF_NONE) {
         // Todo: check need for implementation
@@ -1197,37 +1303,37 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
 
     p_frame_header->all_lossless = p_frame_header->coded_lossless && (p_frame_header->frame_size.frame_width == p_frame_header->frame_size.upscaled_width);
 
-    LoopFilterParams(p_stream, offset, p_seq_header, p_frame_header);
-    CdefParams(p_stream, offset, p_seq_header, p_frame_header);
-    LrParams(p_stream, offset, p_seq_header, p_frame_header);
-    ReadTxMode(p_stream, offset, p_frame_header);
+    LoopFilterParams(bit_reader, p_seq_header, p_frame_header);
+    CdefParams(bit_reader, p_seq_header, p_frame_header);
+    LrParams(bit_reader, p_seq_header, p_frame_header);
+    ReadTxMode(bit_reader, p_frame_header);
 
     // frame_reference_mode()
     if (p_frame_header->frame_is_intra) {
         p_frame_header->frame_reference_mode.reference_select = 0;
     } else {
-        p_frame_header->frame_reference_mode.reference_select = Parser::GetBit(p_stream, offset);
+        p_frame_header->frame_reference_mode.reference_select = bit_reader.GetBit();
     }
 
-    SkipModeParams(p_stream, offset, p_seq_header, p_frame_header);
+    SkipModeParams(bit_reader, p_seq_header, p_frame_header);
 
     if (p_frame_header->frame_is_intra || p_frame_header->error_resilient_mode || !p_seq_header->enable_warped_motion) {
         p_frame_header->allow_warped_motion = 0;
     } else {
-        p_frame_header->allow_warped_motion = Parser::GetBit(p_stream, offset);
+        p_frame_header->allow_warped_motion = bit_reader.GetBit();
     }
 
-    p_frame_header->reduced_tx_set = Parser::GetBit(p_stream, offset);
+    p_frame_header->reduced_tx_set = bit_reader.GetBit();
 
-    GlobalMotionParams(p_stream, offset, p_frame_header);
-    FilmGrainParams(p_stream, offset, p_seq_header, p_frame_header);
+    GlobalMotionParams(bit_reader, p_frame_header);
+    FilmGrainParams(bit_reader, p_seq_header, p_frame_header);
 
-    *p_bytes_parsed = (offset + 7) >> 3;
+    *p_bytes_parsed = (bit_reader.GetBitOffset() + 7) >> 3;
     return PARSER_OK;
 }
 
 void Av1VideoParser::ParseTileGroupObu(uint8_t *p_stream, size_t size) {
-    size_t offset = 0;  // current bit offset
+    Parser::BitReader bit_reader(p_stream, size);
     Av1SequenceHeader *p_seq_header = &seq_header_;
     Av1FrameHeader *p_frame_header = &frame_header_;
     Av1TileGroupDataInfo *p_tile_group = &tile_group_data_;
@@ -1245,18 +1351,18 @@ void Av1VideoParser::ParseTileGroupObu(uint8_t *p_stream, size_t size) {
     // First parse the header
     p_tile_group->num_tiles = tile_cols * tile_rows;
     if (p_tile_group->num_tiles > 1) {
-        tile_start_and_end_present_flag = Parser::GetBit(p_stream, offset);
+        tile_start_and_end_present_flag = bit_reader.GetBit();
     }
     if (p_tile_group->num_tiles == 1 || !tile_start_and_end_present_flag) {
         p_tile_group->tg_start = 0;
         p_tile_group->tg_end = p_tile_group->num_tiles - 1;
     } else {
         uint32_t tile_bits = p_frame_header->tile_info.tile_cols_log2 + p_frame_header->tile_info.tile_rows_log2;
-        p_tile_group->tg_start = Parser::ReadBits(p_stream, offset, tile_bits);
-        p_tile_group->tg_end = Parser::ReadBits(p_stream, offset, tile_bits);
+        p_tile_group->tg_start = bit_reader.ReadBits(tile_bits);
+        p_tile_group->tg_end = bit_reader.ReadBits(tile_bits);
     }
 
-    header_bytes = ((offset + 7) >> 3);
+    header_bytes = ((bit_reader.GetBitOffset() + 7) >> 3);
     p_tg_buf += header_bytes;
     tg_size -= header_bytes;
     for (int tile_num = p_tile_group->tg_start; tile_num <= p_tile_group->tg_end; tile_num++) {
@@ -1289,12 +1395,12 @@ void Av1VideoParser::ParseTileGroupObu(uint8_t *p_stream, size_t size) {
     }
 }
 
-void Av1VideoParser::ParseColorConfig(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header) {
+void Av1VideoParser::ParseColorConfig(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header) {
     p_seq_header->color_config.bit_depth = 8;
     
-    p_seq_header->color_config.high_bitdepth = Parser::GetBit(p_stream, offset);
+    p_seq_header->color_config.high_bitdepth = bit_reader.GetBit();
     if (p_seq_header->seq_profile == 2 && p_seq_header->color_config.high_bitdepth) {
-        p_seq_header->color_config.twelve_bit = Parser::GetBit(p_stream, offset);
+        p_seq_header->color_config.twelve_bit = bit_reader.GetBit();
         p_seq_header->color_config.bit_depth = p_seq_header->color_config.twelve_bit ? 12 : 10;
     } else if (p_seq_header->seq_profile <= 2) {
         p_seq_header->color_config.bit_depth = p_seq_header->color_config.high_bitdepth ? 10 : 8;
@@ -1303,15 +1409,15 @@ void Av1VideoParser::ParseColorConfig(const uint8_t *p_stream, size_t &offset, A
     if (p_seq_header->seq_profile == 1) {
         p_seq_header->color_config.mono_chrome = 0;
     } else {
-        p_seq_header->color_config.mono_chrome = Parser::GetBit(p_stream, offset);
+        p_seq_header->color_config.mono_chrome = bit_reader.GetBit();
     }
     p_seq_header->color_config.num_planes = p_seq_header->color_config.mono_chrome ? 1 : 3;
 
-    p_seq_header->color_config.color_description_present_flag = Parser::GetBit(p_stream, offset);
+    p_seq_header->color_config.color_description_present_flag = bit_reader.GetBit();
     if (p_seq_header->color_config.color_description_present_flag) {
-        p_seq_header->color_config.color_primaries = Parser::ReadBits(p_stream, offset, 8);
-        p_seq_header->color_config.transfer_characteristics = Parser::ReadBits(p_stream, offset, 8);
-        p_seq_header->color_config.matrix_coefficients = Parser::ReadBits(p_stream, offset, 8);
+        p_seq_header->color_config.color_primaries = bit_reader.ReadBits(8);
+        p_seq_header->color_config.transfer_characteristics = bit_reader.ReadBits(8);
+        p_seq_header->color_config.matrix_coefficients = bit_reader.ReadBits(8);
     } else {
         p_seq_header->color_config.color_primaries = CP_UNSPECIFIED;
         p_seq_header->color_config.transfer_characteristics = TC_UNSPECIFIED;
@@ -1319,7 +1425,7 @@ void Av1VideoParser::ParseColorConfig(const uint8_t *p_stream, size_t &offset, A
     }
 
     if (p_seq_header->color_config.mono_chrome) {
-        p_seq_header->color_config.color_range = Parser::GetBit(p_stream, offset);
+        p_seq_header->color_config.color_range = bit_reader.GetBit();
         p_seq_header->color_config.subsampling_x = 1;
         p_seq_header->color_config.subsampling_y = 1;
         p_seq_header->color_config.chroma_sample_position = CSP_UNKNOWN;
@@ -1330,7 +1436,7 @@ void Av1VideoParser::ParseColorConfig(const uint8_t *p_stream, size_t &offset, A
         p_seq_header->color_config.subsampling_x = 0;
         p_seq_header->color_config.subsampling_y = 0;
     } else {
-        p_seq_header->color_config.color_range = Parser::GetBit(p_stream, offset);
+        p_seq_header->color_config.color_range = bit_reader.GetBit();
         if (p_seq_header->seq_profile == 0) {
             p_seq_header->color_config.subsampling_x = 1;
             p_seq_header->color_config.subsampling_y = 1;
@@ -1339,9 +1445,9 @@ void Av1VideoParser::ParseColorConfig(const uint8_t *p_stream, size_t &offset, A
             p_seq_header->color_config.subsampling_y = 0;
         } else {
             if (p_seq_header->color_config.bit_depth == 12) {
-                p_seq_header->color_config.subsampling_x = Parser::GetBit(p_stream, offset);
+                p_seq_header->color_config.subsampling_x = bit_reader.GetBit();
                 if (p_seq_header->color_config.subsampling_x) {
-                    p_seq_header->color_config.subsampling_y = Parser::GetBit(p_stream, offset);
+                    p_seq_header->color_config.subsampling_y = bit_reader.GetBit();
                 } else {
                     p_seq_header->color_config.subsampling_y = 0;
                 }
@@ -1352,11 +1458,11 @@ void Av1VideoParser::ParseColorConfig(const uint8_t *p_stream, size_t &offset, A
         }
 
         if (p_seq_header->color_config.subsampling_x && p_seq_header->color_config.subsampling_y) {
-            p_seq_header->color_config.chroma_sample_position = Parser::ReadBits(p_stream, offset, 2);
+            p_seq_header->color_config.chroma_sample_position = bit_reader.ReadBits(2);
         }
     }
 
-    p_seq_header->color_config.separate_uv_delta_q = Parser::GetBit(p_stream, offset);
+    p_seq_header->color_config.separate_uv_delta_q = bit_reader.GetBit();
 }
 
 void Av1VideoParser::MarkRefFrames(Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header, uint32_t id_len) {
@@ -1376,11 +1482,11 @@ void Av1VideoParser::MarkRefFrames(Av1SequenceHeader *p_seq_header, Av1FrameHead
     }
 }
 
-void Av1VideoParser::FrameSize(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::FrameSize(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     if (p_frame_header->frame_size_override_flag) {
-        p_frame_header->frame_size.frame_width_minus_1 = Parser::ReadBits(p_stream, offset, p_seq_header->frame_width_bits_minus_1 + 1);
+        p_frame_header->frame_size.frame_width_minus_1 = bit_reader.ReadBits(p_seq_header->frame_width_bits_minus_1 + 1);
         p_frame_header->frame_size.frame_width = p_frame_header->frame_size.frame_width_minus_1 + 1;
-        p_frame_header->frame_size.frame_height_minus_1 = Parser::ReadBits(p_stream, offset, p_seq_header->frame_height_bits_minus_1 + 1);
+        p_frame_header->frame_size.frame_height_minus_1 = bit_reader.ReadBits(p_seq_header->frame_height_bits_minus_1 + 1);
         p_frame_header->frame_size.frame_height = p_frame_header->frame_size.frame_height_minus_1 + 1;
     } else {
         p_frame_header->frame_size.frame_width_minus_1 = p_seq_header->max_frame_width_minus_1;
@@ -1388,18 +1494,18 @@ void Av1VideoParser::FrameSize(const uint8_t *p_stream, size_t &offset, Av1Seque
         p_frame_header->frame_size.frame_width = p_seq_header->max_frame_width_minus_1 + 1;
         p_frame_header->frame_size.frame_height = p_seq_header->max_frame_height_minus_1 + 1;
     }
-    SuperResParams(p_stream, offset, p_seq_header, p_frame_header);
+    SuperResParams(bit_reader, p_seq_header, p_frame_header);
     ComputeImageSize(p_frame_header);
 }
 
-void Av1VideoParser::SuperResParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::SuperResParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     if (p_seq_header->enable_superres) {
-        p_frame_header->frame_size.superres_params.use_superres = Parser::GetBit(p_stream, offset);
+        p_frame_header->frame_size.superres_params.use_superres = bit_reader.GetBit();
     } else {
         p_frame_header->frame_size.superres_params.use_superres = 0;
     }
     if (p_frame_header->frame_size.superres_params.use_superres) {
-        p_frame_header->frame_size.superres_params.coded_denom = Parser::ReadBits(p_stream, offset, SUPERRES_DENOM_BITS);
+        p_frame_header->frame_size.superres_params.coded_denom = bit_reader.ReadBits(SUPERRES_DENOM_BITS);
         p_frame_header->frame_size.superres_params.super_res_denom = p_frame_header->frame_size.superres_params.coded_denom + SUPERRES_DENOM_MIN;
     } else {
         p_frame_header->frame_size.superres_params.super_res_denom = SUPERRES_NUM;
@@ -1413,11 +1519,11 @@ void Av1VideoParser::ComputeImageSize(Av1FrameHeader *p_frame_header) {
     p_frame_header->frame_size.mi_rows = 2 * ((p_frame_header->frame_size.frame_height + 7) >> 3);
 }
 
-void Av1VideoParser::RenderSize(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header) {
-    p_frame_header->render_size.render_and_frame_size_different = Parser::GetBit(p_stream, offset);
+void Av1VideoParser::RenderSize(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header) {
+    p_frame_header->render_size.render_and_frame_size_different = bit_reader.GetBit();
     if (p_frame_header->render_size.render_and_frame_size_different) {
-        p_frame_header->render_size.render_width_minus_1 = Parser::ReadBits(p_stream, offset, 16);
-        p_frame_header->render_size.render_height_minus_1 = Parser::ReadBits(p_stream, offset, 16);
+        p_frame_header->render_size.render_width_minus_1 = bit_reader.ReadBits(16);
+        p_frame_header->render_size.render_height_minus_1 = bit_reader.ReadBits(16);
         p_frame_header->render_size.render_width = p_frame_header->render_size.render_width_minus_1 + 1;
         p_frame_header->render_size.render_height = p_frame_header->render_size.render_height_minus_1 + 1;
     } else {
@@ -1554,9 +1660,9 @@ int Av1VideoParser::FindLatestForward(int *shifted_order_hints, int *used_frame,
     return ref;
 }
 
-void Av1VideoParser::FrameSizeWithRefs(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::FrameSizeWithRefs(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     for (int i = 0; i < REFS_PER_FRAME; i++) {
-        p_frame_header->found_ref = Parser::GetBit(p_stream, offset);
+        p_frame_header->found_ref = bit_reader.GetBit();
         if (p_frame_header->found_ref) {
             frame_header_.frame_size.upscaled_width = dpb_buffer_.ref_upscaled_width[frame_header_.ref_frame_idx[i]];
             frame_header_.frame_size.frame_width = frame_header_.frame_size.upscaled_width;
@@ -1570,10 +1676,10 @@ void Av1VideoParser::FrameSizeWithRefs(const uint8_t *p_stream, size_t &offset,
     }
 
     if (p_frame_header->found_ref == 0) {
-        FrameSize(p_stream, offset, p_seq_header, p_frame_header);
-        RenderSize(p_stream, offset, p_frame_header);
+        FrameSize(bit_reader, p_seq_header, p_frame_header);
+        RenderSize(bit_reader, p_frame_header);
     } else {
-        SuperResParams(p_stream, offset, p_seq_header, p_frame_header);
+        SuperResParams(bit_reader, p_seq_header, p_frame_header);
         ComputeImageSize(p_frame_header);
     }
 }
@@ -1626,7 +1732,7 @@ void Av1VideoParser::LoadPrevious(Av1FrameHeader *p_frame_header) {
     }
 }
 
-void Av1VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::TileInfo(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     int32_t sb_cols;
     int32_t sb_rows;
     int32_t sb_shift;
@@ -1658,11 +1764,11 @@ void Av1VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Av1Sequen
     max_log2_tile_rows = TileLog2(1, std::min(sb_rows, MAX_TILE_ROWS));
     min_log2_tiles = std::max(min_log2_tile_cols, static_cast<int>(TileLog2(max_tile_area_sb, sb_rows * sb_cols)));
 
-    p_frame_header->tile_info.uniform_tile_spacing_flag = Parser::GetBit(p_stream, offset);
+    p_frame_header->tile_info.uniform_tile_spacing_flag = bit_reader.GetBit();
     if (p_frame_header->tile_info.uniform_tile_spacing_flag) {
         p_frame_header->tile_info.tile_cols_log2 = min_log2_tile_cols;
         while (p_frame_header->tile_info.tile_cols_log2 < max_log2_tile_cols) {
-            p_frame_header->tile_info.increment_tile_cols_log2 = Parser::GetBit(p_stream, offset);
+            p_frame_header->tile_info.increment_tile_cols_log2 = bit_reader.GetBit();
             if (p_frame_header->tile_info.increment_tile_cols_log2 == 1) {
                 p_frame_header->tile_info.tile_cols_log2++;
             } else {
@@ -1681,7 +1787,7 @@ void Av1VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Av1Sequen
         min_log2_tile_rows = std::max(min_log2_tiles - p_frame_header->tile_info.tile_cols_log2, 0);
         p_frame_header->tile_info.tile_rows_log2 = min_log2_tile_rows;
         while (p_frame_header->tile_info.tile_rows_log2 < max_log2_tile_rows) {
-            p_frame_header->tile_info.increment_tile_rows_log2 = Parser::GetBit(p_stream, offset);
+            p_frame_header->tile_info.increment_tile_rows_log2 = bit_reader.GetBit();
             if (p_frame_header->tile_info.increment_tile_rows_log2 == 1) {
                 p_frame_header->tile_info.tile_rows_log2++;
             } else {
@@ -1711,7 +1817,7 @@ void Av1VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Av1Sequen
         for (i = 0; start_sb < sb_cols; i++) {
             p_frame_header->tile_info.mi_col_starts[i] = start_sb << sb_shift;
             max_width = std::min(sb_cols - start_sb, max_tile_width_sb);
-            p_frame_header->tile_info.width_in_sbs_minus_1[i] = ReadUnsignedNonSymmetic(p_stream, offset, max_width);
+            p_frame_header->tile_info.width_in_sbs_minus_1[i] = ReadUnsignedNonSymmetic(bit_reader, max_width);
             size_sb = p_frame_header->tile_info.width_in_sbs_minus_1[i] + 1;
             widest_tile_sb = std::max(size_sb, widest_tile_sb);
             start_sb += size_sb;
@@ -1731,7 +1837,7 @@ void Av1VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Av1Sequen
         for (i = 0; start_sb < sb_rows; i++) {
             p_frame_header->tile_info.mi_row_starts[i] = start_sb << sb_shift;
             max_height = std::min(sb_rows - start_sb, max_tile_height_sb);
-            p_frame_header->tile_info.height_in_sbs_minus_1[i] = ReadUnsignedNonSymmetic(p_stream, offset, max_height);
+            p_frame_header->tile_info.height_in_sbs_minus_1[i] = ReadUnsignedNonSymmetic(bit_reader, max_height);
             size_sb = p_frame_header->tile_info.height_in_sbs_minus_1[i] + 1;
             start_sb += size_sb;
         }
@@ -1741,8 +1847,8 @@ void Av1VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Av1Sequen
     }
 
     if (p_frame_header->tile_info.tile_cols_log2 > 0 || p_frame_header->tile_info.tile_rows_log2 > 0) {
-        p_frame_header->tile_info.context_update_tile_id = Parser::ReadBits(p_stream, offset, p_frame_header->tile_info.tile_rows_log2 + p_frame_header->tile_info.tile_cols_log2);
-        p_frame_header->tile_info.tile_size_bytes_minus_1 = Parser::ReadBits(p_stream, offset, 2);
+        p_frame_header->tile_info.context_update_tile_id = bit_reader.ReadBits(p_frame_header->tile_info.tile_rows_log2 + p_frame_header->tile_info.tile_cols_log2);
+        p_frame_header->tile_info.tile_size_bytes_minus_1 = bit_reader.ReadBits(2);
     } else {
         p_frame_header->tile_info.context_update_tile_id = 0;
     }
@@ -1754,22 +1860,22 @@ uint32_t Av1VideoParser::TileLog2(uint32_t blk_size, uint32_t target) {
     return k;
 }
 
-void Av1VideoParser::QuantizationParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
-    p_frame_header->quantization_params.base_q_idx = Parser::ReadBits(p_stream, offset, 8);
-    p_frame_header->quantization_params.delta_q_y_dc = ReadDeltaQ(p_stream, offset, p_frame_header);
+void Av1VideoParser::QuantizationParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+    p_frame_header->quantization_params.base_q_idx = bit_reader.ReadBits(8);
+    p_frame_header->quantization_params.delta_q_y_dc = ReadDeltaQ(bit_reader, p_frame_header);
 
     if (p_seq_header->color_config.num_planes > 1) {
         if (p_seq_header->color_config.separate_uv_delta_q) {
-            p_frame_header->quantization_params.diff_uv_delta = Parser::GetBit(p_stream, offset);
+            p_frame_header->quantization_params.diff_uv_delta = bit_reader.GetBit();
         } else {
             p_frame_header->quantization_params.diff_uv_delta = 0;
         }
-        p_frame_header->quantization_params.delta_q_u_dc = ReadDeltaQ(p_stream, offset, p_frame_header);
-        p_frame_header->quantization_params.delta_q_u_ac = ReadDeltaQ(p_stream, offset, p_frame_header);
+        p_frame_header->quantization_params.delta_q_u_dc = ReadDeltaQ(bit_reader, p_frame_header);
+        p_frame_header->quantization_params.delta_q_u_ac = ReadDeltaQ(bit_reader, p_frame_header);
 
         if (p_frame_header->quantization_params.diff_uv_delta) {
-            p_frame_header->quantization_params.delta_q_v_dc = ReadDeltaQ(p_stream, offset, p_frame_header);
-            p_frame_header->quantization_params.delta_q_v_ac = ReadDeltaQ(p_stream, offset, p_frame_header);
+            p_frame_header->quantization_params.delta_q_v_dc = ReadDeltaQ(bit_reader, p_frame_header);
+            p_frame_header->quantization_params.delta_q_v_ac = ReadDeltaQ(bit_reader, p_frame_header);
         } else {
             p_frame_header->quantization_params.delta_q_v_dc = p_frame_header->quantization_params.delta_q_u_dc;
             p_frame_header->quantization_params.delta_q_v_ac = p_frame_header->quantization_params.delta_q_u_ac;
@@ -1781,29 +1887,29 @@ void Av1VideoParser::QuantizationParams(const uint8_t *p_stream, size_t &offset,
         p_frame_header->quantization_params.delta_q_v_ac = 0;
     }
 
-    p_frame_header->quantization_params.using_qmatrix = Parser::GetBit(p_stream, offset);
+    p_frame_header->quantization_params.using_qmatrix = bit_reader.GetBit();
     if (p_frame_header->quantization_params.using_qmatrix) {
-        p_frame_header->quantization_params.qm_y = Parser::ReadBits(p_stream, offset, 4);
-        p_frame_header->quantization_params.qm_u = Parser::ReadBits(p_stream, offset, 4);
+        p_frame_header->quantization_params.qm_y = bit_reader.ReadBits(4);
+        p_frame_header->quantization_params.qm_u = bit_reader.ReadBits(4);
         if (!p_seq_header->color_config.separate_uv_delta_q) {
             p_frame_header->quantization_params.qm_v = p_frame_header->quantization_params.qm_u;
         } else {
-            p_frame_header->quantization_params.qm_v = Parser::ReadBits(p_stream, offset, 4);
+            p_frame_header->quantization_params.qm_v = bit_reader.ReadBits(4);
         }
     }
 }
 
-int32_t Av1VideoParser::ReadDeltaQ(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header) {
-    p_frame_header->quantization_params.delta_coded = Parser::GetBit(p_stream, offset);
+int32_t Av1VideoParser::ReadDeltaQ(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header) {
+    p_frame_header->quantization_params.delta_coded = bit_reader.GetBit();
     if (p_frame_header->quantization_params.delta_coded) {
-        p_frame_header->quantization_params.delta_q = ReadSigned(p_stream, offset, 1 + 6);
+        p_frame_header->quantization_params.delta_q = ReadSigned(bit_reader, 1 + 6);
     } else {
         p_frame_header->quantization_params.delta_q = 0;
     }
     return p_frame_header->quantization_params.delta_q;
 }
 
-void Av1VideoParser::SegmentationParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::SegmentationParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header) {
     int i, j;
     int clipped_value;
     uint32_t bits_to_read;
@@ -1811,35 +1917,35 @@ void Av1VideoParser::SegmentationParams(const uint8_t *p_stream, size_t &offset,
     uint32_t segmentation_feature_signed[SEG_LVL_MAX] = { 1, 1, 1, 1, 1, 0, 0, 0 };
     uint32_t segmentation_feature_max[SEG_LVL_MAX] = {255, MAX_LOOP_FILTER, MAX_LOOP_FILTER, MAX_LOOP_FILTER, MAX_LOOP_FILTER, 7, 0, 0 };
 
-    p_frame_header->segmentation_params.segmentation_enabled = Parser::GetBit(p_stream, offset);
+    p_frame_header->segmentation_params.segmentation_enabled = bit_reader.GetBit();
     if (p_frame_header->segmentation_params.segmentation_enabled == 1) {
         if (p_frame_header->primary_ref_frame == PRIMARY_REF_NONE) {
             p_frame_header->segmentation_params.segmentation_update_map = 1;
             p_frame_header->segmentation_params.segmentation_temporal_update = 0;
             p_frame_header->segmentation_params.segmentation_update_data = 1;
         } else {
-            p_frame_header->segmentation_params.segmentation_update_map = Parser::GetBit(p_stream, offset);
+            p_frame_header->segmentation_params.segmentation_update_map = bit_reader.GetBit();
             if (p_frame_header->segmentation_params.segmentation_update_map == 1) {
-                p_frame_header->segmentation_params.segmentation_temporal_update = Parser::GetBit(p_stream, offset);
+                p_frame_header->segmentation_params.segmentation_temporal_update = bit_reader.GetBit();
             }
-            p_frame_header->segmentation_params.segmentation_update_data = Parser::GetBit(p_stream, offset);
+            p_frame_header->segmentation_params.segmentation_update_data = bit_reader.GetBit();
         }
 
         if (p_frame_header->segmentation_params.segmentation_update_data == 1) {
             for (i = 0; i < MAX_SEGMENTS; i++) {
                 for (j = 0; j < SEG_LVL_MAX; j++) {
                     p_frame_header->segmentation_params.feature_value = 0;
-                    p_frame_header->segmentation_params.feature_enabled = Parser::GetBit(p_stream, offset);
+                    p_frame_header->segmentation_params.feature_enabled = bit_reader.GetBit();
                     p_frame_header->segmentation_params.feature_enabled_flags[i][j] = p_frame_header->segmentation_params.feature_enabled;
                     clipped_value = 0;
                     if (p_frame_header->segmentation_params.feature_enabled == 1) {
                         bits_to_read = segmentation_feature_bits[j];
                         int limit = segmentation_feature_max[j];
                         if (segmentation_feature_signed[j] == 1) {
-                            p_frame_header->segmentation_params.feature_value = ReadSigned(p_stream, offset, 1 + bits_to_read);
+                            p_frame_header->segmentation_params.feature_value = ReadSigned(bit_reader, 1 + bits_to_read);
                             clipped_value = std::clamp(static_cast<int>(p_frame_header->segmentation_params.feature_value), -limit, limit);
                         } else {
-                            p_frame_header->segmentation_params.feature_value = Parser::ReadBits(p_stream, offset, bits_to_read);
+                            p_frame_header->segmentation_params.feature_value = bit_reader.ReadBits(bits_to_read);
                             clipped_value = std::clamp(static_cast<int>(p_frame_header->segmentation_params.feature_value), 0, limit);
                         }
                     }
@@ -1871,28 +1977,28 @@ void Av1VideoParser::SegmentationParams(const uint8_t *p_stream, size_t &offset,
     }
 }
 
-void Av1VideoParser::DeltaQParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::DeltaQParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header) {
     p_frame_header->delta_q_params.delta_q_res = 0;
     p_frame_header->delta_q_params.delta_q_present = 0;
     if (p_frame_header->quantization_params.base_q_idx > 0) {
-        p_frame_header->delta_q_params.delta_q_present = Parser::GetBit(p_stream, offset);
+        p_frame_header->delta_q_params.delta_q_present = bit_reader.GetBit();
     }
     if (p_frame_header->delta_q_params.delta_q_present) {
-        p_frame_header->delta_q_params.delta_q_res = Parser::ReadBits(p_stream, offset, 2);
+        p_frame_header->delta_q_params.delta_q_res = bit_reader.ReadBits(2);
     }
 }
 
-void Av1VideoParser::DeltaLFParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::DeltaLFParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header) {
     p_frame_header->delta_lf_params.delta_lf_present = 0;
     p_frame_header->delta_lf_params.delta_lf_res = 0;
     p_frame_header->delta_lf_params.delta_lf_multi = 0;
     if (p_frame_header->delta_q_params.delta_q_present) {
         if (!p_frame_header->allow_intrabc) {
-            p_frame_header->delta_lf_params.delta_lf_present = Parser::GetBit(p_stream, offset);
+            p_frame_header->delta_lf_params.delta_lf_present = bit_reader.GetBit();
         }
         if (p_frame_header->delta_lf_params.delta_lf_present) {
-            p_frame_header->delta_lf_params.delta_lf_res = Parser::ReadBits(p_stream, offset, 2);
-            p_frame_header->delta_lf_params.delta_lf_multi = Parser::GetBit(p_stream, offset);
+            p_frame_header->delta_lf_params.delta_lf_res = bit_reader.ReadBits(2);
+            p_frame_header->delta_lf_params.delta_lf_multi = bit_reader.GetBit();
         }
     }
 }
@@ -1912,7 +2018,7 @@ int Av1VideoParser::GetQIndex(Av1FrameHeader *p_frame_header, int ignore_delta_q
     }
 }
 
-void Av1VideoParser::LoopFilterParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::LoopFilterParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     int i;
 
     if (p_frame_header->coded_lossless || p_frame_header->allow_intrabc) {
@@ -1932,38 +2038,38 @@ void Av1VideoParser::LoopFilterParams(const uint8_t *p_stream, size_t &offset, A
         return;
     }
 
-    p_frame_header->loop_filter_params.loop_filter_level[0] = Parser::ReadBits(p_stream, offset, 6);
-    p_frame_header->loop_filter_params.loop_filter_level[1] = Parser::ReadBits(p_stream, offset, 6);
+    p_frame_header->loop_filter_params.loop_filter_level[0] = bit_reader.ReadBits(6);
+    p_frame_header->loop_filter_params.loop_filter_level[1] = bit_reader.ReadBits(6);
     if (p_seq_header->color_config.num_planes > 1) {
         if (p_frame_header->loop_filter_params.loop_filter_level[0] || p_frame_header->loop_filter_params.loop_filter_level[1]) {
-            p_frame_header->loop_filter_params.loop_filter_level[2] = Parser::ReadBits(p_stream, offset, 6);
-            p_frame_header->loop_filter_params.loop_filter_level[3] = Parser::ReadBits(p_stream, offset, 6);
+            p_frame_header->loop_filter_params.loop_filter_level[2] = bit_reader.ReadBits(6);
+            p_frame_header->loop_filter_params.loop_filter_level[3] = bit_reader.ReadBits(6);
         }
     }
 
-    p_frame_header->loop_filter_params.loop_filter_sharpness = Parser::ReadBits(p_stream, offset, 3);
-    p_frame_header->loop_filter_params.loop_filter_delta_enabled = Parser::GetBit(p_stream, offset);
+    p_frame_header->loop_filter_params.loop_filter_sharpness = bit_reader.ReadBits(3);
+    p_frame_header->loop_filter_params.loop_filter_delta_enabled = bit_reader.GetBit();
     if (p_frame_header->loop_filter_params.loop_filter_delta_enabled == 1) {
-        p_frame_header->loop_filter_params.loop_filter_delta_update = Parser::GetBit(p_stream, offset);
+        p_frame_header->loop_filter_params.loop_filter_delta_update = bit_reader.GetBit();
         if (p_frame_header->loop_filter_params.loop_filter_delta_update == 1) {
             for (i = 0; i < TOTAL_REFS_PER_FRAME; i++) {
-                p_frame_header->loop_filter_params.update_ref_delta = Parser::GetBit(p_stream, offset);
+                p_frame_header->loop_filter_params.update_ref_delta = bit_reader.GetBit();
                 if (p_frame_header->loop_filter_params.update_ref_delta == 1) {
-                    p_frame_header->loop_filter_params.loop_filter_ref_deltas[i] = ReadSigned(p_stream, offset, 1 + 6);
+                    p_frame_header->loop_filter_params.loop_filter_ref_deltas[i] = ReadSigned(bit_reader, 1 + 6);
                 }
             }
             for (i = 0; i < 2; i++) {
-                p_frame_header->loop_filter_params.update_mode_delta = Parser::GetBit(p_stream, offset);
+                p_frame_header->loop_filter_params.update_mode_delta = bit_reader.GetBit();
                 if ( p_frame_header->loop_filter_params.update_mode_delta == 1 )
                 {
-                    p_frame_header->loop_filter_params.loop_filter_mode_deltas[i] = ReadSigned(p_stream, offset, 1 + 6);
+                    p_frame_header->loop_filter_params.loop_filter_mode_deltas[i] = ReadSigned(bit_reader, 1 + 6);
                 }
             }
         }
     }
 }
 
-void Av1VideoParser::CdefParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::CdefParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     if (p_frame_header->coded_lossless || p_frame_header->allow_intrabc ||!p_seq_header->enable_cdef) {
         p_frame_header->cdef_params.cdef_bits = 0;
         p_frame_header->cdef_params.cdef_y_pri_strength[0] = 0;
@@ -1974,12 +2080,12 @@ void Av1VideoParser::CdefParams(const uint8_t *p_stream, size_t &offset, Av1Sequ
         return;
     }
 
-    p_frame_header->cdef_params.cdef_damping_minus_3 = Parser::ReadBits(p_stream, offset, 2);
+    p_frame_header->cdef_params.cdef_damping_minus_3 = bit_reader.ReadBits(2);
     p_frame_header->cdef_params.cdef_damping = p_frame_header->cdef_params.cdef_damping_minus_3 + 3;
-    p_frame_header->cdef_params.cdef_bits = Parser::ReadBits(p_stream, offset, 2);
+    p_frame_header->cdef_params.cdef_bits = bit_reader.ReadBits(2);
     for (int i = 0; i < (1 << p_frame_header->cdef_params.cdef_bits); i++) {
-        p_frame_header->cdef_params.cdef_y_pri_strength[i] = Parser::ReadBits(p_stream, offset, 4);
-        p_frame_header->cdef_params.cdef_y_sec_strength[i] = Parser::ReadBits(p_stream, offset, 2);
+        p_frame_header->cdef_params.cdef_y_pri_strength[i] = bit_reader.ReadBits(4);
+        p_frame_header->cdef_params.cdef_y_sec_strength[i] = bit_reader.ReadBits(2);
         /* Note: cdef_y_sec_strength is to be packed into the lower 2 bits of cdef_y_strengths, same way as in coded stream.
                  VA-VPI driver or below is expected to do the conditional increment, which we skip here.
         if (p_frame_header->cdef_params.cdef_y_sec_strength[i] == 3) {
@@ -1987,8 +2093,8 @@ void Av1VideoParser::CdefParams(const uint8_t *p_stream, size_t &offset, Av1Sequ
         }*/
 
         if (p_seq_header->color_config.num_planes > 1) {
-            p_frame_header->cdef_params.cdef_uv_pri_strength[i] = Parser::ReadBits(p_stream, offset, 4);
-            p_frame_header->cdef_params.cdef_uv_sec_strength[i] = Parser::ReadBits(p_stream, offset, 2);
+            p_frame_header->cdef_params.cdef_uv_pri_strength[i] = bit_reader.ReadBits(4);
+            p_frame_header->cdef_params.cdef_uv_sec_strength[i] = bit_reader.ReadBits(2);
             /* Note: cdef_uv_sec_strength is to be packed into the lower 2 bits of cdef_uv_strengths, same way as in coded stream.
                      VA-VPI driver or below is expected to do the conditional increment, which we skip here.
             if (p_frame_header->cdef_params.cdef_uv_sec_strength[i] == 3) {
@@ -1998,7 +2104,7 @@ void Av1VideoParser::CdefParams(const uint8_t *p_stream, size_t &offset, Av1Sequ
     }
 }
 
-void Av1VideoParser::LrParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::LrParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     uint32_t remap_lr_type[4] = {kRestoreNone, kRestoreSwitchable, kRestoreWiener, kRestoreSgrproj};
 
     if (p_frame_header->all_lossless || p_frame_header->allow_intrabc || !p_seq_header->enable_restoration) {
@@ -2012,7 +2118,7 @@ void Av1VideoParser::LrParams(const uint8_t *p_stream, size_t &offset, Av1Sequen
     p_frame_header->lr_params.uses_lr = 0;
     uint32_t uses_chroma_lr = 0;
     for (int i = 0; i < p_seq_header->color_config.num_planes; i++) {
-        p_frame_header->lr_params.lr_type[i] = Parser::ReadBits(p_stream, offset, 2);
+        p_frame_header->lr_params.lr_type[i] = bit_reader.ReadBits(2);
         p_frame_header->lr_params.frame_restoration_type[i] = remap_lr_type[p_frame_header->lr_params.lr_type[i]];
         if (p_frame_header->lr_params.frame_restoration_type[i] != kRestoreNone) {
             p_frame_header->lr_params.uses_lr = 1;
@@ -2024,19 +2130,19 @@ void Av1VideoParser::LrParams(const uint8_t *p_stream, size_t &offset, Av1Sequen
 
     if (p_frame_header->lr_params.uses_lr) {
         if (p_seq_header->use_128x128_superblock) {
-            p_frame_header->lr_params.lr_unit_shift = Parser::GetBit(p_stream, offset);
+            p_frame_header->lr_params.lr_unit_shift = bit_reader.GetBit();
             p_frame_header->lr_params.lr_unit_shift++;
         } else {
-            p_frame_header->lr_params.lr_unit_shift = Parser::GetBit(p_stream, offset);
+            p_frame_header->lr_params.lr_unit_shift = bit_reader.GetBit();
             if (p_frame_header->lr_params.lr_unit_shift) {
-                p_frame_header->lr_params.lr_unit_extra_shift = Parser::GetBit(p_stream, offset);
+                p_frame_header->lr_params.lr_unit_extra_shift = bit_reader.GetBit();
                 p_frame_header->lr_params.lr_unit_shift += p_frame_header->lr_params.lr_unit_extra_shift;
             }
         }
 
         p_frame_header->lr_params.loop_restoration_size[0] = RESTORATION_TILESIZE_MAX >> (2 - p_frame_header->lr_params.lr_unit_shift);
         if (p_seq_header->color_config.subsampling_x && p_seq_header->color_config.subsampling_y && uses_chroma_lr) {
-            p_frame_header->lr_params.lr_uv_shift = Parser::GetBit(p_stream, offset);
+            p_frame_header->lr_params.lr_uv_shift = bit_reader.GetBit();
         } else {
             p_frame_header->lr_params.lr_uv_shift = 0;
         }
@@ -2045,11 +2151,11 @@ void Av1VideoParser::LrParams(const uint8_t *p_stream, size_t &offset, Av1Sequen
     }
 }
 
-void Av1VideoParser::ReadTxMode(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::ReadTxMode(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header) {
     if (p_frame_header->coded_lossless == 1) {
         p_frame_header->tx_mode.tx_mode = kOnly4x4;
     } else {
-        p_frame_header->tx_mode.tx_mode_select = Parser::GetBit(p_stream, offset);
+        p_frame_header->tx_mode.tx_mode_select = bit_reader.GetBit();
         if (p_frame_header->tx_mode.tx_mode_select) {
             p_frame_header->tx_mode.tx_mode = kTxModeSelect;
         } else {
@@ -2058,7 +2164,7 @@ void Av1VideoParser::ReadTxMode(const uint8_t *p_stream, size_t &offset, Av1Fram
     }
 }
 
-void Av1VideoParser::SkipModeParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::SkipModeParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     uint32_t skip_mode_allowed;
     int forward_idx, backward_idx;
     int forward_hint, backward_hint;
@@ -2118,13 +2224,13 @@ void Av1VideoParser::SkipModeParams(const uint8_t *p_stream, size_t &offset, Av1
     }
 
     if (skip_mode_allowed ) {
-        p_frame_header->skip_mode_params.skip_mode_present = Parser::GetBit(p_stream, offset);
+        p_frame_header->skip_mode_params.skip_mode_present = bit_reader.GetBit();
     } else {
         p_frame_header->skip_mode_params.skip_mode_present = 0;
     }
 }
 
-void Av1VideoParser::GlobalMotionParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::GlobalMotionParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header) {
     int ref;
     int type;
 
@@ -2139,13 +2245,13 @@ void Av1VideoParser::GlobalMotionParams(const uint8_t *p_stream, size_t &offset,
     }
 
     for (ref = kLastFrame; ref <= kAltRefFrame; ref++) {
-        p_frame_header->global_motion_params.is_global = Parser::GetBit(p_stream, offset);
+        p_frame_header->global_motion_params.is_global = bit_reader.GetBit();
         if (p_frame_header->global_motion_params.is_global) {
-            p_frame_header->global_motion_params.is_rot_zoom = Parser::GetBit(p_stream, offset);
+            p_frame_header->global_motion_params.is_rot_zoom = bit_reader.GetBit();
             if (p_frame_header->global_motion_params.is_rot_zoom) {
                 type = kRotZoom;
             } else {
-                p_frame_header->global_motion_params.is_translation = Parser::GetBit(p_stream, offset);
+                p_frame_header->global_motion_params.is_translation = bit_reader.GetBit();
                 type = p_frame_header->global_motion_params.is_translation ? kTranslation : kAffine;
             }
         } else {
@@ -2154,19 +2260,19 @@ void Av1VideoParser::GlobalMotionParams(const uint8_t *p_stream, size_t &offset,
         p_frame_header->global_motion_params.gm_type[ref] = type;
 
         if (type >= kRotZoom) {
-            ReadGlobalParam(p_stream, offset, p_frame_header, type, ref, 2);
-            ReadGlobalParam(p_stream, offset, p_frame_header, type, ref, 3);
+            ReadGlobalParam(bit_reader, p_frame_header, type, ref, 2);
+            ReadGlobalParam(bit_reader, p_frame_header, type, ref, 3);
             if (type == kAffine) {
-                ReadGlobalParam(p_stream, offset, p_frame_header, type, ref, 4);
-                ReadGlobalParam(p_stream, offset, p_frame_header, type, ref, 5);
+                ReadGlobalParam(bit_reader, p_frame_header, type, ref, 4);
+                ReadGlobalParam(bit_reader, p_frame_header, type, ref, 5);
             } else {
                 p_frame_header->global_motion_params.gm_params[ref][4] = -p_frame_header->global_motion_params.gm_params[ref][3];
                 p_frame_header->global_motion_params.gm_params[ref][5] = p_frame_header->global_motion_params.gm_params[ref][2];
             }
         }
         if (type >= kTranslation) {
-            ReadGlobalParam(p_stream, offset, p_frame_header, type, ref, 0);
-            ReadGlobalParam(p_stream, offset, p_frame_header, type, ref, 1);
+            ReadGlobalParam(bit_reader, p_frame_header, type, ref, 0);
+            ReadGlobalParam(bit_reader, p_frame_header, type, ref, 1);
         }
         if (type <= kAffine) {
             p_frame_header->global_motion_params.gm_invalid[ref] = !ShearParamsValidation(&p_frame_header->global_motion_params.gm_params[ref][0]);
@@ -2174,7 +2280,7 @@ void Av1VideoParser::GlobalMotionParams(const uint8_t *p_stream, size_t &offset,
     }
 }
 
-void Av1VideoParser::ReadGlobalParam(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header, int type, int ref, int idx) {
+void Av1VideoParser::ReadGlobalParam(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header, int type, int ref, int idx) {
     int abs_bits = GM_ABS_ALPHA_BITS;
     int prec_bits = GM_ALPHA_PREC_BITS;
 
@@ -2192,16 +2298,16 @@ void Av1VideoParser::ReadGlobalParam(const uint8_t *p_stream, size_t &offset, Av
     int sub = (idx % 3) == 2 ? (1 << prec_bits) : 0;
     int mx = (1 << abs_bits);
     int r = (prev_gm_params_[ref][idx] >> prec_diff) - sub;
-    p_frame_header->global_motion_params.gm_params[ref][idx] = (DecodeSignedSubexpWithRef(p_stream, offset, -mx, mx + 1, r) << prec_diff) + round;
+    p_frame_header->global_motion_params.gm_params[ref][idx] = (DecodeSignedSubexpWithRef(bit_reader, -mx, mx + 1, r) << prec_diff) + round;
 }
 
-int Av1VideoParser::DecodeSignedSubexpWithRef(const uint8_t *p_stream, size_t &offset, int low, int high, int r) {
-    int x = DecodeUnsignedSubexpWithRef(p_stream, offset, high - low, r - low);
+int Av1VideoParser::DecodeSignedSubexpWithRef(Parser::BitReader &bit_reader, int low, int high, int r) {
+    int x = DecodeUnsignedSubexpWithRef(bit_reader, high - low, r - low);
     return x + low;
 }
 
-int Av1VideoParser::DecodeUnsignedSubexpWithRef(const uint8_t *p_stream, size_t &offset, int mx, int r) {
-    int v = DecodeSubexp(p_stream, offset, mx);
+int Av1VideoParser::DecodeUnsignedSubexpWithRef(Parser::BitReader &bit_reader, int mx, int r) {
+    int v = DecodeSubexp(bit_reader, mx);
     if ((r << 1) <= mx) {
         return InverseRecenter(r, v);
     } else {
@@ -2209,7 +2315,7 @@ int Av1VideoParser::DecodeUnsignedSubexpWithRef(const uint8_t *p_stream, size_t
     }
 }
 
-int Av1VideoParser::DecodeSubexp(const uint8_t *p_stream, size_t &offset, int num_syms) {
+int Av1VideoParser::DecodeSubexp(Parser::BitReader &bit_reader, int num_syms) {
     int i = 0;
     int mk = 0;
     int k = 3;
@@ -2217,15 +2323,15 @@ int Av1VideoParser::DecodeSubexp(const uint8_t *p_stream, size_t &offset, int nu
         int b2 = i ? k + i - 1 : k;
         int a = 1 << b2;
         if (num_syms <= mk + 3 * a) {
-            int subexp_final_bits = ReadUnsignedNonSymmetic(p_stream, offset, num_syms - mk);
+            int subexp_final_bits = ReadUnsignedNonSymmetic(bit_reader, num_syms - mk);
             return subexp_final_bits + mk;
         } else {
-            int subexp_more_bits = Parser::GetBit(p_stream, offset);
+            int subexp_more_bits = bit_reader.GetBit();
             if (subexp_more_bits) {
                 i++;
                 mk += a;
             } else {
-                int subexp_bits = Parser::ReadBits(p_stream, offset, b2);
+                int subexp_bits = bit_reader.ReadBits(b2);
                 return subexp_bits + mk;
             }
         }
@@ -2309,7 +2415,7 @@ void Av1VideoParser::ResolveDivisor(int d, int *div_shift, int *div_factor) {
     }
 }
 
-void Av1VideoParser::FilmGrainParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
+void Av1VideoParser::FilmGrainParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header) {
     int i;
 
     if (!p_seq_header->film_grain_params_present || (!p_frame_header->show_frame && !p_frame_header->showable_frame)) {
@@ -2317,7 +2423,7 @@ void Av1VideoParser::FilmGrainParams(const uint8_t *p_stream, size_t &offset, Av
         memset(&p_frame_header->film_grain_params, 0, sizeof(Av1FilmGrainParams));
         return;
     }
-    p_frame_header->film_grain_params.apply_grain = Parser::GetBit(p_stream, offset);
+    p_frame_header->film_grain_params.apply_grain = bit_reader.GetBit();
     if ( !p_frame_header->film_grain_params.apply_grain )
     {
         // reset_grain_params()
@@ -2325,58 +2431,58 @@ void Av1VideoParser::FilmGrainParams(const uint8_t *p_stream, size_t &offset, Av
         return;
     }
 
-    p_frame_header->film_grain_params.grain_seed = Parser::ReadBits(p_stream, offset, 16);
+    p_frame_header->film_grain_params.grain_seed = bit_reader.ReadBits(16);
     if (p_frame_header->frame_type == kInterFrame) {
-        p_frame_header->film_grain_params.update_grain = Parser::GetBit(p_stream, offset);
+        p_frame_header->film_grain_params.update_grain = bit_reader.GetBit();
     } else {
         p_frame_header->film_grain_params.update_grain = 1;
     }
 
     if (!p_frame_header->film_grain_params.update_grain) {
-        p_frame_header->film_grain_params.film_grain_params_ref_idx = Parser::ReadBits(p_stream, offset, 3);
+        p_frame_header->film_grain_params.film_grain_params_ref_idx = bit_reader.ReadBits(3);
         int temp_grain_seed = p_frame_header->film_grain_params.grain_seed;
         p_frame_header->film_grain_params = dpb_buffer_.saved_film_grain_params[p_frame_header->film_grain_params.film_grain_params_ref_idx]; // load_grain_params()
         p_frame_header->film_grain_params.grain_seed = temp_grain_seed;
         return;
     }
 
-    p_frame_header->film_grain_params.num_y_points = Parser::ReadBits(p_stream, offset, 4);
+    p_frame_header->film_grain_params.num_y_points = bit_reader.ReadBits(4);
     for (i = 0; i < p_frame_header->film_grain_params.num_y_points; i++) {
-        p_frame_header->film_grain_params.point_y_value[i] = Parser::ReadBits(p_stream, offset, 8);
-        p_frame_header->film_grain_params.point_y_scaling[i] = Parser::ReadBits(p_stream, offset, 8);
+        p_frame_header->film_grain_params.point_y_value[i] = bit_reader.ReadBits(8);
+        p_frame_header->film_grain_params.point_y_scaling[i] = bit_reader.ReadBits(8);
     }
 
     if (p_seq_header->color_config.mono_chrome) {
         p_frame_header->film_grain_params.chroma_scaling_from_luma = 0;
     } else {
-        p_frame_header->film_grain_params.chroma_scaling_from_luma = Parser::GetBit(p_stream, offset);
+        p_frame_header->film_grain_params.chroma_scaling_from_luma = bit_reader.GetBit();
     }
 
     if (p_seq_header->color_config.mono_chrome || p_frame_header->film_grain_params.chroma_scaling_from_luma || (p_seq_header->color_config.subsampling_x == 1 && p_seq_header->color_config.subsampling_y == 1 && p_frame_header->film_grain_params.num_y_points == 0)) {
         p_frame_header->film_grain_params.num_cb_points = 0;
         p_frame_header->film_grain_params.num_cr_points = 0;
     } else {
-        p_frame_header->film_grain_params.num_cb_points = Parser::ReadBits(p_stream, offset, 4);
+        p_frame_header->film_grain_params.num_cb_points = bit_reader.ReadBits(4);
         for (i = 0; i < p_frame_header->film_grain_params.num_cb_points; i++) {
-            p_frame_header->film_grain_params.point_cb_value[i] = Parser::ReadBits(p_stream, offset, 8);
-            p_frame_header->film_grain_params.point_cb_scaling[i] = Parser::ReadBits(p_stream, offset, 8);
+            p_frame_header->film_grain_params.point_cb_value[i] = bit_reader.ReadBits(8);
+            p_frame_header->film_grain_params.point_cb_scaling[i] = bit_reader.ReadBits(8);
         }
-        p_frame_header->film_grain_params.num_cr_points = Parser::ReadBits(p_stream, offset, 4);
+        p_frame_header->film_grain_params.num_cr_points = bit_reader.ReadBits(4);
         for ( i = 0; i < p_frame_header->film_grain_params.num_cr_points; i++ )
         {
-            p_frame_header->film_grain_params.point_cr_value[i] = Parser::ReadBits(p_stream, offset, 8);
-            p_frame_header->film_grain_params.point_cr_scaling[i] = Parser::ReadBits(p_stream, offset, 8);
+            p_frame_header->film_grain_params.point_cr_value[i] = bit_reader.ReadBits(8);
+            p_frame_header->film_grain_params.point_cr_scaling[i] = bit_reader.ReadBits(8);
         }
     }
 
-    p_frame_header->film_grain_params.grain_scaling_minus_8 = Parser::ReadBits(p_stream, offset, 2);
-    p_frame_header->film_grain_params.ar_coeff_lag = Parser::ReadBits(p_stream, offset, 2);
+    p_frame_header->film_grain_params.grain_scaling_minus_8 = bit_reader.ReadBits(2);
+    p_frame_header->film_grain_params.ar_coeff_lag = bit_reader.ReadBits(2);
     uint32_t num_pos_luma = 2 * p_frame_header->film_grain_params.ar_coeff_lag * (p_frame_header->film_grain_params.ar_coeff_lag + 1);
     uint32_t num_pos_chroma;
     if (p_frame_header->film_grain_params.num_y_points) {
         num_pos_chroma = num_pos_luma + 1;
         for (i = 0; i < num_pos_luma; i++) {
-            p_frame_header->film_grain_params.ar_coeffs_y_plus_128[i] = Parser::ReadBits(p_stream, offset, 8);
+            p_frame_header->film_grain_params.ar_coeffs_y_plus_128[i] = bit_reader.ReadBits(8);
         }
     } else {
         num_pos_chroma = num_pos_luma;
@@ -2384,33 +2490,33 @@ void Av1VideoParser::FilmGrainParams(const uint8_t *p_stream, size_t &offset, Av
 
     if (p_frame_header->film_grain_params.chroma_scaling_from_luma || p_frame_header->film_grain_params.num_cb_points) {
         for (i = 0; i < num_pos_chroma; i++) {
-            p_frame_header->film_grain_params.ar_coeffs_cb_plus_128[i] = Parser::ReadBits(p_stream, offset, 8);
+            p_frame_header->film_grain_params.ar_coeffs_cb_plus_128[i] = bit_reader.ReadBits(8);
         }
     }
 
     if (p_frame_header->film_grain_params.chroma_scaling_from_luma || p_frame_header->film_grain_params.num_cr_points) {
         for (i = 0; i < num_pos_chroma; i++) {
-            p_frame_header->film_grain_params.ar_coeffs_cr_plus_128[i] = Parser::ReadBits(p_stream, offset, 8);
+            p_frame_header->film_grain_params.ar_coeffs_cr_plus_128[i] = bit_reader.ReadBits(8);
         }
     }
 
-    p_frame_header->film_grain_params.ar_coeff_shift_minus_6 = Parser::ReadBits(p_stream, offset, 2);
-    p_frame_header->film_grain_params.grain_scale_shift = Parser::ReadBits(p_stream, offset, 2);
+    p_frame_header->film_grain_params.ar_coeff_shift_minus_6 = bit_reader.ReadBits(2);
+    p_frame_header->film_grain_params.grain_scale_shift = bit_reader.ReadBits(2);
 
     if (p_frame_header->film_grain_params.num_cb_points) {
-        p_frame_header->film_grain_params.cb_mult = Parser::ReadBits(p_stream, offset, 8);
-        p_frame_header->film_grain_params.cb_luma_mult = Parser::ReadBits(p_stream, offset, 8);
-        p_frame_header->film_grain_params.cb_offset = Parser::ReadBits(p_stream, offset, 9);
+        p_frame_header->film_grain_params.cb_mult = bit_reader.ReadBits(8);
+        p_frame_header->film_grain_params.cb_luma_mult = bit_reader.ReadBits(8);
+        p_frame_header->film_grain_params.cb_offset = bit_reader.ReadBits(9);
     }
 
     if (p_frame_header->film_grain_params.num_cr_points) {
-        p_frame_header->film_grain_params.cr_mult = Parser::ReadBits(p_stream, offset, 8);
-        p_frame_header->film_grain_params.cr_luma_mult = Parser::ReadBits(p_stream, offset, 8);
-        p_frame_header->film_grain_params.cr_offset = Parser::ReadBits(p_stream, offset, 9);
+        p_frame_header->film_grain_params.cr_mult = bit_reader.ReadBits(8);
+        p_frame_header->film_grain_params.cr_luma_mult = bit_reader.ReadBits(8);
+        p_frame_header->film_grain_params.cr_offset = bit_reader.ReadBits(9);
     }
 
-    p_frame_header->film_grain_params.overlap_flag = Parser::GetBit(p_stream, offset);
-    p_frame_header->film_grain_params.clip_to_restricted_range = Parser::GetBit(p_stream, offset);
+    p_frame_header->film_grain_params.overlap_flag = bit_reader.GetBit();
+    p_frame_header->film_grain_params.clip_to_restricted_range = bit_reader.GetBit();
 }
 
 #if DBGINFO
@@ -2688,7 +2794,7 @@ void Av1VideoParser::PrintDpb() {
     if (num_output_pics_) {
         MSG_NO_NEWLINE("output_pic_list:");
         for (i = 0; i < num_output_pics_; i++) {
-            MSG_NO_NEWLINE(" " << output_pic_list_[i]);
+            MSG_NO_NEWLINE(" " << GetOutputPicture(i));
         }
         MSG("");
     }
@@ -55,6 +55,12 @@ public:
      */
     virtual rocDecStatus UnInitialize();     // derived method
 
+    /*! \brief function to reset the AV1 parser, e.g. after a seek
+     * \param [in] flags Combination of <tt>RocdecParserResetFlags</tt>
+     * @return rocDecStatus
+     */
+    virtual rocDecStatus Reset(uint32_t flags);
+
     typedef struct {
         uint32_t tile_offset;
         uint32_t tile_size;
@@ -117,6 +123,7 @@ protected:
     uint32_t obu_byte_offset_; // current OBU byte offset, not including header and obu_size syntax elements
 
     uint32_t seen_frame_header_; // SeenFrameHeader
+    bool skip_curr_frame_; // the OBUs of the current frame are dropped in keyframe only mode
     Av1SequenceHeader seq_header_;
     Av1FrameHeader frame_header_;
     Av1TileGroupDataInfo tile_group_data_;
@@ -191,15 +198,30 @@ protected:
 
     /*! \brief Function to parse an OBU header
      * \param [in] p_stream Pointer to the bit stream
+     * \param [in] size Byte size of the stream
      * \return <tt>ParserResult</tt>
      */
-    ParserResult ParseObuHeader(const uint8_t *p_stream);
+    ParserResult ParseObuHeader(const uint8_t *p_stream, size_t size);
 
     /*! \brief Function to parse an OBU header and size
      * \return <tt>ParserResult</tt>
      */
     ParserResult ReadObuHeaderAndSize();
 
+    /*! \brief Function to check if the current OBU is to be dropped: it belongs to a temporal layer above max_temporal_id_plus1
+     *  or is not part of the selected operating point, or belongs to a frame other than a key frame in keyframe only mode
+     * \return true if the OBU is dropped
+     */
+    bool IsObuDropped();
+
+    /*! \brief Function to check if a frame is a shown key frame (or error resilient intra only frame) from the first bits of its
+     *  uncompressed header
+     * \param [in] p_stream Pointer to the frame header OBU payload
+     * \param [in] size Byte size of the payload
+     * \return true if the frame is decoded in keyframe only mode
+     */
+    bool IsKeyFrame(const uint8_t *p_stream, size_t size);
+
     /*! \brief Function to parse a sequence header OBU. 5.5.
      * \param [in] p_stream Pointer to the bit stream
      * \param [in] size Byte size of the stream
@@ -231,13 +253,11 @@ protected:
     void ParseTileGroupObu(uint8_t *p_stream, size_t size);
 
     /*! \brief Function to parse color config in sequence header
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_seq_header Pointer to sequence header struct
      * \return None
      */
-    void ParseColorConfig(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header);
+    void ParseColorConfig(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header);
 
     /*! \brief Function to mark reference frames
      * \param [in] p_seq_header Pointer to sequence header
@@ -247,24 +267,20 @@ protected:
     void MarkRefFrames(Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header, uint32_t id_len);
 
     /*! \brief Function to parse frame size
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void FrameSize(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void FrameSize(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse super res parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void SuperResParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void SuperResParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to calculate 4x4 block columns and rows of the frame
      * \param [in] p_frame_header Pointer to frame header struct
@@ -274,13 +290,11 @@ protected:
     void ComputeImageSize(Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse render size info
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void RenderSize(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header);
+    void RenderSize(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to compute the distance between two order hints by sign extending the result of subtracting the values.
      * \param [in] p_seq_header Pointer to sequence header struct
@@ -325,14 +339,12 @@ protected:
     int FindLatestForward(int *shifted_order_hints, int *used_frame, int curr_frame_hint, int &latest_order_hint);
 
     /*! \brief Function to parse frame size with refs info
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void FrameSizeWithRefs(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void FrameSizeWithRefs(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to indicate that this frame can be decoded without dependence on previous coded frames. setup_past_independence() in spec.
      * \param [out] p_frame_header Pointer to frame header struct
@@ -345,14 +357,12 @@ protected:
     void LoadPrevious(Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse tile info
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void TileInfo(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void TileInfo(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to calculate the smallest value for k such that blk_size << k is greater than or equal to target.
      * \param [in] blk_size Block size
@@ -362,50 +372,40 @@ protected:
     uint32_t TileLog2(uint32_t blk_size, uint32_t target);
 
     /*! \brief Function to parse quantization parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void QuantizationParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void QuantizationParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to read delta quantizer
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \return Delta quantizer value
      */
-    int32_t ReadDeltaQ(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header);
+    int32_t ReadDeltaQ(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to segmentation parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void SegmentationParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header);
+    void SegmentationParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse quantizer index delta parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void DeltaQParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header);
+    void DeltaQParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse loop filter delta parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void DeltaLFParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header);
+    void DeltaLFParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to return the quantizer index for the current block
      *  \param [in] p_frame_header Pointer to frame header struct
@@ -416,86 +416,72 @@ protected:
     int GetQIndex(Av1FrameHeader *p_frame_header, int ignore_delta_q, int segment_id);
 
     /*! \brief Function to parse loop filter parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void LoopFilterParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void LoopFilterParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse CDEF parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void CdefParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void CdefParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to loop restoration parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void LrParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void LrParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse TX mode
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void ReadTxMode(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header);
+    void ReadTxMode(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to skip mode parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void SkipModeParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void SkipModeParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to parse global motion parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void GlobalMotionParams(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header);
+    void GlobalMotionParams(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to calculate global motion parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_frame_header Pointer to frame header struct
      * \param [in] type Motion type
      * \param [in] ref Reference frame
      * \param [in] idx Parameter index
      * \return None
      */
-    void ReadGlobalParam(const uint8_t *p_stream, size_t &offset, Av1FrameHeader *p_frame_header, int type, int ref, int idx);
+    void ReadGlobalParam(Parser::BitReader &bit_reader, Av1FrameHeader *p_frame_header, int type, int ref, int idx);
 
     /*! \brief Function to decode signed subexp with ref. 5.9.26. decode_signed_subexp_with_ref()
      */
-    int DecodeSignedSubexpWithRef(const uint8_t *p_stream, size_t &offset, int low, int high, int r);
+    int DecodeSignedSubexpWithRef(Parser::BitReader &bit_reader, int low, int high, int r);
 
     /*! \brief Function to decode unsigned subexp with ref. 5.9.27. decode_unsigned_subexp_with_ref()
      */
-    int DecodeUnsignedSubexpWithRef(const uint8_t *p_stream, size_t &offset, int mx, int r);
+    int DecodeUnsignedSubexpWithRef(Parser::BitReader &bit_reader, int mx, int r);
 
     /*! \brief Function to decode subexp. 5.9.28. decode_subexp()
      */
-    int DecodeSubexp(const uint8_t *p_stream, size_t &offset, int num_syms);
+    int DecodeSubexp(Parser::BitReader &bit_reader, int num_syms);
 
     /*! \brief Function to inverse recenter. 5.9.29. inverse_recenter()
      */
@@ -517,14 +503,12 @@ protected:
     void ResolveDivisor(int d, int *div_shift, int *div_factor);
 
     /*! \brief Function to parse film grain parameters
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [in] offset Starting bit offset
-     * \param [out] offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] p_seq_header Pointer to sequence header struct
      * \param [out] p_frame_header Pointer to frame header struct
      * \return None
      */
-    void FilmGrainParams(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
+    void FilmGrainParams(Parser::BitReader &bit_reader, Av1SequenceHeader *p_seq_header, Av1FrameHeader *p_frame_header);
 
     /*! \brief Function to round a number to 2^n
      *  \param [in] x The number to be rounded
@@ -562,14 +546,12 @@ protected:
     }
 
     /*! \brief Function to read variable length unsigned n-bit number appearing directly in the bitstream. 4.10.3. uvlc().
-     * \param [in] p_stream Bit stream pointer
-     * \param [in] bit_offset Starting bit offset
-     * \param [out] bit_offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return The unsigned value
      */
-    inline uint32_t ReadUVLC(const uint8_t *p_stream, size_t &bit_offset) {
+    inline uint32_t ReadUVLC(Parser::BitReader &bit_reader) {
         int leading_zeros = 0;
-        while (!Parser::GetBit(p_stream, bit_offset)) {
+        while (!bit_reader.GetBit() && !bit_reader.IsOverrun()) {
             ++leading_zeros;
         }
         // Maximum 32 bits.
@@ -577,7 +559,7 @@ protected:
             return 0xFFFFFFFF;
         }
         uint32_t base = (1u << leading_zeros) - 1;
-        uint32_t value = Parser::ReadBits(p_stream, bit_offset, leading_zeros);
+        uint32_t value = bit_reader.ReadBits(leading_zeros);
         return base + value;
     }
 
@@ -616,15 +598,13 @@ protected:
     }
 
     /*! \brief Function to read signed integer converted from an n bits unsigned integer in the bitstream. 4.10.6. su(n).
-     * \param [in] p_stream Bit stream pointer
-     * \param [in] bit_offset Starting bit offset
-     * \param [out] bit_offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] num_bits Number of bits to read
      * \return The signed value
      */
-    inline int32_t ReadSigned(const uint8_t *p_stream, size_t &bit_offset, int num_bits) {
+    inline int32_t ReadSigned(Parser::BitReader &bit_reader, int num_bits) {
         int32_t value;
-        uint32_t u_value = Parser::ReadBits(p_stream, bit_offset, num_bits);
+        uint32_t u_value = bit_reader.ReadBits(num_bits);
         uint32_t sign_mask = 1 << (num_bits - 1);
         if ( u_value & sign_mask ) {
             value = u_value - 2 * sign_mask;
@@ -637,20 +617,18 @@ protected:
     /*! \brief Function to read unsigned encoded (non-symmetric) integer with maximum number of values num_bits 
      *         (i.e. output in range 0..num_bits-1). This encoding is non-symmetric because the values are not all 
      *         coded with the same number of bits. 4.10.7. ns(n).
-     * \param [in] p_stream Bit stream pointer
-     * \param [in] bit_offset Starting bit offset
-     * \param [out] bit_offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] num_bits Number of bits to read
      * \return The unsigned value
      */
-    inline uint32_t ReadUnsignedNonSymmetic(const uint8_t *p_stream, size_t &bit_offset, int num_bits) {
+    inline uint32_t ReadUnsignedNonSymmetic(Parser::BitReader &bit_reader, int num_bits) {
         uint32_t w = FloorLog2(num_bits) + 1;
         uint32_t m = (1 << w) - num_bits;
-        uint32_t v = Parser::ReadBits(p_stream, bit_offset, w - 1);
+        uint32_t v = bit_reader.ReadBits(w - 1);
         if (v < m) {
             return v;
         }
-        uint32_t extra_bit = Parser::GetBit(p_stream, bit_offset);
+        uint32_t extra_bit = bit_reader.GetBit();
         return (v << 1) - m + extra_bit;
     }
 
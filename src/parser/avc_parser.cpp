@@ -61,9 +61,54 @@ rocDecStatus AvcVideoParser::UnInitialize() {
     return ROCDEC_SUCCESS;
 }
 
+rocDecStatus AvcVideoParser::Reset(uint32_t flags) {
+    if ((flags & ROCDEC_PARSER_RESET_FLUSH) && FlushDpb() != PARSER_OK) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    // DPB size is only set when an SPS is activated, keep it for the active SPS
+    uint32_t dpb_size = dpb_buffer_.dpb_size;
+    InitDpb();
+    prev_pic_order_cnt_msb_ = 0;
+    prev_pic_order_cnt_lsb_ = 0;
+    prev_top_field_order_cnt_ = 0;
+    prev_frame_num_offset_ = 0;
+    prev_frame_num_ = 0;
+    prev_ref_frame_num_ = 0;
+    prev_has_mmco_5_ = 0;
+    curr_has_mmco_5_ = 0;
+    prev_ref_pic_bottom_field_ = 0;
+    curr_ref_pic_bottom_field_ = 0;
+    max_long_term_frame_idx_ = NO_LONG_TERM_FRAME_INDICES;
+    field_pic_count_ = 0;
+    second_field_ = 0;
+    first_field_pic_idx_ = 0;
+    first_field_dec_buf_idx_ = 0;
+    memset(&curr_pic_, 0, sizeof(AvcPicture));
+    slice_info_list_.assign(slice_info_list_.size(), {0});
+    slice_param_list_.assign(slice_param_list_.size(), {0});
+    if (flags & ROCDEC_PARSER_RESET_KEEP_PARAM_SETS) {
+        dpb_buffer_.dpb_size = dpb_size;
+    } else {
+        active_sps_id_ = -1;
+        active_pps_id_ = -1;
+        for (int i = 0; i < AVC_MAX_SPS_NUM; i++) {
+            sps_list_[i].is_received = 0;
+        }
+        for (int i = 0; i < AVC_MAX_PPS_NUM; i++) {
+            pps_list_[i].is_received = 0;
+        }
+    }
+    return RocVideoParser::Reset(flags);
+}
+
 rocDecStatus AvcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
+    // A discontinuity, e.g. after a splice or a seek: output the pending pictures, then drop the reference state
+    if ((p_data->flags & ROCDEC_PKT_DISCONTINUITY) && Reset(ROCDEC_PARSER_RESET_FLUSH | ROCDEC_PARSER_RESET_KEEP_PARAM_SETS) != ROCDEC_SUCCESS) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
     if (p_data->payload && p_data->payload_size) {
         curr_pts_ = p_data->pts;
+        IndexNalUnits(p_data, rocDecVideoCodec_AVC);
         if (ParsePictureData(p_data->payload, p_data->payload_size) != PARSER_OK) {
             ERR(STR("Parser failed!"));
             return ROCDEC_RUNTIME_ERROR;
@@ -78,7 +123,7 @@ rocDecStatus AvcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
         }
 
         // Whenever new sei message found
-        if (pfn_get_sei_message_cb_ && sei_message_count_ > 0) {
+        if (pfn_get_sei_message_cb_ && sei_message_count_ > 0 && !pic_skipped_) {
             SendSeiMsgPayload();
         }
 
@@ -113,6 +158,11 @@ rocDecStatus AvcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
         }
 
         pic_count_++;
+
+        // Keyframe only: output the frame right away once it is complete. The next IDR picture does not refer to it.
+        if (parser_params_.keyframe_only && !(field_pic_count_ & 1) && FlushDpb() != PARSER_OK) {
+            return ROCDEC_RUNTIME_ERROR;
+        }
     } else if (!(p_data->flags & ROCDEC_PKT_ENDOFSTREAM)) {
         // If no payload and EOS is not set, treated as invalid.
         return ROCDEC_INVALID_PARAMETER;
@@ -128,46 +178,56 @@ rocDecStatus AvcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
 }
 
 ParserResult AvcVideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t pic_data_size) {
-    ParserResult ret = PARSER_OK;
     ParserResult ret2;
 
     pic_data_buffer_ptr_ = (uint8_t*)p_stream;
     pic_data_size_ = pic_data_size;
-    curr_byte_offset_ = 0;
-    start_code_num_ = 0;
     curr_start_code_offset_ = 0;
-    next_start_code_offset_ = 0;
+    nal_unit_size_ = 0;
 
     num_slices_ = 0;
+    pic_skipped_ = false;
     sei_message_count_ = 0;
     sei_payload_size_ = 0;
     curr_pic_ = {0};
 
-    do {
-        ret = GetNalUnit();
-        if (ret == PARSER_NOT_FOUND) {
-            ERR(STR("Error: no start code found in the frame data."));
-            return ret;
-        }
+    if (num_nal_units_ == 0) {
+        ERR(STR("Error: no start code found in the frame data."));
+        return PARSER_NOT_FOUND;
+    }
+
+    for (uint32_t i = 0; i < num_nal_units_; i++) {
+        curr_start_code_offset_ = nal_units_[i].offset;
+        nal_unit_size_ = nal_units_[i].size;
 
         // Parse the NAL unit
         if (nal_unit_size_) {
             // start code + NAL unit header = 4 bytes
-            int ebsp_size = nal_unit_size_ - 4 > RBSP_BUF_SIZE ? RBSP_BUF_SIZE : nal_unit_size_ - 4; // only copy enough bytes for header parsing
-
             nal_unit_header_ = ParseNalUnitHeader(pic_data_buffer_ptr_[curr_start_code_offset_ + 3]);
+            // Drop the non-reference pictures, except the second field of a pair whose first field is decoded
+            if (IsNonRefPicDropped() && nal_unit_header_.nal_ref_idc == 0 && !(field_pic_count_ & 1) &&
+                nal_unit_header_.nal_unit_type >= kAvcNalTypeSlice_Non_IDR && nal_unit_header_.nal_unit_type <= kAvcNalTypeSlice_Data_Partition_C) {
+                if (nal_unit_header_.nal_unit_type <= kAvcNalTypeSlice_Data_Partition_A && nal_unit_size_ > 4 &&
+                    (pic_data_buffer_ptr_[curr_start_code_offset_ + 4] & 0x80)) {  // first_mb_in_slice is 0
+                    CountDroppedNonRefPic();
+                }
+                pic_skipped_ = true;
+                continue;
+            }
+            // Keyframe only: drop the non-IDR pictures without parsing the slice headers, except the second field of an IDR picture
+            if (parser_params_.keyframe_only && !(field_pic_count_ & 1) &&
+                nal_unit_header_.nal_unit_type >= kAvcNalTypeSlice_Non_IDR && nal_unit_header_.nal_unit_type <= kAvcNalTypeSlice_Data_Partition_C) {
+                pic_skipped_ = true;
+                continue;
+            }
             switch (nal_unit_header_.nal_unit_type) {
                 case kAvcNalTypeSeq_Parameter_Set: {
-                    memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 4), ebsp_size);
-                    rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
-                    ParseSps(rbsp_buf_, rbsp_size_);
+                    ParseSps(pic_data_buffer_ptr_ + curr_start_code_offset_ + 4, nal_unit_size_ - 4);
                     break;
                 }
 
                 case kAvcNalTypePic_Parameter_Set: {
-                    memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 4), ebsp_size);
-                    rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
-                    if ((ret2 = ParsePps(rbsp_buf_, rbsp_size_)) != PARSER_OK) {
+                    if ((ret2 = ParsePps(pic_data_buffer_ptr_ + curr_start_code_offset_ + 4, nal_unit_size_ - 4)) != PARSER_OK) {
                         return ret2;
                     }
                     break;
@@ -189,10 +249,8 @@ ParserResult AvcVideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                     slice_info_list_[num_slices_].slice_data_offset = curr_start_code_offset_;
                     slice_info_list_[num_slices_].slice_data_size = nal_unit_size_;
 
-                    memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 4), ebsp_size);
-                    rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
                     AvcSliceHeader *p_slice_header = &slice_info_list_[num_slices_].slice_header;
-                    if ((ret2 = ParseSliceHeader(rbsp_buf_, rbsp_size_, p_slice_header)) != PARSER_OK) {
+                    if ((ret2 = ParseSliceHeader(pic_data_buffer_ptr_ + curr_start_code_offset_ + 4, nal_unit_size_ - 4, p_slice_header)) != PARSER_OK) {
                         return ret2;
                     }
 
@@ -252,20 +310,7 @@ ParserResult AvcVideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
 
                 case kAvcNalTypeSEI_Info: {
                     if (pfn_get_sei_message_cb_) {
-                        int sei_ebsp_size = nal_unit_size_ - 4; // copy the entire NAL unit
-                        if (sei_rbsp_buf_) {
-                            if (sei_ebsp_size > sei_rbsp_buf_size_) {
-                                delete [] sei_rbsp_buf_;
-                                sei_rbsp_buf_ = new uint8_t [sei_ebsp_size];
-                                sei_rbsp_buf_size_ = sei_ebsp_size;
-                            }
-                        } else {
-                            sei_rbsp_buf_size_ = sei_ebsp_size > INIT_SEI_PAYLOAD_BUF_SIZE ? sei_ebsp_size : INIT_SEI_PAYLOAD_BUF_SIZE;
-                            sei_rbsp_buf_ = new uint8_t [sei_rbsp_buf_size_];
-                        }
-                        memcpy(sei_rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 4), sei_ebsp_size);
-                        rbsp_size_ = EbspToRbsp(sei_rbsp_buf_, 0, sei_ebsp_size);
-                        ParseSeiMessage(sei_rbsp_buf_, rbsp_size_);
+                        ParseSeiNalUnit(pic_data_buffer_ptr_ + curr_start_code_offset_ + 4, nal_unit_size_ - 4);
                     }
                     break;
                 }
@@ -284,12 +329,7 @@ ParserResult AvcVideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                     break;
             }
         }
-
-        // Break if this is the last NAL unit
-        if (ret == PARSER_EOF) {
-            break;
-        }
-    } while (1);
+    }
 
     return PARSER_OK;
 }
@@ -399,19 +439,11 @@ ParserResult AvcVideoParser::NotifyNewSps(AvcSeqParameterSet *p_sps) {
     video_format_params_.seqhdr_data_length = 0;
 
     // callback function with RocdecVideoFormat params filled out
-    if (pfn_sequece_cb_(parser_params_.user_data, &video_format_params_) == 0) {
-        ERR("Sequence callback function failed.");
-        return PARSER_FAIL;
-    } else {
-        return PARSER_OK;
-    }
+    return ReportVideoFormat();
 }
 
 void AvcVideoParser::SendSeiMsgPayload() {
-    sei_message_info_params_.sei_message_count = sei_message_count_;
-    sei_message_info_params_.sei_message = sei_message_list_.data();
-    sei_message_info_params_.sei_data = (void*)sei_payload_buf_;
-    sei_message_info_params_.picIdx = curr_pic_.dec_buf_idx;
+    SetSeiMessageInfo(curr_pic_.dec_buf_idx);
 
     // callback function with RocdecSeiMessageInfo params filled out
     if (pfn_get_sei_message_cb_) pfn_get_sei_message_cb_(parser_params_.user_data, &sei_message_info_params_);
@@ -456,6 +488,26 @@ ParserResult AvcVideoParser::SendPicForDecode() {
     dec_pic_params_.ref_pic_flag = slice_nal_unit_header_.nal_ref_idc;
     dec_pic_params_.intra_pic_flag = p_slice_header->slice_type == kAvcSliceTypeI || p_slice_header->slice_type == kAvcSliceTypeI_7 || p_slice_header->slice_type == kAvcSliceTypeSI || p_slice_header->slice_type == kAvcSliceTypeSI_9;
 
+    if (parser_params_.header_only) {
+        RocdecParsedPicInfo pic_info = {};
+        pic_info.pic_type = ROCDEC_PIC_TYPE_I;
+        for (i = 0; i < num_slices_; i++) {
+            // slice_type % 5: 0 = P, 1 = B, 2 = I, 3 = SP, 4 = SI
+            uint32_t slice_type = slice_info_list_[i].slice_header.slice_type % 5;
+            if (slice_type == kAvcSliceTypeB) {
+                pic_info.pic_type = ROCDEC_PIC_TYPE_B;
+                break;
+            } else if (slice_type == kAvcSliceTypeP || slice_type == kAvcSliceTypeSP) {
+                pic_info.pic_type = ROCDEC_PIC_TYPE_P;
+            }
+        }
+        pic_info.pic_order_cnt = curr_pic_.pic_order_cnt;
+        pic_info.qp = 26 + p_pps->pic_init_qp_minus26 + p_slice_header->slice_qp_delta;
+        pic_info.ref_pic_flag = slice_nal_unit_header_.nal_ref_idc ? 1 : 0;
+        pic_info.key_frame_flag = slice_nal_unit_header_.nal_unit_type == kAvcNalTypeSlice_IDR ? 1 : 0;
+        return OutputParsedPicture(&pic_info);
+    }
+
     // Set up the picture parameter buffer
     RocdecAvcPicParams *p_pic_param = &dec_pic_params_.pic_params.avc;
 
@@ -713,12 +765,11 @@ ParserResult AvcVideoParser::SendPicForDecode() {
 }
 
 AvcNalUnitHeader AvcVideoParser::ParseNalUnitHeader(uint8_t header_byte) {
-    size_t bit_offset = 0;
     AvcNalUnitHeader nal_header;
 
-    nal_header.forbidden_zero_bit = Parser::GetBit(&header_byte, bit_offset);
-    nal_header.nal_ref_idc = Parser::ReadBits(&header_byte, bit_offset, 2);
-    nal_header.nal_unit_type = Parser::ReadBits(&header_byte, bit_offset, 5);
+    nal_header.forbidden_zero_bit = (header_byte >> 7) & 1;
+    nal_header.nal_ref_idc = (header_byte >> 5) & 3;
+    nal_header.nal_unit_type = header_byte & 0x1F;
     return nal_header;
 }
 
@@ -777,22 +828,29 @@ const int Default_8x8_Inter[64] = {
 };
 
 void AvcVideoParser::ParseSps(uint8_t *p_stream, size_t size) {
-    size_t offset = 0;  // current bit offset
+    Parser::BitReader bit_reader(p_stream, size, true);
     AvcSeqParameterSet *p_sps = nullptr;
 
     // Parse and temporarily store till set id
-    uint32_t profile_idc = Parser::ReadBits(p_stream, offset, 8);
-    uint32_t constraint_set0_flag = Parser::GetBit(p_stream, offset);
-    uint32_t constraint_set1_flag = Parser::GetBit(p_stream, offset);
-    uint32_t constraint_set2_flag = Parser::GetBit(p_stream, offset);
-    uint32_t constraint_set3_flag = Parser::GetBit(p_stream, offset);
-    uint32_t constraint_set4_flag = Parser::GetBit(p_stream, offset);
-    uint32_t constraint_set5_flag = Parser::GetBit(p_stream, offset);
-    uint32_t reserved_zero_2bits = Parser::ReadBits(p_stream, offset, 2);
-    uint32_t level_idc = Parser::ReadBits(p_stream, offset, 8);
-    uint32_t seq_parameter_set_id = Parser::ExpGolomb::ReadUe(p_stream, offset);
+    uint32_t profile_idc = bit_reader.ReadBits(8);
+    uint32_t constraint_set0_flag = bit_reader.GetBit();
+    uint32_t constraint_set1_flag = bit_reader.GetBit();
+    uint32_t constraint_set2_flag = bit_reader.GetBit();
+    uint32_t constraint_set3_flag = bit_reader.GetBit();
+    uint32_t constraint_set4_flag = bit_reader.GetBit();
+    uint32_t constraint_set5_flag = bit_reader.GetBit();
+    uint32_t reserved_zero_2bits = bit_reader.ReadBits(2);
+    uint32_t level_idc = bit_reader.ReadBits(8);
+    uint32_t seq_parameter_set_id = bit_reader.ReadUe();
 
     p_sps = &sps_list_[seq_parameter_set_id];
+    if (param_set_cache_.Lookup(kParamSetSps, seq_parameter_set_id, p_stream, size)) {
+        return;  // identical to the stored SPS with the same id
+    }
+    // The stored SPS is cleared below: a failed parse must not leave its payload in the cache
+    param_set_cache_.Invalidate(kParamSetSps, seq_parameter_set_id);
+    // PPS parsing depends on the SPS (e.g. scaling list fall-back rules), so the stored PPS payloads can no longer be trusted
+    param_set_cache_.Invalidate(kParamSetPps);
     memset(p_sps, 0, sizeof(AvcSeqParameterSet));
 
     p_sps->profile_idc = profile_idc;
@@ -819,23 +877,23 @@ void AvcVideoParser::ParseSps(uint8_t *p_stream, size_t size) {
         p_sps->profile_idc == 139 ||
         p_sps->profile_idc == 134 ||
         p_sps->profile_idc == 135) {
-        p_sps->chroma_format_idc = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_sps->chroma_format_idc = bit_reader.ReadUe();
         if (p_sps->chroma_format_idc == 3) {
-            p_sps->separate_colour_plane_flag = Parser::GetBit(p_stream, offset);
+            p_sps->separate_colour_plane_flag = bit_reader.GetBit();
         }
         
-        p_sps->bit_depth_luma_minus8 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_sps->bit_depth_chroma_minus8 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_sps->qpprime_y_zero_transform_bypass_flag = Parser::GetBit(p_stream, offset);
-        p_sps->seq_scaling_matrix_present_flag = Parser::GetBit(p_stream, offset);
+        p_sps->bit_depth_luma_minus8 = bit_reader.ReadUe();
+        p_sps->bit_depth_chroma_minus8 = bit_reader.ReadUe();
+        p_sps->qpprime_y_zero_transform_bypass_flag = bit_reader.GetBit();
+        p_sps->seq_scaling_matrix_present_flag = bit_reader.GetBit();
         if (p_sps->seq_scaling_matrix_present_flag == 1) {
             for (int i = 0; i < ((p_sps->chroma_format_idc != 3) ? 8 : 12); i++) {
-                p_sps->seq_scaling_list_present_flag[i] = Parser::GetBit(p_stream, offset);
+                p_sps->seq_scaling_list_present_flag[i] = bit_reader.GetBit();
                 if (p_sps->seq_scaling_list_present_flag[i] == 1) {
                     if ( i < 6 ) {
-                        GetScalingList(p_stream, offset, p_sps->scaling_list_4x4[i], 16, &p_sps->use_default_scaling_matrix_4x4_flag[i]);
+                        GetScalingList(bit_reader, p_sps->scaling_list_4x4[i], 16, &p_sps->use_default_scaling_matrix_4x4_flag[i]);
                     } else {
-                        GetScalingList(p_stream, offset, p_sps->scaling_list_8x8[i - 6], 64, &p_sps->use_default_scaling_matrix_8x8_flag[i - 6]);
+                        GetScalingList(bit_reader, p_sps->scaling_list_8x8[i - 6], 64, &p_sps->use_default_scaling_matrix_8x8_flag[i - 6]);
                     }
                 }
             }
@@ -920,44 +978,50 @@ void AvcVideoParser::ParseSps(uint8_t *p_stream, size_t size) {
         }
     }
 
-    p_sps->log2_max_frame_num_minus4 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_sps->pic_order_cnt_type = Parser::ExpGolomb::ReadUe(p_stream, offset);
+    p_sps->log2_max_frame_num_minus4 = bit_reader.ReadUe();
+    p_sps->pic_order_cnt_type = bit_reader.ReadUe();
     if (p_sps->pic_order_cnt_type == 0 ) {
-        p_sps->log2_max_pic_order_cnt_lsb_minus4 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_sps->log2_max_pic_order_cnt_lsb_minus4 = bit_reader.ReadUe();
     } else if (p_sps->pic_order_cnt_type == 1) {
-        p_sps->delta_pic_order_always_zero_flag = Parser::GetBit(p_stream, offset);
-        p_sps->offset_for_non_ref_pic = Parser::ExpGolomb::ReadSe(p_stream, offset);
-        p_sps->offset_for_top_to_bottom_field = Parser::ExpGolomb::ReadSe(p_stream, offset);
-        p_sps->num_ref_frames_in_pic_order_cnt_cycle = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_sps->delta_pic_order_always_zero_flag = bit_reader.GetBit();
+        p_sps->offset_for_non_ref_pic = bit_reader.ReadSe();
+        p_sps->offset_for_top_to_bottom_field = bit_reader.ReadSe();
+        p_sps->num_ref_frames_in_pic_order_cnt_cycle = bit_reader.ReadUe();
         for (int i = 0; i < p_sps->num_ref_frames_in_pic_order_cnt_cycle; i++) {
-            p_sps->offset_for_ref_frame[i] = Parser::ExpGolomb::ReadSe(p_stream, offset);
+            p_sps->offset_for_ref_frame[i] = bit_reader.ReadSe();
         }
     }
 
-    p_sps->max_num_ref_frames = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_sps->gaps_in_frame_num_value_allowed_flag = Parser::GetBit(p_stream, offset);
-    p_sps->pic_width_in_mbs_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_sps->pic_height_in_map_units_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_sps->frame_mbs_only_flag = Parser::GetBit(p_stream, offset);
+    p_sps->max_num_ref_frames = bit_reader.ReadUe();
+    p_sps->gaps_in_frame_num_value_allowed_flag = bit_reader.GetBit();
+    p_sps->pic_width_in_mbs_minus1 = bit_reader.ReadUe();
+    p_sps->pic_height_in_map_units_minus1 = bit_reader.ReadUe();
+    p_sps->frame_mbs_only_flag = bit_reader.GetBit();
     if (!p_sps->frame_mbs_only_flag) {
-        p_sps->mb_adaptive_frame_field_flag = Parser::GetBit(p_stream, offset);
+        p_sps->mb_adaptive_frame_field_flag = bit_reader.GetBit();
     }
 
-    p_sps->direct_8x8_inference_flag = Parser::GetBit(p_stream, offset);
-    p_sps->frame_cropping_flag = Parser::GetBit(p_stream, offset);
+    p_sps->direct_8x8_inference_flag = bit_reader.GetBit();
+    p_sps->frame_cropping_flag = bit_reader.GetBit();
     if (p_sps->frame_cropping_flag) {
-        p_sps->frame_crop_left_offset = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_sps->frame_crop_right_offset = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_sps->frame_crop_top_offset = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_sps->frame_crop_bottom_offset = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_sps->frame_crop_left_offset = bit_reader.ReadUe();
+        p_sps->frame_crop_right_offset = bit_reader.ReadUe();
+        p_sps->frame_crop_top_offset = bit_reader.ReadUe();
+        p_sps->frame_crop_bottom_offset = bit_reader.ReadUe();
     }
 
-    p_sps->vui_parameters_present_flag = Parser::GetBit(p_stream, offset);
+    p_sps->vui_parameters_present_flag = bit_reader.GetBit();
     if (p_sps->vui_parameters_present_flag == 1) {
-        GetVuiParameters(p_stream, offset, &p_sps->vui_seq_parameters);
+        GetVuiParameters(bit_reader, &p_sps->vui_seq_parameters);
     }
 
     p_sps->is_received = 1;  // confirm SPS with seq_parameter_set_id received (but not activated)
+    param_set_cache_.Insert(kParamSetSps, seq_parameter_set_id, p_stream, size);
+    // The active SPS has been replaced by a different one with the same id. The sequence callback is only called if the
+    // video format has changed.
+    if (static_cast<int32_t>(seq_parameter_set_id) == active_sps_id_) {
+        new_seq_activated_ = true;
+    }
 
 #if DBGINFO
     PrintSps(p_sps);
@@ -967,79 +1031,84 @@ void AvcVideoParser::ParseSps(uint8_t *p_stream, size_t size) {
 ParserResult AvcVideoParser::ParsePps(uint8_t *p_stream, size_t stream_size_in_byte) {
     AvcSeqParameterSet *p_sps = nullptr;
     AvcPicParameterSet *p_pps = nullptr;
-    size_t offset = 0; // current bit offset
+    Parser::BitReader bit_reader(p_stream, stream_size_in_byte, true);
 
     // Parse and temporarily store
-    uint32_t pic_parameter_set_id = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    uint32_t seq_parameter_set_id = Parser::ExpGolomb::ReadUe(p_stream, offset);
+    uint32_t pic_parameter_set_id = bit_reader.ReadUe();
+    uint32_t seq_parameter_set_id = bit_reader.ReadUe();
 
     p_sps = &sps_list_[seq_parameter_set_id];
     p_pps = &pps_list_[pic_parameter_set_id];
+    if (param_set_cache_.Lookup(kParamSetPps, pic_parameter_set_id, p_stream, stream_size_in_byte)) {
+        return PARSER_OK;  // identical to the stored PPS with the same id
+    }
+    // The stored PPS is cleared below: a failed parse must not leave its payload in the cache
+    param_set_cache_.Invalidate(kParamSetPps, pic_parameter_set_id);
     memset(p_pps, 0, sizeof(AvcPicParameterSet));	
 
     p_pps->pic_parameter_set_id = pic_parameter_set_id;
     p_pps->seq_parameter_set_id = seq_parameter_set_id;
 
-    p_pps->entropy_coding_mode_flag = Parser::GetBit(p_stream, offset);
-    p_pps->bottom_field_pic_order_in_frame_present_flag = Parser::GetBit(p_stream, offset);
+    p_pps->entropy_coding_mode_flag = bit_reader.GetBit();
+    p_pps->bottom_field_pic_order_in_frame_present_flag = bit_reader.GetBit();
 
-    p_pps->num_slice_groups_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+    p_pps->num_slice_groups_minus1 = bit_reader.ReadUe();
     if (p_pps->num_slice_groups_minus1 > 0) {
         // Note: VCN supports High Profile only (num_slice_groups_minus1 = 0)
         ERR("Multiple slice groups are not supported");
         return PARSER_NOT_SUPPORTED;
 
-        p_pps->slice_group_map_type = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_pps->slice_group_map_type = bit_reader.ReadUe();
         if (p_pps->slice_group_map_type == 0) {
             for (int i_group = 0; i_group <= p_pps->num_slice_groups_minus1; i_group++) {
-                p_pps->run_length_minus1[i_group] = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                p_pps->run_length_minus1[i_group] = bit_reader.ReadUe();
             }
         } else if (p_pps->slice_group_map_type == 2) {
             for (int i_group = 0; i_group < p_pps->num_slice_groups_minus1; i_group++ ) {
-                p_pps->top_left[i_group] = Parser::ExpGolomb::ReadUe(p_stream, offset);
-                p_pps->bottom_right[i_group] = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                p_pps->top_left[i_group] = bit_reader.ReadUe();
+                p_pps->bottom_right[i_group] = bit_reader.ReadUe();
             }
         } else if (p_pps->slice_group_map_type == 3 || p_pps->slice_group_map_type == 4 || p_pps->slice_group_map_type == 5) {
-            p_pps->slice_group_change_direction_flag = Parser::GetBit(p_stream, offset);
-            p_pps->slice_group_change_rate_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+            p_pps->slice_group_change_direction_flag = bit_reader.GetBit();
+            p_pps->slice_group_change_rate_minus1 = bit_reader.ReadUe();
         } else if (p_pps->slice_group_map_type == 6) {
-            p_pps->pic_size_in_map_units_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+            p_pps->pic_size_in_map_units_minus1 = bit_reader.ReadUe();
             int slice_group_id_size = ceil(log2(p_pps->num_slice_groups_minus1 + 1));
             for (int i = 0; i <= p_pps->pic_size_in_map_units_minus1; i++) {
-                int temp = Parser::ReadBits(p_stream, offset, slice_group_id_size);
+                int temp = bit_reader.ReadBits(slice_group_id_size);
                 ERR("AVC PPS parsing: slice_group_id memory not allocaed!");
             }
         }
     }
 
-    p_pps->num_ref_idx_l0_default_active_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_pps->num_ref_idx_l1_default_active_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_pps->weighted_pred_flag = Parser::GetBit(p_stream, offset);
-    p_pps->weighted_bipred_idc = Parser::ReadBits(p_stream, offset, 2);
-    p_pps->pic_init_qp_minus26 = Parser::ExpGolomb::ReadSe(p_stream, offset);
-    p_pps->pic_init_qs_minus26 = Parser::ExpGolomb::ReadSe(p_stream, offset);
-    p_pps->chroma_qp_index_offset = Parser::ExpGolomb::ReadSe(p_stream, offset);
-    p_pps->deblocking_filter_control_present_flag = Parser::GetBit(p_stream, offset);
-    p_pps->constrained_intra_pred_flag = Parser::GetBit(p_stream, offset);
-    p_pps->redundant_pic_cnt_present_flag = Parser::GetBit(p_stream, offset);
+    p_pps->num_ref_idx_l0_default_active_minus1 = bit_reader.ReadUe();
+    p_pps->num_ref_idx_l1_default_active_minus1 = bit_reader.ReadUe();
+    p_pps->weighted_pred_flag = bit_reader.GetBit();
+    p_pps->weighted_bipred_idc = bit_reader.ReadBits(2);
+    p_pps->pic_init_qp_minus26 = bit_reader.ReadSe();
+    p_pps->pic_init_qs_minus26 = bit_reader.ReadSe();
+    p_pps->chroma_qp_index_offset = bit_reader.ReadSe();
+    p_pps->deblocking_filter_control_present_flag = bit_reader.GetBit();
+    p_pps->constrained_intra_pred_flag = bit_reader.GetBit();
+    p_pps->redundant_pic_cnt_present_flag = bit_reader.GetBit();
 
-    if (MoreRbspData(p_stream, stream_size_in_byte, offset)) {
-        p_pps->transform_8x8_mode_flag = Parser::GetBit(p_stream, offset);
-        p_pps->pic_scaling_matrix_present_flag = Parser::GetBit(p_stream, offset);
+    if (bit_reader.MoreRbspData()) {
+        p_pps->transform_8x8_mode_flag = bit_reader.GetBit();
+        p_pps->pic_scaling_matrix_present_flag = bit_reader.GetBit();
         if (p_pps->pic_scaling_matrix_present_flag == 1) {
             int count = p_sps->chroma_format_idc != 3 ? 2 : 6;
             for (int i = 0; i < 6 + count * p_pps->transform_8x8_mode_flag; i++) {
-                p_pps->pic_scaling_list_present_flag [i] = Parser::GetBit(p_stream, offset);
+                p_pps->pic_scaling_list_present_flag [i] = bit_reader.GetBit();
                 if (p_pps->pic_scaling_list_present_flag[i] == 1) {
                     if ( i < 6 ) {
-                        GetScalingList(p_stream, offset, p_pps->scaling_list_4x4[i], 16, &p_pps->use_default_scaling_matrix_4x4_flag[i]);
+                        GetScalingList(bit_reader, p_pps->scaling_list_4x4[i], 16, &p_pps->use_default_scaling_matrix_4x4_flag[i]);
                     } else {
-                        GetScalingList(p_stream, offset, p_pps->scaling_list_8x8[i - 6], 64, &p_pps->use_default_scaling_matrix_8x8_flag[i - 6]);
+                        GetScalingList(bit_reader, p_pps->scaling_list_8x8[i - 6], 64, &p_pps->use_default_scaling_matrix_8x8_flag[i - 6]);
                     }
                 }
             }
         }
-        p_pps->second_chroma_qp_index_offset = Parser::ExpGolomb::ReadSe(p_stream, offset);
+        p_pps->second_chroma_qp_index_offset = bit_reader.ReadSe();
     } else {
         /// When second_chroma_qp_index_offset is not present, it shall be inferred to be equal to chroma_qp_index_offset.
         p_pps->second_chroma_qp_index_offset = p_pps->chroma_qp_index_offset;
@@ -1146,6 +1215,7 @@ ParserResult AvcVideoParser::ParsePps(uint8_t *p_stream, size_t stream_size_in_b
     }
 
     p_pps->is_received = 1;  // confirm PPS with pic_parameter_set_id received (but not activated)
+    param_set_cache_.Insert(kParamSetPps, pic_parameter_set_id, p_stream, stream_size_in_byte);
 
 #if DBGINFO
     PrintPps(p_pps);
@@ -1155,16 +1225,16 @@ ParserResult AvcVideoParser::ParsePps(uint8_t *p_stream, size_t stream_size_in_b
 
 ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_size_in_byte, AvcSliceHeader *p_slice_header) {
     int i;
-    size_t offset = 0;  // current bit offset
+    Parser::BitReader bit_reader(p_stream, stream_size_in_byte, true);
     AvcSeqParameterSet *p_sps = nullptr;
     AvcPicParameterSet *p_pps = nullptr;
 
     curr_has_mmco_5_ = 0;
     memset(p_slice_header, 0, sizeof(AvcSliceHeader));
 
-    p_slice_header->first_mb_in_slice = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_slice_header->slice_type = Parser::ExpGolomb::ReadUe(p_stream, offset);
-    p_slice_header->pic_parameter_set_id = Parser::ExpGolomb::ReadUe(p_stream, offset);
+    p_slice_header->first_mb_in_slice = bit_reader.ReadUe();
+    p_slice_header->slice_type = bit_reader.ReadUe();
+    p_slice_header->pic_parameter_set_id = bit_reader.ReadUe();
 
     // Set active SPS and PPS for the current slice
     active_pps_id_ = p_slice_header->pic_parameter_set_id;
@@ -1217,15 +1287,15 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
     }
 
     if (p_sps->separate_colour_plane_flag == 1) {
-        p_slice_header->colour_plane_id = Parser::ReadBits(p_stream, offset, 2);
+        p_slice_header->colour_plane_id = bit_reader.ReadBits(2);
     }
-    p_slice_header->frame_num = Parser::ReadBits(p_stream, offset, p_sps->log2_max_frame_num_minus4 + 4);
+    p_slice_header->frame_num = bit_reader.ReadBits(p_sps->log2_max_frame_num_minus4 + 4);
 
     if (p_sps->frame_mbs_only_flag != 1) {
-        p_slice_header->field_pic_flag = Parser::GetBit(p_stream, offset);
+        p_slice_header->field_pic_flag = bit_reader.GetBit();
         if (p_slice_header->field_pic_flag == 1)
         {
-            p_slice_header->bottom_field_flag = Parser::GetBit(p_stream, offset);
+            p_slice_header->bottom_field_flag = bit_reader.GetBit();
         }
     } else {
         p_slice_header->field_pic_flag = 0;
@@ -1237,39 +1307,39 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
     }
     
     if (nal_unit_header_.nal_unit_type == kAvcNalTypeSlice_IDR) {
-        p_slice_header->idr_pic_id = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_slice_header->idr_pic_id = bit_reader.ReadUe();
     }
 
     if (p_sps->pic_order_cnt_type == 0) {
-        p_slice_header->pic_order_cnt_lsb = Parser::ReadBits(p_stream, offset, p_sps->log2_max_pic_order_cnt_lsb_minus4 + 4);
+        p_slice_header->pic_order_cnt_lsb = bit_reader.ReadBits(p_sps->log2_max_pic_order_cnt_lsb_minus4 + 4);
         if (p_pps->bottom_field_pic_order_in_frame_present_flag == 1 && p_slice_header->field_pic_flag != 1 ) {
-            p_slice_header->delta_pic_order_cnt_bottom = Parser::ExpGolomb::ReadSe(p_stream, offset);
+            p_slice_header->delta_pic_order_cnt_bottom = bit_reader.ReadSe();
         }
     }
 
     if (p_sps->pic_order_cnt_type == 1 && p_sps->delta_pic_order_always_zero_flag != 1) {
-        p_slice_header->delta_pic_order_cnt[0] = Parser::ExpGolomb::ReadSe(p_stream, offset);
+        p_slice_header->delta_pic_order_cnt[0] = bit_reader.ReadSe();
         if (p_pps->bottom_field_pic_order_in_frame_present_flag == 1 && p_slice_header->field_pic_flag != 1) {
-            p_slice_header->delta_pic_order_cnt[1] = Parser::ExpGolomb::ReadSe(p_stream, offset);
+            p_slice_header->delta_pic_order_cnt[1] = bit_reader.ReadSe();
         }
     }
 
     if (p_pps->redundant_pic_cnt_present_flag == 1) {
-        p_slice_header->redundant_pic_cnt = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_slice_header->redundant_pic_cnt = bit_reader.ReadUe();
     }
 
     if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6 ) { // B-Slice
-        p_slice_header->direct_spatial_mv_pred_flag = Parser::GetBit(p_stream, offset);
+        p_slice_header->direct_spatial_mv_pred_flag = bit_reader.GetBit();
     }
 
     if (p_slice_header->slice_type == kAvcSliceTypeP || p_slice_header->slice_type == kAvcSliceTypeP_5 ||
         p_slice_header->slice_type == kAvcSliceTypeSP || p_slice_header->slice_type == kAvcSliceTypeSP_8 ||
         p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
-        p_slice_header->num_ref_idx_active_override_flag = Parser::GetBit(p_stream, offset);
+        p_slice_header->num_ref_idx_active_override_flag = bit_reader.GetBit();
         if (p_slice_header->num_ref_idx_active_override_flag == 1) {
-            p_slice_header->num_ref_idx_l0_active_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+            p_slice_header->num_ref_idx_l0_active_minus1 = bit_reader.ReadUe();
             if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
-                p_slice_header->num_ref_idx_l1_active_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                p_slice_header->num_ref_idx_l1_active_minus1 = bit_reader.ReadUe();
             }
         } else {
             p_slice_header->num_ref_idx_l0_active_minus1 = p_pps->num_ref_idx_l0_default_active_minus1;
@@ -1286,16 +1356,16 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
     int modification_of_pic_nums_idc;
     if (p_slice_header->slice_type != kAvcSliceTypeI && p_slice_header->slice_type != kAvcSliceTypeSI &&
         p_slice_header->slice_type != kAvcSliceTypeI_7 && p_slice_header->slice_type != kAvcSliceTypeSI_9) {
-        p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l0 = Parser::GetBit(p_stream, offset);
+        p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l0 = bit_reader.GetBit();
         if (p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l0 == 1) {
             i = 0;
             do {
-                modification_of_pic_nums_idc = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                modification_of_pic_nums_idc = bit_reader.ReadUe();
                 p_slice_header->ref_pic_list.modification_l0[i].modification_of_pic_nums_idc = modification_of_pic_nums_idc;
                 if (modification_of_pic_nums_idc == 0 || modification_of_pic_nums_idc == 1) {
-                    p_slice_header->ref_pic_list.modification_l0[i].abs_diff_pic_num_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                    p_slice_header->ref_pic_list.modification_l0[i].abs_diff_pic_num_minus1 = bit_reader.ReadUe();
                 } else if (modification_of_pic_nums_idc == 2) {
-                    p_slice_header->ref_pic_list.modification_l0[i].long_term_pic_num = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                    p_slice_header->ref_pic_list.modification_l0[i].long_term_pic_num = bit_reader.ReadUe();
                 }
                 i++;
             } while (modification_of_pic_nums_idc != 3);
@@ -1303,16 +1373,16 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
     }
 
     if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
-        p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l1 = Parser::GetBit(p_stream, offset);
+        p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l1 = bit_reader.GetBit();
         if (p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l1 == 1) {
             i = 0;
             do {
-                modification_of_pic_nums_idc = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                modification_of_pic_nums_idc = bit_reader.ReadUe();
                 p_slice_header->ref_pic_list.modification_l1[i].modification_of_pic_nums_idc = modification_of_pic_nums_idc;
                 if (modification_of_pic_nums_idc == 0 || modification_of_pic_nums_idc == 1) {
-                    p_slice_header->ref_pic_list.modification_l1[i].abs_diff_pic_num_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                    p_slice_header->ref_pic_list.modification_l1[i].abs_diff_pic_num_minus1 = bit_reader.ReadUe();
                 } else if(modification_of_pic_nums_idc == 2) {
-                    p_slice_header->ref_pic_list.modification_l1[i].long_term_pic_num = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                    p_slice_header->ref_pic_list.modification_l1[i].long_term_pic_num = bit_reader.ReadUe();
                 }
                 i++;
             } while (modification_of_pic_nums_idc != 3);
@@ -1325,29 +1395,29 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
             (p_slice_header->slice_type == kAvcSliceTypeSP || p_slice_header->slice_type == kAvcSliceTypeSP_8))) ||
         (p_pps->weighted_bipred_idc == 1 &&
             (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6))) {
-        p_slice_header->pred_weight_table.luma_log2_weight_denom = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_slice_header->pred_weight_table.luma_log2_weight_denom = bit_reader.ReadUe();
         
         int ChromaArrayType = p_sps->separate_colour_plane_flag == 0 ? p_sps->chroma_format_idc : 0;
         if (ChromaArrayType != 0) {
-            p_slice_header->pred_weight_table.chroma_log2_weight_denom = Parser::ExpGolomb::ReadUe(p_stream, offset);
+            p_slice_header->pred_weight_table.chroma_log2_weight_denom = bit_reader.ReadUe();
         }
         
         for (i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
-            p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0_flag = Parser::GetBit(p_stream, offset);
+            p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0_flag = bit_reader.GetBit();
             if (p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0_flag == 1) {
-                p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0 = Parser::ExpGolomb::ReadSe(p_stream, offset);
-                p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l0 = Parser::ExpGolomb::ReadSe(p_stream, offset);
+                p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0 = bit_reader.ReadSe();
+                p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l0 = bit_reader.ReadSe();
             } else {
                 p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0 = 1 << p_slice_header->pred_weight_table.luma_log2_weight_denom;
                 p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l0 = 0;
             }
             
             if (ChromaArrayType != 0) {
-                p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l0_flag = Parser::GetBit(p_stream, offset);
+                p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l0_flag = bit_reader.GetBit();
                 if (p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l0_flag == 1) {
                     for (int j = 0; j < 2; j++) {
-                        p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l0[j] = Parser::ExpGolomb::ReadSe(p_stream, offset);
-                        p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l0[j] = Parser::ExpGolomb::ReadSe(p_stream, offset);
+                        p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l0[j] = bit_reader.ReadSe();
+                        p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l0[j] = bit_reader.ReadSe();
                     }
                 } else {
                     for (int j = 0; j < 2; j++) {
@@ -1360,21 +1430,21 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
         
         if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
             for (int i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
-                p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1_flag = Parser::GetBit(p_stream, offset);
+                p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1_flag = bit_reader.GetBit();
                 if (p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1_flag == 1) {
-                    p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1 = Parser::ExpGolomb::ReadSe(p_stream, offset);
-                    p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l1 = Parser::ExpGolomb::ReadSe(p_stream, offset);
+                    p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1 = bit_reader.ReadSe();
+                    p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l1 = bit_reader.ReadSe();
                 } else {
                     p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1 = 1 << p_slice_header->pred_weight_table.luma_log2_weight_denom;
                     p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l1 = 0;
                 }
 
                 if (ChromaArrayType != 0 ) {
-                    p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l1_flag = Parser::GetBit(p_stream, offset);
+                    p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l1_flag = bit_reader.GetBit();
                     if (p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l1_flag == 1) {
                         for (int j = 0; j < 2; j++) {
-                            p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l1[j] = Parser::ExpGolomb::ReadSe(p_stream, offset);
-                            p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l1[j] = Parser::ExpGolomb::ReadSe(p_stream, offset);
+                            p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l1[j] = bit_reader.ReadSe();
+                            p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l1[j] = bit_reader.ReadSe();
                         }
                     } else {
                         for (int j = 0; j < 2; j++) {
@@ -1391,27 +1461,27 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
     int memory_management_control_operation;
     if (nal_unit_header_.nal_ref_idc != 0) {
         if (nal_unit_header_.nal_unit_type == kAvcNalTypeSlice_IDR) {
-            p_slice_header->dec_ref_pic_marking.no_output_of_prior_pics_flag = Parser::GetBit(p_stream, offset);
-            p_slice_header->dec_ref_pic_marking.long_term_reference_flag = Parser::GetBit(p_stream, offset);
+            p_slice_header->dec_ref_pic_marking.no_output_of_prior_pics_flag = bit_reader.GetBit();
+            p_slice_header->dec_ref_pic_marking.long_term_reference_flag = bit_reader.GetBit();
         } else {
-            p_slice_header->dec_ref_pic_marking.adaptive_ref_pic_marking_mode_flag = Parser::GetBit(p_stream, offset);
+            p_slice_header->dec_ref_pic_marking.adaptive_ref_pic_marking_mode_flag = bit_reader.GetBit();
             if (p_slice_header->dec_ref_pic_marking.adaptive_ref_pic_marking_mode_flag == 1) {
                 i = 0;
                 do {
-                    memory_management_control_operation = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                    memory_management_control_operation = bit_reader.ReadUe();
                     p_slice_header->dec_ref_pic_marking.mmco[i].memory_management_control_operation = memory_management_control_operation;
                     
                     if (memory_management_control_operation == 1 || memory_management_control_operation == 3) {
-                        p_slice_header->dec_ref_pic_marking.mmco[i].difference_of_pic_nums_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                        p_slice_header->dec_ref_pic_marking.mmco[i].difference_of_pic_nums_minus1 = bit_reader.ReadUe();
                     }
                     if (memory_management_control_operation == 2) {
-                        p_slice_header->dec_ref_pic_marking.mmco[i].long_term_pic_num = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                        p_slice_header->dec_ref_pic_marking.mmco[i].long_term_pic_num = bit_reader.ReadUe();
                     }
                     if (memory_management_control_operation == 3 || memory_management_control_operation == 6) {
-                        p_slice_header->dec_ref_pic_marking.mmco[i].long_term_frame_idx = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                        p_slice_header->dec_ref_pic_marking.mmco[i].long_term_frame_idx = bit_reader.ReadUe();
                     }
                     if (memory_management_control_operation == 4) {
-                        p_slice_header->dec_ref_pic_marking.mmco[i].max_long_term_frame_idx_plus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
+                        p_slice_header->dec_ref_pic_marking.mmco[i].max_long_term_frame_idx_plus1 = bit_reader.ReadUe();
                     }
                     if ( memory_management_control_operation == 5) {
                         curr_has_mmco_5_ = 1;
@@ -1426,27 +1496,27 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
     if (p_pps->entropy_coding_mode_flag == 1 &&
         p_slice_header->slice_type != kAvcSliceTypeI && p_slice_header->slice_type != kAvcSliceTypeSI &&
         p_slice_header->slice_type != kAvcSliceTypeI_7 && p_slice_header->slice_type != kAvcSliceTypeSI_9) {
-        p_slice_header->cabac_init_idc = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_slice_header->cabac_init_idc = bit_reader.ReadUe();
     }
-    p_slice_header->slice_qp_delta = Parser::ExpGolomb::ReadSe(p_stream, offset);
+    p_slice_header->slice_qp_delta = bit_reader.ReadSe();
     if (p_slice_header->slice_type == kAvcSliceTypeSP || p_slice_header->slice_type == kAvcSliceTypeSI ||
         p_slice_header->slice_type == kAvcSliceTypeSP_8 || p_slice_header->slice_type == kAvcSliceTypeSI_9) {
         if (p_slice_header->slice_type == kAvcSliceTypeSP || p_slice_header->slice_type == kAvcSliceTypeSP_8) {
-            p_slice_header->sp_for_switch_flag = Parser::GetBit(p_stream, offset);
+            p_slice_header->sp_for_switch_flag = bit_reader.GetBit();
         }
-        p_slice_header->slice_qs_delta = Parser::ExpGolomb::ReadSe(p_stream, offset);
+        p_slice_header->slice_qs_delta = bit_reader.ReadSe();
     }
 
     if (p_pps->deblocking_filter_control_present_flag == 1) {
-        p_slice_header->disable_deblocking_filter_idc = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_slice_header->disable_deblocking_filter_idc = bit_reader.ReadUe();
         if (p_slice_header->disable_deblocking_filter_idc != 1) {
-            p_slice_header->slice_alpha_c0_offset_div2 = Parser::ExpGolomb::ReadSe(p_stream, offset);
-            p_slice_header->slice_beta_offset_div2 = Parser::ExpGolomb::ReadSe(p_stream, offset);
+            p_slice_header->slice_alpha_c0_offset_div2 = bit_reader.ReadSe();
+            p_slice_header->slice_beta_offset_div2 = bit_reader.ReadSe();
         }
     }
     if (p_pps->num_slice_groups_minus1 > 0 && p_pps->slice_group_map_type >= 3 && p_pps->slice_group_map_type <= 5) {
         int size = ceil(log2((double)(p_sps->pic_height_in_map_units_minus1+1) / (double)(p_pps->slice_group_change_rate_minus1+1) + 1));
-        p_slice_header->slice_group_change_cycle = Parser::ReadBits(p_stream, offset, size);
+        p_slice_header->slice_group_change_cycle = bit_reader.ReadBits(size);
     }
 
 #if DBGINFO
@@ -1455,14 +1525,14 @@ ParserResult AvcVideoParser::ParseSliceHeader(uint8_t *p_stream, size_t stream_s
     return PARSER_OK;
 }
 
-void AvcVideoParser::GetScalingList(uint8_t *p_stream, size_t &offset, uint32_t *scaling_list, uint32_t list_size, uint32_t *use_default_scaling_matrix_flag) {
+void AvcVideoParser::GetScalingList(Parser::BitReader &bit_reader, uint32_t *scaling_list, uint32_t list_size, uint32_t *use_default_scaling_matrix_flag) {
     int32_t last_scale, next_scale, delta_scale;
 
     last_scale = 8;
     next_scale = 8;
     for (int j = 0; j < list_size; j++) {
         if (next_scale != 0) {
-            delta_scale = Parser::ExpGolomb::ReadSe(p_stream, offset);
+            delta_scale = bit_reader.ReadSe();
             next_scale = (last_scale + delta_scale + 256) % 256;
             *use_default_scaling_matrix_flag = (j == 0 && next_scale == 0);
         }
@@ -1472,149 +1542,94 @@ void AvcVideoParser::GetScalingList(uint8_t *p_stream, size_t &offset, uint32_t
     }
 }
 
-void AvcVideoParser::GetVuiParameters(uint8_t *p_stream, size_t &offset, AvcVuiSeqParameters *p_vui_params) {
-    p_vui_params->aspect_ratio_info_present_flag = Parser::GetBit(p_stream, offset);
+void AvcVideoParser::GetVuiParameters(Parser::BitReader &bit_reader, AvcVuiSeqParameters *p_vui_params) {
+    p_vui_params->aspect_ratio_info_present_flag = bit_reader.GetBit();
     if (p_vui_params->aspect_ratio_info_present_flag == 1) {
-        p_vui_params->aspect_ratio_idc = Parser::ReadBits(p_stream, offset, 8);
+        p_vui_params->aspect_ratio_idc = bit_reader.ReadBits(8);
         if (p_vui_params->aspect_ratio_idc == 255 /*Extended_SAR*/) {
-            p_vui_params->sar_width = Parser::ReadBits(p_stream, offset, 16);
-            p_vui_params->sar_height = Parser::ReadBits(p_stream, offset, 16);
+            p_vui_params->sar_width = bit_reader.ReadBits(16);
+            p_vui_params->sar_height = bit_reader.ReadBits(16);
         }
     }
 
-    p_vui_params->overscan_info_present_flag = Parser::GetBit(p_stream, offset);
+    p_vui_params->overscan_info_present_flag = bit_reader.GetBit();
     if (p_vui_params->overscan_info_present_flag == 1) {
-        p_vui_params->overscan_appropriate_flag = Parser::GetBit(p_stream, offset);
+        p_vui_params->overscan_appropriate_flag = bit_reader.GetBit();
     }
 
-    p_vui_params->video_signal_type_present_flag = Parser::GetBit(p_stream, offset);
+    p_vui_params->video_signal_type_present_flag = bit_reader.GetBit();
     if (p_vui_params->video_signal_type_present_flag == 1) {
-        p_vui_params->video_format = Parser::ReadBits(p_stream, offset, 3);
-        p_vui_params->video_full_range_flag = Parser::GetBit(p_stream, offset);
-        p_vui_params->colour_description_present_flag = Parser::GetBit(p_stream, offset);
+        p_vui_params->video_format = bit_reader.ReadBits(3);
+        p_vui_params->video_full_range_flag = bit_reader.GetBit();
+        p_vui_params->colour_description_present_flag = bit_reader.GetBit();
         if (p_vui_params->colour_description_present_flag == 1) {
-            p_vui_params->colour_primaries = Parser::ReadBits(p_stream, offset, 8);
-            p_vui_params->transfer_characteristics = Parser::ReadBits(p_stream, offset, 8);
-            p_vui_params->matrix_coefficients = Parser::ReadBits(p_stream, offset, 8);
+            p_vui_params->colour_primaries = bit_reader.ReadBits(8);
+            p_vui_params->transfer_characteristics = bit_reader.ReadBits(8);
+            p_vui_params->matrix_coefficients = bit_reader.ReadBits(8);
         }
     }
 
-    p_vui_params->chroma_loc_info_present_flag = Parser::GetBit(p_stream, offset);
+    p_vui_params->chroma_loc_info_present_flag = bit_reader.GetBit();
     if (p_vui_params->chroma_loc_info_present_flag == 1) {
-        p_vui_params->chroma_sample_loc_type_top_field = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->chroma_sample_loc_type_bottom_field = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_vui_params->chroma_sample_loc_type_top_field = bit_reader.ReadUe();
+        p_vui_params->chroma_sample_loc_type_bottom_field = bit_reader.ReadUe();
     }
 
-    p_vui_params->timing_info_present_flag = Parser::GetBit(p_stream, offset);
+    p_vui_params->timing_info_present_flag = bit_reader.GetBit();
     if (p_vui_params->timing_info_present_flag == 1) {
-        p_vui_params->num_units_in_tick = Parser::ReadBits(p_stream, offset, 32);
-        p_vui_params->time_scale = Parser::ReadBits(p_stream, offset, 32);
-        p_vui_params->fixed_frame_rate_flag = Parser::GetBit(p_stream, offset);
+        p_vui_params->num_units_in_tick = bit_reader.ReadBits(32);
+        p_vui_params->time_scale = bit_reader.ReadBits(32);
+        p_vui_params->fixed_frame_rate_flag = bit_reader.GetBit();
     }
     
-    p_vui_params->nal_hrd_parameters_present_flag = Parser::GetBit(p_stream, offset);
+    p_vui_params->nal_hrd_parameters_present_flag = bit_reader.GetBit();
     if (p_vui_params->nal_hrd_parameters_present_flag == 1 ) {
-        p_vui_params->nal_hrd_parameters.cpb_cnt_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->nal_hrd_parameters.bit_rate_scale = Parser::ReadBits(p_stream, offset, 4);
-        p_vui_params->nal_hrd_parameters.cpb_size_scale = Parser::ReadBits(p_stream, offset, 4);
+        p_vui_params->nal_hrd_parameters.cpb_cnt_minus1 = bit_reader.ReadUe();
+        p_vui_params->nal_hrd_parameters.bit_rate_scale = bit_reader.ReadBits(4);
+        p_vui_params->nal_hrd_parameters.cpb_size_scale = bit_reader.ReadBits(4);
         for (int SchedSelIdx = 0; SchedSelIdx <= p_vui_params->nal_hrd_parameters.cpb_cnt_minus1; SchedSelIdx ++) {
-            p_vui_params->nal_hrd_parameters.bit_rate_value_minus1[SchedSelIdx] = Parser::ExpGolomb::ReadUe(p_stream, offset);
-            p_vui_params->nal_hrd_parameters.cpb_size_value_minus1[SchedSelIdx] = Parser::ExpGolomb::ReadUe(p_stream, offset);
-            p_vui_params->nal_hrd_parameters.cbr_flag[SchedSelIdx] = Parser::ReadBits(p_stream, offset, 1);
+            p_vui_params->nal_hrd_parameters.bit_rate_value_minus1[SchedSelIdx] = bit_reader.ReadUe();
+            p_vui_params->nal_hrd_parameters.cpb_size_value_minus1[SchedSelIdx] = bit_reader.ReadUe();
+            p_vui_params->nal_hrd_parameters.cbr_flag[SchedSelIdx] = bit_reader.ReadBits(1);
         }
-        p_vui_params->nal_hrd_parameters.initial_cpb_removal_delay_length_minus1 = Parser::ReadBits(p_stream, offset, 5);
-        p_vui_params->nal_hrd_parameters.cpb_removal_delay_length_minus1 = Parser::ReadBits(p_stream, offset, 5);
-        p_vui_params->nal_hrd_parameters.dpb_output_delay_length_minus1 = Parser::ReadBits(p_stream, offset, 5);
-        p_vui_params->nal_hrd_parameters.time_offset_length = Parser::ReadBits(p_stream, offset, 5);
+        p_vui_params->nal_hrd_parameters.initial_cpb_removal_delay_length_minus1 = bit_reader.ReadBits(5);
+        p_vui_params->nal_hrd_parameters.cpb_removal_delay_length_minus1 = bit_reader.ReadBits(5);
+        p_vui_params->nal_hrd_parameters.dpb_output_delay_length_minus1 = bit_reader.ReadBits(5);
+        p_vui_params->nal_hrd_parameters.time_offset_length = bit_reader.ReadBits(5);
     }
     
-    p_vui_params->vcl_hrd_parameters_present_flag = Parser::GetBit(p_stream, offset);
+    p_vui_params->vcl_hrd_parameters_present_flag = bit_reader.GetBit();
     if (p_vui_params->vcl_hrd_parameters_present_flag == 1) {
-        p_vui_params->vcl_hrd_parameters.cpb_cnt_minus1 = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->vcl_hrd_parameters.bit_rate_scale = Parser::ReadBits(p_stream, offset, 4);
-        p_vui_params->vcl_hrd_parameters.cpb_size_scale = Parser::ReadBits(p_stream, offset, 4);
+        p_vui_params->vcl_hrd_parameters.cpb_cnt_minus1 = bit_reader.ReadUe();
+        p_vui_params->vcl_hrd_parameters.bit_rate_scale = bit_reader.ReadBits(4);
+        p_vui_params->vcl_hrd_parameters.cpb_size_scale = bit_reader.ReadBits(4);
         for (int SchedSelIdx = 0; SchedSelIdx <= p_vui_params->vcl_hrd_parameters.cpb_cnt_minus1; SchedSelIdx ++) {
-            p_vui_params->vcl_hrd_parameters.bit_rate_value_minus1[SchedSelIdx] = Parser::ExpGolomb::ReadUe(p_stream, offset);
-            p_vui_params->vcl_hrd_parameters.cpb_size_value_minus1[SchedSelIdx] = Parser::ExpGolomb::ReadUe(p_stream, offset);
-            p_vui_params->vcl_hrd_parameters.cbr_flag[SchedSelIdx] = Parser::GetBit(p_stream, offset);
+            p_vui_params->vcl_hrd_parameters.bit_rate_value_minus1[SchedSelIdx] = bit_reader.ReadUe();
+            p_vui_params->vcl_hrd_parameters.cpb_size_value_minus1[SchedSelIdx] = bit_reader.ReadUe();
+            p_vui_params->vcl_hrd_parameters.cbr_flag[SchedSelIdx] = bit_reader.GetBit();
         }
-        p_vui_params->vcl_hrd_parameters.initial_cpb_removal_delay_length_minus1 = Parser::ReadBits(p_stream, offset, 5);
-        p_vui_params->vcl_hrd_parameters.cpb_removal_delay_length_minus1 = Parser::ReadBits(p_stream, offset, 5);
-        p_vui_params->vcl_hrd_parameters.dpb_output_delay_length_minus1 = Parser::ReadBits(p_stream, offset, 5);
-        p_vui_params->vcl_hrd_parameters.time_offset_length = Parser::ReadBits(p_stream, offset, 5);
+        p_vui_params->vcl_hrd_parameters.initial_cpb_removal_delay_length_minus1 = bit_reader.ReadBits(5);
+        p_vui_params->vcl_hrd_parameters.cpb_removal_delay_length_minus1 = bit_reader.ReadBits(5);
+        p_vui_params->vcl_hrd_parameters.dpb_output_delay_length_minus1 = bit_reader.ReadBits(5);
+        p_vui_params->vcl_hrd_parameters.time_offset_length = bit_reader.ReadBits(5);
     }
     if (p_vui_params->nal_hrd_parameters_present_flag == 1 || p_vui_params->vcl_hrd_parameters_present_flag == 1) {
-        p_vui_params->low_delay_hrd_flag = Parser::GetBit(p_stream, offset);
+        p_vui_params->low_delay_hrd_flag = bit_reader.GetBit();
     }
     
-    p_vui_params->pic_struct_present_flag = Parser::GetBit(p_stream, offset);
-    p_vui_params->bitstream_restriction_flag = Parser::GetBit(p_stream, offset);
+    p_vui_params->pic_struct_present_flag = bit_reader.GetBit();
+    p_vui_params->bitstream_restriction_flag = bit_reader.GetBit();
     if (p_vui_params->bitstream_restriction_flag) {
-        p_vui_params->motion_vectors_over_pic_boundaries_flag = Parser::GetBit(p_stream, offset);
-        p_vui_params->max_bytes_per_pic_denom = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->max_bits_per_mb_denom = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->log2_max_mv_length_horizontal = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->log2_max_mv_length_vertical = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->num_reorder_frames = Parser::ExpGolomb::ReadUe(p_stream, offset);
-        p_vui_params->max_dec_frame_buffering = Parser::ExpGolomb::ReadUe(p_stream, offset);
+        p_vui_params->motion_vectors_over_pic_boundaries_flag = bit_reader.GetBit();
+        p_vui_params->max_bytes_per_pic_denom = bit_reader.ReadUe();
+        p_vui_params->max_bits_per_mb_denom = bit_reader.ReadUe();
+        p_vui_params->log2_max_mv_length_horizontal = bit_reader.ReadUe();
+        p_vui_params->log2_max_mv_length_vertical = bit_reader.ReadUe();
+        p_vui_params->num_reorder_frames = bit_reader.ReadUe();
+        p_vui_params->max_dec_frame_buffering = bit_reader.ReadUe();
     }
 }
 
-bool AvcVideoParser::MoreRbspData(uint8_t *p_stream, size_t stream_size_in_byte, size_t bit_offset) {
-    bool more_rbsp_bits = false;
-    uint8_t curr_byte = p_stream[bit_offset >> 3];
-    uint8_t next_bytes[3];
-    uint32_t next_byte_offset = (bit_offset >> 3) + 1;
-    int bit_offset_in_byte = bit_offset % 8;
-    
-    /// If the following bytes are not start code, we have more RBSP data. If we don't have enough bytes
-    /// in the stream, pad with 0.
-    next_bytes[0] = next_byte_offset < stream_size_in_byte ? p_stream[next_byte_offset] : 0;
-    next_bytes[1] = (next_byte_offset + 1) < stream_size_in_byte ? p_stream[next_byte_offset + 1] : 0;
-    next_bytes[2] = (next_byte_offset + 2) < stream_size_in_byte ? p_stream[next_byte_offset + 2] : 0;
-
-    if ( (next_bytes[0] == 0x00 && next_bytes[1] == 0x00 && next_bytes[2] == 0x00) ||  // padding zero bytes
-         (next_bytes[0] == 0x00 && next_bytes[1] == 0x00 && next_bytes[2] == 0x01) ) { // start code
-        /// Continue checking the existence of the trailing bits in the current byte.
-    } else {
-        return true;
-    }
-        
-    /// Check if RBSP trailing bits immediately follow
-    if ((bit_offset_in_byte) == 0) {
-        if (curr_byte == 0x80) { // RBSP trailing bits
-            more_rbsp_bits = false;
-        } else {
-            more_rbsp_bits = true;
-        }
-    } else {
-        uint8_t curr_bit = curr_byte & (0x80 >> bit_offset_in_byte);
-        if ( curr_bit == 0 ) {
-            more_rbsp_bits = true; // rbsp_stop_one_bit has to be 1.
-        } else {
-            /// If this is the last bit, need to grab the next byte
-            if ( bit_offset_in_byte == 7 ) {
-                if ( next_bytes[0] != 0 ) {
-                    more_rbsp_bits = true;
-                } else {
-                    more_rbsp_bits = false;
-                }
-            } else {
-                bit_offset_in_byte++;
-                for (int i = bit_offset_in_byte; i < 8; i++) {
-                    curr_bit = curr_byte & (0x80 >> i);
-                    if ( curr_bit ) {
-                        more_rbsp_bits = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-    
-    return more_rbsp_bits;
-}
-
 void AvcVideoParser::InitDpb() {
     memset(&dpb_buffer_, 0, sizeof(DecodedPictureBuffer));
     for (int i = 0; i < AVC_MAX_DPB_FRAMES; i++) {
@@ -2552,6 +2567,11 @@ ParserResult AvcVideoParser::ModifiyRefList(AvcPicture *ref_pic_list_x, AvcListM
 }
 
 ParserResult AvcVideoParser::CheckDpbAndOutput() {
+    // Without reordering the current picture is the next one in output order
+    bool zero_reorder = IsZeroReorderOutput();
+    if (zero_reorder && OutputPicsFromDpb() != PARSER_OK) {
+        return PARSER_FAIL;
+    }
     // If DPB is full, bump one picture out
     if (dpb_buffer_.dpb_fullness == dpb_buffer_.dpb_size) {
         if (BumpPicFromDpb() != PARSER_OK) {
@@ -2560,7 +2580,7 @@ ParserResult AvcVideoParser::CheckDpbAndOutput() {
     }
     // Output decoded pictures from DPB if any are ready
     if (pfn_display_picture_cb_ && num_output_pics_ > 0) {
-        if (OutputDecodedPictures(false) != PARSER_OK) {
+        if (OutputDecodedPictures(zero_reorder) != PARSER_OK) {
             return PARSER_FAIL;
         }
     }
@@ -2572,12 +2592,8 @@ ParserResult AvcVideoParser::FindFreeInDecBufPool() {
 
     if (curr_pic_.pic_structure == kFrame || !second_field_) {
         // Find a free buffer in decode buffer pool
-        for (dec_buf_index = 0; dec_buf_index < dec_buf_pool_size_; dec_buf_index++) {
-            if (decode_buffer_pool_[dec_buf_index].use_status == kNotUsed) {
-                break;
-            }
-        }
-        if (dec_buf_index == dec_buf_pool_size_) {
+        dec_buf_index = GetFreeDecBufIndex();
+        if (dec_buf_index < 0) {
             ERR("Could not find a free buffer in decode buffer pool.");
             return PARSER_NOT_FOUND;
         }
@@ -3006,8 +3022,7 @@ ParserResult AvcVideoParser::BumpPicFromDpb() {
                     ERR("Error! Decode buffer pool overflow!");
                     return PARSER_OUT_OF_RANGE;
                 } else {
-                    output_pic_list_[num_output_pics_] = dpb_buffer_.frame_buffer_list[min_poc_pic_idx_ref].dec_buf_idx;
-                    num_output_pics_++;
+                    AddOutputPicture(dpb_buffer_.frame_buffer_list[min_poc_pic_idx_ref].dec_buf_idx);
                 }
             }
         }
@@ -3034,14 +3049,13 @@ ParserResult AvcVideoParser::BumpPicFromDpb() {
                 ERR("Error! Decode buffer pool overflow!");
                 return PARSER_OUT_OF_RANGE;
             } else {
-                output_pic_list_[num_output_pics_] = dpb_buffer_.frame_buffer_list[min_poc_pic_idx_no_ref].dec_buf_idx;
-                num_output_pics_++;
+                AddOutputPicture(dpb_buffer_.frame_buffer_list[min_poc_pic_idx_no_ref].dec_buf_idx);
             }
         }
     }
     // Remove it from DPB and mark unused for decode in decode buffer pool
     dpb_buffer_.frame_buffer_list[min_poc_pic_idx_no_ref].use_status = kNotUsed;
-    decode_buffer_pool_[dpb_buffer_.frame_buffer_list[min_poc_pic_idx_no_ref].dec_buf_idx].use_status &= ~kFrameUsedForDecode;
+    ClearDecBufUseStatus(dpb_buffer_.frame_buffer_list[min_poc_pic_idx_no_ref].dec_buf_idx, kFrameUsedForDecode);
     if (dpb_buffer_.dpb_fullness > 0 ) {
         dpb_buffer_.dpb_fullness--;
     }
@@ -3049,6 +3063,58 @@ ParserResult AvcVideoParser::BumpPicFromDpb() {
     return PARSER_OK;
 }
 
+bool AvcVideoParser::IsZeroReorderOutput() {
+    if (!parser_params_.zero_reorder_output || active_sps_id_ < 0) {
+        return false;
+    }
+    AvcSeqParameterSet *p_sps = &sps_list_[active_sps_id_];
+    if (p_sps->vui_parameters_present_flag && p_sps->vui_seq_parameters.bitstream_restriction_flag) {
+        return p_sps->vui_seq_parameters.num_reorder_frames == 0;
+    }
+    // max_num_reorder_frames is inferred to be 0 for the intra profiles
+    return p_sps->constraint_set3_flag && (p_sps->profile_idc == 44 || p_sps->profile_idc == 86 || p_sps->profile_idc == 100 ||
+        p_sps->profile_idc == 110 || p_sps->profile_idc == 122 || p_sps->profile_idc == 244);
+}
+
+ParserResult AvcVideoParser::OutputPicsFromDpb() {
+    uint32_t i;
+    while (dpb_buffer_.num_pics_needed_for_output > 0) {
+        int32_t min_poc = 0x7FFFFFFF;  // largest possible POC value 2^31 - 1
+        uint32_t min_poc_pic_idx = AVC_MAX_DPB_FRAMES;
+        for (i = 0; i < dpb_buffer_.dpb_size; i++) {
+            if (dpb_buffer_.frame_buffer_list[i].use_status && dpb_buffer_.frame_buffer_list[i].pic_output_flag && dpb_buffer_.frame_buffer_list[i].pic_order_cnt < min_poc) {
+                min_poc = dpb_buffer_.frame_buffer_list[i].pic_order_cnt;
+                min_poc_pic_idx = i;
+            }
+        }
+        if (min_poc_pic_idx >= dpb_buffer_.dpb_size) {
+            ERR("Error! Could not find a picture that is needed for output.");
+            return PARSER_OUT_OF_RANGE;
+        }
+
+        // Mark as "not needed for output" and insert into output/display picture list
+        dpb_buffer_.frame_buffer_list[min_poc_pic_idx].pic_output_flag = 0;
+        dpb_buffer_.num_pics_needed_for_output--;
+        if (pfn_display_picture_cb_) {
+            if (num_output_pics_ >= dec_buf_pool_size_) {
+                ERR("Error! Decode buffer pool overflow!");
+                return PARSER_OUT_OF_RANGE;
+            } else {
+                AddOutputPicture(dpb_buffer_.frame_buffer_list[min_poc_pic_idx].dec_buf_idx);
+            }
+        }
+        // A non-reference picture is not needed any more
+        if (dpb_buffer_.frame_buffer_list[min_poc_pic_idx].is_reference == kUnusedForReference) {
+            dpb_buffer_.frame_buffer_list[min_poc_pic_idx].use_status = kNotUsed;
+            ClearDecBufUseStatus(dpb_buffer_.frame_buffer_list[min_poc_pic_idx].dec_buf_idx, kFrameUsedForDecode);
+            if (dpb_buffer_.dpb_fullness > 0) {
+                dpb_buffer_.dpb_fullness--;
+            }
+        }
+    }
+    return PARSER_OK;
+}
+
 ParserResult AvcVideoParser::InsertCurrPicIntoDpb() {
     int i;
     // We have reserved a spot in DPB already.
@@ -3107,9 +3173,9 @@ ParserResult AvcVideoParser::InsertCurrPicIntoDpb() {
         }
 
         // Mark as used in decode buffer pool
-        decode_buffer_pool_[curr_pic_.dec_buf_idx].use_status |= kFrameUsedForDecode;
+        SetDecBufUseStatus(curr_pic_.dec_buf_idx, kFrameUsedForDecode);
         if (pfn_display_picture_cb_ && curr_pic_.pic_output_flag) {
-            decode_buffer_pool_[curr_pic_.dec_buf_idx].use_status |= kFrameUsedForDisplay;
+            SetDecBufUseStatus(curr_pic_.dec_buf_idx, kFrameUsedForDisplay);
         }
         decode_buffer_pool_[curr_pic_.dec_buf_idx].pic_order_cnt = curr_pic_.pic_order_cnt;
         decode_buffer_pool_[curr_pic_.dec_buf_idx].pts = curr_pts_;
@@ -3150,7 +3216,7 @@ ParserResult AvcVideoParser::FlushDpb() {
         dpb_buffer_.frame_buffer_list[i].use_status = kNotUsed;
         dpb_buffer_.field_pic_list[i * 2].use_status = kNotUsed;
         dpb_buffer_.field_pic_list[i * 2 + 1].use_status = kNotUsed;
-        decode_buffer_pool_[dpb_buffer_.frame_buffer_list[i].dec_buf_idx].use_status = kNotUsed;
+        ClearDecBufUseStatus(dpb_buffer_.frame_buffer_list[i].dec_buf_idx, kFrameUsedForDecode | kFrameUsedForDisplay);
     }
     return PARSER_OK;
 }
@@ -3405,7 +3471,7 @@ void AvcVideoParser::PrintDpb() {
     if (num_output_pics_) {
         MSG("output_pic_list:");
         for (i = 0; i < num_output_pics_; i++) {
-            MSG_NO_NEWLINE(output_pic_list_[i] << ", ");
+            MSG_NO_NEWLINE(GetOutputPicture(i) << ", ");
         }
         MSG("");
     }
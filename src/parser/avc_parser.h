@@ -52,6 +52,12 @@ public:
      */
     virtual rocDecStatus UnInitialize();     // derived method
 
+    /*! \brief function to reset the AVC parser, e.g. after a seek
+     * \param [in] flags Combination of <tt>RocdecParserResetFlags</tt>
+     * @return rocDecStatus
+     */
+    virtual rocDecStatus Reset(uint32_t flags);
+
     enum PictureStructure {
         kFrame,
         kTopField,
@@ -192,29 +198,19 @@ protected:
     ParserResult ParseSliceHeader(uint8_t *p_stream, size_t stream_size_in_byte, AvcSliceHeader *p_slice_header);
 
     /*! \brief Function to parse a scaling list
-     * \param [in] p_stream A pointer of <tt>uint8_t</tt> for the input stream to be parsed
-     * \param [in/out] offset Current bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] scaling_list Pointer to the output scaling list
      * \param [in] list_size Scaling list size
      * \param [out] use_default_scaling_matrix_flag Array of flags that indicate whether to use default values
      */
-    void GetScalingList(uint8_t *p_stream, size_t &offset, uint32_t *scaling_list, uint32_t list_size, uint32_t *use_default_scaling_matrix_flag);
+    void GetScalingList(Parser::BitReader &bit_reader, uint32_t *scaling_list, uint32_t list_size, uint32_t *use_default_scaling_matrix_flag);
 
     /*! \brief Function to parse vidio usability information (VUI) parameters
-     * \param [in] p_stream The pointer to the input bit stream
-     * \param [in/out] offset Current bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_vui_params The pointer to VUI structure
      * \return No return value
      */
-    void GetVuiParameters(uint8_t *p_stream, size_t &offset, AvcVuiSeqParameters *p_vui_params);
-
-    /*! \brief Function to check if there is more data in RBSP
-     * \param [in] p_stream The pointer to the input bit stream
-     * \param [in] stream_size_in_byte The byte size of the stream
-     * \param [in] bit_offset The current bit offset
-     * \return true/false
-    */
-    bool MoreRbspData(uint8_t *p_stream, size_t stream_size_in_byte, size_t bit_offset);
+    void GetVuiParameters(Parser::BitReader &bit_reader, AvcVuiSeqParameters *p_vui_params);
 
     /*! \brief Function to initialize DPB buffer.
      */
@@ -281,6 +277,17 @@ protected:
      */
     ParserResult BumpPicFromDpb();
 
+    /*! \brief Function to check if the pictures are displayed right after they are submitted for decode
+     * \return True if <tt>zero_reorder_output</tt> is set and the active SPS signals max_num_reorder_frames equal to 0. E.2.1.
+     */
+    bool IsZeroReorderOutput();
+
+    /*! \brief Function to output all the pictures that are needed for output in POC order without waiting for DPB
+     * fullness. Reference pictures stay in DPB, non-reference pictures are removed.
+     * \return <tt>ParserResult</tt>
+     */
+    ParserResult OutputPicsFromDpb();
+
     /*! \brief Function to insert the current picture into DPB.
      * \return <tt>ParserResult</tt>
      */
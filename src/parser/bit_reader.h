@@ -0,0 +1,270 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace Parser {
+    /**
+     * @brief MSB-first bit reader used for header parsing of all codecs.
+     *
+     * Bits are served from a left aligned 64-bit cache word which is refilled with up to 8 bytes at a time. Reads past the end
+     * of the buffer return zero bits and set the overrun flag instead of touching memory outside of [data, data + size).
+     *
+     * When skip_emulation_bytes is set, the buffer is an AVC/HEVC EBSP and the emulation prevention bytes (0x03 in 0x000003)
+     * are dropped while refilling, so the parsers see the RBSP without a separate conversion pass. Bit offsets are then RBSP
+     * bit offsets.
+     */
+    class BitReader {
+    public:
+        BitReader() {};
+        BitReader(const uint8_t *data, size_t size, bool skip_emulation_bytes = false) { Init(data, size, skip_emulation_bytes); };
+
+        /*! \brief Function to (re)start reading from the beginning of a buffer
+         * \param [in] data Pointer to the buffer
+         * \param [in] size Size of the buffer in bytes
+         * \param [in] skip_emulation_bytes Set to true to read an EBSP and skip its emulation prevention bytes
+         */
+        inline void Init(const uint8_t *data, size_t size, bool skip_emulation_bytes = false) {
+            data_ = data;
+            next_ = data;
+            end_ = data + size;
+            cache_ = 0;
+            cache_bits_ = 0;
+            pad_bytes_ = 0;
+            skip_emulation_bytes_ = skip_emulation_bytes;
+            zero_run_ = 0;
+            emu_bytes_ = 0;
+        }
+
+        /*! \brief Function to read up to 32 bits
+         * \param [in] num_bits Number of bits to read
+         * \return The value read. 0 if num_bits is greater than 32.
+         */
+        inline uint32_t ReadBits(uint32_t num_bits) {
+            if (num_bits == 0 || num_bits > 32) {
+                return 0;
+            }
+            if (cache_bits_ < num_bits) {
+                Refill();
+            }
+            uint32_t value = static_cast<uint32_t>(cache_ >> (64 - num_bits));
+            cache_ <<= num_bits;
+            cache_bits_ -= num_bits;
+            return value;
+        }
+
+        /*! \brief Function to read one bit
+         */
+        inline bool GetBit() {
+            if (cache_bits_ == 0) {
+                Refill();
+            }
+            bool bit = cache_ >> 63;
+            cache_ <<= 1;
+            cache_bits_--;
+            return bit;
+        }
+
+        /*! \brief Function to skip the set number of bits
+         * \param [in] num_bits Number of bits to skip
+         */
+        inline void SkipBits(size_t num_bits) {
+            if (num_bits <= cache_bits_) {
+                // Shifting a 64-bit word by 64 is undefined
+                cache_ = num_bits < 64 ? cache_ << num_bits : 0;
+                cache_bits_ -= num_bits;
+                return;
+            }
+            if (skip_emulation_bytes_) {
+                // Emulation prevention bytes have to be found in the skipped range
+                for (; num_bits > 32; num_bits -= 32) {
+                    ReadBits(32);
+                }
+                ReadBits(num_bits);
+                return;
+            }
+            num_bits -= cache_bits_;
+            cache_ = 0;
+            cache_bits_ = 0;
+            size_t bytes_left = end_ - next_;
+            size_t skip_bytes = num_bits >> 3;
+            if (skip_bytes > bytes_left) {
+                pad_bytes_ += skip_bytes - bytes_left;
+                skip_bytes = bytes_left;
+            }
+            next_ += skip_bytes;
+            ReadBits(num_bits & 7);
+        }
+
+        /*! \brief Function to skip to the next byte boundary
+         */
+        inline void ByteAlign() {
+            SkipBits(cache_bits_ & 7);
+        }
+
+        /*! \brief Function to read an unsigned Exp-Golomb code ue(v)
+         * \return The decoded value. 0 if the prefix is longer than 31 bits (invalid code).
+         */
+        inline uint32_t ReadUe() {
+            if (cache_bits_ < 57) {
+                Refill();
+            }
+            // A cache with at least 57 valid bits holds any code with up to 28 leading zeros
+            int leading_zeros = cache_ ? __builtin_clzll(cache_) : 64;
+            if (leading_zeros <= 28) {
+                uint32_t code_len = 2 * leading_zeros + 1;
+                uint32_t value = static_cast<uint32_t>(cache_ >> (64 - code_len)) - 1;
+                cache_ <<= code_len;
+                cache_bits_ -= code_len;
+                return value;
+            }
+            leading_zeros = 0;
+            while (!GetBit()) {
+                if (++leading_zeros > 31) {
+                    return 0;
+                }
+            }
+            return (1u << leading_zeros) - 1 + ReadBits(leading_zeros);
+        }
+
+        /*! \brief Function to read a signed Exp-Golomb code se(v)
+         */
+        inline int32_t ReadSe() {
+            uint32_t ue = ReadUe();
+            int32_t value = static_cast<int32_t>((ue >> 1) + (ue & 1));
+            return (ue & 1) ? value : -value;
+        }
+
+        /*! \brief Function to get the number of bits consumed from the start of the buffer, not counting emulation prevention bytes
+         */
+        inline size_t GetBitOffset() const {
+            return (next_ - data_ - emu_bytes_ + pad_bytes_) * 8 - cache_bits_;
+        }
+
+        /*! \brief Function to check if there is more data before the RBSP trailing bits (more_rbsp_data())
+         * \return True if the current position is before the rbsp_stop_one_bit, the last bit equal to 1 in the buffer
+         */
+        inline bool MoreRbspData() const {
+            const uint8_t *last = end_;
+            while (last > data_ && *(last - 1) == 0) {
+                last--;
+            }
+            if (last == data_) {
+                return false;
+            }
+            size_t stop_bit_pos = (last - 1 - data_) * 8 + 7 - __builtin_ctz(*(last - 1));
+            if (skip_emulation_bytes_) {
+                // Move the stop bit position to RBSP bits. All emulation prevention bytes are before the last non-zero byte.
+                uint32_t zero_run = 0;
+                for (const uint8_t *p = data_; p < last - 1; p++) {
+                    if (zero_run >= 2 && *p == 0x03) {
+                        stop_bit_pos -= 8;
+                        zero_run = 0;
+                    } else {
+                        zero_run = *p ? 0 : zero_run + 1;
+                    }
+                }
+            }
+            return GetBitOffset() < stop_bit_pos;
+        }
+
+        /*! \brief Function to check if the reader is at a byte boundary
+         */
+        inline bool IsByteAligned() const {
+            return (cache_bits_ & 7) == 0;
+        }
+
+        /*! \brief Function to check if more bits than available in the buffer have been consumed
+         */
+        inline bool IsOverrun() const {
+            // The zero padding is at the end of the cache, so some of it has been consumed if it is longer than the cache
+            return pad_bytes_ * 8 > cache_bits_;
+        }
+
+        /*! \brief Function to get the buffer being read
+         */
+        inline const uint8_t *GetData() const { return data_; }
+
+        /*! \brief Function to get the size of the buffer being read in bytes
+         */
+        inline size_t GetSize() const { return end_ - data_; }
+
+    private:
+        const uint8_t *data_ = nullptr;     // start of the buffer
+        const uint8_t *next_ = nullptr;     // next byte to be loaded into the cache
+        const uint8_t *end_ = nullptr;      // end of the buffer
+        uint64_t cache_ = 0;                // left aligned cache word
+        uint32_t cache_bits_ = 0;           // number of valid bits in the cache
+        size_t pad_bytes_ = 0;              // zero bytes fed into the cache after the end of the buffer
+        bool skip_emulation_bytes_ = false; // true if the buffer is an EBSP
+        uint32_t zero_run_ = 0;             // number of consecutive zero bytes loaded last, EBSP only
+        size_t emu_bytes_ = 0;              // number of emulation prevention bytes skipped so far
+
+        /*! \brief Function to top up the cache to at least 57 bits
+         */
+        inline void Refill() {
+            uint32_t fill_bytes = (64 - cache_bits_) >> 3;
+            if (end_ - next_ >= 8) {
+                uint64_t word;
+                memcpy(&word, next_, 8);
+                // An EBSP word can be loaded as is if it has no zero byte and does not complete a 0x000003 sequence
+                if (!skip_emulation_bytes_ || (zero_run_ < 2 && !HasZeroByte(word))) {
+                    word = __builtin_bswap64(word);
+                    word >>= 64 - fill_bytes * 8;
+                    cache_ |= word << (64 - fill_bytes * 8 - cache_bits_);
+                    next_ += fill_bytes;
+                    cache_bits_ += fill_bytes * 8;
+                    zero_run_ = 0;
+                    return;
+                }
+            }
+            while (fill_bytes > 0) {
+                uint64_t byte = 0;
+                if (next_ < end_) {
+                    byte = *next_++;
+                    if (skip_emulation_bytes_) {
+                        if (zero_run_ >= 2 && byte == 0x03) {
+                            emu_bytes_++;
+                            zero_run_ = 0;
+                            continue;
+                        }
+                        zero_run_ = byte ? 0 : zero_run_ + 1;
+                    }
+                } else {
+                    pad_bytes_++;
+                }
+                cache_ |= byte << (56 - cache_bits_);
+                cache_bits_ += 8;
+                fill_bytes--;
+            }
+        }
+
+        /*! \brief Function to check if any byte of a 64-bit word is zero
+         */
+        static inline bool HasZeroByte(uint64_t word) {
+            return ((word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull) != 0;
+        }
+    };
+}
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "emulation_prevention.h"
+#include "start_code_scanner.h"
+
+namespace Parser {
+
+size_t EbspToRbsp(const uint8_t *src, size_t src_size, uint8_t *dst, std::vector<uint32_t> *emu_byte_pos) {
+    size_t read_pos = 0;
+    size_t write_pos = 0;
+    if (emu_byte_pos) {
+        emu_byte_pos->clear();
+    }
+    while (read_pos < src_size) {
+        size_t seq_pos = read_pos + ScanEmulationPrevention(src + read_pos, src_size - read_pos);
+        if (seq_pos >= src_size) {
+            break;
+        }
+        size_t emu_pos = seq_pos + 2;
+        //check the 4th byte after 0x000003, except when cabac_zero_word is used, in which case the last three bytes of this NAL unit must be 0x000003
+        if (emu_pos + 1 < src_size && src[emu_pos + 1] > 0x03) {
+            return static_cast<size_t>(-1);
+        }
+        //if cabac_zero_word is used, the final byte of this NAL unit(0x03) is kept
+        if (emu_pos + 1 == src_size) {
+            break;
+        }
+        if (dst + write_pos != src + read_pos) {
+            memmove(dst + write_pos, src + read_pos, emu_pos - read_pos);
+        }
+        write_pos += emu_pos - read_pos;
+        read_pos = emu_pos + 1;
+        if (emu_byte_pos) {
+            emu_byte_pos->push_back(static_cast<uint32_t>(emu_pos));
+        }
+    }
+    if (dst + write_pos != src + read_pos) {
+        memmove(dst + write_pos, src + read_pos, src_size - read_pos);
+    }
+    write_pos += src_size - read_pos;
+    return write_pos;
+}
+
+}
@@ -0,0 +1,42 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace Parser {
+    /*! \brief Function to convert an encapsulated byte sequence payload (EBSP) into a raw byte sequence payload (RBSP) by
+     * removing the emulation prevention bytes (0x03 in 0x000003) in a single pass.
+     *
+     * Runs of bytes without an emulation prevention sequence are located with <tt>ScanEmulationPrevention</tt> and copied in
+     * one go. <tt>dst</tt> may be equal to <tt>src</tt> for in-place conversion. A trailing 0x03 following a cabac_zero_word
+     * is kept.
+     * \param [in] src Pointer to the EBSP
+     * \param [in] src_size Size of the EBSP in bytes
+     * \param [out] dst Pointer to the output RBSP buffer. It must hold at least <tt>src_size</tt> bytes.
+     * \param [out] emu_byte_pos Optional list to receive the byte offsets in <tt>src</tt> of the removed emulation prevention bytes
+     * \return Size of the RBSP in bytes. <tt>static_cast<size_t>(-1)</tt> if an invalid byte follows an emulation prevention sequence.
+     */
+    size_t EbspToRbsp(const uint8_t *src, size_t src_size, uint8_t *dst, std::vector<uint32_t> *emu_byte_pos = nullptr);
+}
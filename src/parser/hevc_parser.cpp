@@ -54,9 +54,42 @@ rocDecStatus HevcVideoParser::UnInitialize() {
     return ROCDEC_SUCCESS;
 }
 
+rocDecStatus HevcVideoParser::Reset(uint32_t flags) {
+    if ((flags & ROCDEC_PARSER_RESET_FLUSH) && FlushDpb() != PARSER_OK) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    // DPB size is set again from the active SPS on the next slice. With pic_count_ reset the next IRAP picture gets
+    // NoRaslOutputFlag = 1 as the first picture of a bitstream.
+    InitDpb();
+    memset(&curr_pic_info_, 0, sizeof(HevcPicInfo));
+    first_pic_after_eos_nal_unit_ = 0;
+    slice_info_list_.assign(slice_info_list_.size(), {0});
+    slice_param_list_.assign(slice_param_list_.size(), {0});
+    if (!(flags & ROCDEC_PARSER_RESET_KEEP_PARAM_SETS)) {
+        m_active_vps_id_ = -1;
+        m_active_sps_id_ = -1;
+        m_active_pps_id_ = -1;
+        for (int i = 0; i < MAX_VPS_COUNT; i++) {
+            vps_list_[i].is_received = 0;
+        }
+        for (int i = 0; i < MAX_SPS_COUNT; i++) {
+            sps_list_[i].is_received = 0;
+        }
+        for (int i = 0; i < MAX_PPS_COUNT; i++) {
+            pps_list_[i].is_received = 0;
+        }
+    }
+    return RocVideoParser::Reset(flags);
+}
+
 rocDecStatus HevcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
+    // A discontinuity, e.g. after a splice or a seek: output the pending pictures, then drop the reference state
+    if ((p_data->flags & ROCDEC_PKT_DISCONTINUITY) && Reset(ROCDEC_PARSER_RESET_FLUSH | ROCDEC_PARSER_RESET_KEEP_PARAM_SETS) != ROCDEC_SUCCESS) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
     if (p_data->payload && p_data->payload_size) {
         curr_pts_ = p_data->pts;
+        IndexNalUnits(p_data, rocDecVideoCodec_HEVC);
         if (ParsePictureData(p_data->payload, p_data->payload_size) != PARSER_OK) {
             ERR(STR("Parser failed!"));
             return ROCDEC_RUNTIME_ERROR;
@@ -71,7 +104,7 @@ rocDecStatus HevcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
         }
 
         // Whenever new sei message found
-        if (pfn_get_sei_message_cb_ && sei_message_count_ > 0) {
+        if (pfn_get_sei_message_cb_ && sei_message_count_ > 0 && !pic_skipped_) {
             SendSeiMsgPayload();
         }
 
@@ -86,14 +119,20 @@ rocDecStatus HevcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
             return ROCDEC_RUNTIME_ERROR;
         }
 
-        // Output decoded pictures from DPB if any are ready
+        // Output decoded pictures from DPB if any are ready. Without reordering the picture just submitted is bumped already
+        // (C.5.2.3) and is displayed right away.
         if (pfn_display_picture_cb_ && num_output_pics_ > 0) {
-            if (OutputDecodedPictures(false) != PARSER_OK) {
+            if (OutputDecodedPictures(IsZeroReorderOutput()) != PARSER_OK) {
                 return ROCDEC_RUNTIME_ERROR;
             }
         }
 
         pic_count_++;
+
+        // Keyframe only: output the picture right away. The next IRAP picture does not refer to it.
+        if (parser_params_.keyframe_only && FlushDpb() != PARSER_OK) {
+            return ROCDEC_RUNTIME_ERROR;
+        }
     } else if (!(p_data->flags & ROCDEC_PKT_ENDOFSTREAM)) {
         // If no payload and EOS is not set, treated as invalid.
         return ROCDEC_INVALID_PARAMETER;
@@ -202,19 +241,11 @@ int HevcVideoParser::FillSeqCallbackFn(HevcSeqParamSet* sps_data) {
     video_format_params_.seqhdr_data_length = 0;
 
     // callback function with RocdecVideoFormat params filled out
-    if (pfn_sequece_cb_(parser_params_.user_data, &video_format_params_) == 0) {
-        ERR("Sequence callback function failed.");
-        return PARSER_FAIL;
-    } else {
-        return PARSER_OK;
-    }
+    return ReportVideoFormat();
 }
 
 void HevcVideoParser::SendSeiMsgPayload() {
-    sei_message_info_params_.sei_message_count = sei_message_count_;
-    sei_message_info_params_.sei_message = sei_message_list_.data();
-    sei_message_info_params_.sei_data = (void*)sei_payload_buf_;
-    sei_message_info_params_.picIdx = curr_pic_info_.dec_buf_idx;
+    SetSeiMessageInfo(curr_pic_info_.dec_buf_idx);
 
     // callback function with RocdecSeiMessageInfo params filled out
     if (pfn_get_sei_message_cb_) pfn_get_sei_message_cb_(parser_params_.user_data, &sei_message_info_params_);
@@ -240,6 +271,24 @@ int HevcVideoParser::SendPicForDecode() {
     dec_pic_params_.ref_pic_flag = 1;  // HEVC decoded picture is always marked as short term at first.
     dec_pic_params_.intra_pic_flag = slice_info_list_[0].slice_header.slice_type == HEVC_SLICE_TYPE_I ? 1 : 0;
 
+    if (parser_params_.header_only) {
+        RocdecParsedPicInfo pic_info = {};
+        pic_info.pic_type = ROCDEC_PIC_TYPE_I;
+        for (i = 0; i < num_slices_; i++) {
+            if (slice_info_list_[i].slice_header.slice_type == HEVC_SLICE_TYPE_B) {
+                pic_info.pic_type = ROCDEC_PIC_TYPE_B;
+                break;
+            } else if (slice_info_list_[i].slice_header.slice_type == HEVC_SLICE_TYPE_P) {
+                pic_info.pic_type = ROCDEC_PIC_TYPE_P;
+            }
+        }
+        pic_info.pic_order_cnt = curr_pic_info_.pic_order_cnt;
+        pic_info.qp = 26 + pps_ptr->init_qp_minus26 + slice_info_list_[0].slice_header.slice_qp_delta;
+        pic_info.ref_pic_flag = IsRefPic(&slice_nal_unit_header_) ? 1 : 0;
+        pic_info.key_frame_flag = IsIrapPic(&slice_nal_unit_header_) ? 1 : 0;
+        return OutputParsedPicture(&pic_info);
+    }
+
     // Todo: field_pic_flag, bottom_field_flag, second_field, ref_pic_flag, and intra_pic_flag seems to be associated with AVC/H.264.
     // Do we need them for general purpose? Reomve if not.
 
@@ -524,51 +573,61 @@ int HevcVideoParser::SendPicForDecode() {
 }
 
 ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t pic_data_size) {
-    ParserResult ret = PARSER_OK;
     ParserResult ret2;
 
     pic_data_buffer_ptr_ = (uint8_t*)p_stream;
     pic_data_size_ = pic_data_size;
-    curr_byte_offset_ = 0;
-    start_code_num_ = 0;
     curr_start_code_offset_ = 0;
-    next_start_code_offset_ = 0;
+    nal_unit_size_ = 0;
 
     num_slices_ = 0;
+    pic_skipped_ = false;
     sei_message_count_ = 0;
     sei_payload_size_ = 0;
 
-    do {
-        ret = GetNalUnit();
-        if (ret == PARSER_NOT_FOUND) {
-            ERR(STR("Error: no start code found in the frame data."));
-            return ret;
-        }
+    if (num_nal_units_ == 0) {
+        ERR(STR("Error: no start code found in the frame data."));
+        return PARSER_NOT_FOUND;
+    }
+
+    for (uint32_t i = 0; i < num_nal_units_; i++) {
+        curr_start_code_offset_ = nal_units_[i].offset;
+        nal_unit_size_ = nal_units_[i].size;
         // Parse the NAL unit
         if (nal_unit_size_ >= 5) {
             // start code + NAL unit header = 5 bytes
-            int ebsp_size = nal_unit_size_ - 5 > RBSP_BUF_SIZE ? RBSP_BUF_SIZE : nal_unit_size_ - 5; // only copy enough bytes for header parsing
-
             nal_unit_header_ = ParseNalUnitHeader(&pic_data_buffer_ptr_[curr_start_code_offset_ + 3]);
+            // Sub-bitstream extraction: discard the NAL units of the temporal sub-layers above the selected one
+            if (parser_params_.max_temporal_id_plus1 && nal_unit_header_.nuh_temporal_id_plus1 > parser_params_.max_temporal_id_plus1) {
+                continue;
+            }
+            // Drop the sub-layer non-reference pictures of the highest decoded sub-layer. No later picture refers to them.
+            if (IsNonRefPicDropped() && nal_unit_header_.nal_unit_type <= NAL_UNIT_RESERVED_VCL_N14 && !IsRefPic(&nal_unit_header_) &&
+                m_active_sps_id_ >= 0 && nal_unit_header_.nuh_temporal_id_plus1 - 1 >= GetHighestTid(&sps_list_[m_active_sps_id_])) {
+                if (nal_unit_size_ > 5 && (pic_data_buffer_ptr_[curr_start_code_offset_ + 5] & 0x80)) {  // first_slice_segment_in_pic_flag
+                    CountDroppedNonRefPic();
+                }
+                pic_skipped_ = true;
+                continue;
+            }
+            // Keyframe only: drop all VCL NAL units of non-IRAP pictures without parsing the slice headers
+            if (parser_params_.keyframe_only && nal_unit_header_.nal_unit_type <= NAL_UNIT_RESERVED_VCL31 && !IsIrapPic(&nal_unit_header_)) {
+                pic_skipped_ = true;
+                continue;
+            }
             switch (nal_unit_header_.nal_unit_type) {
                 case NAL_UNIT_VPS: {
-                    memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 5), ebsp_size);
-                    rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
-                    ParseVps(rbsp_buf_, rbsp_size_);
+                    ParseVps(pic_data_buffer_ptr_ + curr_start_code_offset_ + 5, nal_unit_size_ - 5);
                     break;
                 }
 
                 case NAL_UNIT_SPS: {
-                    memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 5), ebsp_size);
-                    rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
-                    ParseSps(rbsp_buf_, rbsp_size_);
+                    ParseSps(pic_data_buffer_ptr_ + curr_start_code_offset_ + 5, nal_unit_size_ - 5);
                     break;
                 }
 
                 case NAL_UNIT_PPS: {
-                    memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 5), ebsp_size);
-                    rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
-                    ParsePps(rbsp_buf_, rbsp_size_);
+                    ParsePps(pic_data_buffer_ptr_ + curr_start_code_offset_ + 5, nal_unit_size_ - 5);
                     break;
                 }
                 
@@ -599,10 +658,8 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
                     slice_info_list_[num_slices_].slice_data_offset = curr_start_code_offset_;
                     slice_info_list_[num_slices_].slice_data_size = nal_unit_size_;
 
-                    memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 5), ebsp_size);
-                    rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
                     HevcSliceSegHeader *p_slice_header = &slice_info_list_[num_slices_].slice_header;
-                    if ((ret2 = ParseSliceHeader(rbsp_buf_, rbsp_size_, p_slice_header)) != PARSER_OK) {
+                    if ((ret2 = ParseSliceHeader(pic_data_buffer_ptr_ + curr_start_code_offset_ + 5, nal_unit_size_ - 5, p_slice_header)) != PARSER_OK) {
                         // we got an error while parsing this NAL unit. ignore and continue with next NAL unit
                         break;      // ignore and continue to next nal_unit
                     }
@@ -616,7 +673,8 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
                         pic_stream_data_size_ = pic_data_size - curr_start_code_offset_;
 
                         if (IsIrapPic(&slice_nal_unit_header_)) {
-                            if (IsIdrPic(&slice_nal_unit_header_) || IsBlaPic(&slice_nal_unit_header_) || pic_count_ == 0 || first_pic_after_eos_nal_unit_) {
+                            // In keyframe only mode HandleCraAsBlaFlag is set since the pictures between the IRAP pictures are dropped
+                            if (IsIdrPic(&slice_nal_unit_header_) || IsBlaPic(&slice_nal_unit_header_) || pic_count_ == 0 || first_pic_after_eos_nal_unit_ || parser_params_.keyframe_only) {
                                 no_rasl_output_flag_ = 1;
                             } else {
                                 no_rasl_output_flag_ = 0;
@@ -672,20 +730,7 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
                 case NAL_UNIT_PREFIX_SEI:
                 case NAL_UNIT_SUFFIX_SEI: {
                     if (pfn_get_sei_message_cb_) {
-                        int sei_ebsp_size = nal_unit_size_ - 5; // copy the entire NAL unit
-                        if (sei_rbsp_buf_) {
-                            if (sei_ebsp_size > sei_rbsp_buf_size_) {
-                                delete [] sei_rbsp_buf_;
-                                sei_rbsp_buf_ = new uint8_t [sei_ebsp_size];
-                                sei_rbsp_buf_size_ = sei_ebsp_size;
-                            }
-                        } else {
-                            sei_rbsp_buf_size_ = sei_ebsp_size > INIT_SEI_PAYLOAD_BUF_SIZE ? sei_ebsp_size : INIT_SEI_PAYLOAD_BUF_SIZE;
-                            sei_rbsp_buf_ = new uint8_t [sei_rbsp_buf_size_];
-                        }
-                        memcpy(sei_rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 5), sei_ebsp_size);
-                        rbsp_size_ = EbspToRbsp(sei_rbsp_buf_, 0, sei_ebsp_size);
-                        ParseSeiMessage(sei_rbsp_buf_, rbsp_size_);
+                        ParseSeiNalUnit(pic_data_buffer_ptr_ + curr_start_code_offset_ + 5, nal_unit_size_ - 5);
                     }
                     break;
                 }
@@ -704,122 +749,117 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
                     break;
             }
         }
-
-        // Break if this is the last NAL unit
-        if (ret == PARSER_EOF) {
-            break;
-        }
-    } while (1);
+    }
 
     return PARSER_OK;
 }
 
-void HevcVideoParser::ParsePtl(HevcProfileTierLevel *ptl, bool profile_present_flag, uint32_t max_num_sub_layers_minus1, uint8_t *nalu, size_t size, size_t& offset) {
+void HevcVideoParser::ParsePtl(HevcProfileTierLevel *ptl, bool profile_present_flag, uint32_t max_num_sub_layers_minus1, Parser::BitReader &bit_reader) {
     if (profile_present_flag) {
-        ptl->general_profile_space = Parser::ReadBits(nalu, offset, 2);
-        ptl->general_tier_flag = Parser::GetBit(nalu, offset);
-        ptl->general_profile_idc = Parser::ReadBits(nalu, offset, 5);
+        ptl->general_profile_space = bit_reader.ReadBits(2);
+        ptl->general_tier_flag = bit_reader.GetBit();
+        ptl->general_profile_idc = bit_reader.ReadBits(5);
         for (int i = 0; i < 32; i++) {
-            ptl->general_profile_compatibility_flag[i] = Parser::GetBit(nalu, offset);
+            ptl->general_profile_compatibility_flag[i] = bit_reader.GetBit();
         }
-        ptl->general_progressive_source_flag = Parser::GetBit(nalu, offset);
-        ptl->general_interlaced_source_flag = Parser::GetBit(nalu, offset);
-        ptl->general_non_packed_constraint_flag = Parser::GetBit(nalu, offset);
-        ptl->general_frame_only_constraint_flag = Parser::GetBit(nalu, offset);
+        ptl->general_progressive_source_flag = bit_reader.GetBit();
+        ptl->general_interlaced_source_flag = bit_reader.GetBit();
+        ptl->general_non_packed_constraint_flag = bit_reader.GetBit();
+        ptl->general_frame_only_constraint_flag = bit_reader.GetBit();
         // ReadBits is limited to 32
-        offset += 44; // skip 44 bits
+        bit_reader.SkipBits(44); // skip 44 bits
         // Todo: add constrant flags parsing for higher profiles when needed
     }
 
-    ptl->general_level_idc = Parser::ReadBits(nalu, offset, 8);
+    ptl->general_level_idc = bit_reader.ReadBits(8);
     for(uint32_t i = 0; i < max_num_sub_layers_minus1; i++) {
-        ptl->sub_layer_profile_present_flag[i] = Parser::GetBit(nalu, offset);
-        ptl->sub_layer_level_present_flag[i] = Parser::GetBit(nalu, offset);
+        ptl->sub_layer_profile_present_flag[i] = bit_reader.GetBit();
+        ptl->sub_layer_level_present_flag[i] = bit_reader.GetBit();
     }
     if (max_num_sub_layers_minus1 > 0) {
         for(uint32_t i = max_num_sub_layers_minus1; i < 8; i++) {               
-            ptl->reserved_zero_2bits[i] = Parser::ReadBits(nalu, offset, 2);
+            ptl->reserved_zero_2bits[i] = bit_reader.ReadBits(2);
         }
     }
     for (uint32_t i = 0; i < max_num_sub_layers_minus1; i++) {
         if (ptl->sub_layer_profile_present_flag[i]) {
-            ptl->sub_layer_profile_space[i] = Parser::ReadBits(nalu, offset, 2);
-            ptl->sub_layer_tier_flag[i] = Parser::GetBit(nalu, offset);
-            ptl->sub_layer_profile_idc[i] = Parser::ReadBits(nalu, offset, 5);
+            ptl->sub_layer_profile_space[i] = bit_reader.ReadBits(2);
+            ptl->sub_layer_tier_flag[i] = bit_reader.GetBit();
+            ptl->sub_layer_profile_idc[i] = bit_reader.ReadBits(5);
             for (int j = 0; j < 32; j++) {
-                ptl->sub_layer_profile_compatibility_flag[i][j] = Parser::GetBit(nalu, offset);
+                ptl->sub_layer_profile_compatibility_flag[i][j] = bit_reader.GetBit();
             }
-            ptl->sub_layer_progressive_source_flag[i] = Parser::GetBit(nalu, offset);
-            ptl->sub_layer_interlaced_source_flag[i] = Parser::GetBit(nalu, offset);
-            ptl->sub_layer_non_packed_constraint_flag[i] = Parser::GetBit(nalu, offset);
-            ptl->sub_layer_frame_only_constraint_flag[i] = Parser::GetBit(nalu, offset);
+            ptl->sub_layer_progressive_source_flag[i] = bit_reader.GetBit();
+            ptl->sub_layer_interlaced_source_flag[i] = bit_reader.GetBit();
+            ptl->sub_layer_non_packed_constraint_flag[i] = bit_reader.GetBit();
+            ptl->sub_layer_frame_only_constraint_flag[i] = bit_reader.GetBit();
             // ReadBits is limited to 32
-            offset += 44;  // skip 44 bits
+            bit_reader.SkipBits(44);  // skip 44 bits
             // Todo: add constrant flags parsing for higher profiles when needed
         }
         if (ptl->sub_layer_level_present_flag[i]) {
-            ptl->sub_layer_level_idc[i] = Parser::ReadBits(nalu, offset, 8);
+            ptl->sub_layer_level_idc[i] = bit_reader.ReadBits(8);
         }
     }
 }
 
-void HevcVideoParser::ParseSubLayerHrdParameters(HevcSubLayerHrdParameters *sub_hrd, uint32_t cpb_cnt, bool sub_pic_hrd_params_present_flag, uint8_t *nalu, size_t /*size*/, size_t& offset) {
+void HevcVideoParser::ParseSubLayerHrdParameters(HevcSubLayerHrdParameters *sub_hrd, uint32_t cpb_cnt, bool sub_pic_hrd_params_present_flag, Parser::BitReader &bit_reader) {
     for (uint32_t i = 0; i <= cpb_cnt; i++) {
-        sub_hrd->bit_rate_value_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
-        sub_hrd->cpb_size_value_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+        sub_hrd->bit_rate_value_minus1[i] = bit_reader.ReadUe();
+        sub_hrd->cpb_size_value_minus1[i] = bit_reader.ReadUe();
         if(sub_pic_hrd_params_present_flag) {
-            sub_hrd->cpb_size_du_value_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
-            sub_hrd->bit_rate_du_value_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            sub_hrd->cpb_size_du_value_minus1[i] = bit_reader.ReadUe();
+            sub_hrd->bit_rate_du_value_minus1[i] = bit_reader.ReadUe();
         }
-        sub_hrd->cbr_flag[i] = Parser::GetBit(nalu, offset);
+        sub_hrd->cbr_flag[i] = bit_reader.GetBit();
     }
 }
 
-void HevcVideoParser::ParseHrdParameters(HevcHrdParameters *hrd, bool common_inf_present_flag, uint32_t max_num_sub_layers_minus1, uint8_t *nalu, size_t size,size_t &offset) {
+void HevcVideoParser::ParseHrdParameters(HevcHrdParameters *hrd, bool common_inf_present_flag, uint32_t max_num_sub_layers_minus1, Parser::BitReader &bit_reader) {
     if (common_inf_present_flag) {
-        hrd->nal_hrd_parameters_present_flag = Parser::GetBit(nalu, offset);
-        hrd->vcl_hrd_parameters_present_flag = Parser::GetBit(nalu, offset);
+        hrd->nal_hrd_parameters_present_flag = bit_reader.GetBit();
+        hrd->vcl_hrd_parameters_present_flag = bit_reader.GetBit();
         if (hrd->nal_hrd_parameters_present_flag || hrd->vcl_hrd_parameters_present_flag) {
-            hrd->sub_pic_hrd_params_present_flag = Parser::GetBit(nalu, offset);
+            hrd->sub_pic_hrd_params_present_flag = bit_reader.GetBit();
             if (hrd->sub_pic_hrd_params_present_flag) {
-                hrd->tick_divisor_minus2 = Parser::ReadBits(nalu, offset, 8);
-                hrd->du_cpb_removal_delay_increment_length_minus1 = Parser::ReadBits(nalu, offset, 5);
-                hrd->sub_pic_cpb_params_in_pic_timing_sei_flag = Parser::GetBit(nalu, offset);
-                hrd->dpb_output_delay_du_length_minus1 = Parser::ReadBits(nalu, offset, 5);
+                hrd->tick_divisor_minus2 = bit_reader.ReadBits(8);
+                hrd->du_cpb_removal_delay_increment_length_minus1 = bit_reader.ReadBits(5);
+                hrd->sub_pic_cpb_params_in_pic_timing_sei_flag = bit_reader.GetBit();
+                hrd->dpb_output_delay_du_length_minus1 = bit_reader.ReadBits(5);
             }
-            hrd->bit_rate_scale = Parser::ReadBits(nalu, offset, 4);
-            hrd->cpb_size_scale = Parser::ReadBits(nalu, offset, 4);
+            hrd->bit_rate_scale = bit_reader.ReadBits(4);
+            hrd->cpb_size_scale = bit_reader.ReadBits(4);
             if (hrd->sub_pic_hrd_params_present_flag) {
-                hrd->cpb_size_du_scale = Parser::ReadBits(nalu, offset, 4);
+                hrd->cpb_size_du_scale = bit_reader.ReadBits(4);
             }
-            hrd->initial_cpb_removal_delay_length_minus1 = Parser::ReadBits(nalu, offset, 5);
-            hrd->au_cpb_removal_delay_length_minus1 = Parser::ReadBits(nalu, offset, 5);
-            hrd->dpb_output_delay_length_minus1 = Parser::ReadBits(nalu, offset, 5);
+            hrd->initial_cpb_removal_delay_length_minus1 = bit_reader.ReadBits(5);
+            hrd->au_cpb_removal_delay_length_minus1 = bit_reader.ReadBits(5);
+            hrd->dpb_output_delay_length_minus1 = bit_reader.ReadBits(5);
         }
     }
     for (uint32_t i = 0; i <= max_num_sub_layers_minus1; i++) {
-        hrd->fixed_pic_rate_general_flag[i] = Parser::GetBit(nalu, offset);
+        hrd->fixed_pic_rate_general_flag[i] = bit_reader.GetBit();
         if (!hrd->fixed_pic_rate_general_flag[i]) {
-            hrd->fixed_pic_rate_within_cvs_flag[i] = Parser::GetBit(nalu, offset);
+            hrd->fixed_pic_rate_within_cvs_flag[i] = bit_reader.GetBit();
         } else {
             hrd->fixed_pic_rate_within_cvs_flag[i] = hrd->fixed_pic_rate_general_flag[i];
         }
 
         if (hrd->fixed_pic_rate_within_cvs_flag[i]) {
-            hrd->elemental_duration_in_tc_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            hrd->elemental_duration_in_tc_minus1[i] = bit_reader.ReadUe();
         } else {
-            hrd->low_delay_hrd_flag[i] = Parser::GetBit(nalu, offset);
+            hrd->low_delay_hrd_flag[i] = bit_reader.GetBit();
         }
         if (!hrd->low_delay_hrd_flag[i]) {
-            hrd->cpb_cnt_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            hrd->cpb_cnt_minus1[i] = bit_reader.ReadUe();
         }
         if (hrd->nal_hrd_parameters_present_flag) {
             //sub_layer_hrd_parameters( i )
-            ParseSubLayerHrdParameters(&hrd->sub_layer_hrd_parameters_0[i], hrd->cpb_cnt_minus1[i], hrd->sub_pic_hrd_params_present_flag, nalu, size, offset);
+            ParseSubLayerHrdParameters(&hrd->sub_layer_hrd_parameters_0[i], hrd->cpb_cnt_minus1[i], hrd->sub_pic_hrd_params_present_flag, bit_reader);
         }
         if (hrd->vcl_hrd_parameters_present_flag) {
             //sub_layer_hrd_parameters( i )
-            ParseSubLayerHrdParameters(&hrd->sub_layer_hrd_parameters_1[i], hrd->cpb_cnt_minus1[i], hrd->sub_pic_hrd_params_present_flag, nalu, size, offset);
+            ParseSubLayerHrdParameters(&hrd->sub_layer_hrd_parameters_1[i], hrd->cpb_cnt_minus1[i], hrd->sub_pic_hrd_params_present_flag, bit_reader);
         }
     }
 }
@@ -906,12 +946,12 @@ void HevcVideoParser::SetDefaultScalingList(HevcScalingListData *sl_ptr) {
     }
 }
 
-void HevcVideoParser::ParseScalingList(HevcScalingListData * sl_ptr, uint8_t *nalu, size_t size, size_t& offset, HevcSeqParamSet *sps_ptr) {
+void HevcVideoParser::ParseScalingList(HevcScalingListData * sl_ptr, Parser::BitReader &bit_reader, HevcSeqParamSet *sps_ptr) {
     for (int size_id = 0; size_id < 4; size_id++) {
         for (int matrix_id = 0; matrix_id < 6; matrix_id += (size_id == 3) ? 3 : 1) {
-            sl_ptr->scaling_list_pred_mode_flag[size_id][matrix_id] = Parser::GetBit(nalu, offset);
+            sl_ptr->scaling_list_pred_mode_flag[size_id][matrix_id] = bit_reader.GetBit();
             if(!sl_ptr->scaling_list_pred_mode_flag[size_id][matrix_id]) {
-                sl_ptr->scaling_list_pred_matrix_id_delta[size_id][matrix_id] = Parser::ExpGolomb::ReadUe(nalu, offset);
+                sl_ptr->scaling_list_pred_matrix_id_delta[size_id][matrix_id] = bit_reader.ReadUe();
                 // If scaling_list_pred_matrix_id_delta is 0, infer from default scaling list. We have filled the scaling
                 // list with default values earlier.
                 if (sl_ptr->scaling_list_pred_matrix_id_delta[size_id][matrix_id]) {
@@ -931,13 +971,13 @@ void HevcVideoParser::ParseScalingList(HevcScalingListData * sl_ptr, uint8_t *na
                 int next_coef = 8;
                 int coef_num = std::min(64, (1 << (4 + (size_id << 1))));
                 if (size_id > 1) {
-                    sl_ptr->scaling_list_dc_coef_minus8[size_id - 2][matrix_id] = Parser::ExpGolomb::ReadSe(nalu, offset);
+                    sl_ptr->scaling_list_dc_coef_minus8[size_id - 2][matrix_id] = bit_reader.ReadSe();
                     next_coef = sl_ptr->scaling_list_dc_coef_minus8[size_id - 2][matrix_id] + 8;
                     // Record DC coefficient for 16x16 or 32x32
                     sl_ptr->scaling_list_dc_coef[size_id - 2][matrix_id] = next_coef;
                 }
                 for (int i = 0; i < coef_num; i++) {
-                    sl_ptr->scaling_list_delta_coef = Parser::ExpGolomb::ReadSe(nalu, offset);
+                    sl_ptr->scaling_list_delta_coef = bit_reader.ReadSe();
                     next_coef = (next_coef + sl_ptr->scaling_list_delta_coef + 256) % 256;
                     if (size_id == 0) {
                         sl_ptr->scaling_list[size_id][matrix_id][diag_scan_4x4[i]] = next_coef;
@@ -963,31 +1003,31 @@ void HevcVideoParser::ParseScalingList(HevcScalingListData * sl_ptr, uint8_t *na
     }
 }
 
-ParserResult HevcVideoParser::ParseShortTermRefPicSet(HevcSeqParamSet *sps_ptr, HevcShortTermRps *rps, uint32_t st_rps_idx, uint32_t number_short_term_ref_pic_sets, HevcShortTermRps rps_ref[], uint8_t *nalu, size_t /*size*/, size_t& offset) {
+ParserResult HevcVideoParser::ParseShortTermRefPicSet(HevcSeqParamSet *sps_ptr, HevcShortTermRps *rps, uint32_t st_rps_idx, uint32_t number_short_term_ref_pic_sets, HevcShortTermRps rps_ref[], Parser::BitReader &bit_reader) {
     int i, j;
 
     memset(rps, 0, sizeof(HevcShortTermRps));
      if (st_rps_idx != 0) {
-        rps->inter_ref_pic_set_prediction_flag = Parser::GetBit(nalu, offset);
+        rps->inter_ref_pic_set_prediction_flag = bit_reader.GetBit();
     } else {
         rps->inter_ref_pic_set_prediction_flag = 0;
     }
     if (rps->inter_ref_pic_set_prediction_flag) {
         if (st_rps_idx == number_short_term_ref_pic_sets) {
-            rps->delta_idx_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+            rps->delta_idx_minus1 = bit_reader.ReadUe();
         } else {
             rps->delta_idx_minus1 = 0;
         }
-        rps->delta_rps_sign = Parser::GetBit(nalu, offset);
-        rps->abs_delta_rps_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+        rps->delta_rps_sign = bit_reader.GetBit();
+        rps->abs_delta_rps_minus1 = bit_reader.ReadUe();
         int ref_rps_idx = st_rps_idx - (rps->delta_idx_minus1 + 1);  // (7-59)
         int delta_rps = (1 - 2 * rps->delta_rps_sign) * (rps->abs_delta_rps_minus1 + 1);  // (7-60)
 
         HevcShortTermRps *ref_rps = &rps_ref[ref_rps_idx];
         for (j = 0; j <= ref_rps->num_of_delta_pocs; j++) {
-            rps->used_by_curr_pic_flag[j] = Parser::GetBit(nalu, offset);
+            rps->used_by_curr_pic_flag[j] = bit_reader.GetBit();
             if (!rps->used_by_curr_pic_flag[j]) {
-                rps->use_delta_flag[j] = Parser::GetBit(nalu, offset);
+                rps->use_delta_flag[j] = bit_reader.GetBit();
             } else {
                 rps->use_delta_flag[j] = 1;
             }
@@ -1038,62 +1078,62 @@ ParserResult HevcVideoParser::ParseShortTermRefPicSet(HevcSeqParamSet *sps_ptr,
         rps->num_positive_pics = i;
         rps->num_of_delta_pocs = rps->num_negative_pics + rps->num_positive_pics;
     } else {
-        rps->num_negative_pics = Parser::ExpGolomb::ReadUe(nalu, offset);
-        rps->num_positive_pics = Parser::ExpGolomb::ReadUe(nalu, offset);
+        rps->num_negative_pics = bit_reader.ReadUe();
+        rps->num_positive_pics = bit_reader.ReadUe();
         rps->num_of_delta_pocs = rps->num_negative_pics + rps->num_positive_pics;
         CHECK_ALLOWED_RANGE(rps->num_of_delta_pocs, 0, sps_ptr->sps_max_dec_pic_buffering_minus1[sps_ptr->sps_max_sub_layers_minus1]);
 
         for (i = 0; i < rps->num_negative_pics; i++) {
-            rps->delta_poc_s0_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            rps->delta_poc_s0_minus1[i] = bit_reader.ReadUe();
             if (i == 0) {
                 rps->delta_poc_s0[i] = -(rps->delta_poc_s0_minus1[i] + 1);
             } else {
                 rps->delta_poc_s0[i] = rps->delta_poc_s0[i - 1] - (rps->delta_poc_s0_minus1[i] + 1);
             }
-            rps->used_by_curr_pic_s0[i] = Parser::GetBit(nalu, offset);
+            rps->used_by_curr_pic_s0[i] = bit_reader.GetBit();
         }
 
         for (i = 0; i < rps->num_positive_pics; i++) {
-            rps->delta_poc_s1_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            rps->delta_poc_s1_minus1[i] = bit_reader.ReadUe();
             if (i == 0) {
                 rps->delta_poc_s1[i] = rps->delta_poc_s1_minus1[i] + 1;
             } else {
                 rps->delta_poc_s1[i] = rps->delta_poc_s1[i - 1] + (rps->delta_poc_s1_minus1[i] + 1);
             }
-            rps->used_by_curr_pic_s1[i] = Parser::GetBit(nalu, offset);
+            rps->used_by_curr_pic_s1[i] = bit_reader.GetBit();
         }
     }
     return PARSER_OK;
 }
 
-void HevcVideoParser::ParsePredWeightTable(HevcSliceSegHeader *slice_header_ptr, int chroma_array_type, uint8_t *stream_ptr, size_t &offset) {
+void HevcVideoParser::ParsePredWeightTable(HevcSliceSegHeader *slice_header_ptr, int chroma_array_type, Parser::BitReader &bit_reader) {
     HevcPredWeightTable *pred_weight_table_ptr = &slice_header_ptr->pred_weight_table;
     int chroma_log2_weight_denom; // ChromaLog2WeightDenom
     int i, j;
 
-    pred_weight_table_ptr->luma_log2_weight_denom = Parser::ExpGolomb::ReadUe(stream_ptr, offset);
+    pred_weight_table_ptr->luma_log2_weight_denom = bit_reader.ReadUe();
     if (chroma_array_type) {
-        pred_weight_table_ptr->delta_chroma_log2_weight_denom = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
+        pred_weight_table_ptr->delta_chroma_log2_weight_denom = bit_reader.ReadSe();
     }
     chroma_log2_weight_denom = pred_weight_table_ptr->luma_log2_weight_denom + pred_weight_table_ptr->delta_chroma_log2_weight_denom;
 
     for (i = 0; i <= slice_header_ptr->num_ref_idx_l0_active_minus1; i++) {
-        pred_weight_table_ptr->luma_weight_l0_flag[i] = Parser::GetBit(stream_ptr, offset);
+        pred_weight_table_ptr->luma_weight_l0_flag[i] = bit_reader.GetBit();
     }
     if (chroma_array_type) {
         for (i = 0; i <= slice_header_ptr->num_ref_idx_l0_active_minus1; i++) {
-            pred_weight_table_ptr->chroma_weight_l0_flag[i] = Parser::GetBit(stream_ptr, offset);
+            pred_weight_table_ptr->chroma_weight_l0_flag[i] = bit_reader.GetBit();
         }
     }
     for (i = 0; i <= slice_header_ptr->num_ref_idx_l0_active_minus1; i++) {
         if (pred_weight_table_ptr->luma_weight_l0_flag[i]) {
-            pred_weight_table_ptr->delta_luma_weight_l0[i] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
-            pred_weight_table_ptr->luma_offset_l0[i] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
+            pred_weight_table_ptr->delta_luma_weight_l0[i] = bit_reader.ReadSe();
+            pred_weight_table_ptr->luma_offset_l0[i] = bit_reader.ReadSe();
         }
         if (pred_weight_table_ptr->chroma_weight_l0_flag[i]) {
             for (j = 0; j < 2; j++) {
-                pred_weight_table_ptr->delta_chroma_weight_l0[i][j] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
-                pred_weight_table_ptr->delta_chroma_offset_l0[i][j] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
+                pred_weight_table_ptr->delta_chroma_weight_l0[i][j] = bit_reader.ReadSe();
+                pred_weight_table_ptr->delta_chroma_offset_l0[i][j] = bit_reader.ReadSe();
                 pred_weight_table_ptr->chroma_weight_l0[i][j] = (1 << chroma_log2_weight_denom) + pred_weight_table_ptr->delta_chroma_weight_l0[i][j];
                 pred_weight_table_ptr->chroma_offset_l0[i][j] = std::clamp((pred_weight_table_ptr->delta_chroma_offset_l0[i][j] - ((128 * pred_weight_table_ptr->chroma_weight_l0[i][j]) >> chroma_log2_weight_denom) + 128), -128, 127);
             }
@@ -1107,22 +1147,22 @@ void HevcVideoParser::ParsePredWeightTable(HevcSliceSegHeader *slice_header_ptr,
 
     if (slice_header_ptr->slice_type == HEVC_SLICE_TYPE_B) {
         for (i = 0; i <= slice_header_ptr->num_ref_idx_l1_active_minus1; i++) {
-            pred_weight_table_ptr->luma_weight_l1_flag[i] = Parser::GetBit(stream_ptr, offset);
+            pred_weight_table_ptr->luma_weight_l1_flag[i] = bit_reader.GetBit();
         }
         if (chroma_array_type) {
             for (i = 0; i <= slice_header_ptr->num_ref_idx_l1_active_minus1; i++) {
-                pred_weight_table_ptr->chroma_weight_l1_flag[i] = Parser::GetBit(stream_ptr, offset);
+                pred_weight_table_ptr->chroma_weight_l1_flag[i] = bit_reader.GetBit();
             }
         }
         for (i = 0; i <= slice_header_ptr->num_ref_idx_l1_active_minus1; i++) {
             if (pred_weight_table_ptr->luma_weight_l1_flag[i]) {
-                pred_weight_table_ptr->delta_luma_weight_l1[i] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
-                pred_weight_table_ptr->luma_offset_l1[i] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
+                pred_weight_table_ptr->delta_luma_weight_l1[i] = bit_reader.ReadSe();
+                pred_weight_table_ptr->luma_offset_l1[i] = bit_reader.ReadSe();
             }
             if (pred_weight_table_ptr->chroma_weight_l1_flag[i]) {
                 for (j = 0; j < 2; j++) {
-                    pred_weight_table_ptr->delta_chroma_weight_l1[i][j] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
-                    pred_weight_table_ptr->delta_chroma_offset_l1[i][j] = Parser::ExpGolomb::ReadSe(stream_ptr, offset);
+                    pred_weight_table_ptr->delta_chroma_weight_l1[i][j] = bit_reader.ReadSe();
+                    pred_weight_table_ptr->delta_chroma_offset_l1[i][j] = bit_reader.ReadSe();
                     pred_weight_table_ptr->chroma_weight_l1[i][j] = (1 << chroma_log2_weight_denom) + pred_weight_table_ptr->delta_chroma_weight_l1[i][j];
                     pred_weight_table_ptr->chroma_offset_l1[i][j] = std::clamp((pred_weight_table_ptr->delta_chroma_offset_l1[i][j] - ((128 * pred_weight_table_ptr->chroma_weight_l1[i][j]) >> chroma_log2_weight_denom) + 128), -128, 127);
                 }
@@ -1136,125 +1176,131 @@ void HevcVideoParser::ParsePredWeightTable(HevcSliceSegHeader *slice_header_ptr,
     }
 }
 
-void HevcVideoParser::ParseVui(HevcVuiParameters *vui, uint32_t max_num_sub_layers_minus1, uint8_t *nalu, size_t size, size_t &offset) {
-    vui->aspect_ratio_info_present_flag = Parser::GetBit(nalu, offset);
+void HevcVideoParser::ParseVui(HevcVuiParameters *vui, uint32_t max_num_sub_layers_minus1, Parser::BitReader &bit_reader) {
+    vui->aspect_ratio_info_present_flag = bit_reader.GetBit();
     if (vui->aspect_ratio_info_present_flag) {
-        vui->aspect_ratio_idc = Parser::ReadBits(nalu, offset, 8);
+        vui->aspect_ratio_idc = bit_reader.ReadBits(8);
         if (vui->aspect_ratio_idc == 255) {
-            vui->sar_width = Parser::ReadBits(nalu, offset, 16);
-            vui->sar_height = Parser::ReadBits(nalu, offset, 16);
+            vui->sar_width = bit_reader.ReadBits(16);
+            vui->sar_height = bit_reader.ReadBits(16);
         }
     }
-    vui->overscan_info_present_flag = Parser::GetBit(nalu, offset);
+    vui->overscan_info_present_flag = bit_reader.GetBit();
     if (vui->overscan_info_present_flag) {
-        vui->overscan_appropriate_flag = Parser::GetBit(nalu, offset);
+        vui->overscan_appropriate_flag = bit_reader.GetBit();
     }
-    vui->video_signal_type_present_flag = Parser::GetBit(nalu, offset);
+    vui->video_signal_type_present_flag = bit_reader.GetBit();
     if (vui->video_signal_type_present_flag) {
-        vui->video_format = Parser::ReadBits(nalu, offset, 3);
-        vui->video_full_range_flag = Parser::GetBit(nalu, offset);
-        vui->colour_description_present_flag = Parser::GetBit(nalu, offset);
+        vui->video_format = bit_reader.ReadBits(3);
+        vui->video_full_range_flag = bit_reader.GetBit();
+        vui->colour_description_present_flag = bit_reader.GetBit();
         if (vui->colour_description_present_flag) {
-            vui->colour_primaries = Parser::ReadBits(nalu, offset, 8);
-            vui->transfer_characteristics = Parser::ReadBits(nalu, offset, 8);
-            vui->matrix_coeffs = Parser::ReadBits(nalu, offset, 8);
+            vui->colour_primaries = bit_reader.ReadBits(8);
+            vui->transfer_characteristics = bit_reader.ReadBits(8);
+            vui->matrix_coeffs = bit_reader.ReadBits(8);
         }
     }
-    vui->chroma_loc_info_present_flag = Parser::GetBit(nalu, offset);
+    vui->chroma_loc_info_present_flag = bit_reader.GetBit();
     if (vui->chroma_loc_info_present_flag) {
-        vui->chroma_sample_loc_type_top_field = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->chroma_sample_loc_type_bottom_field = Parser::ExpGolomb::ReadUe(nalu, offset);
+        vui->chroma_sample_loc_type_top_field = bit_reader.ReadUe();
+        vui->chroma_sample_loc_type_bottom_field = bit_reader.ReadUe();
     }
-    vui->neutral_chroma_indication_flag = Parser::GetBit(nalu, offset);
-    vui->field_seq_flag = Parser::GetBit(nalu, offset);
-    vui->frame_field_info_present_flag = Parser::GetBit(nalu, offset);
-    vui->default_display_window_flag = Parser::GetBit(nalu, offset);
+    vui->neutral_chroma_indication_flag = bit_reader.GetBit();
+    vui->field_seq_flag = bit_reader.GetBit();
+    vui->frame_field_info_present_flag = bit_reader.GetBit();
+    vui->default_display_window_flag = bit_reader.GetBit();
     if (vui->default_display_window_flag) {
-        vui->def_disp_win_left_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->def_disp_win_right_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->def_disp_win_top_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->def_disp_win_bottom_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
+        vui->def_disp_win_left_offset = bit_reader.ReadUe();
+        vui->def_disp_win_right_offset = bit_reader.ReadUe();
+        vui->def_disp_win_top_offset = bit_reader.ReadUe();
+        vui->def_disp_win_bottom_offset = bit_reader.ReadUe();
     }
-    vui->vui_timing_info_present_flag = Parser::GetBit(nalu, offset);
+    vui->vui_timing_info_present_flag = bit_reader.GetBit();
     if (vui->vui_timing_info_present_flag) {
-        vui->vui_num_units_in_tick = Parser::ReadBits(nalu, offset, 32);
-        vui->vui_time_scale = Parser::ReadBits(nalu, offset, 32);
-        vui->vui_poc_proportional_to_timing_flag = Parser::GetBit(nalu, offset);
+        vui->vui_num_units_in_tick = bit_reader.ReadBits(32);
+        vui->vui_time_scale = bit_reader.ReadBits(32);
+        vui->vui_poc_proportional_to_timing_flag = bit_reader.GetBit();
         if (vui->vui_poc_proportional_to_timing_flag) {
-            vui->vui_num_ticks_poc_diff_one_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+            vui->vui_num_ticks_poc_diff_one_minus1 = bit_reader.ReadUe();
         }
-        vui->vui_hrd_parameters_present_flag = Parser::GetBit(nalu, offset);
+        vui->vui_hrd_parameters_present_flag = bit_reader.GetBit();
         if (vui->vui_hrd_parameters_present_flag) {
-            ParseHrdParameters(&vui->hrd_parameters, 1, max_num_sub_layers_minus1, nalu, size, offset);
+            ParseHrdParameters(&vui->hrd_parameters, 1, max_num_sub_layers_minus1, bit_reader);
         }
     }
-    vui->bitstream_restriction_flag = Parser::GetBit(nalu, offset);
+    vui->bitstream_restriction_flag = bit_reader.GetBit();
     if (vui->bitstream_restriction_flag) {
-        vui->tiles_fixed_structure_flag = Parser::GetBit(nalu, offset);
-        vui->motion_vectors_over_pic_boundaries_flag = Parser::GetBit(nalu, offset);
-        vui->restricted_ref_pic_lists_flag = Parser::GetBit(nalu, offset);
-        vui->min_spatial_segmentation_idc = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->max_bytes_per_pic_denom = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->max_bits_per_min_cu_denom = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->log2_max_mv_length_horizontal = Parser::ExpGolomb::ReadUe(nalu, offset);
-        vui->log2_max_mv_length_vertical = Parser::ExpGolomb::ReadUe(nalu, offset);
+        vui->tiles_fixed_structure_flag = bit_reader.GetBit();
+        vui->motion_vectors_over_pic_boundaries_flag = bit_reader.GetBit();
+        vui->restricted_ref_pic_lists_flag = bit_reader.GetBit();
+        vui->min_spatial_segmentation_idc = bit_reader.ReadUe();
+        vui->max_bytes_per_pic_denom = bit_reader.ReadUe();
+        vui->max_bits_per_min_cu_denom = bit_reader.ReadUe();
+        vui->log2_max_mv_length_horizontal = bit_reader.ReadUe();
+        vui->log2_max_mv_length_vertical = bit_reader.ReadUe();
     }
 }
 
 void HevcVideoParser::ParseVps(uint8_t *nalu, size_t size) {
-    size_t offset = 0; // current bit offset
-    uint32_t vps_id = Parser::ReadBits(nalu, offset, 4);
+    Parser::BitReader bit_reader(nalu, size, true);
+    uint32_t vps_id = bit_reader.ReadBits(4);
     HevcVideoParamSet *p_vps = &vps_list_[vps_id];
+    if (param_set_cache_.Lookup(kParamSetVps, vps_id, nalu, size)) {
+        return;  // identical to the stored VPS with the same id
+    }
+    // The stored VPS is cleared below: a failed parse must not leave its payload in the cache
+    param_set_cache_.Invalidate(kParamSetVps, vps_id);
     memset(p_vps, 0, sizeof(HevcVideoParamSet));
 
     p_vps->vps_video_parameter_set_id = vps_id;
-    p_vps->vps_base_layer_internal_flag = Parser::GetBit(nalu, offset);
-    p_vps->vps_base_layer_available_flag = Parser::GetBit(nalu, offset);
-    p_vps->vps_max_layers_minus1 = Parser::ReadBits(nalu, offset, 6);
-    p_vps->vps_max_sub_layers_minus1 = Parser::ReadBits(nalu, offset, 3);
-    p_vps->vps_temporal_id_nesting_flag = Parser::GetBit(nalu, offset);
-    p_vps->vps_reserved_0xffff_16bits = Parser::ReadBits(nalu, offset, 16);
-    ParsePtl(&p_vps->profile_tier_level, true, p_vps->vps_max_sub_layers_minus1, nalu, size, offset);
-    p_vps->vps_sub_layer_ordering_info_present_flag = Parser::GetBit(nalu, offset);
+    p_vps->vps_base_layer_internal_flag = bit_reader.GetBit();
+    p_vps->vps_base_layer_available_flag = bit_reader.GetBit();
+    p_vps->vps_max_layers_minus1 = bit_reader.ReadBits(6);
+    p_vps->vps_max_sub_layers_minus1 = bit_reader.ReadBits(3);
+    p_vps->vps_temporal_id_nesting_flag = bit_reader.GetBit();
+    p_vps->vps_reserved_0xffff_16bits = bit_reader.ReadBits(16);
+    ParsePtl(&p_vps->profile_tier_level, true, p_vps->vps_max_sub_layers_minus1, bit_reader);
+    p_vps->vps_sub_layer_ordering_info_present_flag = bit_reader.GetBit();
 
     for (int i = 0; i <= p_vps->vps_max_sub_layers_minus1; i++) {
         if (p_vps->vps_sub_layer_ordering_info_present_flag || (i == 0)) {
-            p_vps->vps_max_dec_pic_buffering_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
-            p_vps->vps_max_num_reorder_pics[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
-            p_vps->vps_max_latency_increase_plus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            p_vps->vps_max_dec_pic_buffering_minus1[i] = bit_reader.ReadUe();
+            p_vps->vps_max_num_reorder_pics[i] = bit_reader.ReadUe();
+            p_vps->vps_max_latency_increase_plus1[i] = bit_reader.ReadUe();
         } else {
             p_vps->vps_max_dec_pic_buffering_minus1[i] = p_vps->vps_max_dec_pic_buffering_minus1[0];
             p_vps->vps_max_num_reorder_pics[i] = p_vps->vps_max_num_reorder_pics[0];
             p_vps->vps_max_latency_increase_plus1[i] = p_vps->vps_max_latency_increase_plus1[0];
         }
     }
-    p_vps->vps_max_layer_id = Parser::ReadBits(nalu, offset, 6);
-    p_vps->vps_num_layer_sets_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+    p_vps->vps_max_layer_id = bit_reader.ReadBits(6);
+    p_vps->vps_num_layer_sets_minus1 = bit_reader.ReadUe();
     for (int i = 1; i <= p_vps->vps_num_layer_sets_minus1; i++) {
         for (int j = 0; j <= p_vps->vps_max_layer_id; j++) {
-            p_vps->layer_id_included_flag[i][j] = Parser::GetBit(nalu, offset);
+            p_vps->layer_id_included_flag[i][j] = bit_reader.GetBit();
         }
     }
-    p_vps->vps_timing_info_present_flag = Parser::GetBit(nalu, offset);
+    p_vps->vps_timing_info_present_flag = bit_reader.GetBit();
     if(p_vps->vps_timing_info_present_flag) {
-        p_vps->vps_num_units_in_tick = Parser::ReadBits(nalu, offset, 32);
-        p_vps->vps_time_scale = Parser::ReadBits(nalu, offset, 32);
-        p_vps->vps_poc_proportional_to_timing_flag = Parser::GetBit(nalu, offset);
+        p_vps->vps_num_units_in_tick = bit_reader.ReadBits(32);
+        p_vps->vps_time_scale = bit_reader.ReadBits(32);
+        p_vps->vps_poc_proportional_to_timing_flag = bit_reader.GetBit();
         if(p_vps->vps_poc_proportional_to_timing_flag) {
-            p_vps->vps_num_ticks_poc_diff_one_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+            p_vps->vps_num_ticks_poc_diff_one_minus1 = bit_reader.ReadUe();
         }
-        p_vps->vps_num_hrd_parameters = Parser::ExpGolomb::ReadUe(nalu, offset);
+        p_vps->vps_num_hrd_parameters = bit_reader.ReadUe();
         for (int i = 0; i<p_vps->vps_num_hrd_parameters; i++) {
-            p_vps->hrd_layer_set_idx[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            p_vps->hrd_layer_set_idx[i] = bit_reader.ReadUe();
             if (i > 0) {
-                p_vps->cprms_present_flag[i] = Parser::GetBit(nalu, offset);
+                p_vps->cprms_present_flag[i] = bit_reader.GetBit();
             }
             //parse HRD parameters
-            ParseHrdParameters(&p_vps->hrd_parameters[i], p_vps->cprms_present_flag[i], p_vps->vps_max_sub_layers_minus1, nalu, size, offset);
+            ParseHrdParameters(&p_vps->hrd_parameters[i], p_vps->cprms_present_flag[i], p_vps->vps_max_sub_layers_minus1, bit_reader);
         }
     }
-    p_vps->vps_extension_flag = Parser::GetBit(nalu, offset);
+    p_vps->vps_extension_flag = bit_reader.GetBit();
     p_vps->is_received = 1;
+    param_set_cache_.Insert(kParamSetVps, vps_id, nalu, size);
 
 #if DBGINFO
     PrintVps(p_vps);
@@ -1263,17 +1309,24 @@ void HevcVideoParser::ParseVps(uint8_t *nalu, size_t size) {
 
 void HevcVideoParser::ParseSps(uint8_t *nalu, size_t size) {
     HevcSeqParamSet *sps_ptr = nullptr;
-    size_t offset = 0;
+    Parser::BitReader bit_reader(nalu, size, true);
 
-    uint32_t vps_id = Parser::ReadBits(nalu, offset, 4);
-    uint32_t max_sub_layer_minus1 = Parser::ReadBits(nalu, offset, 3);
-    uint32_t sps_temporal_id_nesting_flag = Parser::GetBit(nalu, offset);
+    uint32_t vps_id = bit_reader.ReadBits(4);
+    uint32_t max_sub_layer_minus1 = bit_reader.ReadBits(3);
+    uint32_t sps_temporal_id_nesting_flag = bit_reader.GetBit();
     HevcProfileTierLevel ptl;
     memset (&ptl, 0, sizeof(ptl));
-    ParsePtl(&ptl, true, max_sub_layer_minus1, nalu, size, offset);
+    ParsePtl(&ptl, true, max_sub_layer_minus1, bit_reader);
 
-    uint32_t sps_id = Parser::ExpGolomb::ReadUe(nalu, offset);
+    uint32_t sps_id = bit_reader.ReadUe();
     sps_ptr = &sps_list_[sps_id];
+    if (param_set_cache_.Lookup(kParamSetSps, sps_id, nalu, size)) {
+        return;  // identical to the stored SPS with the same id
+    }
+    // The stored SPS is cleared below: a failed parse must not leave its payload in the cache
+    param_set_cache_.Invalidate(kParamSetSps, sps_id);
+    // PPS parsing depends on the SPS (e.g. scaling list inference), so the stored PPS payloads can no longer be trusted
+    param_set_cache_.Invalidate(kParamSetPps);
 
     memset(sps_ptr, 0, sizeof(HevcSeqParamSet));
     sps_ptr->sps_video_parameter_set_id = vps_id;
@@ -1281,53 +1334,53 @@ void HevcVideoParser::ParseSps(uint8_t *nalu, size_t size) {
     sps_ptr->sps_temporal_id_nesting_flag = sps_temporal_id_nesting_flag;
     memcpy (&sps_ptr->profile_tier_level, &ptl, sizeof(ptl));
     sps_ptr->sps_seq_parameter_set_id = sps_id;
-    sps_ptr->chroma_format_idc = Parser::ExpGolomb::ReadUe(nalu, offset);
+    sps_ptr->chroma_format_idc = bit_reader.ReadUe();
     if (sps_ptr->chroma_format_idc == 3) {
-        sps_ptr->separate_colour_plane_flag = Parser::GetBit(nalu, offset);
+        sps_ptr->separate_colour_plane_flag = bit_reader.GetBit();
     }
-    sps_ptr->pic_width_in_luma_samples = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr->pic_height_in_luma_samples = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr->conformance_window_flag = Parser::GetBit(nalu, offset);
+    sps_ptr->pic_width_in_luma_samples = bit_reader.ReadUe();
+    sps_ptr->pic_height_in_luma_samples = bit_reader.ReadUe();
+    sps_ptr->conformance_window_flag = bit_reader.GetBit();
     if (sps_ptr->conformance_window_flag) {
-        sps_ptr->conf_win_left_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
-        sps_ptr->conf_win_right_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
-        sps_ptr->conf_win_top_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
-        sps_ptr->conf_win_bottom_offset = Parser::ExpGolomb::ReadUe(nalu, offset);
-    }
-    sps_ptr->bit_depth_luma_minus8 = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr->bit_depth_chroma_minus8 = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr->log2_max_pic_order_cnt_lsb_minus4 = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr->sps_sub_layer_ordering_info_present_flag = Parser::GetBit(nalu, offset);
+        sps_ptr->conf_win_left_offset = bit_reader.ReadUe();
+        sps_ptr->conf_win_right_offset = bit_reader.ReadUe();
+        sps_ptr->conf_win_top_offset = bit_reader.ReadUe();
+        sps_ptr->conf_win_bottom_offset = bit_reader.ReadUe();
+    }
+    sps_ptr->bit_depth_luma_minus8 = bit_reader.ReadUe();
+    sps_ptr->bit_depth_chroma_minus8 = bit_reader.ReadUe();
+    sps_ptr->log2_max_pic_order_cnt_lsb_minus4 = bit_reader.ReadUe();
+    sps_ptr->sps_sub_layer_ordering_info_present_flag = bit_reader.GetBit();
     for (int i = 0; i <= sps_ptr->sps_max_sub_layers_minus1; i++) {
         if (sps_ptr->sps_sub_layer_ordering_info_present_flag || (i == 0)) {
-            sps_ptr->sps_max_dec_pic_buffering_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
-            sps_ptr->sps_max_num_reorder_pics[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
-            sps_ptr->sps_max_latency_increase_plus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+            sps_ptr->sps_max_dec_pic_buffering_minus1[i] = bit_reader.ReadUe();
+            sps_ptr->sps_max_num_reorder_pics[i] = bit_reader.ReadUe();
+            sps_ptr->sps_max_latency_increase_plus1[i] = bit_reader.ReadUe();
         } else {
             sps_ptr->sps_max_dec_pic_buffering_minus1[i] = sps_ptr->sps_max_dec_pic_buffering_minus1[0];
             sps_ptr->sps_max_num_reorder_pics[i] = sps_ptr->sps_max_num_reorder_pics[0];
             sps_ptr->sps_max_latency_increase_plus1[i] = sps_ptr->sps_max_latency_increase_plus1[0];
         }
     }
-    sps_ptr->log2_min_luma_coding_block_size_minus3 = Parser::ExpGolomb::ReadUe(nalu, offset);
+    sps_ptr->log2_min_luma_coding_block_size_minus3 = bit_reader.ReadUe();
 
     int log2_min_cu_size = sps_ptr->log2_min_luma_coding_block_size_minus3 + 3;
 
-    sps_ptr->log2_diff_max_min_luma_coding_block_size = Parser::ExpGolomb::ReadUe(nalu, offset);
+    sps_ptr->log2_diff_max_min_luma_coding_block_size = bit_reader.ReadUe();
 
     int max_cu_depth_delta = sps_ptr->log2_diff_max_min_luma_coding_block_size;
     sps_ptr->max_cu_width = ( 1<<(log2_min_cu_size + max_cu_depth_delta));
     sps_ptr->max_cu_height = ( 1<<(log2_min_cu_size + max_cu_depth_delta));
 
-    sps_ptr->log2_min_transform_block_size_minus2 = Parser::ExpGolomb::ReadUe(nalu, offset);
+    sps_ptr->log2_min_transform_block_size_minus2 = bit_reader.ReadUe();
 
     uint32_t quadtree_tu_log2_min_size = sps_ptr->log2_min_transform_block_size_minus2 + 2;
     int add_cu_depth = std::max (0, log2_min_cu_size - (int)quadtree_tu_log2_min_size);
     sps_ptr->max_cu_depth = (max_cu_depth_delta + add_cu_depth);
 
-    sps_ptr->log2_diff_max_min_transform_block_size = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr->max_transform_hierarchy_depth_inter = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr->max_transform_hierarchy_depth_intra = Parser::ExpGolomb::ReadUe(nalu, offset);
+    sps_ptr->log2_diff_max_min_transform_block_size = bit_reader.ReadUe();
+    sps_ptr->max_transform_hierarchy_depth_inter = bit_reader.ReadUe();
+    sps_ptr->max_transform_hierarchy_depth_intra = bit_reader.ReadUe();
 
     // Infer dimensional variables
     int min_cb_log2_size_y = sps_ptr->log2_min_luma_coding_block_size_minus3 + 3;  // MinCbLog2SizeY
@@ -1337,54 +1390,60 @@ void HevcVideoParser::ParseSps(uint8_t *nalu, size_t size) {
     pic_height_in_ctbs_y_ = (sps_ptr->pic_height_in_luma_samples + ctb_size_y - 1) / ctb_size_y;  // PicHeightInCtbsY
     pic_size_in_ctbs_y_ = pic_width_in_ctbs_y_ * pic_height_in_ctbs_y_;  // PicSizeInCtbsY
 
-    sps_ptr->scaling_list_enabled_flag = Parser::GetBit(nalu, offset);
+    sps_ptr->scaling_list_enabled_flag = bit_reader.GetBit();
     if (sps_ptr->scaling_list_enabled_flag) {
         // Set up default values first
         SetDefaultScalingList(&sps_ptr->scaling_list_data);
 
-        sps_ptr->sps_scaling_list_data_present_flag = Parser::GetBit(nalu, offset);
+        sps_ptr->sps_scaling_list_data_present_flag = bit_reader.GetBit();
         if (sps_ptr->sps_scaling_list_data_present_flag) {
-            ParseScalingList(&sps_ptr->scaling_list_data, nalu, size, offset, sps_ptr);
+            ParseScalingList(&sps_ptr->scaling_list_data, bit_reader, sps_ptr);
         }
     }
-    sps_ptr->amp_enabled_flag = Parser::GetBit(nalu, offset);
-    sps_ptr->sample_adaptive_offset_enabled_flag = Parser::GetBit(nalu, offset);
-    sps_ptr->pcm_enabled_flag = Parser::GetBit(nalu, offset);
+    sps_ptr->amp_enabled_flag = bit_reader.GetBit();
+    sps_ptr->sample_adaptive_offset_enabled_flag = bit_reader.GetBit();
+    sps_ptr->pcm_enabled_flag = bit_reader.GetBit();
     if (sps_ptr->pcm_enabled_flag) {
-        sps_ptr->pcm_sample_bit_depth_luma_minus1 = Parser::ReadBits(nalu, offset, 4);
-        sps_ptr->pcm_sample_bit_depth_chroma_minus1 = Parser::ReadBits(nalu, offset, 4);
-        sps_ptr->log2_min_pcm_luma_coding_block_size_minus3 = Parser::ExpGolomb::ReadUe(nalu, offset);
-        sps_ptr->log2_diff_max_min_pcm_luma_coding_block_size = Parser::ExpGolomb::ReadUe(nalu, offset);
-        sps_ptr->pcm_loop_filter_disabled_flag = Parser::GetBit(nalu, offset);
+        sps_ptr->pcm_sample_bit_depth_luma_minus1 = bit_reader.ReadBits(4);
+        sps_ptr->pcm_sample_bit_depth_chroma_minus1 = bit_reader.ReadBits(4);
+        sps_ptr->log2_min_pcm_luma_coding_block_size_minus3 = bit_reader.ReadUe();
+        sps_ptr->log2_diff_max_min_pcm_luma_coding_block_size = bit_reader.ReadUe();
+        sps_ptr->pcm_loop_filter_disabled_flag = bit_reader.GetBit();
     }
-    sps_ptr->num_short_term_ref_pic_sets = Parser::ExpGolomb::ReadUe(nalu, offset);
+    sps_ptr->num_short_term_ref_pic_sets = bit_reader.ReadUe();
     for (int i=0; i<sps_ptr->num_short_term_ref_pic_sets; i++) {
         //short_term_ref_pic_set( i )
-        if (ParseShortTermRefPicSet(sps_ptr, &sps_ptr->st_rps[i], i, sps_ptr->num_short_term_ref_pic_sets, sps_ptr->st_rps, nalu, size, offset) != PARSER_OK) {
+        if (ParseShortTermRefPicSet(sps_ptr, &sps_ptr->st_rps[i], i, sps_ptr->num_short_term_ref_pic_sets, sps_ptr->st_rps, bit_reader) != PARSER_OK) {
             return;
         }
     }
-    sps_ptr->long_term_ref_pics_present_flag = Parser::GetBit(nalu, offset);
+    sps_ptr->long_term_ref_pics_present_flag = bit_reader.GetBit();
     if (sps_ptr->long_term_ref_pics_present_flag) {
-        sps_ptr->num_long_term_ref_pics_sps = Parser::ExpGolomb::ReadUe(nalu, offset);  //max is 32
+        sps_ptr->num_long_term_ref_pics_sps = bit_reader.ReadUe();  //max is 32
         sps_ptr->lt_rps.num_of_pics = sps_ptr->num_long_term_ref_pics_sps;
         for (int i=0; i<sps_ptr->num_long_term_ref_pics_sps; i++) {
             //The number of bits used to represent lt_ref_pic_poc_lsb_sps[ i ] is equal to log2_max_pic_order_cnt_lsb_minus4 + 4.
-            sps_ptr->lt_ref_pic_poc_lsb_sps[i] = Parser::ReadBits(nalu, offset, (sps_ptr->log2_max_pic_order_cnt_lsb_minus4 + 4));
-            sps_ptr->used_by_curr_pic_lt_sps_flag[i] = Parser::GetBit(nalu, offset);
+            sps_ptr->lt_ref_pic_poc_lsb_sps[i] = bit_reader.ReadBits((sps_ptr->log2_max_pic_order_cnt_lsb_minus4 + 4));
+            sps_ptr->used_by_curr_pic_lt_sps_flag[i] = bit_reader.GetBit();
             sps_ptr->lt_rps.pocs[i]=sps_ptr->lt_ref_pic_poc_lsb_sps[i];
             sps_ptr->lt_rps.used_by_curr_pic[i] = sps_ptr->used_by_curr_pic_lt_sps_flag[i];            
         }
     }
-    sps_ptr->sps_temporal_mvp_enabled_flag = Parser::GetBit(nalu, offset);
-    sps_ptr->strong_intra_smoothing_enabled_flag = Parser::GetBit(nalu, offset);
-    sps_ptr->vui_parameters_present_flag = Parser::GetBit(nalu, offset);
+    sps_ptr->sps_temporal_mvp_enabled_flag = bit_reader.GetBit();
+    sps_ptr->strong_intra_smoothing_enabled_flag = bit_reader.GetBit();
+    sps_ptr->vui_parameters_present_flag = bit_reader.GetBit();
     if (sps_ptr->vui_parameters_present_flag) {
         //vui_parameters()
-        ParseVui(&sps_ptr->vui_parameters, sps_ptr->sps_max_sub_layers_minus1, nalu, size, offset);
+        ParseVui(&sps_ptr->vui_parameters, sps_ptr->sps_max_sub_layers_minus1, bit_reader);
     }
-    sps_ptr->sps_extension_flag = Parser::GetBit(nalu, offset);
+    sps_ptr->sps_extension_flag = bit_reader.GetBit();
     sps_ptr->is_received = 1;
+    param_set_cache_.Insert(kParamSetSps, sps_id, nalu, size);
+    // The active SPS has been replaced by a different one with the same id. The sequence callback is only called if the
+    // video format has changed.
+    if (static_cast<int32_t>(sps_id) == m_active_sps_id_) {
+        new_seq_activated_ = true;
+    }
 
 #if DBGINFO
     PrintSps(sps_ptr);
@@ -1393,50 +1452,55 @@ void HevcVideoParser::ParseSps(uint8_t *nalu, size_t size) {
 
 void HevcVideoParser::ParsePps(uint8_t *nalu, size_t size) {
     int i;
-    size_t offset = 0;
-    uint32_t pps_id = Parser::ExpGolomb::ReadUe(nalu, offset);
+    Parser::BitReader bit_reader(nalu, size, true);
+    uint32_t pps_id = bit_reader.ReadUe();
     HevcPicParamSet *pps_ptr = &pps_list_[pps_id];
+    if (param_set_cache_.Lookup(kParamSetPps, pps_id, nalu, size)) {
+        return;  // identical to the stored PPS with the same id
+    }
+    // The stored PPS is cleared below: a failed parse must not leave its payload in the cache
+    param_set_cache_.Invalidate(kParamSetPps, pps_id);
     memset(pps_ptr, 0, sizeof(HevcPicParamSet));
 
     pps_ptr->pps_pic_parameter_set_id = pps_id;
-    pps_ptr->pps_seq_parameter_set_id = Parser::ExpGolomb::ReadUe(nalu, offset);
-    pps_ptr->dependent_slice_segments_enabled_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->output_flag_present_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->num_extra_slice_header_bits = Parser::ReadBits(nalu, offset, 3);
-    pps_ptr->sign_data_hiding_enabled_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->cabac_init_present_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->num_ref_idx_l0_default_active_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
-    pps_ptr->num_ref_idx_l1_default_active_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
-    pps_ptr->init_qp_minus26 = Parser::ExpGolomb::ReadSe(nalu, offset);
-    pps_ptr->constrained_intra_pred_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->transform_skip_enabled_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->cu_qp_delta_enabled_flag = Parser::GetBit(nalu, offset);
+    pps_ptr->pps_seq_parameter_set_id = bit_reader.ReadUe();
+    pps_ptr->dependent_slice_segments_enabled_flag = bit_reader.GetBit();
+    pps_ptr->output_flag_present_flag = bit_reader.GetBit();
+    pps_ptr->num_extra_slice_header_bits = bit_reader.ReadBits(3);
+    pps_ptr->sign_data_hiding_enabled_flag = bit_reader.GetBit();
+    pps_ptr->cabac_init_present_flag = bit_reader.GetBit();
+    pps_ptr->num_ref_idx_l0_default_active_minus1 = bit_reader.ReadUe();
+    pps_ptr->num_ref_idx_l1_default_active_minus1 = bit_reader.ReadUe();
+    pps_ptr->init_qp_minus26 = bit_reader.ReadSe();
+    pps_ptr->constrained_intra_pred_flag = bit_reader.GetBit();
+    pps_ptr->transform_skip_enabled_flag = bit_reader.GetBit();
+    pps_ptr->cu_qp_delta_enabled_flag = bit_reader.GetBit();
     if (pps_ptr->cu_qp_delta_enabled_flag) {
-        pps_ptr->diff_cu_qp_delta_depth = Parser::ExpGolomb::ReadUe(nalu, offset);
-    }
-    pps_ptr->pps_cb_qp_offset = Parser::ExpGolomb::ReadSe(nalu, offset);
-    pps_ptr->pps_cr_qp_offset = Parser::ExpGolomb::ReadSe(nalu, offset);
-    pps_ptr->pps_slice_chroma_qp_offsets_present_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->weighted_pred_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->weighted_bipred_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->transquant_bypass_enabled_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->tiles_enabled_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->entropy_coding_sync_enabled_flag = Parser::GetBit(nalu, offset);
+        pps_ptr->diff_cu_qp_delta_depth = bit_reader.ReadUe();
+    }
+    pps_ptr->pps_cb_qp_offset = bit_reader.ReadSe();
+    pps_ptr->pps_cr_qp_offset = bit_reader.ReadSe();
+    pps_ptr->pps_slice_chroma_qp_offsets_present_flag = bit_reader.GetBit();
+    pps_ptr->weighted_pred_flag = bit_reader.GetBit();
+    pps_ptr->weighted_bipred_flag = bit_reader.GetBit();
+    pps_ptr->transquant_bypass_enabled_flag = bit_reader.GetBit();
+    pps_ptr->tiles_enabled_flag = bit_reader.GetBit();
+    pps_ptr->entropy_coding_sync_enabled_flag = bit_reader.GetBit();
     if (pps_ptr->tiles_enabled_flag) {
-        pps_ptr->num_tile_columns_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
-        pps_ptr->num_tile_rows_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
-        pps_ptr->uniform_spacing_flag = Parser::GetBit(nalu, offset);
+        pps_ptr->num_tile_columns_minus1 = bit_reader.ReadUe();
+        pps_ptr->num_tile_rows_minus1 = bit_reader.ReadUe();
+        pps_ptr->uniform_spacing_flag = bit_reader.GetBit();
         if (!pps_ptr->uniform_spacing_flag) {
             int temp_size = pic_width_in_ctbs_y_; // PicWidthInCtbsY
             for (i = 0; i < pps_ptr->num_tile_columns_minus1; i++) {
-                pps_ptr->column_width_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+                pps_ptr->column_width_minus1[i] = bit_reader.ReadUe();
                 temp_size -= pps_ptr->column_width_minus1[i] + 1;
             }
             pps_ptr->column_width_minus1[i] = temp_size - 1; // last column at num_tile_columns_minus1
 
             temp_size = pic_height_in_ctbs_y_; // PicHeightInCtbsY
             for (i = 0; i < pps_ptr->num_tile_rows_minus1; i++) {
-                pps_ptr->row_height_minus1[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
+                pps_ptr->row_height_minus1[i] = bit_reader.ReadUe();
                 temp_size -= pps_ptr->row_height_minus1[i] + 1;
             }
             pps_ptr->row_height_minus1[i] = temp_size - 1;  // last row at num_tile_rows_minus1
@@ -1448,62 +1512,63 @@ void HevcVideoParser::ParsePps(uint8_t *nalu, size_t size) {
                 pps_ptr->row_height_minus1[i] = ((i + 1) * pic_height_in_ctbs_y_) / (pps_ptr->num_tile_rows_minus1 + 1) - (i * pic_height_in_ctbs_y_) / (pps_ptr->num_tile_rows_minus1 + 1) - 1;
             }
         }
-        pps_ptr->loop_filter_across_tiles_enabled_flag = Parser::GetBit(nalu, offset);
+        pps_ptr->loop_filter_across_tiles_enabled_flag = bit_reader.GetBit();
     } else {
         pps_ptr->loop_filter_across_tiles_enabled_flag = 1;
         pps_ptr->uniform_spacing_flag = 1;
         pps_ptr->num_tile_columns_minus1 = 0;
         pps_ptr->num_tile_rows_minus1 = 0;
     }
-    pps_ptr->pps_loop_filter_across_slices_enabled_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->deblocking_filter_control_present_flag = Parser::GetBit(nalu, offset);
+    pps_ptr->pps_loop_filter_across_slices_enabled_flag = bit_reader.GetBit();
+    pps_ptr->deblocking_filter_control_present_flag = bit_reader.GetBit();
     if (pps_ptr->deblocking_filter_control_present_flag) {
-        pps_ptr->deblocking_filter_override_enabled_flag = Parser::GetBit(nalu, offset);
-        pps_ptr->pps_deblocking_filter_disabled_flag = Parser::GetBit(nalu, offset);
+        pps_ptr->deblocking_filter_override_enabled_flag = bit_reader.GetBit();
+        pps_ptr->pps_deblocking_filter_disabled_flag = bit_reader.GetBit();
         if (!pps_ptr->pps_deblocking_filter_disabled_flag) {
-            pps_ptr->pps_beta_offset_div2 = Parser::ExpGolomb::ReadSe(nalu, offset);
-            pps_ptr->pps_tc_offset_div2 = Parser::ExpGolomb::ReadSe(nalu, offset);
+            pps_ptr->pps_beta_offset_div2 = bit_reader.ReadSe();
+            pps_ptr->pps_tc_offset_div2 = bit_reader.ReadSe();
         }
     }
-    pps_ptr->pps_scaling_list_data_present_flag = Parser::GetBit(nalu, offset);
+    pps_ptr->pps_scaling_list_data_present_flag = bit_reader.GetBit();
     if (pps_ptr->pps_scaling_list_data_present_flag) {
         // Set up default values first
         SetDefaultScalingList(&pps_ptr->scaling_list_data);
 
-        ParseScalingList(&pps_ptr->scaling_list_data, nalu, size, offset, &sps_list_[pps_ptr->pps_seq_parameter_set_id]);
+        ParseScalingList(&pps_ptr->scaling_list_data, bit_reader, &sps_list_[pps_ptr->pps_seq_parameter_set_id]);
     } else {
         pps_ptr->scaling_list_data = sps_list_[pps_ptr->pps_seq_parameter_set_id].scaling_list_data;
     }
-    pps_ptr->lists_modification_present_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->log2_parallel_merge_level_minus2 = Parser::ExpGolomb::ReadUe(nalu, offset);
-    pps_ptr->slice_segment_header_extension_present_flag = Parser::GetBit(nalu, offset);
-    pps_ptr->pps_extension_present_flag = Parser::GetBit(nalu, offset);
+    pps_ptr->lists_modification_present_flag = bit_reader.GetBit();
+    pps_ptr->log2_parallel_merge_level_minus2 = bit_reader.ReadUe();
+    pps_ptr->slice_segment_header_extension_present_flag = bit_reader.GetBit();
+    pps_ptr->pps_extension_present_flag = bit_reader.GetBit();
     if (pps_ptr->pps_extension_present_flag) {
-        pps_ptr->pps_range_extension_flag = Parser::GetBit(nalu, offset);
-        pps_ptr->pps_multilayer_extension_flag = Parser::GetBit(nalu, offset);
-        pps_ptr->pps_extension_6bits = Parser::ReadBits(nalu, offset, 6);
+        pps_ptr->pps_range_extension_flag = bit_reader.GetBit();
+        pps_ptr->pps_multilayer_extension_flag = bit_reader.GetBit();
+        pps_ptr->pps_extension_6bits = bit_reader.ReadBits(6);
     }
 
     // pps_range_extension()
     if (pps_ptr->pps_range_extension_flag) {
         if (pps_ptr->transform_skip_enabled_flag) {
-            pps_ptr->log2_max_transform_skip_block_size_minus2 = Parser::ExpGolomb::ReadUe(nalu, offset);
+            pps_ptr->log2_max_transform_skip_block_size_minus2 = bit_reader.ReadUe();
         }
-        pps_ptr->cross_component_prediction_enabled_flag = Parser::GetBit(nalu, offset);
-        pps_ptr->chroma_qp_offset_list_enabled_flag = Parser::GetBit(nalu, offset);
+        pps_ptr->cross_component_prediction_enabled_flag = bit_reader.GetBit();
+        pps_ptr->chroma_qp_offset_list_enabled_flag = bit_reader.GetBit();
         if (pps_ptr->chroma_qp_offset_list_enabled_flag) {
-            pps_ptr->diff_cu_chroma_qp_offset_depth = Parser::ExpGolomb::ReadUe(nalu, offset);
-            pps_ptr->chroma_qp_offset_list_len_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+            pps_ptr->diff_cu_chroma_qp_offset_depth = bit_reader.ReadUe();
+            pps_ptr->chroma_qp_offset_list_len_minus1 = bit_reader.ReadUe();
             for (int i = 0; i <= pps_ptr->chroma_qp_offset_list_len_minus1; i++) {
-                pps_ptr->cb_qp_offset_list[i] = Parser::ExpGolomb::ReadSe(nalu, offset);
-                pps_ptr->cr_qp_offset_list[i] = Parser::ExpGolomb::ReadSe(nalu, offset);
+                pps_ptr->cb_qp_offset_list[i] = bit_reader.ReadSe();
+                pps_ptr->cr_qp_offset_list[i] = bit_reader.ReadSe();
             }
         }
-        pps_ptr->log2_sao_offset_scale_luma = Parser::ExpGolomb::ReadUe(nalu, offset);
-        pps_ptr->log2_sao_offset_scale_chroma = Parser::ExpGolomb::ReadUe(nalu, offset);
+        pps_ptr->log2_sao_offset_scale_luma = bit_reader.ReadUe();
+        pps_ptr->log2_sao_offset_scale_chroma = bit_reader.ReadUe();
     }
 
     pps_ptr->is_received = 1;
+    param_set_cache_.Insert(kParamSetPps, pps_id, nalu, size);
 
 #if DBGINFO
     PrintPps(pps_ptr);
@@ -1513,18 +1578,18 @@ void HevcVideoParser::ParsePps(uint8_t *nalu, size_t size) {
 ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcSliceSegHeader *p_slice_header) {
     HevcPicParamSet *pps_ptr = nullptr;
     HevcSeqParamSet *sps_ptr = nullptr;
-    size_t offset = 0;
+    Parser::BitReader bit_reader(nalu, size, true);
     HevcSliceSegHeader temp_sh;
     memset(p_slice_header, 0, sizeof(HevcSliceSegHeader));
     memset(&temp_sh, 0, sizeof(temp_sh));
 
-    temp_sh.first_slice_segment_in_pic_flag = p_slice_header->first_slice_segment_in_pic_flag = Parser::GetBit(nalu, offset);
+    temp_sh.first_slice_segment_in_pic_flag = p_slice_header->first_slice_segment_in_pic_flag = bit_reader.GetBit();
     if (IsIrapPic(&slice_nal_unit_header_)) {
-        temp_sh.no_output_of_prior_pics_flag = p_slice_header->no_output_of_prior_pics_flag = Parser::GetBit(nalu, offset);
+        temp_sh.no_output_of_prior_pics_flag = p_slice_header->no_output_of_prior_pics_flag = bit_reader.GetBit();
     }
 
     // Set active VPS, SPS and PPS for the current slice
-    m_active_pps_id_ = Parser::ExpGolomb::ReadUe(nalu, offset);
+    m_active_pps_id_ = bit_reader.ReadUe();
     CHECK_ALLOWED_MAX(m_active_pps_id_, (MAX_PPS_COUNT - 1));
     temp_sh.slice_pic_parameter_set_id = p_slice_header->slice_pic_parameter_set_id = m_active_pps_id_;
     pps_ptr = &pps_list_[m_active_pps_id_];
@@ -1580,37 +1645,37 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
 
     if (!p_slice_header->first_slice_segment_in_pic_flag) {
         if (pps_ptr->dependent_slice_segments_enabled_flag) {
-            temp_sh.dependent_slice_segment_flag = p_slice_header->dependent_slice_segment_flag = Parser::GetBit(nalu, offset);
+            temp_sh.dependent_slice_segment_flag = p_slice_header->dependent_slice_segment_flag = bit_reader.GetBit();
         }
         int bits_slice_segment_address = (int)ceilf(log2f((float)pic_size_in_ctbs_y_));
-        temp_sh.slice_segment_address = p_slice_header->slice_segment_address = Parser::ReadBits(nalu, offset, bits_slice_segment_address);
+        temp_sh.slice_segment_address = p_slice_header->slice_segment_address = bit_reader.ReadBits(bits_slice_segment_address);
         //todo:: check for max slice_segment_address and error if exceeds max
     }
 
     if (!p_slice_header->dependent_slice_segment_flag) {
         for (int i = 0; i < pps_ptr->num_extra_slice_header_bits; i++) {
-            p_slice_header->slice_reserved_flag[i] = Parser::GetBit(nalu, offset);
+            p_slice_header->slice_reserved_flag[i] = bit_reader.GetBit();
         }
-        p_slice_header->slice_type = Parser::ExpGolomb::ReadUe(nalu, offset);
+        p_slice_header->slice_type = bit_reader.ReadUe();
         CHECK_ALLOWED_MAX(p_slice_header->slice_type, 2);
 
         if (pps_ptr->output_flag_present_flag) {
-            p_slice_header->pic_output_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->pic_output_flag = bit_reader.GetBit();
         } else {
             p_slice_header->pic_output_flag = 1;  // default value
         }
         if (sps_ptr->separate_colour_plane_flag) {
-            p_slice_header->colour_plane_id = Parser::ReadBits(nalu, offset, 2);
+            p_slice_header->colour_plane_id = bit_reader.ReadBits(2);
         }
 
         if (slice_nal_unit_header_.nal_unit_type != NAL_UNIT_CODED_SLICE_IDR_W_RADL && slice_nal_unit_header_.nal_unit_type != NAL_UNIT_CODED_SLICE_IDR_N_LP) {
             //length of slice_pic_order_cnt_lsb is log2_max_pic_order_cnt_lsb_minus4 + 4 bits.
-            p_slice_header->slice_pic_order_cnt_lsb = Parser::ReadBits(nalu, offset, (sps_ptr->log2_max_pic_order_cnt_lsb_minus4 + 4));
+            p_slice_header->slice_pic_order_cnt_lsb = bit_reader.ReadBits((sps_ptr->log2_max_pic_order_cnt_lsb_minus4 + 4));
 
-            p_slice_header->short_term_ref_pic_set_sps_flag = Parser::GetBit(nalu, offset);
-            int32_t pos = offset;
+            p_slice_header->short_term_ref_pic_set_sps_flag = bit_reader.GetBit();
+            int32_t pos = bit_reader.GetBitOffset();
             if (!p_slice_header->short_term_ref_pic_set_sps_flag) {
-                if ( ParseShortTermRefPicSet(sps_ptr, &p_slice_header->st_rps, sps_ptr->num_short_term_ref_pic_sets, sps_ptr->num_short_term_ref_pic_sets, sps_ptr->st_rps, nalu, size, offset) != PARSER_OK) {
+                if ( ParseShortTermRefPicSet(sps_ptr, &p_slice_header->st_rps, sps_ptr->num_short_term_ref_pic_sets, sps_ptr->num_short_term_ref_pic_sets, sps_ptr->st_rps, bit_reader) != PARSER_OK) {
                     return PARSER_WRONG_STATE;
                 }
             } else {
@@ -1620,7 +1685,7 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
                         num_bits++;
                     }
                     if (num_bits > 0) {
-                        p_slice_header->short_term_ref_pic_set_idx = Parser::ReadBits(nalu, offset, num_bits);
+                        p_slice_header->short_term_ref_pic_set_idx = bit_reader.ReadBits(num_bits);
                     }
                 } else {
                     p_slice_header->short_term_ref_pic_set_idx = 0;
@@ -1629,13 +1694,13 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
                 // Copy the SPS RPS to slice RPS
                 p_slice_header->st_rps = sps_ptr->st_rps[p_slice_header->short_term_ref_pic_set_idx];
             }
-            p_slice_header->short_term_ref_pic_set_size = offset - pos;
+            p_slice_header->short_term_ref_pic_set_size = bit_reader.GetBitOffset() - pos;
 
             if (sps_ptr->long_term_ref_pics_present_flag) {
                 if (sps_ptr->num_long_term_ref_pics_sps > 0) {
-                    p_slice_header->num_long_term_sps = Parser::ExpGolomb::ReadUe(nalu, offset);
+                    p_slice_header->num_long_term_sps = bit_reader.ReadUe();
                 }
-                p_slice_header->num_long_term_pics = Parser::ExpGolomb::ReadUe(nalu, offset);
+                p_slice_header->num_long_term_pics = bit_reader.ReadUe();
                 if (p_slice_header->num_long_term_pics > 16) {
                     ERR("Parsed Value exceeds allowed max");
                     return PARSER_OUT_OF_RANGE;
@@ -1650,22 +1715,22 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
                     if (i < p_slice_header->num_long_term_sps) {
                         if (sps_ptr->num_long_term_ref_pics_sps > 1) {
                             if( bits_for_ltrp_in_sps > 0) {
-                                p_slice_header->lt_idx_sps[i] = Parser::ReadBits(nalu, offset, bits_for_ltrp_in_sps);
+                                p_slice_header->lt_idx_sps[i] = bit_reader.ReadBits(bits_for_ltrp_in_sps);
                                 p_slice_header->lt_rps.pocs[i] = sps_ptr->lt_rps.pocs[p_slice_header->lt_idx_sps[i]];  // PocLsbLt[]
                                 p_slice_header->lt_rps.used_by_curr_pic[i] = sps_ptr->lt_rps.used_by_curr_pic[p_slice_header->lt_idx_sps[i]];  // UsedByCurrPicLt[]
                             }
                         }
                     } else {
-                        p_slice_header->poc_lsb_lt[i] = Parser::ReadBits(nalu, offset, (sps_ptr->log2_max_pic_order_cnt_lsb_minus4 + 4));
-                        p_slice_header->used_by_curr_pic_lt_flag[i] = Parser::GetBit(nalu, offset);
+                        p_slice_header->poc_lsb_lt[i] = bit_reader.ReadBits((sps_ptr->log2_max_pic_order_cnt_lsb_minus4 + 4));
+                        p_slice_header->used_by_curr_pic_lt_flag[i] = bit_reader.GetBit();
                         p_slice_header->lt_rps.pocs[i] = p_slice_header->poc_lsb_lt[i];  // PocLsbLt[]
                         p_slice_header->lt_rps.used_by_curr_pic[i] = p_slice_header->used_by_curr_pic_lt_flag[i];  // UsedByCurrPicLt[]
                     }
                     int delta_poc_msb_cycle_lt = 0;
-                    p_slice_header->delta_poc_msb_present_flag[i] = Parser::GetBit(nalu, offset);
+                    p_slice_header->delta_poc_msb_present_flag[i] = bit_reader.GetBit();
                     if (p_slice_header->delta_poc_msb_present_flag[i]) {
                         // Store DeltaPocMsbCycleLt in delta_poc_msb_cycle_lt for later use
-                        delta_poc_msb_cycle_lt = Parser::ExpGolomb::ReadUe(nalu, offset);
+                        delta_poc_msb_cycle_lt = bit_reader.ReadUe();
                     }
                     if ( i == 0 || i == p_slice_header->num_long_term_sps) {
                         p_slice_header->delta_poc_msb_cycle_lt[i] = delta_poc_msb_cycle_lt;
@@ -1675,26 +1740,26 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
                 }
             }
             if (sps_ptr->sps_temporal_mvp_enabled_flag) {
-                p_slice_header->slice_temporal_mvp_enabled_flag = Parser::GetBit(nalu, offset);
+                p_slice_header->slice_temporal_mvp_enabled_flag = bit_reader.GetBit();
             }
         }
 
         int chroma_array_type = sps_ptr->separate_colour_plane_flag ? 0 : sps_ptr->chroma_format_idc;  // ChromaArrayType
         if (sps_ptr->sample_adaptive_offset_enabled_flag) {
-            p_slice_header->slice_sao_luma_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->slice_sao_luma_flag = bit_reader.GetBit();
             if (chroma_array_type)
             {
-                p_slice_header->slice_sao_chroma_flag = Parser::GetBit(nalu, offset);
+                p_slice_header->slice_sao_chroma_flag = bit_reader.GetBit();
             }
         }
 
         if (p_slice_header->slice_type != HEVC_SLICE_TYPE_I) {
-            p_slice_header->num_ref_idx_active_override_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->num_ref_idx_active_override_flag = bit_reader.GetBit();
             if (p_slice_header->num_ref_idx_active_override_flag) {
-                p_slice_header->num_ref_idx_l0_active_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+                p_slice_header->num_ref_idx_l0_active_minus1 = bit_reader.ReadUe();
                 CHECK_ALLOWED_MAX(p_slice_header->num_ref_idx_l0_active_minus1, 14);
                 if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
-                    p_slice_header->num_ref_idx_l1_active_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+                    p_slice_header->num_ref_idx_l1_active_minus1 = bit_reader.ReadUe();
                     CHECK_ALLOWED_MAX(p_slice_header->num_ref_idx_l1_active_minus1, 14);
                 }
             } else {
@@ -1734,19 +1799,19 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
                     list_entry_bits++;
                 }
 
-                p_slice_header->ref_pic_list_modification_flag_l0 = Parser::GetBit(nalu, offset);
+                p_slice_header->ref_pic_list_modification_flag_l0 = bit_reader.GetBit();
                 if (p_slice_header->ref_pic_list_modification_flag_l0) {
                     for (int i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
-                        p_slice_header->list_entry_l0[i] = Parser::ReadBits(nalu, offset, list_entry_bits);
+                        p_slice_header->list_entry_l0[i] = bit_reader.ReadBits(list_entry_bits);
                         //todo;; check_max
                     }
                 }
 
                 if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
-                    p_slice_header->ref_pic_list_modification_flag_l1 = Parser::GetBit(nalu, offset);
+                    p_slice_header->ref_pic_list_modification_flag_l1 = bit_reader.GetBit();
                     if (p_slice_header->ref_pic_list_modification_flag_l1) {
                         for (int i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
-                            p_slice_header->list_entry_l1[i] = Parser::ReadBits(nalu, offset, list_entry_bits);
+                            p_slice_header->list_entry_l1[i] = bit_reader.ReadBits(list_entry_bits);
                             //todo::checkmax
                         }
                     }
@@ -1754,18 +1819,18 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
             }
 
             if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
-                p_slice_header->mvd_l1_zero_flag = Parser::GetBit(nalu, offset);
+                p_slice_header->mvd_l1_zero_flag = bit_reader.GetBit();
             }
             if (pps_ptr->cabac_init_present_flag) {
-                p_slice_header->cabac_init_flag = Parser::GetBit(nalu, offset);
+                p_slice_header->cabac_init_flag = bit_reader.GetBit();
             }
 
             if (p_slice_header->slice_temporal_mvp_enabled_flag) {
                 if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
-                    p_slice_header->collocated_from_l0_flag = Parser::GetBit(nalu, offset);
+                    p_slice_header->collocated_from_l0_flag = bit_reader.GetBit();
                 }
                 if ((p_slice_header->collocated_from_l0_flag && p_slice_header->num_ref_idx_l0_active_minus1 > 0) || (!p_slice_header->collocated_from_l0_flag && p_slice_header->num_ref_idx_l1_active_minus1 > 0)) {
-                    p_slice_header->collocated_ref_idx = Parser::ExpGolomb::ReadUe(nalu, offset);
+                    p_slice_header->collocated_ref_idx = bit_reader.ReadUe();
                     if (p_slice_header->slice_type == HEVC_SLICE_TYPE_P || (p_slice_header->slice_type == HEVC_SLICE_TYPE_B && p_slice_header->collocated_from_l0_flag == 1)) {
                         CHECK_ALLOWED_MAX(p_slice_header->collocated_ref_idx, p_slice_header->num_ref_idx_l0_active_minus1);
                     } else {
@@ -1775,38 +1840,38 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
             }
 
             if ((pps_ptr->weighted_pred_flag && p_slice_header->slice_type == HEVC_SLICE_TYPE_P) || (pps_ptr->weighted_bipred_flag && p_slice_header->slice_type == HEVC_SLICE_TYPE_B)) {
-                ParsePredWeightTable(p_slice_header, chroma_array_type, nalu, offset);
+                ParsePredWeightTable(p_slice_header, chroma_array_type, bit_reader);
             }
-            p_slice_header->five_minus_max_num_merge_cand = Parser::ExpGolomb::ReadUe(nalu, offset);
+            p_slice_header->five_minus_max_num_merge_cand = bit_reader.ReadUe();
             //CHECK_ALLOWED_MAX(p_slice_header->five_minus_max_num_merge_cand, 4);
         }
 
-        p_slice_header->slice_qp_delta = Parser::ExpGolomb::ReadSe(nalu, offset);
+        p_slice_header->slice_qp_delta = bit_reader.ReadSe();
         if (pps_ptr->pps_slice_chroma_qp_offsets_present_flag) {
-            p_slice_header->slice_cb_qp_offset = Parser::ExpGolomb::ReadSe(nalu, offset);
+            p_slice_header->slice_cb_qp_offset = bit_reader.ReadSe();
             CHECK_ALLOWED_RANGE(p_slice_header->slice_cb_qp_offset, -12, 12);
-            p_slice_header->slice_cr_qp_offset = Parser::ExpGolomb::ReadSe(nalu, offset);
+            p_slice_header->slice_cr_qp_offset = bit_reader.ReadSe();
             CHECK_ALLOWED_RANGE(p_slice_header->slice_cr_qp_offset, -12, 12);
         }
         if (pps_ptr->chroma_qp_offset_list_enabled_flag) {
-            p_slice_header->cu_chroma_qp_offset_enabled_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->cu_chroma_qp_offset_enabled_flag = bit_reader.GetBit();
         }
         if (pps_ptr->deblocking_filter_override_enabled_flag) {
-            p_slice_header->deblocking_filter_override_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->deblocking_filter_override_flag = bit_reader.GetBit();
         }
         if (p_slice_header->deblocking_filter_override_flag) {
-            p_slice_header->slice_deblocking_filter_disabled_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->slice_deblocking_filter_disabled_flag = bit_reader.GetBit();
             if ( !p_slice_header->slice_deblocking_filter_disabled_flag ) {
-                p_slice_header->slice_beta_offset_div2 = Parser::ExpGolomb::ReadSe(nalu, offset);
+                p_slice_header->slice_beta_offset_div2 = bit_reader.ReadSe();
                 CHECK_ALLOWED_RANGE(p_slice_header->slice_beta_offset_div2, -6, 6);
-                p_slice_header->slice_tc_offset_div2 = Parser::ExpGolomb::ReadSe(nalu, offset);
+                p_slice_header->slice_tc_offset_div2 = bit_reader.ReadSe();
                 CHECK_ALLOWED_RANGE(p_slice_header->slice_tc_offset_div2, -6, 6);
             }
         }
 
         if (pps_ptr->pps_loop_filter_across_slices_enabled_flag && (p_slice_header->slice_sao_luma_flag || p_slice_header->slice_sao_chroma_flag ||
 !p_slice_header->slice_deblocking_filter_disabled_flag)) {
-            p_slice_header->slice_loop_filter_across_slices_enabled_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->slice_loop_filter_across_slices_enabled_flag = bit_reader.GetBit();
         }
 
         memcpy(&slice_header_copy_, p_slice_header, sizeof(HevcSliceSegHeader));
@@ -1828,16 +1893,16 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
         } else {
             max_num_entry_point_offsets = (pps_ptr->num_tile_columns_minus1 + 1) * pic_height_in_ctbs_y_ - 1;
         }
-        p_slice_header->num_entry_point_offsets = Parser::ExpGolomb::ReadUe(nalu, offset);
+        p_slice_header->num_entry_point_offsets = bit_reader.ReadUe();
         if (p_slice_header->num_entry_point_offsets > max_num_entry_point_offsets) {
             p_slice_header->num_entry_point_offsets = max_num_entry_point_offsets;
         }
 
  #if 0 // do not parse syntax parameters that are not used by HW decode
        if (p_slice_header->num_entry_point_offsets) {
-            p_slice_header->offset_len_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+            p_slice_header->offset_len_minus1 = bit_reader.ReadUe();
             for (int i = 0; i < p_slice_header->num_entry_point_offsets; i++) {
-                p_slice_header->entry_point_offset_minus1[i] = Parser::ReadBits(nalu, offset, p_slice_header->offset_len_minus1 + 1);
+                p_slice_header->entry_point_offset_minus1[i] = bit_reader.ReadBits(p_slice_header->offset_len_minus1 + 1);
             }
         }
 #endif
@@ -1845,9 +1910,9 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
 
 #if 0 // do not parse syntax parameters that are not used by HW decode
     if (pps_ptr->slice_segment_header_extension_present_flag) {
-        p_slice_header->slice_segment_header_extension_length = Parser::ExpGolomb::ReadUe(nalu, offset);
+        p_slice_header->slice_segment_header_extension_length = bit_reader.ReadUe();
         for (int i = 0; i < p_slice_header->slice_segment_header_extension_length; i++) {
-            p_slice_header->slice_segment_header_extension_data_byte[i] = Parser::ReadBits(nalu, offset, 8);
+            p_slice_header->slice_segment_header_extension_data_byte[i] = bit_reader.ReadBits(8);
         }
     }
 #endif
@@ -2150,7 +2215,7 @@ void HevcVideoParser::EmptyDpb() {
         dpb_buffer_.frame_buffer_list[i].is_reference = kUnusedForReference;
         dpb_buffer_.frame_buffer_list[i].pic_output_flag = 0;
         dpb_buffer_.frame_buffer_list[i].use_status = kNotUsed;
-        decode_buffer_pool_[dpb_buffer_.frame_buffer_list[i].dec_buf_idx].use_status = kNotUsed;
+        ClearDecBufUseStatus(dpb_buffer_.frame_buffer_list[i].dec_buf_idx, kFrameUsedForDecode | kFrameUsedForDisplay);
     }
     dpb_buffer_.dpb_fullness = 0;
     dpb_buffer_.num_pics_needed_for_output = 0;
@@ -2199,7 +2264,7 @@ int HevcVideoParser::MarkOutputPictures() {
         for (i = 0; i < HEVC_MAX_DPB_FRAMES; i++) {
             if (dpb_buffer_.frame_buffer_list[i].is_reference == kUnusedForReference && dpb_buffer_.frame_buffer_list[i].pic_output_flag == 0 && dpb_buffer_.frame_buffer_list[i].use_status) {
                 dpb_buffer_.frame_buffer_list[i].use_status = kNotUsed;
-                decode_buffer_pool_[dpb_buffer_.frame_buffer_list[i].dec_buf_idx].use_status &= ~kFrameUsedForDecode;
+                ClearDecBufUseStatus(dpb_buffer_.frame_buffer_list[i].dec_buf_idx, kFrameUsedForDecode);
                 if (dpb_buffer_.dpb_fullness > 0) {
                     dpb_buffer_.dpb_fullness--;
                 } else {
@@ -2210,7 +2275,7 @@ int HevcVideoParser::MarkOutputPictures() {
         }
 
         HevcSeqParamSet *sps_ptr = &sps_list_[m_active_sps_id_];
-        uint32_t highest_tid = sps_ptr->sps_max_sub_layers_minus1; // HighestTid
+        uint32_t highest_tid = GetHighestTid(sps_ptr);
         uint32_t max_num_reorder_pics = sps_ptr->sps_max_num_reorder_pics[highest_tid];
         uint32_t max_dec_pic_buffering = sps_ptr->sps_max_dec_pic_buffering_minus1[highest_tid] + 1;
 
@@ -2236,12 +2301,8 @@ ParserResult HevcVideoParser::FindFreeInDecBufPool() {
     int dec_buf_index;
 
     // Find a free buffer in decode buffer pool
-    for (dec_buf_index = 0; dec_buf_index < dec_buf_pool_size_; dec_buf_index++) {
-        if (decode_buffer_pool_[dec_buf_index].use_status == kNotUsed) {
-            break;
-        }
-    }
-    if (dec_buf_index == dec_buf_pool_size_) {
+    dec_buf_index = GetFreeDecBufIndex();
+    if (dec_buf_index < 0) {
         ERR("Could not find a free buffer in decode buffer pool.");
         return PARSER_NOT_FOUND;
     }
@@ -2287,15 +2348,15 @@ ParserResult HevcVideoParser::FindFreeInDpbAndMark() {
     dpb_buffer_.dpb_fullness++;
 
     // Mark as used in decode buffer pool
-    decode_buffer_pool_[curr_pic_info_.dec_buf_idx].use_status |= kFrameUsedForDecode;
+    SetDecBufUseStatus(curr_pic_info_.dec_buf_idx, kFrameUsedForDecode);
     if (pfn_display_picture_cb_ && curr_pic_info_.pic_output_flag) {
-        decode_buffer_pool_[curr_pic_info_.dec_buf_idx].use_status |= kFrameUsedForDisplay;
+        SetDecBufUseStatus(curr_pic_info_.dec_buf_idx, kFrameUsedForDisplay);
     }
     decode_buffer_pool_[curr_pic_info_.dec_buf_idx].pic_order_cnt = curr_pic_info_.pic_order_cnt;
     decode_buffer_pool_[curr_pic_info_.dec_buf_idx].pts = curr_pts_;
 
     HevcSeqParamSet *sps_ptr = &sps_list_[m_active_sps_id_];
-    uint32_t highest_tid = sps_ptr->sps_max_sub_layers_minus1; // HighestTid
+    uint32_t highest_tid = GetHighestTid(sps_ptr);
     uint32_t max_num_reorder_pics = sps_ptr->sps_max_num_reorder_pics[highest_tid];
 
     while ( dpb_buffer_.num_pics_needed_for_output > max_num_reorder_pics) {
@@ -2336,7 +2397,7 @@ int HevcVideoParser::BumpPicFromDpb() {
     // If it is not used for reference, empty it.
     if (dpb_buffer_.frame_buffer_list[min_poc_pic_idx].is_reference == kUnusedForReference) {
         dpb_buffer_.frame_buffer_list[min_poc_pic_idx].use_status = kNotUsed;
-        decode_buffer_pool_[dpb_buffer_.frame_buffer_list[min_poc_pic_idx].dec_buf_idx].use_status &= ~kFrameUsedForDecode;
+        ClearDecBufUseStatus(dpb_buffer_.frame_buffer_list[min_poc_pic_idx].dec_buf_idx, kFrameUsedForDecode);
         if (dpb_buffer_.dpb_fullness > 0 ) {
             dpb_buffer_.dpb_fullness--;
         }
@@ -2348,8 +2409,7 @@ int HevcVideoParser::BumpPicFromDpb() {
             ERR("Error! Decode buffer pool overflow!");
             return PARSER_OUT_OF_RANGE;
         } else {
-            output_pic_list_[num_output_pics_] = dpb_buffer_.frame_buffer_list[min_poc_pic_idx].dec_buf_idx;
-            num_output_pics_++;
+            AddOutputPicture(dpb_buffer_.frame_buffer_list[min_poc_pic_idx].dec_buf_idx);
         }
     }
 
@@ -2773,7 +2833,7 @@ void HevcVideoParser::PrintDpb() {
     if (num_output_pics_) {
         MSG("output_pic_list:");
         for (i = 0; i < num_output_pics_; i++) {
-            MSG_NO_NEWLINE(output_pic_list_[i] << ", ");
+            MSG_NO_NEWLINE(GetOutputPicture(i) << ", ");
         }
         MSG("");
     }
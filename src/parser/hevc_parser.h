@@ -59,6 +59,12 @@ public:
      */
     virtual rocDecStatus UnInitialize();     // derived method :: nothing to do for this
 
+    /*! \brief function to reset the HEVC parser, e.g. after a seek
+     * \param [in] flags Combination of <tt>RocdecParserResetFlags</tt>
+     * @return rocDecStatus
+     */
+    virtual rocDecStatus Reset(uint32_t flags);
+
 protected:
     /*! \brief Inline function to Parse the NAL Unit Header
      * 
@@ -77,6 +83,26 @@ protected:
         return nalu_header;
     }
 
+    /*! \brief Inline function to get HighestTid, the highest temporal sub-layer to decode
+     * \param [in] sps_ptr Pointer to the active SPS
+     * \return sps_max_sub_layers_minus1, limited by <tt>max_temporal_id_plus1</tt> of the parser parameters
+     */
+    inline uint32_t GetHighestTid(HevcSeqParamSet *sps_ptr) {
+        uint32_t highest_tid = sps_ptr->sps_max_sub_layers_minus1;
+        if (parser_params_.max_temporal_id_plus1 && parser_params_.max_temporal_id_plus1 - 1 < highest_tid) {
+            highest_tid = parser_params_.max_temporal_id_plus1 - 1;
+        }
+        return highest_tid;
+    }
+
+    /*! \brief Inline function to check if the pictures are displayed right after they are submitted for decode
+     * \return True if <tt>zero_reorder_output</tt> is set and the active SPS has sps_max_num_reorder_pics[HighestTid] equal to 0
+     */
+    inline bool IsZeroReorderOutput() {
+        return parser_params_.zero_reorder_output && m_active_sps_id_ >= 0 &&
+               sps_list_[m_active_sps_id_].sps_max_num_reorder_pics[GetHighestTid(&sps_list_[m_active_sps_id_])] == 0;
+    }
+
     /*! \brief Slice info of a picture
      */
     typedef struct {
@@ -185,34 +211,28 @@ protected:
      * \param [out] ptl A pointer of <tt>HevcProfileTierLevel</tt> for the output from teh parsed stream
      * \param [in] profile_present_flag Input of <tt>bool</tt> - 1 specifies profile information is present, else 0
      * \param [in] max_num_sub_layers_minus1 Input of <tt>uint32_t</tt> - plus 1 specifies the maximum number of temporal sub-layers that may be present
-     * \param [in] nalu A pointer of <tt>uint8_t</tt> for the input stream to be parsed
-     * \param [in] size Size of the input stream
-     * \param [in] offset Reference to the offset in the input buffer
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return No return value
      */
-    void ParsePtl(HevcProfileTierLevel *ptl, bool profile_present_flag, uint32_t max_num_sub_layers_minus1, uint8_t *nalu, size_t size, size_t &offset);
+    void ParsePtl(HevcProfileTierLevel *ptl, bool profile_present_flag, uint32_t max_num_sub_layers_minus1, Parser::BitReader &bit_reader);
     
     /*! \brief Function to parse Sub Layer Hypothetical Reference Decoder Parameters
      * \param [out] sub_hrd A pointer of <tt>HevcSubLayerHrdParameters</tt> for the output from teh parsed stream
      * \param [in] cpb_cnt Input of <tt>uint32_t</tt> - specifies the coded picture buffer count in a HRD buffer
      * \param [in] sub_pic_hrd_params_present_flag Input of <tt>bool</tt> - 1 specifies sub layer HRD information is present, else 0
-     * \param [in] nalu A pointer of <tt>uint8_t</tt> for the input stream to be parsed
-     * \param [in] size Size of the input stream
-     * \param [in] offset Reference to the offset in the input buffer
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return No return value
      */
-    void ParseSubLayerHrdParameters(HevcSubLayerHrdParameters *sub_hrd, uint32_t cpb_cnt, bool sub_pic_hrd_params_present_flag, uint8_t *nalu, size_t size, size_t &offset);
+    void ParseSubLayerHrdParameters(HevcSubLayerHrdParameters *sub_hrd, uint32_t cpb_cnt, bool sub_pic_hrd_params_present_flag, Parser::BitReader &bit_reader);
     
     /*! \brief Function to parse Hypothetical Reference Decoder Parameters
      * \param [out] hrd A pointer of <tt>HevcHrdParameters</tt> for the output from the parsed stream
      * \param [in] common_inf_present_flag Input of <tt>bool</tt> - 1 specifies HRD information is present, else 0
      * \param [in] max_num_sub_layers_minus1 Input of <tt>uint32_t</tt> - plus 1 specifies the maximum number of temporal sub-layers that may be present
-     * \param [in] nalu A pointer of <tt>uint8_t</tt> for the input stream to be parsed
-     * \param [in] size Size of the input stream
-     * \param [in] offset Reference to the offset in the input buffer
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return No return value
      */
-    void ParseHrdParameters(HevcHrdParameters *hrd, bool common_inf_present_flag, uint32_t max_num_sub_layers_minus1, uint8_t *nalu, size_t size, size_t &offset);
+    void ParseHrdParameters(HevcHrdParameters *hrd, bool common_inf_present_flag, uint32_t max_num_sub_layers_minus1, Parser::BitReader &bit_reader);
     
     /*! \brief Function to set the default values to the scaling list
      * \param [out] sl_ptr A pointer to the scaling list <tt>HevcScalingListData</tt>
@@ -222,23 +242,19 @@ protected:
 
     /*! \brief Function to parse Scaling List
      * \param [out] sl_ptr A pointer of <tt>HevcScalingListData</tt> for the output from the parsed stream
-     * \param [in] data A pointer of <tt>uint8_t</tt> for the input stream to be parsed
-     * \param [in] size Size of the input stream
-     * \param [in] offset Reference to the offset in the input buffer
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] sps_ptr Pointer to the current SPS
      * \return No return value
      */
-    void ParseScalingList(HevcScalingListData * sl_ptr, uint8_t *data, size_t size, size_t &offset, HevcSeqParamSet *sps_ptr);
+    void ParseScalingList(HevcScalingListData * sl_ptr, Parser::BitReader &bit_reader, HevcSeqParamSet *sps_ptr);
     
     /*! \brief Function to parse Video Usability Information
      * \param [out] vui A pointer of <tt>HevcVuiParameters</tt> for the output from the parsed stream
      * \param [in] max_num_sub_layers_minus1 Input of <tt>uint32_t</tt> - plus 1 specifies the maximum number of temporal sub-layers that may be present
-     * \param [in] data A pointer of <tt>uint8_t</tt> for the input stream to be parsed
-     * \param [in] size Size of the input stream
-     * \param [in] offset Reference to the offset in the input buffer
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return No return value
      */
-    void ParseVui(HevcVuiParameters *vui, uint32_t max_num_sub_layers_minus1, uint8_t *data, size_t size, size_t &offset);
+    void ParseVui(HevcVuiParameters *vui, uint32_t max_num_sub_layers_minus1, Parser::BitReader &bit_reader);
     
     /*! \brief Function to parse Short Term Reference Picture Set
      * \param [in] sps_ptr The pointer to the associated SPS
@@ -246,20 +262,17 @@ protected:
      * \param [in] st_rps_idx specifies the index in the RPS buffer
      * \param [in] num_short_term_ref_pic_sets Specifies the count of Short Term RPS in <tt>uint32_t</tt>
      * \param [in] rps_ref A reference of <tt>HevcShortTermRps</tt> to the RPS buffer
-     * \param [in] data A pointer of <tt>uint8_t</tt> for the input stream to be parsed
-     * \param [in] size Size of the input stream
-     * \param [in] offset Reference to the offset in the input buffer
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return No return value
      */
-    ParserResult ParseShortTermRefPicSet(HevcSeqParamSet *sps_ptr, HevcShortTermRps *rps, uint32_t st_rps_idx, uint32_t num_short_term_ref_pic_sets, HevcShortTermRps rps_ref[], uint8_t *data, size_t size, size_t &offset);
+    ParserResult ParseShortTermRefPicSet(HevcSeqParamSet *sps_ptr, HevcShortTermRps *rps, uint32_t st_rps_idx, uint32_t num_short_term_ref_pic_sets, HevcShortTermRps rps_ref[], Parser::BitReader &bit_reader);
     
     /*! \brief Function to parse weighted prediction table
      * \param [in/out] Slice_header_ptr Pointer to the slice segment header
      * \param [in] chroma_array_type ChromaArrayType
-     * \param [in] stream_ptr Bit stream pointer
-     * \param [in/out] offset Bit offset of the current parsing action
+     * \param [in/out] bit_reader Bit reader of the input stream
      */
-    void ParsePredWeightTable(HevcSliceSegHeader *slice_header_ptr, int chroma_array_type, uint8_t *stream_ptr, size_t &offset);
+    void ParsePredWeightTable(HevcSliceSegHeader *slice_header_ptr, int chroma_array_type, Parser::BitReader &bit_reader);
 
     /*! \brief Function to parse Slice Header
      * \param [in] nalu A pointer of <tt>uint8_t</tt> for the input stream to be parsed
@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "nal_unit_index.h"
+#include "start_code_scanner.h"
+
+namespace Parser {
+
+RocdecNalUnitInfo MakeNalUnitInfo(const uint8_t *data, uint32_t offset, uint32_t size, rocDecVideoCodec codec_type) {
+    RocdecNalUnitInfo nal_unit = {0};
+    nal_unit.offset = offset;
+    nal_unit.size = size;
+    const uint8_t *header = data + offset + 3;
+    if (codec_type == rocDecVideoCodec_HEVC) {
+        // forbidden_zero_bit (1), nal_unit_type (6), nuh_layer_id (6), nuh_temporal_id_plus1 (3)
+        if (size >= 5) {
+            nal_unit.nal_unit_type = (header[0] >> 1) & 0x3F;
+            nal_unit.layer_id = ((header[0] & 0x01) << 5) | (header[1] >> 3);
+            uint8_t temporal_id_plus1 = header[1] & 0x07;
+            nal_unit.temporal_id = temporal_id_plus1 ? temporal_id_plus1 - 1 : 0;
+        }
+    } else {
+        // forbidden_zero_bit (1), nal_ref_idc (2), nal_unit_type (5)
+        if (size >= 4) {
+            nal_unit.nal_unit_type = header[0] & 0x1F;
+        }
+    }
+    return nal_unit;
+}
+
+size_t BuildNalUnitIndex(const uint8_t *data, size_t size, rocDecVideoCodec codec_type, std::vector<RocdecNalUnitInfo> &nal_units) {
+    nal_units.clear();
+    size_t start_code_offset = ScanStartCode(data, size);
+    while (start_code_offset < size) {
+        size_t search_offset = start_code_offset + 3;
+        size_t next_start_code_offset = search_offset < size ? search_offset + ScanStartCode(data + search_offset, size - search_offset) : size;
+        nal_units.push_back(MakeNalUnitInfo(data, start_code_offset, next_start_code_offset - start_code_offset, codec_type));
+        start_code_offset = next_start_code_offset;
+    }
+    return nal_units.size();
+}
+
+bool IsValidNalUnitIndex(const uint8_t *data, size_t size, const RocdecNalUnitInfo *nal_units, uint32_t num_nal_units) {
+    if (nal_units == nullptr || num_nal_units == 0) {
+        return false;
+    }
+    size_t min_offset = 0;
+    for (uint32_t i = 0; i < num_nal_units; i++) {
+        size_t offset = nal_units[i].offset;
+        size_t nal_size = nal_units[i].size;
+        if (offset < min_offset || nal_size < 3 || offset + nal_size > size) {
+            return false;
+        }
+        if (data[offset] != 0 || data[offset + 1] != 0 || data[offset + 2] != 1) {
+            return false;
+        }
+        min_offset = offset + nal_size;
+    }
+    return true;
+}
+
+}
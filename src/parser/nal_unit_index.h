@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "rocparser.h"
+
+namespace Parser {
+    /*! \brief Function to fill the index entry of a NAL unit from its start code prefix and NAL unit header
+     * \param [in] data Pointer to the buffer holding the NAL unit
+     * \param [in] offset Byte offset of the start code prefix (0x000001) in the buffer
+     * \param [in] size Size of the NAL unit in bytes, start code prefix included
+     * \param [in] codec_type Codec of the stream, <tt>rocDecVideoCodec_AVC</tt> or <tt>rocDecVideoCodec_HEVC</tt>
+     * \return The index entry. The header fields are 0 if the NAL unit is too short to hold a header.
+     */
+    RocdecNalUnitInfo MakeNalUnitInfo(const uint8_t *data, uint32_t offset, uint32_t size, rocDecVideoCodec codec_type);
+
+    /*! \brief Function to build the NAL unit index of an Annex B access unit in one pass over the buffer
+     *
+     * A NAL unit spans from its start code prefix to the next start code prefix or the end of the buffer. Bytes before
+     * the first start code prefix are not indexed.
+     * \param [in] data Pointer to the buffer
+     * \param [in] size Size of the buffer in bytes
+     * \param [in] codec_type Codec of the stream, <tt>rocDecVideoCodec_AVC</tt> or <tt>rocDecVideoCodec_HEVC</tt>
+     * \param [out] nal_units The NAL unit index. Existing entries are replaced.
+     * \return Number of NAL units found
+     */
+    size_t BuildNalUnitIndex(const uint8_t *data, size_t size, rocDecVideoCodec codec_type, std::vector<RocdecNalUnitInfo> &nal_units);
+
+    /*! \brief Function to check an externally supplied NAL unit index against the buffer it describes
+     * \param [in] data Pointer to the buffer
+     * \param [in] size Size of the buffer in bytes
+     * \param [in] nal_units Pointer to the NAL unit index
+     * \param [in] num_nal_units Number of entries in the index
+     * \return true if the entries are in ascending order, do not overlap, lie inside the buffer and begin with a start code prefix
+     */
+    bool IsValidNalUnitIndex(const uint8_t *data, size_t size, const RocdecNalUnitInfo *nal_units, uint32_t num_nal_units);
+}
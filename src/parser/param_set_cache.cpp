@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "param_set_cache.h"
+
+namespace Parser {
+
+static size_t TrimTrailingZeroBytes(const uint8_t *data, size_t size) {
+    while (size > 0 && data[size - 1] == 0) {
+        size--;
+    }
+    return size;
+}
+
+/* 64-bit FNV-1a over 8-byte words, followed by the remaining bytes */
+static uint64_t HashPayload(const uint8_t *data, size_t size) {
+    const uint64_t fnv_prime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * fnv_prime;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ data[i]) * fnv_prime;
+    }
+    return hash;
+}
+
+bool ParameterSetCache::Lookup(uint32_t type, uint32_t id, const uint8_t *data, size_t size) {
+    size = TrimTrailingZeroBytes(data, size);
+    if (type < entries_.size() && id < entries_[type].size()) {
+        const CacheEntry &entry = entries_[type][id];
+        if (entry.valid && entry.payload.size() == size && entry.hash == HashPayload(data, size) && memcmp(entry.payload.data(), data, size) == 0) {
+            num_hits_++;
+            return true;
+        }
+    }
+    num_misses_++;
+    return false;
+}
+
+void ParameterSetCache::Insert(uint32_t type, uint32_t id, const uint8_t *data, size_t size) {
+    if (id >= kMaxParamSetIdCount) {
+        return;
+    }
+    size = TrimTrailingZeroBytes(data, size);
+    if (type >= entries_.size()) {
+        entries_.resize(type + 1);
+    }
+    if (id >= entries_[type].size()) {
+        entries_[type].resize(id + 1);
+    }
+    CacheEntry &entry = entries_[type][id];
+    entry.valid = true;
+    entry.hash = HashPayload(data, size);
+    entry.payload.assign(data, data + size);
+}
+
+void ParameterSetCache::Invalidate(uint32_t type) {
+    if (type < entries_.size()) {
+        for (auto &entry : entries_[type]) {
+            entry.valid = false;
+        }
+    }
+}
+
+void ParameterSetCache::Invalidate(uint32_t type, uint32_t id) {
+    if (type < entries_.size() && id < entries_[type].size()) {
+        entries_[type][id].valid = false;
+    }
+}
+
+void ParameterSetCache::Clear() {
+    for (uint32_t type = 0; type < entries_.size(); type++) {
+        Invalidate(type);
+    }
+}
+
+}
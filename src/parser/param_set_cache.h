@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace Parser {
+    const uint32_t kMaxParamSetIdCount = 256;  // largest id range of all parameter set types (AVC PPS)
+
+    /*! \brief Cache of the raw payloads of the most recently parsed parameter sets, keyed by parameter set type and id
+     *
+     * Streams commonly repeat identical parameter sets before every random access point. A parser looks up the payload
+     * before parsing a parameter set and skips the parse on a hit, since the parsed set stored for the id is still valid.
+     * Lookups compare a 64-bit hash of the payload first and then the payload bytes. Trailing zero bytes (trailing_zero_8bits
+     * or the leading zero byte of the next start code) are not part of the key.
+     */
+    class ParameterSetCache {
+    public:
+        ParameterSetCache() : num_hits_(0), num_misses_(0) {};
+
+        /*! \brief Function to look up a parameter set payload
+         * \param [in] type Parameter set type, defined by the parser
+         * \param [in] id Parameter set id
+         * \param [in] data Pointer to the parameter set payload
+         * \param [in] size Size of the payload in bytes
+         * \return true if the payload is identical to the one stored for the type and id
+         */
+        bool Lookup(uint32_t type, uint32_t id, const uint8_t *data, size_t size);
+
+        /*! \brief Function to store a parameter set payload after it has been parsed successfully
+         * \param [in] type Parameter set type, defined by the parser
+         * \param [in] id Parameter set id
+         * \param [in] data Pointer to the parameter set payload
+         * \param [in] size Size of the payload in bytes
+         */
+        void Insert(uint32_t type, uint32_t id, const uint8_t *data, size_t size);
+
+        /*! \brief Function to drop all stored payloads of a type, e.g. when the sets depend on a parameter set that has changed
+         * \param [in] type Parameter set type
+         */
+        void Invalidate(uint32_t type);
+
+        /*! \brief Function to drop the stored payload of a parameter set. A parser calls it on a lookup miss, before the parsed set
+         * stored for the id is overwritten, so that the payload is only cached again once the new set has been parsed successfully.
+         * \param [in] type Parameter set type
+         * \param [in] id Parameter set id
+         */
+        void Invalidate(uint32_t type, uint32_t id);
+
+        /*! \brief Function to drop all stored payloads. The hit and miss counters are kept.
+         */
+        void Clear();
+
+        uint64_t GetNumHits() const { return num_hits_; };
+        uint64_t GetNumMisses() const { return num_misses_; };
+
+    private:
+        typedef struct {
+            bool valid;
+            uint64_t hash;
+            std::vector<uint8_t> payload;
+        } CacheEntry;
+
+        std::vector<std::vector<CacheEntry>> entries_;  // indexed by type, then by id
+        uint64_t num_hits_;
+        uint64_t num_misses_;
+    };
+}
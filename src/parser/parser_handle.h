@@ -37,8 +37,11 @@ public:
     bool NoError() { return error_.empty(); }
     const char* ErrorMsg() { return error_.c_str(); }
     void CaptureError(const std::string& err_msg) { error_ = err_msg; }
-    rocDecStatus ParseVideoData(RocdecSourceDataPacket *packet) { return roc_parser_->ParseVideoData(packet); }
+    rocDecStatus ParseVideoData(RocdecSourceDataPacket *packet) { return roc_parser_->IsByteStreamInput() ? roc_parser_->ParseByteStream(packet) : roc_parser_->ParseVideoData(packet); }
     rocDecStatus MarkFrameForReuse(int pic_idx) { return roc_parser_->MarkFrameForReuse(pic_idx); }
+    rocDecStatus GetParserStats(RocdecParserStats *stats) { return roc_parser_->GetParserStats(stats); }
+    rocDecStatus Reset(uint32_t flags) { return roc_parser_->Reset(flags); }
+    rocDecStatus SetDisplayStartPts(RocdecTimeStamp pts) { return roc_parser_->SetDisplayStartPts(pts); }
     rocDecStatus DestroyParser() { return DestroyParserInternal(); };
 
 private:
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
 #include "roc_video_parser.h"
 
 RocVideoParser::RocVideoParser() {
@@ -27,15 +28,28 @@ RocVideoParser::RocVideoParser() {
     pic_width_ = 0;
     pic_height_ = 0;
     new_seq_activated_ = false;
+    video_format_reported_ = false;
+    released_frame_mask_ = 0;
     frame_rate_.numerator = 0;
     frame_rate_.denominator = 0;
     curr_pts_ = 0;
+    pic_skipped_ = false;
+    num_skipped_non_ref_pics_ = 0;
+    suppress_display_ = false;
+    display_start_pts_ = 0;
+    num_suppressed_pics_ = 0;
+    nal_units_ = nullptr;
+    num_nal_units_ = 0;
 
     sei_rbsp_buf_ = nullptr;
     sei_rbsp_buf_size_ = 0;
     sei_payload_buf_ = nullptr;
     sei_payload_buf_size_ = 0;
     sei_message_list_.assign(INIT_SEI_MESSAGE_COUNT, {0});
+    sei_message_payload_.assign(INIT_SEI_MESSAGE_COUNT, nullptr);
+    sei_payload_offset_.assign(INIT_SEI_MESSAGE_COUNT, 0);
+    sei_filter_enabled_ = false;
+    sei_filter_ = {};
 }
 
 RocVideoParser::~RocVideoParser() {
@@ -62,43 +76,219 @@ rocDecStatus RocVideoParser::Initialize(RocdecParserParams *pParams) {
     pfn_decode_picture_cb_  = pParams->pfn_decode_picture;        /**< Called when a picture is ready to be decoded (decode order)         */
     pfn_display_picture_cb_ = pParams->pfn_display_picture;       /**< Called whenever a picture is ready to be displayed (display order)  */
     pfn_get_sei_message_cb_ = pParams->pfn_get_sei_msg;           /**< Called when all SEI messages are parsed for particular frame        */
+    pfn_parsed_picture_cb_  = pParams->pfn_parsed_picture;        /**< Called when a picture is parsed in header only mode                 */
 
     parser_params_ = *pParams;
+    if (pParams->sei_filter) {
+        sei_filter_ = *pParams->sei_filter;
+        sei_filter_enabled_ = true;
+    }
+    parser_params_.sei_filter = nullptr; // the filter is not required to outlive this call
 
+    if (parser_params_.max_num_decode_surfaces > MAX_DEC_BUF_POOL_SIZE) {
+        ERR("Number of decode surfaces " + TOSTR(parser_params_.max_num_decode_surfaces) + " exceeds the maximum of " + TOSTR(MAX_DEC_BUF_POOL_SIZE));
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    if (parser_params_.byte_stream_input) {
+        if (parser_params_.codec_type != rocDecVideoCodec_AVC && parser_params_.codec_type != rocDecVideoCodec_HEVC) {
+            ERR("Byte stream input is only supported for AVC and HEVC.");
+            return ROCDEC_NOT_SUPPORTED;
+        }
+        au_assembler_.SetCodec(parser_params_.codec_type);
+    }
     dec_buf_pool_size_ = parser_params_.max_num_decode_surfaces;
     decode_buffer_pool_.resize(dec_buf_pool_size_, {0});
-    output_pic_list_.resize(dec_buf_pool_size_, 0xFF);
+    output_pic_list_.resize(MAX_DEC_BUF_POOL_SIZE, 0xFF);
     InitDecBufPool();
 
     return ROCDEC_SUCCESS;
 }
 
 rocDecStatus RocVideoParser::MarkFrameForReuse(int pic_idx) {
-    if (pic_idx < 0) {
+    if (pic_idx < 0 || pic_idx >= MAX_DEC_BUF_POOL_SIZE) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    // Without explicit_frame_release the parser recycles displayed frames itself. Otherwise the release is handed over to
+    // the parser thread, which owns decode_buffer_pool_, through an atomic mask.
+    if (parser_params_.explicit_frame_release) {
+        released_frame_mask_.fetch_or(1ULL << pic_idx, std::memory_order_release);
+    }
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus RocVideoParser::GetParserStats(RocdecParserStats *stats) {
+    *stats = {0};
+    stats->num_param_set_cache_hits = param_set_cache_.GetNumHits();
+    stats->num_param_set_cache_misses = param_set_cache_.GetNumMisses();
+    stats->num_skipped_non_ref_pics = num_skipped_non_ref_pics_;
+    stats->num_suppressed_pics = num_suppressed_pics_;
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus RocVideoParser::SetDisplayStartPts(RocdecTimeStamp pts) {
+    suppress_display_ = true;
+    display_start_pts_ = pts;
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus RocVideoParser::Reset(uint32_t flags) {
+    // Discard the pictures that are still in decode or display state. Frames held by the application stay reserved.
+    for (uint32_t i = 0; i < dec_buf_pool_size_; i++) {
+        ClearDecBufUseStatus(i, kFrameUsedForDecode | kFrameUsedForDisplay);
+    }
+    num_output_pics_ = 0;
+    output_pic_head_ = 0;
+    pic_count_ = 0;
+    pic_skipped_ = false;
+    sei_message_count_ = 0;
+    sei_payload_size_ = 0;
+    au_assembler_.Clear();
+    if (!(flags & ROCDEC_PARSER_RESET_KEEP_PARAM_SETS)) {
+        // The next sequence is reported again, even if its format is unchanged
+        param_set_cache_.Clear();
+        pic_width_ = 0;
+        pic_height_ = 0;
+        new_seq_activated_ = false;
+        video_format_reported_ = false;
+    }
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus RocVideoParser::ParseByteStream(RocdecSourceDataPacket *p_data) {
+    rocDecStatus status = ROCDEC_SUCCESS;
+    // A discontinuity ends the access unit received before it. It is parsed and output with the pending pictures before the reset.
+    if (p_data->flags & ROCDEC_PKT_DISCONTINUITY) {
+        status = ParseAccessUnits(true);
+        if (Reset(ROCDEC_PARSER_RESET_FLUSH | ROCDEC_PARSER_RESET_KEEP_PARAM_SETS) != ROCDEC_SUCCESS) {
+            return ROCDEC_RUNTIME_ERROR;
+        }
+    }
+    if (p_data->payload && p_data->payload_size) {
+        au_assembler_.Append(p_data->payload, p_data->payload_size, p_data->flags & ROCDEC_PKT_TIMESTAMP, p_data->pts);
+    } else if (!(p_data->flags & ROCDEC_PKT_ENDOFSTREAM)) {
+        // If no payload and EOS is not set, treated as invalid.
         return ROCDEC_INVALID_PARAMETER;
     }
-    //todo::
-    return ROCDEC_NOT_IMPLEMENTED;
+
+    rocDecStatus ret = ParseAccessUnits(p_data->flags & (ROCDEC_PKT_ENDOFPICTURE | ROCDEC_PKT_ENDOFSTREAM));
+    if (ret != ROCDEC_SUCCESS && status == ROCDEC_SUCCESS) {
+        status = ret;
+    }
+
+    if (p_data->flags & ROCDEC_PKT_ENDOFSTREAM) {
+        au_assembler_.Clear();
+        RocdecSourceDataPacket eos_packet = {};
+        eos_packet.flags = p_data->flags & (ROCDEC_PKT_ENDOFSTREAM | ROCDEC_PKT_NOTIFY_EOS);
+        ret = ParseVideoData(&eos_packet);
+        if (ret != ROCDEC_SUCCESS && status == ROCDEC_SUCCESS) {
+            status = ret;
+        }
+    }
+    return status;
+}
+
+rocDecStatus RocVideoParser::ParseAccessUnits(bool end_of_au) {
+    // An access unit that fails to parse is dropped. The following access units and the end of stream are still processed.
+    rocDecStatus status = ROCDEC_SUCCESS;
+    Parser::AccessUnitAssembler::AccessUnit au;
+    while (au_assembler_.GetAccessUnit(au, end_of_au)) {
+        RocdecSourceDataPacket au_packet = {};
+        au_packet.flags = ROCDEC_PKT_NAL_INDEX | (au.pts_valid ? ROCDEC_PKT_TIMESTAMP : 0);
+        au_packet.payload = au.data;
+        au_packet.payload_size = au.size;
+        au_packet.pts = au.pts;
+        au_packet.nal_units = au.nal_units;
+        au_packet.num_nal_units = au.num_nal_units;
+        rocDecStatus ret = ParseVideoData(&au_packet);
+        if (ret != ROCDEC_SUCCESS && status == ROCDEC_SUCCESS) {
+            status = ret;
+        }
+    }
+    return status;
 }
 
 void RocVideoParser::InitDecBufPool() {
     for (int i = 0; i < dec_buf_pool_size_; i++) {
         decode_buffer_pool_[i].use_status = kNotUsed;
         decode_buffer_pool_[i].pic_order_cnt = 0;
-        output_pic_list_[i] = 0xFF;
     }
+    dec_buf_used_mask_ = 0;
     num_output_pics_ = 0;
+    output_pic_head_ = 0;
+}
+
+void RocVideoParser::ReclaimReleasedFrames() {
+    if (released_frame_mask_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    uint64_t released_mask = released_frame_mask_.exchange(0, std::memory_order_acquire);
+    while (released_mask) {
+        uint32_t i = __builtin_ctzll(released_mask);
+        released_mask &= released_mask - 1;
+        if (i < dec_buf_pool_size_) {
+            ClearDecBufUseStatus(i, kFrameUsedByApp);
+        }
+    }
+}
+
+int RocVideoParser::GetFreeDecBufIndex() {
+    ReclaimReleasedFrames();
+    uint64_t pool_mask = dec_buf_pool_size_ >= MAX_DEC_BUF_POOL_SIZE ? ~0ULL : (1ULL << dec_buf_pool_size_) - 1;
+    uint64_t free_mask = ~dec_buf_used_mask_ & pool_mask;
+    return free_mask ? __builtin_ctzll(free_mask) : -1;
 }
 
 void RocVideoParser::CheckAndAdjustDecBufPoolSize(int dpb_size) {
     int min_dec_buf_pool_size = dpb_size + (parser_params_.max_display_delay > DECODE_BUF_POOL_EXTENSION ? parser_params_.max_display_delay : DECODE_BUF_POOL_EXTENSION);
+    if (min_dec_buf_pool_size > MAX_DEC_BUF_POOL_SIZE) {
+        ERR("Decode buffer pool size " + TOSTR(min_dec_buf_pool_size) + " is limited to " + TOSTR(MAX_DEC_BUF_POOL_SIZE));
+        min_dec_buf_pool_size = MAX_DEC_BUF_POOL_SIZE;
+    }
     if ( dec_buf_pool_size_ < min_dec_buf_pool_size) {
         dec_buf_pool_size_ = min_dec_buf_pool_size;
         decode_buffer_pool_.resize(dec_buf_pool_size_, {0});
-        output_pic_list_.resize(dec_buf_pool_size_, 0xFF);
     }
 }
 
+ParserResult RocVideoParser::ReportVideoFormat() {
+    if (video_format_reported_ &&
+        video_format_params_.codec == reported_video_format_.codec &&
+        video_format_params_.coded_width == reported_video_format_.coded_width &&
+        video_format_params_.coded_height == reported_video_format_.coded_height &&
+        video_format_params_.display_area.left == reported_video_format_.display_area.left &&
+        video_format_params_.display_area.top == reported_video_format_.display_area.top &&
+        video_format_params_.display_area.right == reported_video_format_.display_area.right &&
+        video_format_params_.display_area.bottom == reported_video_format_.display_area.bottom &&
+        video_format_params_.chroma_format == reported_video_format_.chroma_format &&
+        video_format_params_.bit_depth_luma_minus8 == reported_video_format_.bit_depth_luma_minus8 &&
+        video_format_params_.bit_depth_chroma_minus8 == reported_video_format_.bit_depth_chroma_minus8 &&
+        video_format_params_.min_num_decode_surfaces == reported_video_format_.min_num_decode_surfaces) {
+        // Same format, e.g. a repeated sequence header after a splice. The decoder does not need to be reconfigured.
+        return PARSER_OK;
+    }
+    if (pfn_sequece_cb_ && pfn_sequece_cb_(parser_params_.user_data, &video_format_params_) == 0) {
+        ERR("Sequence callback function failed.");
+        return PARSER_FAIL;
+    }
+    reported_video_format_ = video_format_params_;
+    video_format_reported_ = true;
+    return PARSER_OK;
+}
+
+ParserResult RocVideoParser::OutputParsedPicture(RocdecParsedPicInfo *pic_info) {
+    pic_info->picture_index = dec_pic_params_.curr_pic_idx;
+    pic_info->bitstream_size = dec_pic_params_.bitstream_data_len;
+    pic_info->num_slices = dec_pic_params_.num_slices;
+    pic_info->field_pic_flag = dec_pic_params_.field_pic_flag;
+    pic_info->bottom_field_flag = dec_pic_params_.bottom_field_flag;
+    pic_info->pts = curr_pts_;
+    if (pfn_parsed_picture_cb_ && pfn_parsed_picture_cb_(parser_params_.user_data, pic_info) == 0) {
+        ERR("Parsed picture callback function failed.");
+        return PARSER_FAIL;
+    }
+    return PARSER_OK;
+}
+
 ParserResult RocVideoParser::OutputDecodedPictures(bool no_delay) {
     RocdecParserDispInfo disp_info = {0};
     disp_info.progressive_frame = 1; // not used
@@ -108,150 +298,156 @@ ParserResult RocVideoParser::OutputDecodedPictures(bool no_delay) {
     if (num_output_pics_ > disp_delay) {
         int num_disp = num_output_pics_ - disp_delay;
         for (int i = 0; i < num_disp; i++) {
-            disp_info.picture_index = output_pic_list_[i];
-            disp_info.pts = decode_buffer_pool_[output_pic_list_[i]].pts;
+            uint32_t disp_idx = GetOutputPicture(i);
+            disp_info.picture_index = disp_idx;
+            disp_info.pts = decode_buffer_pool_[disp_idx].pts;
+            if (suppress_display_) {
+                if (disp_info.pts < display_start_pts_) {
+                    // Pre-roll picture: the surface is free once the picture is no longer referenced
+                    ClearDecBufUseStatus(disp_idx, kFrameUsedForDisplay);
+                    num_suppressed_pics_++;
+                    continue;
+                }
+                suppress_display_ = false;
+            }
+            if (parser_params_.explicit_frame_release) {
+                // Set before the callback since the application may release the frame from within it
+                SetDecBufUseStatus(disp_idx, kFrameUsedByApp);
+            }
             pfn_display_picture_cb_(parser_params_.user_data, &disp_info);
-            decode_buffer_pool_[output_pic_list_[i]].use_status &= ~kFrameUsedForDisplay;
+            ClearDecBufUseStatus(disp_idx, kFrameUsedForDisplay);
         }
+        // The remaining frames stay in the ring
+        output_pic_head_ = (output_pic_head_ + num_disp) & (MAX_DEC_BUF_POOL_SIZE - 1);
         num_output_pics_ = disp_delay;
-        // Shift the remaining frames to the top
-        if (num_output_pics_) {
-            for (int i = 0; i < num_output_pics_; i++) {
-                output_pic_list_[i] = output_pic_list_[i + num_disp];
-            }
-        }
     }
     return PARSER_OK;
 }
 
-ParserResult RocVideoParser::GetNalUnit() {
-    bool start_code_found = false;
-
-    nal_unit_size_ = 0;
-    curr_start_code_offset_ = next_start_code_offset_;  // save the current start code offset
-
-    // Search for the next start code
-    while (curr_byte_offset_ < pic_data_size_ - 2) {
-        if (pic_data_buffer_ptr_[curr_byte_offset_] == 0 && pic_data_buffer_ptr_[curr_byte_offset_ + 1] == 0 && pic_data_buffer_ptr_[curr_byte_offset_ + 2] == 0x01) {
-            curr_start_code_offset_ = next_start_code_offset_;  // save the current start code offset
-
-            start_code_found = true;
-            start_code_num_++;
-            next_start_code_offset_ = curr_byte_offset_;
-            // Move the pointer 3 bytes forward
-            curr_byte_offset_ += 3;
-
-            // For the very first NAL unit, search for the next start code (or reach the end of frame)
-            if (start_code_num_ == 1 ) {
-                start_code_found = false;
-                curr_start_code_offset_ = next_start_code_offset_;
-                continue;
-            } else {
-                break;
-            }
-        }
-        curr_byte_offset_++;
-    }
-    if (start_code_num_ == 0) {
-        // No NAL unit in the frame data
-        return PARSER_NOT_FOUND;
-    }
-    if (start_code_found) {
-        nal_unit_size_ = next_start_code_offset_ - curr_start_code_offset_;
-        return PARSER_OK;
+void RocVideoParser::IndexNalUnits(const RocdecSourceDataPacket *p_data, rocDecVideoCodec codec_type) {
+    if ((p_data->flags & ROCDEC_PKT_NAL_INDEX) && Parser::IsValidNalUnitIndex(p_data->payload, p_data->payload_size, p_data->nal_units, p_data->num_nal_units)) {
+        nal_units_ = p_data->nal_units;
+        num_nal_units_ = p_data->num_nal_units;
     } else {
-        nal_unit_size_ = pic_data_size_ - curr_start_code_offset_;
-        return PARSER_EOF;
+        num_nal_units_ = Parser::BuildNalUnitIndex(p_data->payload, p_data->payload_size, codec_type, nal_unit_index_);
+        nal_units_ = nal_unit_index_.data();
     }
 }
 
-size_t RocVideoParser::EbspToRbsp(uint8_t *streamBuffer,size_t begin_bytepos, size_t end_bytepos) {
-    int count = 0;
-    if (end_bytepos < begin_bytepos) {
-        return end_bytepos;
+void RocVideoParser::ParseSeiNalUnit(uint8_t *sei_ebsp, int sei_ebsp_size) {
+    if (sei_ebsp_size <= 0) {
+        return;
     }
-    uint8_t *streamBuffer_i = streamBuffer + begin_bytepos;
-    uint8_t *streamBuffer_end = streamBuffer + end_bytepos;
-    int reduce_count = 0;
-    for (; streamBuffer_i != streamBuffer_end; ) { 
-        //starting from begin_bytepos to avoid header information
-        //in NAL unit, 0x000000, 0x000001 or 0x000002 shall not occur at any uint8_t-aligned position
-        uint8_t tmp =* streamBuffer_i;
-        if (count == ZEROBYTES_SHORTSTARTCODE) {
-            if (tmp == 0x03) {
-                //check the 4th uint8_t after 0x000003, except when cabac_zero_word is used, in which case the last three bytes of this NAL unit must be 0x000003
-                if ((streamBuffer_i + 1 != streamBuffer_end) && (streamBuffer_i[1] > 0x03)) {
-                    return static_cast<size_t>(-1);
-                }
-                //if cabac_zero_word is used, the final uint8_t of this NAL unit(0x03) is discarded, and the last two bytes of RBSP must be 0x0000
-                if (streamBuffer_i + 1 == streamBuffer_end) {
-                    break;
-                }
-                memmove(streamBuffer_i, streamBuffer_i + 1, streamBuffer_end-streamBuffer_i - 1);
-                streamBuffer_end--;
-                reduce_count++;
-                count = 0;
-                tmp = *streamBuffer_i;
-            } else if (tmp < 0x03) {
-            }
-        }
-        if (tmp == 0x00) {
-            count++;
-        } else {
-            count = 0;
+    // Without emulation prevention bytes the EBSP is identical to the RBSP and the subscribed payloads can be referenced in place
+    if (sei_filter_enabled_ && Parser::ScanEmulationPrevention(sei_ebsp, sei_ebsp_size) == static_cast<size_t>(sei_ebsp_size)) {
+        ParseSeiMessage(sei_ebsp, sei_ebsp_size, true);
+        return;
+    }
+    if (sei_rbsp_buf_) {
+        if (static_cast<uint32_t>(sei_ebsp_size) > sei_rbsp_buf_size_) {
+            delete [] sei_rbsp_buf_;
+            sei_rbsp_buf_ = new uint8_t [sei_ebsp_size];
+            sei_rbsp_buf_size_ = sei_ebsp_size;
         }
-        streamBuffer_i++;
+    } else {
+        sei_rbsp_buf_size_ = sei_ebsp_size > INIT_SEI_PAYLOAD_BUF_SIZE ? sei_ebsp_size : INIT_SEI_PAYLOAD_BUF_SIZE;
+        sei_rbsp_buf_ = new uint8_t [sei_rbsp_buf_size_];
+    }
+    size_t rbsp_size = Parser::EbspToRbsp(sei_ebsp, sei_ebsp_size, sei_rbsp_buf_);
+    if (rbsp_size == static_cast<size_t>(-1)) {
+        return; // invalid emulation prevention sequence: skip the NAL unit
     }
-    return end_bytepos - begin_bytepos + reduce_count;
+    rbsp_size_ = static_cast<int>(rbsp_size);
+    ParseSeiMessage(sei_rbsp_buf_, rbsp_size_, false);
 }
 
-void RocVideoParser::ParseSeiMessage(uint8_t *nalu, size_t size) {
-    int offset = 0; // byte offset
-    int payload_type;
-    int payload_size;
+void RocVideoParser::ParseSeiMessage(uint8_t *nalu, size_t size, bool in_place) {
+    size_t offset = 0; // byte offset
+    uint32_t payload_type;
+    uint32_t payload_size;
 
     do {
         payload_type = 0;
-        while (nalu[offset] == 0xFF) {
+        while (offset < size && nalu[offset] == 0xFF) {
             payload_type += 255;  // ff_byte
             offset++;
         }
+        if (offset >= size) {
+            break;
+        }
         payload_type += nalu[offset];  // last_payload_type_byte
         offset++;
 
         payload_size = 0;
-        while (nalu[offset] == 0xFF) {
+        while (offset < size && nalu[offset] == 0xFF) {
             payload_size += 255;  // ff_byte
             offset++;
         }
+        if (offset >= size) {
+            break;
+        }
         payload_size += nalu[offset];  // last_payload_size_byte
         offset++;
+        if (offset + payload_size > size) {
+            ERR("SEI payload size " + TOSTR(payload_size) + " exceeds the SEI NAL unit size");
+            break;
+        }
+
+        // Payloads not subscribed to are skipped without copying
+        if (sei_filter_enabled_ && (payload_type > 255 || !(sei_filter_.payload_type_mask[payload_type >> 5] & (1u << (payload_type & 31))))) {
+            offset += payload_size;
+            continue;
+        }
 
         // We start with INIT_SEI_MESSAGE_COUNT. Should be enough for normal use cases. If not, resize.
         if((sei_message_count_ + 1) > sei_message_list_.size()) {
             sei_message_list_.resize((sei_message_count_ + 1));
+            sei_message_payload_.resize((sei_message_count_ + 1));
+            sei_payload_offset_.resize((sei_message_count_ + 1));
         }
         sei_message_list_[sei_message_count_].sei_message_type = payload_type;
         sei_message_list_[sei_message_count_].sei_message_size = payload_size;
 
-        if (sei_payload_buf_) {
-            if ((payload_size + sei_payload_size_) > sei_payload_buf_size_) {
-                uint8_t *tmp_ptr = new uint8_t [payload_size + sei_payload_size_];
-                memcpy(tmp_ptr, sei_payload_buf_, sei_payload_size_); // save the existing payload
-                delete [] sei_payload_buf_;
-                sei_payload_buf_ = tmp_ptr;
-            }
+        if (in_place) {
+            sei_message_payload_[sei_message_count_] = nalu + offset;
         } else {
-            // First payload, sei_payload_size_ is 0.
-            sei_payload_buf_size_ = payload_size > INIT_SEI_PAYLOAD_BUF_SIZE ? payload_size : INIT_SEI_PAYLOAD_BUF_SIZE;
-            sei_payload_buf_ = new uint8_t [sei_payload_buf_size_];
+            if (sei_payload_buf_) {
+                if ((payload_size + sei_payload_size_) > sei_payload_buf_size_) {
+                    uint32_t new_buf_size = std::max(payload_size + sei_payload_size_, 2 * sei_payload_buf_size_);
+                    uint8_t *tmp_ptr = new uint8_t [new_buf_size];
+                    memcpy(tmp_ptr, sei_payload_buf_, sei_payload_size_); // save the existing payload
+                    delete [] sei_payload_buf_;
+                    sei_payload_buf_ = tmp_ptr;
+                    sei_payload_buf_size_ = new_buf_size;
+                }
+            } else {
+                // First payload, sei_payload_size_ is 0.
+                sei_payload_buf_size_ = payload_size > INIT_SEI_PAYLOAD_BUF_SIZE ? payload_size : INIT_SEI_PAYLOAD_BUF_SIZE;
+                sei_payload_buf_ = new uint8_t [sei_payload_buf_size_];
+            }
+            // Append the current payload to sei_payload_buf_. Its pointer is resolved in SetSeiMessageInfo() since the buffer
+            // can still be reallocated by the following payloads.
+            memcpy(sei_payload_buf_ + sei_payload_size_, nalu + offset, payload_size);
+            sei_message_payload_[sei_message_count_] = nullptr;
+            sei_payload_offset_[sei_message_count_] = sei_payload_size_;
+            sei_payload_size_ += payload_size;
         }
-        // Append the current payload to sei_payload_buf_
-        memcpy(sei_payload_buf_ + sei_payload_size_, nalu + offset, payload_size);
-
-        sei_payload_size_ += payload_size;
         sei_message_count_++;
 
         offset += payload_size;
     } while (offset < size && nalu[offset] != 0x80);
-}
\ No newline at end of file
+}
+
+void RocVideoParser::SetSeiMessageInfo(int pic_idx) {
+    for (int i = 0; i < sei_message_count_; i++) {
+        if (!sei_message_payload_[i]) {
+            sei_message_payload_[i] = sei_payload_buf_ + sei_payload_offset_[i];
+        }
+    }
+    sei_message_info_params_.sei_message_count = sei_message_count_;
+    sei_message_info_params_.sei_message = sei_message_list_.data();
+    // With a filter sei_payload_buf_ only holds the payloads that had to be unescaped
+    sei_message_info_params_.sei_data = sei_filter_enabled_ ? nullptr : (void*)sei_payload_buf_;
+    sei_message_info_params_.picIdx = pic_idx;
+    sei_message_info_params_.sei_message_payload = sei_message_payload_.data();
+}
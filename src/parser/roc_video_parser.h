@@ -21,11 +21,18 @@ THE SOFTWARE.
 */
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 #include "rocparser.h"
 #include "../commons.h"
+#include "bit_reader.h"
+#include "start_code_scanner.h"
+#include "emulation_prevention.h"
+#include "nal_unit_index.h"
+#include "param_set_cache.h"
+#include "access_unit_assembler.h"
 
 typedef enum ParserResult {
     PARSER_OK                                   = 0,
@@ -74,11 +81,11 @@ typedef struct {
 } Rational;
 
 #define ZEROBYTES_SHORTSTARTCODE 2 //indicates the number of zero bytes in the short start-code prefix
-#define RBSP_BUF_SIZE 1024  // enough to parse any parameter sets or slice headers
 #define INIT_SLICE_LIST_NUM 16 // initial slice/tile information/parameter struct list size
 #define INIT_SEI_MESSAGE_COUNT 16  // initial SEI message count
 #define INIT_SEI_PAYLOAD_BUF_SIZE 1024 * 1024  // initial SEI payload buffer size, 1 MB
 #define DECODE_BUF_POOL_EXTENSION 2
+#define MAX_DEC_BUF_POOL_SIZE 64 // maximum decode buffer pool size, one bit per buffer in a 64-bit mask
 
 #define CHECK_ALLOWED_RANGE(val, min, max) { \
     if (val < min || val > max) { \
@@ -95,12 +102,19 @@ typedef struct {
 }
 
 
+typedef enum ParamSetType {
+    kParamSetVps = 0,
+    kParamSetSps,
+    kParamSetPps,
+} ParamSetType;
+
 enum {
     kNotUsed = 0,
     kTopFieldUsedForDecode = 1,
     kBottomFieldUsedForDecode = 1 << 1,
     kFrameUsedForDecode = kTopFieldUsedForDecode | kBottomFieldUsedForDecode,
-    kFrameUsedForDisplay = 1 << 2
+    kFrameUsedForDisplay = 1 << 2,
+    kFrameUsedByApp = 1 << 3  // displayed but not yet released by the application (explicit_frame_release mode)
 } FrameBufUseStatus;
 
 /**
@@ -119,13 +133,42 @@ public:
     virtual rocDecStatus UnInitialize() = 0;     // pure virtual: implemented by derived class
     /**
      * @brief function to to release surface with pic_idx and mark it for reuse, can be called from a different thread than decode thread
-     * @brief calling thread is responsible for syncronizing
+     * @brief the release is handed over to the parser thread lock-free and takes effect on the next decode buffer allocation
      * \param [in] pic_idx surface index for the picture to be released
      * 
      * @return rocDecStatus 
      */
     virtual rocDecStatus MarkFrameForReuse(int pic_idx);
 
+    /*! \brief Function to get the parser statistics
+     * \param [out] stats Pointer to the statistics struct
+     * \return rocDecStatus
+     */
+    virtual rocDecStatus GetParserStats(RocdecParserStats *stats);
+
+    /*! \brief Function to reset the parser to the state after creation. The codec parsers flush or discard their DPB and
+     *  reset the POC/order hint state, then call this function to reset the common state.
+     * \param [in] flags Combination of <tt>RocdecParserResetFlags</tt>
+     * \return rocDecStatus
+     */
+    virtual rocDecStatus Reset(uint32_t flags);
+
+    /*! \brief Function to suppress the display of the pictures with a PTS less than the set one
+     * \param [in] pts Display start PTS
+     * \return rocDecStatus
+     */
+    rocDecStatus SetDisplayStartPts(RocdecTimeStamp pts);
+
+    /*! \brief Function to check if the packets are chunks of a byte stream, see <tt>byte_stream_input</tt>
+     */
+    bool IsByteStreamInput() { return parser_params_.byte_stream_input; };
+
+    /*! \brief Function to parse a chunk of a byte stream. The complete access units are passed on to <tt>ParseVideoData</tt>.
+     * \param [in] p_data Pointer to the packet holding the chunk
+     * \return rocDecStatus
+     */
+    rocDecStatus ParseByteStream(RocdecSourceDataPacket *p_data);
+
 protected:
     RocdecParserParams parser_params_ = {};
 
@@ -135,6 +178,7 @@ protected:
     PFNVIDDECODECALLBACK pfn_decode_picture_cb_;        /**< Called when a picture is ready to be decoded (decode order)         */
     PFNVIDDISPLAYCALLBACK pfn_display_picture_cb_;      /**< Called whenever a picture is ready to be displayed (display order)  */
     PFNVIDSEIMSGCALLBACK pfn_get_sei_message_cb_;       /**< Called when all SEI messages are parsed for particular frame        */
+    PFNVIDPARSEDPICCALLBACK pfn_parsed_picture_cb_;     /**< Called when a picture is parsed in header only mode                 */
 
     uint32_t pic_count_;  // decoded picture count for the current bitstream
     uint32_t pic_width_;
@@ -154,13 +198,23 @@ protected:
      * is used to retrieve the VA surface Id.
      */
     std::vector<DecodeFrameBuffer> decode_buffer_pool_;
+    uint64_t dec_buf_used_mask_;    // bit i is set if decode_buffer_pool_[i].use_status is not kNotUsed
     uint32_t num_output_pics_;  // number of pictures that are ready to be ouput
-    std::vector<uint32_t> output_pic_list_; // sorted output frame index to decode_buffer_pool_
+    uint32_t output_pic_head_;  // position of the first picture to output in output_pic_list_
+    std::vector<uint32_t> output_pic_list_; // sorted output frame index to decode_buffer_pool_, ring buffer of MAX_DEC_BUF_POOL_SIZE
+    std::atomic<uint64_t> released_frame_mask_;  // frames released by the application with MarkFrameForReuse, set from any thread
 
     RocdecTimeStamp curr_pts_;
     Rational frame_rate_;
+    bool pic_skipped_;  // the picture of the current packet is dropped without decode
+    uint64_t num_skipped_non_ref_pics_;
+    bool suppress_display_;  // pictures with a PTS less than display_start_pts_ are not displayed
+    RocdecTimeStamp display_start_pts_;
+    uint64_t num_suppressed_pics_;
 
     RocdecVideoFormat video_format_params_;
+    RocdecVideoFormat reported_video_format_;   // video format of the last sequence callback
+    bool video_format_reported_;
     RocdecSeiMessageInfo sei_message_info_params_;
     RocdecPicParams dec_pic_params_;
 
@@ -170,13 +224,15 @@ protected:
     int curr_byte_offset_;            // current parsing byte offset
 
     // NAL unit info
-    int start_code_num_;              // number of start codes found so far
     int curr_start_code_offset_;
-    int next_start_code_offset_;
     int nal_unit_size_;
+    Parser::ParameterSetCache param_set_cache_;  // raw payloads of the parsed parameter sets
+    Parser::AccessUnitAssembler au_assembler_;   // access unit assembly of byte stream input
+    std::vector<RocdecNalUnitInfo> nal_unit_index_;  // NAL unit index built by the parser when the packet does not carry one
+    const RocdecNalUnitInfo *nal_units_;             // NAL unit index of the current picture data
+    uint32_t num_nal_units_;
 
     int                 rbsp_size_;
-    uint8_t             rbsp_buf_[RBSP_BUF_SIZE]; // to store parameter set or slice header RBSP
 
     int                 num_slices_;
     uint8_t*            pic_stream_data_ptr_;
@@ -189,6 +245,24 @@ protected:
     uint8_t             *sei_payload_buf_;  // buffer to store SEI playload. Allocated at run time.
     uint32_t            sei_payload_buf_size_;
     uint32_t            sei_payload_size_;  // total SEI payload size of the current frame
+    std::vector<void *> sei_message_payload_;  // payload pointer of each message, nullptr if the payload is in sei_payload_buf_
+    std::vector<uint32_t> sei_payload_offset_;  // payload offset in sei_payload_buf_ of each message
+    bool                sei_filter_enabled_;
+    RocdecSeiFilter     sei_filter_;  // SEI payload types to deliver when sei_filter_enabled_ is set
+
+    /*! \brief Function to call the sequence callback with video_format_params_. The callback is skipped if the format is the
+     *  same as the last reported one in all properties that need a decoder (re)configuration: codec, coded size, display area,
+     *  chroma format, bit depth and number of decode surfaces.
+     * \return <tt>ParserResult</tt>
+     */
+    ParserResult ReportVideoFormat();
+
+    /*! \brief Function to output the record of a parsed picture in header only mode. The fields common to all codecs are
+     *  filled from <tt>dec_pic_params_</tt>, the codec specific ones are set by the caller.
+     * \param [in,out] pic_info Pointer to the picture record with pic_type, pic_order_cnt, qp, ref_pic_flag and key_frame_flag set
+     * \return <tt>ParserResult</tt>
+     */
+    ParserResult OutputParsedPicture(RocdecParsedPicInfo *pic_info);
 
     /*! \brief Function to check the initially set (by decoder) decode buffer pool size and adjust if needed
      *  \param dpb_size The DPB buffer size of the current sequence
@@ -201,94 +275,117 @@ protected:
      */
     ParserResult OutputDecodedPictures(bool no_delay);
 
-    /*! \brief Function to get the NAL Unit data
-     * \return Returns OK if successful, else error code
+    /*! \brief Function to pass the access units of the byte stream assembler on to <tt>ParseVideoData</tt>
+     * \param [in] end_of_au Set to true if the buffered data ends an access unit, so that the last one is parsed as well
+     * \return rocDecStatus
      */
-    ParserResult GetNalUnit();
+    rocDecStatus ParseAccessUnits(bool end_of_au);
 
-    /*! \brief Function to convert from Encapsulated Byte Sequence Packets to Raw Byte Sequence Payload
-     * 
-     * \param [inout] stream_buffer A pointer of <tt>uint8_t</tt> for the converted RBSP buffer.
-     * \param [in] begin_bytepos Start position in the EBSP buffer to convert
-     * \param [in] end_bytepos End position in the EBSP buffer to convert, generally it's size.
-     * \return Returns the size of the converted buffer in <tt>size_t</tt>
+    /*! \brief Function to set up the NAL unit index of the packet payload. The index supplied with the packet is used
+     *  if it is valid, otherwise the payload is scanned once to build it.
+     * \param [in] p_data Pointer to the source data packet
+     * \param [in] codec_type Codec of the parser, <tt>rocDecVideoCodec_AVC</tt> or <tt>rocDecVideoCodec_HEVC</tt>
+     */
+    void IndexNalUnits(const RocdecSourceDataPacket *p_data, rocDecVideoCodec codec_type);
+
+    /*! \brief Function to parse the SEI messages of an SEI NAL unit. When an SEI filter is set and the NAL unit has no emulation
+     *  prevention bytes, the messages are parsed in place and the subscribed payloads are referenced in the packet. Otherwise
+     *  the NAL unit is converted to RBSP first and the payloads are copied.
+     * \param [in] sei_ebsp Pointer to the SEI NAL unit payload following the NAL unit header
+     * \param [in] sei_ebsp_size Size of the NAL unit payload in bytes
      */
-    size_t EbspToRbsp(uint8_t *stream_buffer, size_t begin_bytepos, size_t end_bytepos);
+    void ParseSeiNalUnit(uint8_t *sei_ebsp, int sei_ebsp_size);
 
     /*! \brief Function to parse Sei Message Info
      * \param [in] nalu A pointer of <tt>uint8_t</tt> for the input stream to be parsed
      * \param [in] size Size of the input stream
+     * \param [in] in_place Indicator that the input stream is the packet: the payloads are referenced instead of copied
      * \return No return value
      */
-    void ParseSeiMessage(uint8_t *nalu, size_t size);
+    void ParseSeiMessage(uint8_t *nalu, size_t size, bool in_place);
+
+    /*! \brief Function to fill <tt>sei_message_info_params_</tt> with the SEI messages of the current picture
+     * \param [in] pic_idx Decode buffer index of the current picture
+     */
+    void SetSeiMessageInfo(int pic_idx);
+
+    /*! \brief Function to check if a picture of the given PTS is a pre-roll picture, whose display is suppressed
+     * \param [in] pts PTS of the picture
+     * \return true if the picture is not displayed
+     */
+    bool IsPreRollPic(RocdecTimeStamp pts) { return suppress_display_ && pts < display_start_pts_; }
+
+    /*! \brief Function to check if the non-reference pictures of the current packet are dropped without decode: with
+     *  <tt>skip_non_ref_pics</tt> or as pre-roll pictures
+     * \return true if the non-reference pictures are dropped
+     */
+    bool IsNonRefPicDropped() { return parser_params_.skip_non_ref_pics || IsPreRollPic(curr_pts_); }
+
+    /*! \brief Function to count a non-reference picture dropped by <tt>IsNonRefPicDropped</tt>
+     */
+    void CountDroppedNonRefPic() {
+        if (parser_params_.skip_non_ref_pics) {
+            num_skipped_non_ref_pics_++;
+        } else {
+            num_suppressed_pics_++;
+        }
+    }
 
     /*! \brief Function to initialize the decoded buffer pool
      */
     void InitDecBufPool();
-};
 
-// helpers
-namespace Parser {
-    inline char GetLowByte(uint16_t data) {
-        return (data >> 8);
-    }
+    /*! \brief Function to return the frames released with <tt>MarkFrameForReuse</tt> to the decode buffer pool
+     */
+    void ReclaimReleasedFrames();
 
-    inline char GetHiByte(uint16_t data) {
-        return (data & 0xFF);
-    }
+    /*! \brief Function to find the free buffer with the lowest index in the decode buffer pool
+     * \return Index of the buffer. -1 if all buffers are in use.
+     */
+    int GetFreeDecBufIndex();
 
-    inline bool GetBit(const uint8_t *data, size_t &bit_idx) {
-        bool ret = (data[bit_idx / 8] >> (7 - bit_idx % 8) & 1);
-        bit_idx++;
-        return ret;
-    }
-    inline uint32_t GetBitToUint32(const uint8_t *data, size_t &bit_idx) {
-        uint32_t ret = (data[bit_idx / 8] >> (7 - bit_idx % 8) & 1);
-        bit_idx++;
-        return ret;
+    /*! \brief Function to set use status flags of a buffer in the decode buffer pool
+     * \param [in] dec_buf_idx Index of the buffer
+     * \param [in] flags Flags of <tt>FrameBufUseStatus</tt> to set
+     */
+    void SetDecBufUseStatus(int dec_buf_idx, uint32_t flags) {
+        decode_buffer_pool_[dec_buf_idx].use_status |= flags;
+        dec_buf_used_mask_ |= 1ULL << dec_buf_idx;
     }
 
-    inline uint32_t ReadBits(const uint8_t *data, size_t &start_bit_idx, size_t bits_to_read) {
-        if (bits_to_read > 32) {
-            return 0; // assert(0);
-        }
-        uint32_t result = 0;
-        for (size_t i = 0; i < bits_to_read; i++) {
-            result = result << 1;
-            result |= GetBitToUint32(data, start_bit_idx); // start_bit_idx incremented inside
+    /*! \brief Function to clear use status flags of a buffer in the decode buffer pool. The buffer is free when no flag is left.
+     * \param [in] dec_buf_idx Index of the buffer
+     * \param [in] flags Flags of <tt>FrameBufUseStatus</tt> to clear
+     */
+    void ClearDecBufUseStatus(int dec_buf_idx, uint32_t flags) {
+        decode_buffer_pool_[dec_buf_idx].use_status &= ~flags;
+        if (decode_buffer_pool_[dec_buf_idx].use_status == kNotUsed) {
+            dec_buf_used_mask_ &= ~(1ULL << dec_buf_idx);
         }
-        return result;
     }
 
-    inline size_t CountContiniusZeroBits(const uint8_t *data, size_t &start_bit_idx) {
-        size_t start_bit_idx_org = start_bit_idx;
-        while (GetBit(data, start_bit_idx) == false) {} // start_bit_idx incremented inside
-        start_bit_idx--; // remove non zero
-        return start_bit_idx - start_bit_idx_org;
+    /*! \brief Function to append a picture to the output/display list
+     * \param [in] dec_buf_idx Index of the picture in the decode buffer pool
+     */
+    void AddOutputPicture(uint32_t dec_buf_idx) {
+        output_pic_list_[(output_pic_head_ + num_output_pics_) & (MAX_DEC_BUF_POOL_SIZE - 1)] = dec_buf_idx;
+        num_output_pics_++;
     }
 
-    namespace ExpGolomb {
-        inline uint32_t ReadUe(const uint8_t *data, size_t &start_bit_idx) {
-            size_t zero_bits_count = CountContiniusZeroBits(data, start_bit_idx); // start_bit_idx incremented inside
-            if (zero_bits_count > 30) {
-                return 0; // assert(0)
-            }
-
-            uint32_t value = (0x1 << zero_bits_count) - 1;
-            start_bit_idx++;
-            value += ReadBits(data, start_bit_idx, zero_bits_count);
-            return value;
-        }
-        inline uint32_t ReadSe(const uint8_t *data, size_t &start_bit_idx) {
-            uint32_t ue = ReadUe(data, start_bit_idx);
-            // se From Ue 
-            uint32_t mod2 = ue % 2;
-            uint32_t r = ue / 2 + mod2;
-
-            if (mod2 == 0) {
-                return r * -1;
-            }
-            return r;
-        }
+    /*! \brief Function to get a picture from the output/display list
+     * \param [in] i Position in the list, 0 is the next picture to output
+     * \return Index of the picture in the decode buffer pool
+     */
+    uint32_t GetOutputPicture(uint32_t i) { return output_pic_list_[(output_pic_head_ + i) & (MAX_DEC_BUF_POOL_SIZE - 1)]; }
+};
+
+// helpers
+namespace Parser {
+    inline char GetLowByte(uint16_t data) {
+        return (data >> 8);
+    }
+
+    inline char GetHiByte(uint16_t data) {
+        return (data & 0xFF);
     }
 }
\ No newline at end of file
@@ -106,6 +106,75 @@ rocDecParserMarkFrameForReuse(RocdecVideoParser parser_handle, int pic_idx) {
 
 }
 
+/************************************************************************************************/
+//! \ingroup group_rocparser
+//! \fn rocDecStatus ROCDECAPI rocDecGetParserStats(RocdecVideoParser parser_handle, RocdecParserStats *stats)
+//! Get the statistics of the video parser object
+/************************************************************************************************/
+rocDecStatus ROCDECAPI
+rocDecGetParserStats(RocdecVideoParser parser_handle, RocdecParserStats *stats) {
+    if (parser_handle == nullptr || stats == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_parser_handle = static_cast<RocParserHandle *>(parser_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_parser_handle->GetParserStats(stats);
+    }
+    catch(const std::exception& e) {
+        roc_parser_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+/************************************************************************************************/
+//! \ingroup group_rocparser
+//! \fn rocDecStatus ROCDECAPI rocDecParserReset(RocdecVideoParser parser_handle, uint32_t flags)
+//! Reset the video parser object to the state after creation
+/************************************************************************************************/
+rocDecStatus ROCDECAPI
+rocDecParserReset(RocdecVideoParser parser_handle, uint32_t flags) {
+    if (parser_handle == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_parser_handle = static_cast<RocParserHandle *>(parser_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_parser_handle->Reset(flags);
+    }
+    catch(const std::exception& e) {
+        roc_parser_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
+/************************************************************************************************/
+//! \ingroup group_rocparser
+//! \fn rocDecStatus ROCDECAPI rocDecParserSetDisplayStartPts(RocdecVideoParser parser_handle, RocdecTimeStamp pts)
+//! Suppress the display of the pictures before the set PTS
+/************************************************************************************************/
+rocDecStatus ROCDECAPI
+rocDecParserSetDisplayStartPts(RocdecVideoParser parser_handle, RocdecTimeStamp pts) {
+    if (parser_handle == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    auto roc_parser_handle = static_cast<RocParserHandle *>(parser_handle);
+    rocDecStatus ret;
+    try {
+        ret = roc_parser_handle->SetDisplayStartPts(pts);
+    }
+    catch(const std::exception& e) {
+        roc_parser_handle->CaptureError(e.what());
+        ERR(e.what())
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    return ret;
+}
+
 /************************************************************************************************/
 //! \ingroup FUNCTS
 //! \fn rocDecStatus ROCDECAPI rocDecDestroyVideoParser(RocdecVideoParser parser_handle)
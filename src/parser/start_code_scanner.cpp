@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "start_code_scanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define START_CODE_SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Parser {
+
+/* All scanners look for the three byte pattern 00 00 <third_byte> and return the offset of its first byte. */
+template <uint8_t third_byte>
+static size_t ScanPatternScalar(const uint8_t *data, size_t size) {
+    size_t i = 0;
+    while (i + 2 < size) {
+        if (data[i + 2] == third_byte) {
+            if (data[i] == 0 && data[i + 1] == 0) {
+                return i;
+            }
+            // The pattern can not begin at i + 1 or i + 2 since data[i + 2] is not 0
+            i += 3;
+        } else if (data[i + 2] != 0) {
+            // No pattern can begin at i, i + 1 or i + 2
+            i += 3;
+        } else {
+            i++;
+        }
+    }
+    return size;
+}
+
+#ifdef START_CODE_SCANNER_X86
+/* Each lane k of a block at offset i is a match when data[i + k] == 0, data[i + k + 1] == 0 and data[i + k + 2] == third_byte.
+ * The three conditions are evaluated on three overlapping unaligned loads.
+ */
+template <uint8_t third_byte>
+static size_t ScanPatternSse2(const uint8_t *data, size_t size) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i third = _mm_set1_epi8(third_byte);
+    size_t i = 0;
+    for (; i + 18 <= size; i += 16) {
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 1));
+        __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 2));
+        __m128i match = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(b0, zero), _mm_cmpeq_epi8(b1, zero)), _mm_cmpeq_epi8(b2, third));
+        uint32_t mask = _mm_movemask_epi8(match);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScanPatternScalar<third_byte>(data + i, size - i);
+}
+
+template <uint8_t third_byte>
+__attribute__((target("avx2")))
+static size_t ScanPatternAvx2(const uint8_t *data, size_t size) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i third = _mm256_set1_epi8(third_byte);
+    size_t i = 0;
+    for (; i + 34 <= size; i += 32) {
+        __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 1));
+        __m256i b2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 2));
+        __m256i match = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(b0, zero), _mm256_cmpeq_epi8(b1, zero)), _mm256_cmpeq_epi8(b2, third));
+        uint32_t mask = _mm256_movemask_epi8(match);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScanPatternScalar<third_byte>(data + i, size - i);
+}
+#endif
+
+typedef size_t (*ScanPatternFunc)(const uint8_t *data, size_t size);
+
+template <uint8_t third_byte>
+static ScanPatternFunc SelectScanPattern() {
+#ifdef START_CODE_SCANNER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return ScanPatternAvx2<third_byte>;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return ScanPatternSse2<third_byte>;
+    }
+#endif
+    return ScanPatternScalar<third_byte>;
+}
+
+size_t ScanStartCode(const uint8_t *data, size_t size) {
+    static const ScanPatternFunc scan_func = SelectScanPattern<0x01>();
+    return scan_func(data, size);
+}
+
+size_t ScanStartCodeScalar(const uint8_t *data, size_t size) {
+    return ScanPatternScalar<0x01>(data, size);
+}
+
+size_t ScanEmulationPrevention(const uint8_t *data, size_t size) {
+    static const ScanPatternFunc scan_func = SelectScanPattern<0x03>();
+    return scan_func(data, size);
+}
+
+}
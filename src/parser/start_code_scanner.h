@@ -0,0 +1,48 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Parser {
+    /*! \brief Function to find the first Annex B start code prefix (0x000001) in a buffer
+     *
+     * The search uses AVX2 or SSE2 when the CPU supports it and a scalar skip search otherwise. The implementation is
+     * selected once on first use.
+     * \param [in] data Pointer to the buffer
+     * \param [in] size Size of the buffer in bytes
+     * \return Byte offset of the first 0x00 of the start code. <tt>size</tt> if no start code is found.
+     */
+    size_t ScanStartCode(const uint8_t *data, size_t size);
+
+    /*! \brief Scalar version of <tt>ScanStartCode</tt>, also used for the tail of the SIMD versions
+     */
+    size_t ScanStartCodeScalar(const uint8_t *data, size_t size);
+
+    /*! \brief Function to find the first emulation prevention sequence (0x000003) in a buffer
+     * \param [in] data Pointer to the buffer
+     * \param [in] size Size of the buffer in bytes
+     * \return Byte offset of the first 0x00 of the sequence. <tt>size</tt> if none is found.
+     */
+    size_t ScanEmulationPrevention(const uint8_t *data, size_t size);
+}
@@ -60,7 +60,26 @@ rocDecStatus Vp9VideoParser::UnInitialize() {
     return ROCDEC_SUCCESS;
 }
 
+rocDecStatus Vp9VideoParser::Reset(uint32_t flags) {
+    if ((flags & ROCDEC_PARSER_RESET_FLUSH) && FlushDpb() != PARSER_OK) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
+    // The reference frame slots are refilled by the next key frame
+    InitDpb();
+    memset(&curr_pic_, 0, sizeof(Vp9Picture));
+    memset(&uncompressed_header_, 0, sizeof(Vp9UncompressedHeader));
+    memset(&tile_params_, 0, sizeof(RocdecVp9SliceParams));
+    memset(y_dequant_, 0, sizeof(y_dequant_));
+    memset(uv_dequant_, 0, sizeof(uv_dequant_));
+    memset(lvl_lookup_, 0, sizeof(lvl_lookup_));
+    return RocVideoParser::Reset(flags);
+}
+
 rocDecStatus Vp9VideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) { 
+    // A discontinuity, e.g. after a splice or a seek: output the pending pictures, then drop the reference state
+    if ((p_data->flags & ROCDEC_PKT_DISCONTINUITY) && Reset(ROCDEC_PARSER_RESET_FLUSH | ROCDEC_PARSER_RESET_KEEP_PARAM_SETS) != ROCDEC_SUCCESS) {
+        return ROCDEC_RUNTIME_ERROR;
+    }
     if (p_data->payload && p_data->payload_size) {
         curr_pts_ = p_data->pts;
         if (ParsePictureData(p_data->payload, p_data->payload_size) != PARSER_OK) {
@@ -86,6 +105,11 @@ ParserResult Vp9VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
 
     uint8_t *pic_data_ptr = const_cast<uint8_t*>(p_stream);
     for (int frame_index = 0; frame_index < num_frames_in_chunck_; frame_index++) {
+        // Keyframe only: drop the other frames without parsing their headers
+        if (parser_params_.keyframe_only && !IsKeyFrame(pic_data_ptr, frame_sizes_[frame_index])) {
+            pic_data_ptr += frame_sizes_[frame_index];
+            continue;
+        }
         if ((ret = ParseUncompressedHeader(pic_data_ptr, frame_sizes_[frame_index])) != PARSER_OK) {
             return ret;
         }
@@ -108,20 +132,27 @@ ParserResult Vp9VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
             }
             if (pfn_display_picture_cb_) {
                 disp_idx = dpb_buffer_.frame_store[disp_idx].dec_buf_idx;
-                decode_buffer_pool_[disp_idx].use_status |= kFrameUsedForDisplay;
+                SetDecBufUseStatus(disp_idx, kFrameUsedForDisplay);
                 decode_buffer_pool_[disp_idx].pts = curr_pts_;
                 // Insert into output/display picture list
                 if (num_output_pics_ < dec_buf_pool_size_) {
-                    output_pic_list_[num_output_pics_] = disp_idx;
-                    num_output_pics_++;
+                    AddOutputPicture(disp_idx);
                 } else {
                     ERR("Display list size larger than decode buffer pool size!");
                     return PARSER_OUT_OF_RANGE;
                 }
+                // Shown frames are in output order: no need to wait for the next decoded frame
+                if (parser_params_.zero_reorder_output && (ret = OutputDecodedPictures(true)) != PARSER_OK) {
+                    return ret;
+                }
             }
     #if DBGINFO
             PrintDpb();
     #endif // DBGINFO
+        } else if (IsNonRefPicDropped() && !uncompressed_header_.refresh_frame_flags && !uncompressed_header_.refresh_frame_context &&
+                   !uncompressed_header_.error_resilient_mode && !uncompressed_header_.intra_only) {
+            // The frame updates neither a reference frame nor a probability context: drop it
+            CountDroppedNonRefPic();
         } else {
             pic_stream_data_ptr_ = pic_data_ptr;
             pic_stream_data_size_ = frame_sizes_[frame_index];
@@ -142,7 +173,7 @@ ParserResult Vp9VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
     #endif // DBGINFO
             // Output decoded pictures from DPB if any are ready
             if (pfn_display_picture_cb_ && num_output_pics_ > 0) {
-                if ((ret = OutputDecodedPictures(false)) != PARSER_OK) {
+                if ((ret = OutputDecodedPictures(parser_params_.zero_reorder_output)) != PARSER_OK) {
                     return ret;
                 }
             }
@@ -150,6 +181,10 @@ ParserResult Vp9VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
             pic_count_++;
             dpb_buffer_.dec_ref_count[curr_pic_.pic_idx]--;
             CheckAndUpdateDecStatus();
+            // Keyframe only: output the frame right away
+            if (parser_params_.keyframe_only && (ret = FlushDpb()) != PARSER_OK) {
+                return ret;
+            }
         }
         pic_data_ptr += frame_sizes_[frame_index];
     }
@@ -234,14 +269,7 @@ ParserResult Vp9VideoParser::NotifyNewSequence(Vp9UncompressedHeader *p_uncomp_h
     video_format_params_.seqhdr_data_length = 0;
 
     // callback function with RocdecVideoFormat params filled out
-    if (pfn_sequece_cb_(parser_params_.user_data, &video_format_params_) == 0) {
-        ERR("Sequence callback function failed.");
-        return PARSER_FAIL;
-    } else {
-        return PARSER_OK;
-    }
-    
-    return PARSER_OK;
+    return ReportVideoFormat();
 }
 
 ParserResult Vp9VideoParser::SendPicForDecode() {
@@ -262,6 +290,16 @@ ParserResult Vp9VideoParser::SendPicForDecode() {
     dec_pic_params_.ref_pic_flag = 1;
     dec_pic_params_.intra_pic_flag = frame_is_intra_;
 
+    if (parser_params_.header_only) {
+        RocdecParsedPicInfo pic_info = {};
+        pic_info.pic_type = frame_is_intra_ ? ROCDEC_PIC_TYPE_I : ROCDEC_PIC_TYPE_P;
+        pic_info.pic_order_cnt = pic_count_;
+        pic_info.qp = p_uncomp_header->quantization_params.base_q_idx;
+        pic_info.ref_pic_flag = p_uncomp_header->refresh_frame_flags ? 1 : 0;
+        pic_info.key_frame_flag = p_uncomp_header->frame_type == kVp9KeyFrame ? 1 : 0;
+        return OutputParsedPicture(&pic_info);
+    }
+
     // Set up the picture parameter buffer
     RocdecVp9PicParams *p_pic_param = &dec_pic_params_.pic_params.vp9;
     p_pic_param->frame_width = pic_width_;
@@ -381,17 +419,13 @@ ParserResult Vp9VideoParser::FlushDpb() {
 ParserResult Vp9VideoParser::FindFreeInDecBufPool() {
     int dec_buf_index;
     // Find a free buffer in decode/display buffer pool to store the decoded image
-    for (dec_buf_index = 0; dec_buf_index < dec_buf_pool_size_; dec_buf_index++) {
-        if (decode_buffer_pool_[dec_buf_index].use_status == kNotUsed) {
-            break;
-        }
-    }
-    if (dec_buf_index == dec_buf_pool_size_) {
+    dec_buf_index = GetFreeDecBufIndex();
+    if (dec_buf_index < 0) {
         ERR("Could not find a free buffer in decode buffer pool for decoded image.");
         return PARSER_NOT_FOUND;
     }
     curr_pic_.dec_buf_idx = dec_buf_index;
-    decode_buffer_pool_[dec_buf_index].use_status |= kFrameUsedForDecode;
+    SetDecBufUseStatus(dec_buf_index, kFrameUsedForDecode);
     decode_buffer_pool_[dec_buf_index].pts = curr_pts_;
     return PARSER_OK;
 }
@@ -414,12 +448,11 @@ ParserResult Vp9VideoParser::FindFreeInDpbAndMark() {
     // Mark as used in decode/display buffer pool
     if (pfn_display_picture_cb_ && uncompressed_header_.show_frame) {
         int disp_idx = curr_pic_.dec_buf_idx;
-        decode_buffer_pool_[disp_idx].use_status |= kFrameUsedForDisplay;
+        SetDecBufUseStatus(disp_idx, kFrameUsedForDisplay);
         decode_buffer_pool_[disp_idx].pts = curr_pts_;
         // Insert into output/display picture list
         if (num_output_pics_ < dec_buf_pool_size_) {
-            output_pic_list_[num_output_pics_] = disp_idx;
-            num_output_pics_++;
+            AddOutputPicture(disp_idx);
         } else {
             ERR("Display list size larger than decode buffer pool size!");
             return PARSER_OUT_OF_RANGE;
@@ -432,69 +465,83 @@ void Vp9VideoParser::CheckAndUpdateDecStatus() {
     for (int i = 0; i < VP9_BUFFER_POOL_MAX_SIZE; i++) {
         if (dpb_buffer_.frame_store[i].use_status != kNotUsed && dpb_buffer_.dec_ref_count[i] == 0) {
             dpb_buffer_.frame_store[i].use_status = kNotUsed;
-            decode_buffer_pool_[dpb_buffer_.frame_store[i].dec_buf_idx].use_status &= ~kFrameUsedForDecode;
+            ClearDecBufUseStatus(dpb_buffer_.frame_store[i].dec_buf_idx, kFrameUsedForDecode);
         }
     }
 }
 
+bool Vp9VideoParser::IsKeyFrame(const uint8_t *p_stream, size_t size) {
+    Parser::BitReader bit_reader(p_stream, size);
+    bit_reader.SkipBits(2); // frame_marker
+    uint32_t profile = bit_reader.GetBit();
+    profile |= bit_reader.GetBit() << 1;
+    if (profile == 3) {
+        bit_reader.SkipBits(1); // reserved_zero
+    }
+    if (bit_reader.GetBit()) {
+        return false; // show_existing_frame
+    }
+    return bit_reader.GetBit() == kVp9KeyFrame;
+}
+
 ParserResult Vp9VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t size) {
     ParserResult ret = PARSER_OK;
-    size_t offset = 0;  // current bit offset
+    Parser::BitReader bit_reader(p_stream, size);
     Vp9UncompressedHeader *p_uncomp_header = &uncompressed_header_;
 
     // memset(p_uncomp_header, 0, sizeof(Vp9UncompressedHeader));
-    p_uncomp_header->frame_marker = Parser::ReadBits(p_stream, offset, 2);
-    p_uncomp_header->profile_low_bit = Parser::GetBit(p_stream, offset);
-    p_uncomp_header->profile_high_bit = Parser::GetBit(p_stream, offset);
+    p_uncomp_header->frame_marker = bit_reader.ReadBits(2);
+    p_uncomp_header->profile_low_bit = bit_reader.GetBit();
+    p_uncomp_header->profile_high_bit = bit_reader.GetBit();
     p_uncomp_header->profile = (p_uncomp_header->profile_high_bit << 1) + p_uncomp_header->profile_low_bit;
     if (p_uncomp_header->profile == 3) {
-        p_uncomp_header->reserved_zero = Parser::GetBit(p_stream, offset);
+        p_uncomp_header->reserved_zero = bit_reader.GetBit();
         if (p_uncomp_header->reserved_zero) {
             ERR("Syntax error: reserved_zero in Uncompressed header is not 0 when Profile is 3");
             return PARSER_INVALID_ARG;
         }
     }
-    p_uncomp_header->show_existing_frame = Parser::GetBit(p_stream, offset);
+    p_uncomp_header->show_existing_frame = bit_reader.GetBit();
     if (p_uncomp_header->show_existing_frame) {
-        p_uncomp_header->frame_to_show_map_idx = Parser::ReadBits(p_stream, offset, 3);
+        p_uncomp_header->frame_to_show_map_idx = bit_reader.ReadBits(3);
         p_uncomp_header->header_size_in_bytes = 0;
         p_uncomp_header->refresh_frame_flags = 0;
         p_uncomp_header->loop_filter_params.loop_filter_level = 0;
         return PARSER_OK;
     }
     last_frame_type_ = p_uncomp_header->frame_type;
-    p_uncomp_header->frame_type = Parser::GetBit(p_stream, offset);
-    p_uncomp_header->show_frame = Parser::GetBit(p_stream, offset);
-    p_uncomp_header->error_resilient_mode = Parser::GetBit(p_stream, offset);
+    p_uncomp_header->frame_type = bit_reader.GetBit();
+    p_uncomp_header->show_frame = bit_reader.GetBit();
+    p_uncomp_header->error_resilient_mode = bit_reader.GetBit();
     if (p_uncomp_header->frame_type == kVp9KeyFrame) {
-        if ((ret = FrameSyncCode(p_stream, offset, p_uncomp_header)) != PARSER_OK) {
+        if ((ret = FrameSyncCode(bit_reader, p_uncomp_header)) != PARSER_OK) {
             return ret;
         }
-        if ((ret = ColorConfig(p_stream, offset, p_uncomp_header)) != PARSER_OK) {
+        if ((ret = ColorConfig(bit_reader, p_uncomp_header)) != PARSER_OK) {
             return ret;
         }
-        FrameSize(p_stream, offset, p_uncomp_header);
-        RenderSize(p_stream, offset, p_uncomp_header);
+        FrameSize(bit_reader, p_uncomp_header);
+        RenderSize(bit_reader, p_uncomp_header);
         p_uncomp_header->refresh_frame_flags = 0xFF;
         frame_is_intra_ = 1;
     } else {
         if (p_uncomp_header->show_frame == 0) {
-            p_uncomp_header->intra_only = Parser::GetBit(p_stream, offset);
+            p_uncomp_header->intra_only = bit_reader.GetBit();
         } else {
             p_uncomp_header->intra_only = 0;
         }
         frame_is_intra_ = p_uncomp_header->intra_only;
         if (p_uncomp_header->error_resilient_mode == 0) {
-            p_uncomp_header->reset_frame_context = Parser::ReadBits(p_stream, offset, 2);
+            p_uncomp_header->reset_frame_context = bit_reader.ReadBits(2);
         } else {
             p_uncomp_header->reset_frame_context = 0;
         }
         if (p_uncomp_header->intra_only == 1) {
-            if ((ret = FrameSyncCode(p_stream, offset, p_uncomp_header)) != PARSER_OK) {
+            if ((ret = FrameSyncCode(bit_reader, p_uncomp_header)) != PARSER_OK) {
                 return ret;
             }
             if (p_uncomp_header->profile > 0) {
-                if ((ret = ColorConfig(p_stream, offset, p_uncomp_header)) != PARSER_OK) {
+                if ((ret = ColorConfig(bit_reader, p_uncomp_header)) != PARSER_OK) {
                     return ret;
                 }                
             } else {
@@ -503,36 +550,36 @@ ParserResult Vp9VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
                 p_uncomp_header->color_config.subsampling_y = 1;
                 p_uncomp_header->color_config.bit_depth = 8;
             }
-            p_uncomp_header->refresh_frame_flags = Parser::ReadBits(p_stream, offset, 8);
-            FrameSize(p_stream, offset, p_uncomp_header);
-            RenderSize(p_stream, offset, p_uncomp_header);
+            p_uncomp_header->refresh_frame_flags = bit_reader.ReadBits(8);
+            FrameSize(bit_reader, p_uncomp_header);
+            RenderSize(bit_reader, p_uncomp_header);
         } else {
-            p_uncomp_header->refresh_frame_flags = Parser::ReadBits(p_stream, offset, 8);
+            p_uncomp_header->refresh_frame_flags = bit_reader.ReadBits(8);
             for (int i = 0; i < VP9_REFS_PER_FRAME; i++) {
-                p_uncomp_header->ref_frame_idx[i] = Parser::ReadBits(p_stream, offset, 3);
-                p_uncomp_header->ref_frame_sign_bias[kVp9LastFrame + i] = Parser::GetBit(p_stream, offset);
+                p_uncomp_header->ref_frame_idx[i] = bit_reader.ReadBits(3);
+                p_uncomp_header->ref_frame_sign_bias[kVp9LastFrame + i] = bit_reader.GetBit();
             }
-            FrameSizeWithRefs(p_stream, offset, p_uncomp_header);
-            p_uncomp_header->allow_high_precision_mv = Parser::GetBit(p_stream, offset);
+            FrameSizeWithRefs(bit_reader, p_uncomp_header);
+            p_uncomp_header->allow_high_precision_mv = bit_reader.GetBit();
             // read_interpolation_filter()
             uint8_t literal_to_type[4] = {kVp9EightTapSmooth, kVp9EightTap, kVp9EightTapSharp, kVp9Bilinear};
-            p_uncomp_header->is_filter_switchable = Parser::GetBit(p_stream, offset);
+            p_uncomp_header->is_filter_switchable = bit_reader.GetBit();
             if (p_uncomp_header->is_filter_switchable) {
                 p_uncomp_header->interpolation_filter = kVp9Switchable;
             } else {
-                p_uncomp_header->raw_interpolation_filter = Parser::ReadBits(p_stream, offset, 2);
+                p_uncomp_header->raw_interpolation_filter = bit_reader.ReadBits(2);
                 p_uncomp_header->interpolation_filter = literal_to_type[p_uncomp_header->raw_interpolation_filter];
             }
         }
     }
     if (p_uncomp_header->error_resilient_mode == 0) {
-        p_uncomp_header->refresh_frame_context = Parser::GetBit(p_stream, offset);
-        p_uncomp_header->frame_parallel_decoding_mode = Parser::GetBit(p_stream, offset);
+        p_uncomp_header->refresh_frame_context = bit_reader.GetBit();
+        p_uncomp_header->frame_parallel_decoding_mode = bit_reader.GetBit();
     } else {
         p_uncomp_header->refresh_frame_context = 0;
         p_uncomp_header->frame_parallel_decoding_mode = 1;
     }
-    p_uncomp_header->frame_context_idx = Parser::ReadBits(p_stream, offset, 2);
+    p_uncomp_header->frame_context_idx = bit_reader.ReadBits(2);
     if (frame_is_intra_ || p_uncomp_header->error_resilient_mode) {
         SetupPastIndependence(p_uncomp_header);
         if (p_uncomp_header->frame_type == kVp9KeyFrame || p_uncomp_header->error_resilient_mode == 1 || p_uncomp_header->reset_frame_context == 3) {
@@ -544,14 +591,14 @@ ParserResult Vp9VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
         }
         p_uncomp_header->frame_context_idx = 0;
     }
-    LoopFilterParams(p_stream, offset, p_uncomp_header);
-    QuantizationParams(p_stream, offset, p_uncomp_header);
-    SegmentationParams(p_stream, offset, p_uncomp_header);
+    LoopFilterParams(bit_reader, p_uncomp_header);
+    QuantizationParams(bit_reader, p_uncomp_header);
+    SegmentationParams(bit_reader, p_uncomp_header);
     SetupSegDequant(p_uncomp_header);
     LoopFilterFrameInit(p_uncomp_header);
-    TileInfo(p_stream, offset, p_uncomp_header);
+    TileInfo(bit_reader, p_uncomp_header);
 
-    p_uncomp_header->header_size_in_bytes = Parser::ReadBits(p_stream, offset, 16);
+    p_uncomp_header->header_size_in_bytes = bit_reader.ReadBits(16);
 
     // Arbitrary size change is only supported on key frames. For other frame types, particularly inter-coded frames, only size down is
     // supported where the existing surface can be re-used.
@@ -574,22 +621,22 @@ ParserResult Vp9VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
         }
         new_seq_activated_ = true;
     }
-    uncomp_header_size_ = (offset + 7) >> 3;
+    uncomp_header_size_ = (bit_reader.GetBitOffset() + 7) >> 3;
     return PARSER_OK;
 }
 
-ParserResult Vp9VideoParser::FrameSyncCode(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
-    p_uncomp_header->frame_sync_code.frame_sync_byte_0 = Parser::ReadBits(p_stream, offset, 8);
+ParserResult Vp9VideoParser::FrameSyncCode(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
+    p_uncomp_header->frame_sync_code.frame_sync_byte_0 = bit_reader.ReadBits(8);
     if (p_uncomp_header->frame_sync_code.frame_sync_byte_0 != 0x49) {
         ERR("Syntax error: frame_sync_byte_0 is " + TOSTR(p_uncomp_header->frame_sync_code.frame_sync_byte_0) + " but shall be equal to 0x49.");
         return PARSER_INVALID_ARG;
     }
-    p_uncomp_header->frame_sync_code.frame_sync_byte_1 = Parser::ReadBits(p_stream, offset, 8);
+    p_uncomp_header->frame_sync_code.frame_sync_byte_1 = bit_reader.ReadBits(8);
     if (p_uncomp_header->frame_sync_code.frame_sync_byte_1 != 0x83) {
         ERR("Syntax error: frame_sync_byte_1 is " + TOSTR(p_uncomp_header->frame_sync_code.frame_sync_byte_1) + " but shall be equal to 0x83.");
         return PARSER_INVALID_ARG;
     }
-    p_uncomp_header->frame_sync_code.frame_sync_byte_2 = Parser::ReadBits(p_stream, offset, 8);
+    p_uncomp_header->frame_sync_code.frame_sync_byte_2 = bit_reader.ReadBits(8);
     if (p_uncomp_header->frame_sync_code.frame_sync_byte_2 != 0x42) {
         ERR("Syntax error: frame_sync_byte_2 is " + TOSTR(p_uncomp_header->frame_sync_code.frame_sync_byte_2) + " but shall be equal to 0x42.");
         return PARSER_INVALID_ARG;
@@ -597,20 +644,20 @@ ParserResult Vp9VideoParser::FrameSyncCode(const uint8_t *p_stream, size_t &offs
     return PARSER_OK;
 }
 
-ParserResult Vp9VideoParser::ColorConfig(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
+ParserResult Vp9VideoParser::ColorConfig(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
     if (p_uncomp_header->profile >= 2) {
-        p_uncomp_header->color_config.ten_or_twelve_bit = Parser::GetBit(p_stream, offset);
+        p_uncomp_header->color_config.ten_or_twelve_bit = bit_reader.GetBit();
         p_uncomp_header->color_config.bit_depth = p_uncomp_header->color_config.ten_or_twelve_bit ? 12 : 10;
     } else {
         p_uncomp_header->color_config.bit_depth = 8;
     }
-    p_uncomp_header->color_config.color_space = Parser::ReadBits(p_stream, offset, 3);
+    p_uncomp_header->color_config.color_space = bit_reader.ReadBits(3);
     if (p_uncomp_header->color_config.color_space != CS_RGB) {
-        p_uncomp_header->color_config.color_range = Parser::GetBit(p_stream, offset);
+        p_uncomp_header->color_config.color_range = bit_reader.GetBit();
         if (p_uncomp_header->profile == 1 || p_uncomp_header->profile == 3) {
-            p_uncomp_header->color_config.subsampling_x = Parser::GetBit(p_stream, offset);
-            p_uncomp_header->color_config.subsampling_y = Parser::GetBit(p_stream, offset);
-            p_uncomp_header->color_config.reserved_zero = Parser::GetBit(p_stream, offset);
+            p_uncomp_header->color_config.subsampling_x = bit_reader.GetBit();
+            p_uncomp_header->color_config.subsampling_y = bit_reader.GetBit();
+            p_uncomp_header->color_config.reserved_zero = bit_reader.GetBit();
             if (p_uncomp_header->color_config.reserved_zero) {
                 ERR("Syntax error: reserved_zero in color config is not 0 when Profile is 1 or 3");
                 return PARSER_INVALID_ARG;
@@ -624,7 +671,7 @@ ParserResult Vp9VideoParser::ColorConfig(const uint8_t *p_stream, size_t &offset
         if (p_uncomp_header->profile == 1 || p_uncomp_header->profile == 3) {
             p_uncomp_header->color_config.subsampling_x = 0;
             p_uncomp_header->color_config.subsampling_y = 0;
-            p_uncomp_header->color_config.reserved_zero = Parser::GetBit(p_stream, offset);
+            p_uncomp_header->color_config.reserved_zero = bit_reader.GetBit();
             if (p_uncomp_header->color_config.reserved_zero) {
                 ERR("Syntax error: reserved_zero in color config is not 0 when Profile is 1 or 3");
                 return PARSER_INVALID_ARG;
@@ -634,19 +681,19 @@ ParserResult Vp9VideoParser::ColorConfig(const uint8_t *p_stream, size_t &offset
     return PARSER_OK;
 }
 
-void Vp9VideoParser::FrameSize(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
-    p_uncomp_header->frame_size.frame_width_minus_1 = Parser::ReadBits(p_stream, offset, 16);
-    p_uncomp_header->frame_size.frame_height_minus_1 = Parser::ReadBits(p_stream, offset, 16);
+void Vp9VideoParser::FrameSize(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
+    p_uncomp_header->frame_size.frame_width_minus_1 = bit_reader.ReadBits(16);
+    p_uncomp_header->frame_size.frame_height_minus_1 = bit_reader.ReadBits(16);
     p_uncomp_header->frame_size.frame_width = p_uncomp_header->frame_size.frame_width_minus_1 + 1;
     p_uncomp_header->frame_size.frame_height = p_uncomp_header->frame_size.frame_height_minus_1 + 1;
     ComputeImageSize(p_uncomp_header);
 }
 
-void Vp9VideoParser::RenderSize(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
-    p_uncomp_header->render_size.render_and_frame_size_different = Parser::GetBit(p_stream, offset);
+void Vp9VideoParser::RenderSize(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
+    p_uncomp_header->render_size.render_and_frame_size_different = bit_reader.GetBit();
     if (p_uncomp_header->render_size.render_and_frame_size_different) {
-        p_uncomp_header->render_size.render_width_minus_1 = Parser::ReadBits(p_stream, offset, 16);
-        p_uncomp_header->render_size.render_height_minus_1 = Parser::ReadBits(p_stream, offset, 16);
+        p_uncomp_header->render_size.render_width_minus_1 = bit_reader.ReadBits(16);
+        p_uncomp_header->render_size.render_height_minus_1 = bit_reader.ReadBits(16);
         p_uncomp_header->render_size.render_width = p_uncomp_header->render_size.render_width_minus_1 + 1;
         p_uncomp_header->render_size.render_height = p_uncomp_header->render_size.render_height_minus_1 + 1;
     } else {
@@ -657,10 +704,10 @@ void Vp9VideoParser::RenderSize(const uint8_t *p_stream, size_t &offset, Vp9Unco
     }
 }
 
-void Vp9VideoParser::FrameSizeWithRefs(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
+void Vp9VideoParser::FrameSizeWithRefs(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
     uint8_t found_ref;
     for (int i = 0; i < 3; i++) {
-        found_ref = Parser::GetBit(p_stream, offset);
+        found_ref = bit_reader.GetBit();
         if (found_ref) {
             p_uncomp_header->frame_size.frame_width = dpb_buffer_.ref_frame_width[p_uncomp_header->ref_frame_idx[i]];
             p_uncomp_header->frame_size.frame_height = dpb_buffer_.ref_frame_height[p_uncomp_header->ref_frame_idx[i]];
@@ -668,11 +715,11 @@ void Vp9VideoParser::FrameSizeWithRefs(const uint8_t *p_stream, size_t &offset,
         }
     }
     if (found_ref == 0) {
-        FrameSize(p_stream, offset, p_uncomp_header);
+        FrameSize(bit_reader, p_uncomp_header);
     } else {
         ComputeImageSize(p_uncomp_header);
     }
-    RenderSize(p_stream, offset, p_uncomp_header);
+    RenderSize(bit_reader, p_uncomp_header);
 }
 
 void Vp9VideoParser::ComputeImageSize(Vp9UncompressedHeader *p_uncomp_header) {
@@ -704,78 +751,78 @@ void Vp9VideoParser::SetupPastIndependence(Vp9UncompressedHeader *p_uncomp_heade
     }
 }
 
-void Vp9VideoParser::LoopFilterParams(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
-    p_uncomp_header->loop_filter_params.loop_filter_level = Parser::ReadBits(p_stream, offset, 6);
-    p_uncomp_header->loop_filter_params.loop_filter_sharpness = Parser::ReadBits(p_stream, offset, 3);
-    p_uncomp_header->loop_filter_params.loop_filter_delta_enabled = Parser::GetBit(p_stream, offset);
+void Vp9VideoParser::LoopFilterParams(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
+    p_uncomp_header->loop_filter_params.loop_filter_level = bit_reader.ReadBits(6);
+    p_uncomp_header->loop_filter_params.loop_filter_sharpness = bit_reader.ReadBits(3);
+    p_uncomp_header->loop_filter_params.loop_filter_delta_enabled = bit_reader.GetBit();
     if (p_uncomp_header->loop_filter_params.loop_filter_delta_enabled) {
-        p_uncomp_header->loop_filter_params.loop_filter_delta_update = Parser::GetBit(p_stream, offset);
+        p_uncomp_header->loop_filter_params.loop_filter_delta_update = bit_reader.GetBit();
         if (p_uncomp_header->loop_filter_params.loop_filter_delta_update) {
             for (int i = 0; i < 4; i++) {
-                p_uncomp_header->loop_filter_params.update_ref_delta[i] = Parser::GetBit(p_stream, offset);
+                p_uncomp_header->loop_filter_params.update_ref_delta[i] = bit_reader.GetBit();
                 if (p_uncomp_header->loop_filter_params.update_ref_delta[i]) {
-                    p_uncomp_header->loop_filter_params.loop_filter_ref_deltas[i] = ReadSigned(p_stream, offset, 6);
+                    p_uncomp_header->loop_filter_params.loop_filter_ref_deltas[i] = ReadSigned(bit_reader, 6);
                 }
             }
             for (int i = 0; i < 2; i++) {
-                p_uncomp_header->loop_filter_params.update_mode_delta[i] = Parser::GetBit(p_stream, offset);
+                p_uncomp_header->loop_filter_params.update_mode_delta[i] = bit_reader.GetBit();
                 if (p_uncomp_header->loop_filter_params.update_mode_delta[i]) {
-                    p_uncomp_header->loop_filter_params.loop_filter_mode_deltas[i] = ReadSigned(p_stream, offset, 6);
+                    p_uncomp_header->loop_filter_params.loop_filter_mode_deltas[i] = ReadSigned(bit_reader, 6);
                 }
             }
         }
     }
 }
 
-void Vp9VideoParser::QuantizationParams(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
-    p_uncomp_header->quantization_params.base_q_idx = Parser::ReadBits(p_stream, offset, 8);
-    p_uncomp_header->quantization_params.delta_q_y_dc = ReadDeltaQ(p_stream, offset);
-    p_uncomp_header->quantization_params.delta_q_uv_dc = ReadDeltaQ(p_stream, offset);
-    p_uncomp_header->quantization_params.delta_q_uv_ac = ReadDeltaQ(p_stream, offset);
+void Vp9VideoParser::QuantizationParams(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
+    p_uncomp_header->quantization_params.base_q_idx = bit_reader.ReadBits(8);
+    p_uncomp_header->quantization_params.delta_q_y_dc = ReadDeltaQ(bit_reader);
+    p_uncomp_header->quantization_params.delta_q_uv_dc = ReadDeltaQ(bit_reader);
+    p_uncomp_header->quantization_params.delta_q_uv_ac = ReadDeltaQ(bit_reader);
     p_uncomp_header->quantization_params.lossless = p_uncomp_header->quantization_params.base_q_idx == 0 && p_uncomp_header->quantization_params.delta_q_y_dc == 0 && p_uncomp_header->quantization_params.delta_q_uv_dc == 0 && p_uncomp_header->quantization_params.delta_q_uv_ac == 0;
 }
 
-int8_t Vp9VideoParser::ReadDeltaQ(const uint8_t *p_stream, size_t &offset) {
+int8_t Vp9VideoParser::ReadDeltaQ(Parser::BitReader &bit_reader) {
     uint8_t delta_coded;
     int8_t delta_q;
-    delta_coded = Parser::GetBit(p_stream, offset);
+    delta_coded = bit_reader.GetBit();
     if (delta_coded) {
-        delta_q = ReadSigned(p_stream, offset, 4);
+        delta_q = ReadSigned(bit_reader, 4);
     } else {
         delta_q = 0;
     }
     return delta_q;
 }
 
-void Vp9VideoParser::SegmentationParams(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
+void Vp9VideoParser::SegmentationParams(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
     const uint8_t segmentation_feature_bits[VP9_SEG_LVL_MAX] = {8, 6, 2, 0};
     const uint8_t segmentation_feature_signed[VP9_SEG_LVL_MAX] = {1, 1, 0, 0};
-    p_uncomp_header->segmentation_params.segmentation_enabled = Parser::GetBit(p_stream, offset);
+    p_uncomp_header->segmentation_params.segmentation_enabled = bit_reader.GetBit();
     if (p_uncomp_header->segmentation_params.segmentation_enabled) {
-        p_uncomp_header->segmentation_params.segmentation_update_map = Parser::GetBit(p_stream, offset);
+        p_uncomp_header->segmentation_params.segmentation_update_map = bit_reader.GetBit();
         if (p_uncomp_header->segmentation_params.segmentation_update_map) {
             for (int i = 0; i < 7; i++) {
-                p_uncomp_header->segmentation_params.segmentation_tree_probs[i] = ReadProb(p_stream, offset);
+                p_uncomp_header->segmentation_params.segmentation_tree_probs[i] = ReadProb(bit_reader);
             }
-            p_uncomp_header->segmentation_params.segmentation_temporal_update = Parser::GetBit(p_stream, offset);
+            p_uncomp_header->segmentation_params.segmentation_temporal_update = bit_reader.GetBit();
             for (int i = 0; i < 3; i++) {
-                p_uncomp_header->segmentation_params.segmentation_pred_prob[i] = p_uncomp_header->segmentation_params.segmentation_temporal_update ? ReadProb(p_stream, offset) : 255;
+                p_uncomp_header->segmentation_params.segmentation_pred_prob[i] = p_uncomp_header->segmentation_params.segmentation_temporal_update ? ReadProb(bit_reader) : 255;
             }
         }
-        p_uncomp_header->segmentation_params.segmentation_update_data = Parser::GetBit(p_stream, offset);
+        p_uncomp_header->segmentation_params.segmentation_update_data = bit_reader.GetBit();
         if (p_uncomp_header->segmentation_params.segmentation_update_data) {
-            p_uncomp_header->segmentation_params.segmentation_abs_or_delta_update = Parser::GetBit(p_stream, offset);
+            p_uncomp_header->segmentation_params.segmentation_abs_or_delta_update = bit_reader.GetBit();
             for (int i = 0; i < VP9_MAX_SEGMENTS; i++) {
                 for (int j = 0; j < VP9_SEG_LVL_MAX; j++) {
                     int feature_value = 0;
-                    p_uncomp_header->segmentation_params.feature_enabled[i][j] = Parser::GetBit(p_stream, offset);
+                    p_uncomp_header->segmentation_params.feature_enabled[i][j] = bit_reader.GetBit();
                     if (p_uncomp_header->segmentation_params.feature_enabled[i][j]) {
                         int bits_to_read = segmentation_feature_bits[j];
                         if (bits_to_read) {
-                            feature_value = Parser::ReadBits(p_stream, offset, bits_to_read);
+                            feature_value = bit_reader.ReadBits(bits_to_read);
                         }
                         if (segmentation_feature_signed[j] == 1) {
-                            uint8_t feature_sign = Parser::GetBit(p_stream, offset);
+                            uint8_t feature_sign = bit_reader.GetBit();
                             if (feature_sign) {
                                 feature_value *= -1;
                             }
@@ -791,17 +838,17 @@ void Vp9VideoParser::SegmentationParams(const uint8_t *p_stream, size_t &offset,
     }
 }
 
-uint8_t Vp9VideoParser::ReadProb(const uint8_t *p_stream, size_t &offset) {
+uint8_t Vp9VideoParser::ReadProb(Parser::BitReader &bit_reader) {
     uint8_t prob_coded;
     uint8_t prob = 255;
-    prob_coded = Parser::GetBit(p_stream, offset);
+    prob_coded = bit_reader.GetBit();
     if (prob_coded) {
-        prob = Parser::ReadBits(p_stream, offset, 8);
+        prob = bit_reader.ReadBits(8);
     }
     return prob;
 }
 
-void Vp9VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header) {
+void Vp9VideoParser::TileInfo(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header) {
     // calc_min_log2_tile_cols()
     int min_log2 = 0;
     while ((MAX_TILE_WIDTH_B64 << min_log2) < p_uncomp_header->frame_size.sb64_cols) {
@@ -816,15 +863,15 @@ void Vp9VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Vp9Uncomp
     p_uncomp_header->tile_info.max_log2_tile_cols = max_log2 - 1;
     p_uncomp_header->tile_info.tile_cols_log2 = p_uncomp_header->tile_info.min_log2_tile_cols;
     while (p_uncomp_header->tile_info.tile_cols_log2 < p_uncomp_header->tile_info.max_log2_tile_cols) {
-        if (Parser::GetBit(p_stream, offset)) { // increment_tile_cols_log2
+        if (bit_reader.GetBit()) { // increment_tile_cols_log2
             p_uncomp_header->tile_info.tile_cols_log2++;
         } else {
             break;
         }
     }
-    p_uncomp_header->tile_info.tile_rows_log2 = Parser::GetBit(p_stream, offset);
+    p_uncomp_header->tile_info.tile_rows_log2 = bit_reader.GetBit();
     if (p_uncomp_header->tile_info.tile_rows_log2) {
-        uint8_t increment_tile_rows_log2 = Parser::GetBit(p_stream, offset);
+        uint8_t increment_tile_rows_log2 = bit_reader.GetBit();
         p_uncomp_header->tile_info.tile_rows_log2 += increment_tile_rows_log2;
     }
 }
@@ -1152,7 +1199,7 @@ void Vp9VideoParser::PrintDpb() {
     if (num_output_pics_) {
         MSG_NO_NEWLINE("output_pic_list:");
         for (i = 0; i < num_output_pics_; i++) {
-            MSG_NO_NEWLINE(" " << output_pic_list_[i]);
+            MSG_NO_NEWLINE(" " << GetOutputPicture(i));
         }
         MSG("");
     }
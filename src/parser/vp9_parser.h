@@ -53,6 +53,12 @@ public:
      */
     virtual rocDecStatus UnInitialize();     // derived method
 
+    /*! \brief function to reset the VP9 parser, e.g. after a seek
+     * \param [in] flags Combination of <tt>RocdecParserResetFlags</tt>
+     * @return rocDecStatus
+     */
+    virtual rocDecStatus Reset(uint32_t flags);
+
 protected:
     typedef struct {
         int      pic_idx;
@@ -157,45 +163,47 @@ protected:
      */
     ParserResult ParseUncompressedHeader(uint8_t *p_stream, size_t size);
 
-    /*! \brief Function to parse frame sync syntax (frame_sync_code(), 6.2.1)
+    /*! \brief Function to check if a frame is a key frame from the first bits of its uncompressed header
      * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in] size Byte size of the stream
+     * \return true if the frame is a key frame. false for other frames and show_existing_frame.
+     */
+    bool IsKeyFrame(const uint8_t *p_stream, size_t size);
+
+    /*! \brief Function to parse frame sync syntax (frame_sync_code(), 6.2.1)
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      * \return <tt>ParserResult</tt>
      */
-    ParserResult FrameSyncCode(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    ParserResult FrameSyncCode(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse color config syntax (color_config(), 6.2.2)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      * \return <tt>ParserResult</tt>
      */
-    ParserResult ColorConfig(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    ParserResult ColorConfig(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse frame size syntax (frame_size(), 6.2.3)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      *  \return None
      */
-    void FrameSize(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    void FrameSize(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse render size syntax (frame_size(), 6.2.4)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      *  \return None
      */
-    void RenderSize(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    void RenderSize(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse frame size with refs syntax (frame_size_with_refs(), 6.2.5)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      *  \return None
      */
-    void FrameSizeWithRefs(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    void FrameSizeWithRefs(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to calculate 8x8 and 64x64 block columns and rows of the frame (compute_image_size(), 6.2.6)
      * \param [inout] p_uncomp_header Pointer to uncompressed header struct
@@ -209,50 +217,44 @@ protected:
     void SetupPastIndependence(Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse loop filter params syntax (loop_filter_params(), 6.2.8)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      *  \return None
      */
-    void LoopFilterParams(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    void LoopFilterParams(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse quantization params syntax (quantization_params(), 6.2.9)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      *  \return None
      */
-    void QuantizationParams(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    void QuantizationParams(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse delta quantizer syntax (read_delta_q(), 6.2.10)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return <tt>int8_t</tt>
      */
-    int8_t ReadDeltaQ(const uint8_t *p_stream, size_t &offset);
+    int8_t ReadDeltaQ(Parser::BitReader &bit_reader);
 
     /*! \brief Function to parse segmentation params syntax (segmentation_params(), 6.2.11)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      *  \return None
      */
-    void SegmentationParams(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    void SegmentationParams(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to parse probability syntax (read_delta_q(), 6.2.12)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \return <tt>uint8_t</tt>
      */
-    uint8_t ReadProb(const uint8_t *p_stream, size_t &offset);
+    uint8_t ReadProb(Parser::BitReader &bit_reader);
 
     /*! \brief Function to parse tile info syntax (tile_info(), 6.2.13)
-     * \param [in] p_stream Pointer to the bit stream
-     * \param [inout] offset Bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [out] p_uncomp_header Pointer to uncompressed header struct
      *  \return None
      */
-    void TileInfo(const uint8_t *p_stream, size_t &offset, Vp9UncompressedHeader *p_uncomp_header);
+    void TileInfo(Parser::BitReader &bit_reader, Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to set up Y and UV dequantization values based on segmentation parameters. 8.6.1.
      *  \param [in] p_uncomp_header Pointer to uncompressed header struct
@@ -288,15 +290,13 @@ protected:
     void LoopFilterFrameInit(Vp9UncompressedHeader *p_uncomp_header);
 
     /*! \brief Function to read igned integer using n bits for the value and 1 bit for a sign flag 4.10.6. su(n).
-     * \param [in] p_stream Bit stream pointer
-     * \param [in] bit_offset Starting bit offset
-     * \param [out] bit_offset Updated bit offset
+     * \param [in/out] bit_reader Bit reader of the input stream
      * \param [in] num_bits Number of bits to read
      * \return The signed value
      */
-    inline int32_t ReadSigned(const uint8_t *p_stream, size_t &bit_offset, int num_bits) {
-        uint32_t u_value = Parser::ReadBits(p_stream, bit_offset, num_bits);
-        uint8_t sign = Parser::GetBit(p_stream, bit_offset);
+    inline int32_t ReadSigned(Parser::BitReader &bit_reader, int num_bits) {
+        uint32_t u_value = bit_reader.ReadBits(num_bits);
+        uint8_t sign = bit_reader.GetBit();
         return sign ? -u_value : u_value;
     }
 
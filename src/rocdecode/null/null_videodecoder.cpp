@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <atomic>
+#include "null_videodecoder.h"
+
+std::mutex NullVideoDecoder::record_file_mutex_;
+
+NullVideoDecoder::NullVideoDecoder(RocDecoderCreateInfo &decoder_create_info) : decoder_create_info_{decoder_create_info}, num_submitted_pics_{0} {
+    static std::atomic<uint32_t> num_decoders(0);
+    decoder_id_ = num_decoders++;
+}
+
+NullVideoDecoder::~NullVideoDecoder() {
+    if (record_file_.is_open()) {
+        record_file_.close();
+    }
+}
+
+rocDecStatus NullVideoDecoder::InitializeDecoder() {
+    RocdecDecodeCaps decode_caps = {};
+    decode_caps.codec_type = decoder_create_info_.codec_type;
+    decode_caps.chroma_format = decoder_create_info_.chroma_format;
+    decode_caps.bit_depth_minus_8 = decoder_create_info_.bit_depth_minus_8;
+    GetDecoderCaps(&decode_caps);
+    if (!decode_caps.is_supported || (decode_caps.output_format_mask & (1 << decoder_create_info_.output_format)) == 0) {
+        ERR("The codec config combination is not supported.");
+        return ROCDEC_NOT_SUPPORTED;
+    }
+    if (decoder_create_info_.num_decode_surfaces < 1) {
+        ERR("Invalid number of decode surfaces.");
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    decode_records_.assign(decoder_create_info_.num_decode_surfaces, {});
+
+    const char *record_file_path = std::getenv("ROCDEC_NULL_DECODER_RECORD");
+    if (record_file_path != nullptr) {
+        record_file_.open(record_file_path, std::ios::out | std::ios::app);
+        if (!record_file_.is_open()) {
+            ERR("Failed to open the null decoder record file " + STR(record_file_path));
+        }
+    }
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus NullVideoDecoder::SubmitDecode(RocdecPicParams *pPicParams) {
+    std::vector<int> ref_pic_idx;
+    rocDecStatus rocdec_status = ValidatePicParams(pPicParams, ref_pic_idx);
+    if (rocdec_status != ROCDEC_SUCCESS) {
+        return rocdec_status;
+    }
+
+    NullDecodeRecord &record = decode_records_[pPicParams->curr_pic_idx];
+    record.decoded = true;
+    record.decode_order = num_submitted_pics_++;
+    record.num_slices = pPicParams->num_slices;
+    record.bitstream_data_len = pPicParams->bitstream_data_len;
+
+    if (record_file_.is_open()) {
+        std::lock_guard<std::mutex> lock(record_file_mutex_);
+        record_file_ << "decoder " << decoder_id_ << " pic " << record.decode_order << ": curr_pic_idx " << pPicParams->curr_pic_idx
+                     << ", num_slices " << record.num_slices << ", bitstream_data_len " << record.bitstream_data_len << ", ref_pic_idx";
+        for (auto idx : ref_pic_idx) {
+            record_file_ << " " << idx;
+        }
+        record_file_ << std::endl;
+    }
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus NullVideoDecoder::GetDecodeStatus(int pic_idx, RocdecDecodeStatus *decode_status) {
+    if (!IsValidSurfaceIndex(pic_idx) || decode_status == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    decode_status->decode_status = decode_records_[pic_idx].decoded ? rocDecodeStatus_Success : rocDecodeStatus_Invalid;
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus NullVideoDecoder::ExportSurface(int pic_idx, VADRMPRIMESurfaceDescriptor &va_drm_prime_surface_desc) {
+    ERR("The null decoder backend has no surfaces to map.");
+    return ROCDEC_NOT_SUPPORTED;
+}
+
+rocDecStatus NullVideoDecoder::SyncSurface(int pic_idx) {
+    if (!IsValidSurfaceIndex(pic_idx)) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus NullVideoDecoder::ReconfigureDecoder(RocdecReconfigureDecoderInfo *reconfig_params) {
+    if (reconfig_params == nullptr) {
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    if (reconfig_params->num_decode_surfaces < 1) {
+        ERR("Invalid number of decode surfaces.");
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    decoder_create_info_.width = reconfig_params->width;
+    decoder_create_info_.height = reconfig_params->height;
+    decoder_create_info_.num_decode_surfaces = reconfig_params->num_decode_surfaces;
+    decoder_create_info_.target_height = reconfig_params->target_height;
+    decoder_create_info_.target_width = reconfig_params->target_width;
+    decode_records_.assign(decoder_create_info_.num_decode_surfaces, {});
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus NullVideoDecoder::GetDecoderCaps(RocdecDecodeCaps *dec_cap) {
+    if (dec_cap == nullptr) {
+        ERR("Null decode capability struct pointer.");
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    dec_cap->is_supported = 0;
+    switch (dec_cap->codec_type) {
+        case rocDecVideoCodec_HEVC:
+        case rocDecVideoCodec_AVC:
+        case rocDecVideoCodec_VP9:
+        case rocDecVideoCodec_AV1:
+            break;
+        default:
+            return ROCDEC_SUCCESS;
+    }
+    if (dec_cap->chroma_format != rocDecVideoChromaFormat_Monochrome && dec_cap->chroma_format != rocDecVideoChromaFormat_420) {
+        return ROCDEC_SUCCESS;
+    }
+    if (dec_cap->bit_depth_minus_8 != 0 && dec_cap->bit_depth_minus_8 != 2 && dec_cap->bit_depth_minus_8 != 4) {
+        return ROCDEC_SUCCESS;
+    }
+    dec_cap->is_supported = 1;
+    dec_cap->num_decoders = 1;
+    dec_cap->output_format_mask = (1 << rocDecVideoSurfaceFormat_NV12) | (1 << rocDecVideoSurfaceFormat_P016);
+    dec_cap->max_width = NULL_DEC_MAX_WIDTH;
+    dec_cap->max_height = NULL_DEC_MAX_HEIGHT;
+    dec_cap->min_width = NULL_DEC_MIN_WIDTH;
+    dec_cap->min_height = NULL_DEC_MIN_HEIGHT;
+    return ROCDEC_SUCCESS;
+}
+
+rocDecStatus NullVideoDecoder::ValidatePicParams(RocdecPicParams *pPicParams, std::vector<int> &ref_pic_idx) {
+    if (!IsValidSurfaceIndex(pPicParams->curr_pic_idx)) {
+        ERR("curr_pic_idx exceeded the surface pool limit.");
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    switch (decoder_create_info_.codec_type) {
+        case rocDecVideoCodec_HEVC: {
+            for (int i = 0; i < 15; i++) {
+                if (pPicParams->pic_params.hevc.ref_frames[i].pic_idx != 0xFF) {
+                    if (!IsValidSurfaceIndex(pPicParams->pic_params.hevc.ref_frames[i].pic_idx)) {
+                        ERR("Reference frame index exceeded the surface pool limit.");
+                        return ROCDEC_INVALID_PARAMETER;
+                    }
+                    ref_pic_idx.push_back(pPicParams->pic_params.hevc.ref_frames[i].pic_idx);
+                }
+            }
+            break;
+        }
+
+        case rocDecVideoCodec_AVC: {
+            for (int i = 0; i < 16; i++) {
+                if (pPicParams->pic_params.avc.ref_frames[i].pic_idx != 0xFF) {
+                    if (!IsValidSurfaceIndex(pPicParams->pic_params.avc.ref_frames[i].pic_idx)) {
+                        ERR("Reference frame index exceeded the surface pool limit.");
+                        return ROCDEC_INVALID_PARAMETER;
+                    }
+                    ref_pic_idx.push_back(pPicParams->pic_params.avc.ref_frames[i].pic_idx);
+                }
+            }
+            break;
+        }
+
+        case rocDecVideoCodec_VP9: {
+            for (int i = 0; i < 8; i++) {
+                if (pPicParams->pic_params.vp9.reference_frames[i] != 0xFF) {
+                    if (pPicParams->pic_params.vp9.reference_frames[i] >= decode_records_.size()) {
+                        ERR("Reference frame index exceeded the surface pool limit.");
+                        return ROCDEC_INVALID_PARAMETER;
+                    }
+                    ref_pic_idx.push_back(pPicParams->pic_params.vp9.reference_frames[i]);
+                }
+            }
+            break;
+        }
+
+        case rocDecVideoCodec_AV1: {
+            if (pPicParams->pic_params.av1.current_display_picture != 0xFF && !IsValidSurfaceIndex(pPicParams->pic_params.av1.current_display_picture)) {
+                ERR("Current display picture index exceeded the surface pool limit.");
+                return ROCDEC_INVALID_PARAMETER;
+            }
+            for (int i = 0; i < pPicParams->pic_params.av1.anchor_frames_num; i++) {
+                if (!IsValidSurfaceIndex(pPicParams->pic_params.av1.anchor_frames_list[i])) {
+                    ERR("Anchor frame index exceeded the surface pool limit.");
+                    return ROCDEC_INVALID_PARAMETER;
+                }
+            }
+            for (int i = 0; i < 8; i++) {
+                if (pPicParams->pic_params.av1.ref_frame_map[i] != 0xFF) {
+                    if (!IsValidSurfaceIndex(pPicParams->pic_params.av1.ref_frame_map[i])) {
+                        ERR("Reference frame index exceeded the surface pool limit.");
+                        return ROCDEC_INVALID_PARAMETER;
+                    }
+                    ref_pic_idx.push_back(pPicParams->pic_params.av1.ref_frame_map[i]);
+                }
+            }
+            break;
+        }
+
+        default: {
+            ERR("The codec type is not supported.");
+            return ROCDEC_NOT_SUPPORTED;
+        }
+    }
+    return ROCDEC_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <mutex>
+#include "../../commons.h"
+#include "../../../api/rocdecode.h"
+#include "../video_decoder_backend.h"
+
+#define NULL_DEC_MIN_WIDTH 16
+#define NULL_DEC_MIN_HEIGHT 16
+#define NULL_DEC_MAX_WIDTH 8192
+#define NULL_DEC_MAX_HEIGHT 8192
+
+/*! \brief Record of the last picture submitted to a decode surface
+ */
+typedef struct {
+    bool decoded;                 // a picture has been submitted to the surface
+    uint64_t decode_order;        // submission order of the picture, starting from 0
+    uint32_t num_slices;          // number of slices of the picture
+    uint32_t bitstream_data_len;  // size of the slice data of the picture in bytes
+} NullDecodeRecord;
+
+/*! \brief Software decoder backend that needs no GPU
+ *
+ * Pictures are validated the same way as by the VA-API backend and recorded, but not decoded. Each picture is complete
+ * as soon as it is submitted. When the ROCDEC_NULL_DECODER_RECORD environment variable is set to a file path, one line
+ * per submitted picture is appended to the file.
+ */
+class NullVideoDecoder : public VideoDecoderBackend {
+public:
+    NullVideoDecoder(RocDecoderCreateInfo &decoder_create_info);
+    ~NullVideoDecoder();
+    rocDecStatus InitializeDecoder() override;
+    rocDecStatus SubmitDecode(RocdecPicParams *pPicParams) override;
+    rocDecStatus GetDecodeStatus(int pic_idx, RocdecDecodeStatus* decode_status) override;
+    rocDecStatus ExportSurface(int pic_idx, VADRMPRIMESurfaceDescriptor &va_drm_prime_surface_desc) override;
+    rocDecStatus SyncSurface(int pic_idx) override;
+    rocDecStatus ReconfigureDecoder(RocdecReconfigureDecoderInfo *reconfig_params) override;
+
+    /*! \brief Function to fill the decode capabilities of the null backend
+     * \param [in/out] dec_cap Decode capabilities. The IN parameters are checked and the OUT parameters are filled.
+     * \return <tt>rocDecStatus</tt>
+     */
+    static rocDecStatus GetDecoderCaps(RocdecDecodeCaps *dec_cap);
+
+private:
+    RocDecoderCreateInfo decoder_create_info_;
+    uint32_t decoder_id_;
+    std::vector<NullDecodeRecord> decode_records_;
+    uint64_t num_submitted_pics_;
+    std::ofstream record_file_;
+    static std::mutex record_file_mutex_;  // decoders of a process share the record file
+
+    /*! \brief Function to check a reference picture index against the surface pool
+     * \param [in] pic_idx Picture index
+     * \return true if the index is valid
+     */
+    bool IsValidSurfaceIndex(int pic_idx) { return pic_idx >= 0 && pic_idx < decode_records_.size(); };
+
+    /*! \brief Function to check the surface indices of the picture parameters, as the VA-API backend does in <tt>SubmitDecode</tt>
+     * \param [in] pPicParams Picture parameters
+     * \param [out] ref_pic_idx List of the valid reference picture indices
+     * \return <tt>rocDecStatus</tt>
+     */
+    rocDecStatus ValidatePicParams(RocdecPicParams *pPicParams, std::vector<int> &ref_pic_idx);
+};
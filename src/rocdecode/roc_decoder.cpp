@@ -23,7 +23,13 @@ THE SOFTWARE.
 #include "../commons.h"
 #include "roc_decoder.h"
 
-RocDecoder::RocDecoder(RocDecoderCreateInfo& decoder_create_info): va_video_decoder_{decoder_create_info}, decoder_create_info_{decoder_create_info} {}
+RocDecoder::RocDecoder(RocDecoderCreateInfo& decoder_create_info): decoder_create_info_{decoder_create_info} {
+    if (GetDecoderBackend(decoder_create_info.decoder_backend) == rocDecDecoderBackend_Null) {
+        video_decoder_ = std::make_unique<NullVideoDecoder>(decoder_create_info);
+    } else {
+        video_decoder_ = std::make_unique<VaapiVideoDecoder>(decoder_create_info);
+    }
+}
 
  RocDecoder::~RocDecoder() {
     // clean up the VA-API/HIP interop memories
@@ -53,9 +59,9 @@ RocDecoder::RocDecoder(RocDecoderCreateInfo& decoder_create_info): va_video_deco
     for (auto i = 0; i < hip_interop_.size(); i++) {
         memset((void *)&hip_interop_[i], 0, sizeof(hip_interop_[i]));
     }
-    rocdec_status = va_video_decoder_.InitializeDecoder();
+    rocdec_status = video_decoder_->InitializeDecoder();
     if (rocdec_status != ROCDEC_SUCCESS) {
-        ERR("Failed to initilize the VAAPI Video decoder.");
+        ERR("Failed to initilize the video decoder.");
         return rocdec_status;
     }
 
@@ -64,7 +70,7 @@ RocDecoder::RocDecoder(RocDecoderCreateInfo& decoder_create_info): va_video_deco
 
 rocDecStatus RocDecoder::DecodeFrame(RocdecPicParams *pic_params) {
     rocDecStatus rocdec_status = ROCDEC_SUCCESS;
-    rocdec_status = va_video_decoder_.SubmitDecode(pic_params);
+    rocdec_status = video_decoder_->SubmitDecode(pic_params);
     if (rocdec_status != ROCDEC_SUCCESS) {
         ERR("Decode submission is not successful.");
     }
@@ -74,7 +80,7 @@ rocDecStatus RocDecoder::DecodeFrame(RocdecPicParams *pic_params) {
 
 rocDecStatus RocDecoder::GetDecodeStatus(int pic_idx, RocdecDecodeStatus* decode_status) {
     rocDecStatus rocdec_status = ROCDEC_SUCCESS;
-    rocdec_status = va_video_decoder_.GetDecodeStatus(pic_idx, decode_status);
+    rocdec_status = video_decoder_->GetDecodeStatus(pic_idx, decode_status);
     if (rocdec_status != ROCDEC_SUCCESS) {
         ERR("Failed to query the decode status.");
     }
@@ -93,7 +99,7 @@ rocDecStatus RocDecoder::ReconfigureDecoder(RocdecReconfigureDecoderInfo *reconf
             return rocdec_status;
         }
     }
-    rocdec_status = va_video_decoder_.ReconfigureDecoder(reconfig_params);
+    rocdec_status = video_decoder_->ReconfigureDecoder(reconfig_params);
     if (rocdec_status != ROCDEC_SUCCESS) {
         ERR("Reconfiguration of the decoder failed.");
         return rocdec_status;
@@ -108,7 +114,7 @@ rocDecStatus RocDecoder::GetVideoFrame(int pic_idx, void *dev_mem_ptr[3], uint32
     rocDecStatus rocdec_status = ROCDEC_SUCCESS;
 
     // wait on current surface to make sure that it is ready for the HIP interop
-    rocdec_status = va_video_decoder_.SyncSurface(pic_idx);
+    rocdec_status = video_decoder_->SyncSurface(pic_idx);
     if (rocdec_status != ROCDEC_SUCCESS) {
         ERR("Failed to export surface for picture idx = " + TOSTR(pic_idx));
         return rocdec_status;
@@ -120,7 +126,7 @@ rocDecStatus RocDecoder::GetVideoFrame(int pic_idx, void *dev_mem_ptr[3], uint32
         hipExternalMemoryBufferDesc external_mem_buffer_desc = {};
         VADRMPRIMESurfaceDescriptor va_drm_prime_surface_desc = {};
 
-        rocdec_status = va_video_decoder_.ExportSurface(pic_idx, va_drm_prime_surface_desc);
+        rocdec_status = video_decoder_->ExportSurface(pic_idx, va_drm_prime_surface_desc);
         if (rocdec_status != ROCDEC_SUCCESS) {
             ERR("Failed to export surface for picture idx = " + TOSTR(pic_idx));
             return rocdec_status;
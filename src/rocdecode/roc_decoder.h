@@ -32,7 +32,9 @@ THE SOFTWARE.
 #include <map>
 #include "../api/rocdecode.h"
 #include <hip/hip_runtime.h>
+#include <memory>
 #include "vaapi/vaapi_videodecoder.h"
+#include "null/null_videodecoder.h"
 
 struct HipInteropDeviceMem {
     hipExternalMemory_t hip_ext_mem; // Interface to the vaapi-hip interop
@@ -58,6 +60,6 @@ private:
     rocDecStatus FreeVideoFrame(int pic_idx);
     int num_devices_;
     RocDecoderCreateInfo decoder_create_info_;
-    VaapiVideoDecoder va_video_decoder_;
+    std::unique_ptr<VideoDecoderBackend> video_decoder_;
     std::vector<HipInteropDeviceMem> hip_interop_;
 };
\ No newline at end of file
@@ -22,6 +22,7 @@ THE SOFTWARE.
 #include "dec_handle.h"
 #include "rocdecode.h"
 #include "vaapi_videodecoder.h"
+#include "null/null_videodecoder.h"
 #include "../commons.h"
 
 namespace rocdecode {
@@ -72,6 +73,9 @@ rocDecGetDecoderCaps(RocdecDecodeCaps *pdc) {
     if (pdc == nullptr) {
         return ROCDEC_INVALID_PARAMETER;
     }
+    if (GetDecoderBackend(pdc->decoder_backend) == rocDecDecoderBackend_Null) {
+        return NullVideoDecoder::GetDecoderCaps(pdc);
+    }
     VaContext& va_ctx = VaContext::GetInstance();
     rocDecStatus ret = ROCDEC_SUCCESS;
     if ((ret = va_ctx.CheckDecCapForCodecType(pdc)) != ROCDEC_SUCCESS) {
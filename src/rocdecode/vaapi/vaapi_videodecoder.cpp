@@ -362,8 +362,9 @@ rocDecStatus VaapiVideoDecoder::ReconfigureDecoder(RocdecReconfigureDecoderInfo
 }
 
 bool VaapiVideoDecoder::IsCodecConfigSupported(int device_id, rocDecVideoCodec codec_type, rocDecVideoChromaFormat chroma_format, uint32_t bit_depth_minus8, rocDecVideoSurfaceFormat output_format) {
-    RocdecDecodeCaps decode_caps;
+    RocdecDecodeCaps decode_caps = {};
     decode_caps.device_id = device_id;
+    decode_caps.decoder_backend = rocDecDecoderBackend_Vaapi;
     decode_caps.codec_type = codec_type;
     decode_caps.chroma_format = chroma_format;
     decode_caps.bit_depth_minus_8 = bit_depth_minus8;
@@ -41,6 +41,7 @@ THE SOFTWARE.
 #include <va/va_drmcommon.h>
 #include "../../commons.h"
 #include "../../../api/rocdecode.h"
+#include "../video_decoder_backend.h"
 
 #define CHECK_HIP(call) {\
     hipError_t hip_status = call;\
@@ -88,16 +89,16 @@ typedef struct {
     uint32_t min_height;
 } VaContextInfo;
 
-class VaapiVideoDecoder {
+class VaapiVideoDecoder : public VideoDecoderBackend {
 public:
     VaapiVideoDecoder(RocDecoderCreateInfo &decoder_create_info);
     ~VaapiVideoDecoder();
-    rocDecStatus InitializeDecoder();
-    rocDecStatus SubmitDecode(RocdecPicParams *pPicParams);
-    rocDecStatus GetDecodeStatus(int pic_idx, RocdecDecodeStatus* decode_status);
-    rocDecStatus ExportSurface(int pic_idx, VADRMPRIMESurfaceDescriptor &va_drm_prime_surface_desc);
-    rocDecStatus SyncSurface(int pic_idx);
-    rocDecStatus ReconfigureDecoder(RocdecReconfigureDecoderInfo *reconfig_params);
+    rocDecStatus InitializeDecoder() override;
+    rocDecStatus SubmitDecode(RocdecPicParams *pPicParams) override;
+    rocDecStatus GetDecodeStatus(int pic_idx, RocdecDecodeStatus* decode_status) override;
+    rocDecStatus ExportSurface(int pic_idx, VADRMPRIMESurfaceDescriptor &va_drm_prime_surface_desc) override;
+    rocDecStatus SyncSurface(int pic_idx) override;
+    rocDecStatus ReconfigureDecoder(RocdecReconfigureDecoderInfo *reconfig_params) override;
 
 private:
     RocDecoderCreateInfo decoder_create_info_;
@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <va/va.h>
+#include <va/va_drmcommon.h>
+#include "../../api/rocdecode.h"
+
+/*! \brief Interface of the video decoder backends used by RocDecoder
+ */
+class VideoDecoderBackend {
+public:
+    virtual ~VideoDecoderBackend() {};
+    virtual rocDecStatus InitializeDecoder() = 0;
+    virtual rocDecStatus SubmitDecode(RocdecPicParams *pPicParams) = 0;
+    virtual rocDecStatus GetDecodeStatus(int pic_idx, RocdecDecodeStatus* decode_status) = 0;
+    virtual rocDecStatus ExportSurface(int pic_idx, VADRMPRIMESurfaceDescriptor &va_drm_prime_surface_desc) = 0;
+    virtual rocDecStatus SyncSurface(int pic_idx) = 0;
+    virtual rocDecStatus ReconfigureDecoder(RocdecReconfigureDecoderInfo *reconfig_params) = 0;
+};
+
+/*! \brief Function to resolve the decoder backend to use
+ * \param [in] decoder_backend Requested backend. For <tt>rocDecDecoderBackend_Default</tt>, the ROCDEC_DECODER_BACKEND
+ * environment variable ("vaapi" or "null") selects the backend. VA-API is used if it is not set.
+ * \return The backend to use
+ */
+inline rocDecDecoderBackend GetDecoderBackend(rocDecDecoderBackend decoder_backend) {
+    if (decoder_backend != rocDecDecoderBackend_Default) {
+        return decoder_backend;
+    }
+    const char *backend_name = std::getenv("ROCDEC_DECODER_BACKEND");
+    if (backend_name != nullptr && strcmp(backend_name, "null") == 0) {
+        return rocDecDecoderBackend_Null;
+    }
+    return rocDecDecoderBackend_Vaapi;
+}
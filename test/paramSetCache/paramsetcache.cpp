@@ -0,0 +1,359 @@
+/*
+Copyright (c) 2023 - 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstring>
+#include "es_reader.h"
+#include "parser_handle.h"
+#include "bit_reader.h"
+#include "avc_defines.h"
+#include "hevc_defines.h"
+
+/*
+ * Regression test of the parameter set cache of the AVC and HEVC parsers.
+ *
+ * The parameter sets of the first picture (payload A) are sent, then a parameter set with the same id that fails to parse
+ * (payload B), then A again, followed by the whole stream. B is an HEVC SPS with an out of range short-term RPS, or an AVC PPS
+ * with multiple slice groups. The failed parse of B must not leave A in the cache: the second A has to be parsed again, else
+ * the slices of the stream refer to the cleared set of B and the stream does not decode.
+ */
+
+/*! \brief Per parser state of a test run
+ */
+typedef struct {
+    RocParserHandle *parser;
+    uint64_t num_decoded_pics;
+} ParserContext;
+
+static int ROCDECAPI HandleVideoSequence(void *user_data, RocdecVideoFormat *video_format) {
+    return video_format->min_num_decode_surfaces;
+}
+
+// No-op decoder: only the pictures are counted
+static int ROCDECAPI HandlePictureDecode(void *user_data, RocdecPicParams *pic_params) {
+    static_cast<ParserContext *>(user_data)->num_decoded_pics++;
+    return 1;
+}
+
+static int ROCDECAPI HandlePictureDisplay(void *user_data, RocdecParserDispInfo *disp_info) {
+    ParserContext *p_ctx = static_cast<ParserContext *>(user_data);
+    if (disp_info) {
+        p_ctx->parser->MarkFrameForReuse(disp_info->picture_index);
+    }
+    return 1;
+}
+
+/*! \brief MSB-first bit writer for the hand-written parameter sets
+ */
+class BitWriter {
+public:
+    void PutBits(uint32_t value, int num_bits) {
+        for (int i = num_bits - 1; i >= 0; i--) {
+            if (num_bits_ % 8 == 0) {
+                rbsp_.push_back(0);
+            }
+            rbsp_.back() |= ((value >> i) & 1) << (7 - num_bits_ % 8);
+            num_bits_++;
+        }
+    }
+
+    void PutUe(uint32_t value) {
+        int num_bits = 0;
+        for (uint32_t v = value + 1; v > 1; v >>= 1) {
+            num_bits++;
+        }
+        PutBits(0, num_bits);
+        PutBits(value + 1, num_bits + 1);
+    }
+
+    /*! \brief Function to terminate the RBSP and return the NAL unit with a start code and emulation prevention bytes
+     * \param [in] header NAL unit header
+     * \return NAL unit
+     */
+    std::vector<uint8_t> GetNalUnit(const std::vector<uint8_t> &header) {
+        PutBits(1, 1);  // rbsp_stop_one_bit
+        num_bits_ = 0;  // byte aligned with zero bits
+        std::vector<uint8_t> nal_unit = {0, 0, 1};
+        nal_unit.insert(nal_unit.end(), header.begin(), header.end());
+        int zero_run = 0;
+        for (auto byte : rbsp_) {
+            if (zero_run == 2 && byte <= 3) {
+                nal_unit.push_back(3);
+                zero_run = 0;
+            }
+            nal_unit.push_back(byte);
+            zero_run = byte ? 0 : zero_run + 1;
+        }
+        return nal_unit;
+    }
+
+private:
+    std::vector<uint8_t> rbsp_;
+    int num_bits_ = 0;
+};
+
+/*! \brief Function to split an Annex B buffer into NAL units
+ * \param [in] data Buffer
+ * \param [in] size Buffer size
+ * \return NAL units, each starting with its 3-byte start code. The zero byte of a 4-byte start code ends the previous unit.
+ */
+std::vector<std::vector<uint8_t>> SplitNalUnits(const uint8_t *data, size_t size) {
+    std::vector<size_t> start_codes;
+    for (size_t i = 0; i + 3 <= size; i++) {
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+            start_codes.push_back(i);
+            i += 2;
+        }
+    }
+    std::vector<std::vector<uint8_t>> nal_units;
+    for (size_t i = 0; i < start_codes.size(); i++) {
+        size_t end = i + 1 < start_codes.size() ? start_codes[i + 1] : size;
+        nal_units.emplace_back(data + start_codes[i], data + end);
+    }
+    return nal_units;
+}
+
+/*! \brief Function to skip profile_tier_level() of an HEVC VPS or SPS
+ * \param [in] bit_reader Bit reader positioned at the start of profile_tier_level()
+ * \param [in] max_sub_layers_minus1 sps_max_sub_layers_minus1
+ */
+void SkipHevcPtl(Parser::BitReader &bit_reader, uint32_t max_sub_layers_minus1) {
+    bit_reader.SkipBits(96);  // general profile, tier and level
+    std::vector<uint32_t> profile_present(max_sub_layers_minus1), level_present(max_sub_layers_minus1);
+    for (uint32_t i = 0; i < max_sub_layers_minus1; i++) {
+        profile_present[i] = bit_reader.GetBit();
+        level_present[i] = bit_reader.GetBit();
+    }
+    if (max_sub_layers_minus1 > 0) {
+        bit_reader.SkipBits(2 * (8 - max_sub_layers_minus1));  // reserved_zero_2bits
+    }
+    for (uint32_t i = 0; i < max_sub_layers_minus1; i++) {
+        bit_reader.SkipBits(profile_present[i] * 88 + level_present[i] * 8);
+    }
+}
+
+/*! \brief Function to write an HEVC SPS that fails to parse: its short-term RPS holds more pictures than the DPB
+ * \param [in] sps_id sps_seq_parameter_set_id
+ * \return SPS NAL unit
+ */
+std::vector<uint8_t> MakeBadHevcSps(uint32_t sps_id) {
+    BitWriter bw;
+    bw.PutBits(0, 4);  // sps_video_parameter_set_id
+    bw.PutBits(0, 3);  // sps_max_sub_layers_minus1
+    bw.PutBits(1, 1);  // sps_temporal_id_nesting_flag
+    bw.PutBits(0, 2); bw.PutBits(0, 1); bw.PutBits(1, 5);  // general_profile_space, general_tier_flag, general_profile_idc
+    bw.PutBits(0x60000000, 32);  // general_profile_compatibility_flag[]
+    bw.PutBits(0x9000, 16); bw.PutBits(0, 32);  // progressive/frame only flags, reserved bits
+    bw.PutBits(93, 8);  // general_level_idc
+    bw.PutUe(sps_id);
+    bw.PutUe(1);  // chroma_format_idc
+    bw.PutUe(64);  // pic_width_in_luma_samples
+    bw.PutUe(64);  // pic_height_in_luma_samples
+    bw.PutBits(0, 1);  // conformance_window_flag
+    bw.PutUe(0);  // bit_depth_luma_minus8
+    bw.PutUe(0);  // bit_depth_chroma_minus8
+    bw.PutUe(4);  // log2_max_pic_order_cnt_lsb_minus4
+    bw.PutBits(1, 1);  // sps_sub_layer_ordering_info_present_flag
+    bw.PutUe(0);  // sps_max_dec_pic_buffering_minus1[0]
+    bw.PutUe(0);  // sps_max_num_reorder_pics[0]
+    bw.PutUe(0);  // sps_max_latency_increase_plus1[0]
+    bw.PutUe(0);  // log2_min_luma_coding_block_size_minus3
+    bw.PutUe(1);  // log2_diff_max_min_luma_coding_block_size
+    bw.PutUe(0);  // log2_min_luma_transform_block_size_minus2
+    bw.PutUe(1);  // log2_diff_max_min_luma_transform_block_size
+    bw.PutUe(0);  // max_transform_hierarchy_depth_inter
+    bw.PutUe(0);  // max_transform_hierarchy_depth_intra
+    bw.PutBits(0, 4);  // scaling_list_enabled_flag, amp_enabled_flag, sample_adaptive_offset_enabled_flag, pcm_enabled_flag
+    bw.PutUe(1);  // num_short_term_ref_pic_sets
+    bw.PutUe(2);  // num_negative_pics: out of range, sps_max_dec_pic_buffering_minus1 is 0
+    bw.PutUe(0);  // num_positive_pics
+    for (int i = 0; i < 2; i++) {
+        bw.PutUe(0);  // delta_poc_s0_minus1[i]
+        bw.PutBits(1, 1);  // used_by_curr_pic_s0_flag[i]
+    }
+    bw.PutBits(0, 5);  // long_term_ref_pics_present_flag, temporal_mvp, strong_intra_smoothing, vui and extension flags
+    return bw.GetNalUnit({NAL_UNIT_SPS << 1, 1});
+}
+
+/*! \brief Function to write an AVC PPS that fails to parse: it uses slice groups, which the parser does not support
+ * \param [in] pps_id pic_parameter_set_id
+ * \param [in] sps_id seq_parameter_set_id
+ * \return PPS NAL unit
+ */
+std::vector<uint8_t> MakeBadAvcPps(uint32_t pps_id, uint32_t sps_id) {
+    BitWriter bw;
+    bw.PutUe(pps_id);
+    bw.PutUe(sps_id);
+    bw.PutBits(0, 1);  // entropy_coding_mode_flag
+    bw.PutBits(0, 1);  // bottom_field_pic_order_in_frame_present_flag
+    bw.PutUe(1);  // num_slice_groups_minus1
+    bw.PutUe(0);  // slice_group_map_type
+    bw.PutUe(0);  // run_length_minus1[0]
+    bw.PutUe(0);  // run_length_minus1[1]
+    return bw.GetNalUnit({0x68});
+}
+
+/*! \brief Function to parse packets with no-op callbacks
+ * \param [in] codec_id Codec of the stream
+ * \param [in] packets Packets
+ * \param [in] num_leading_packets Number of packets at the front whose parse errors are expected and ignored
+ * \return Number of decoded pictures
+ */
+uint64_t ParseStream(rocDecVideoCodec codec_id, const std::vector<std::vector<uint8_t>> &packets, size_t num_leading_packets) {
+    ParserContext ctx = {};
+    RocdecParserParams params = {};
+    params.codec_type = codec_id;
+    params.max_num_decode_surfaces = 1;  // increased by the parser as needed
+    params.clock_rate = 1000;
+    params.max_display_delay = 0;
+    params.explicit_frame_release = 1;
+    params.user_data = &ctx;
+    params.pfn_sequence_callback = HandleVideoSequence;
+    params.pfn_decode_picture = HandlePictureDecode;
+    params.pfn_display_picture = HandlePictureDisplay;
+    RocParserHandle parser(&params);
+    ctx.parser = &parser;
+
+    for (size_t i = 0; i < packets.size(); i++) {
+        RocdecSourceDataPacket pkt = {};
+        pkt.payload = packets[i].data();
+        pkt.payload_size = packets[i].size();
+        if (parser.ParseVideoData(&pkt) != ROCDEC_SUCCESS && i >= num_leading_packets) {
+            std::cerr << "ERROR: parser failed at packet " << i << std::endl;
+            break;
+        }
+    }
+    RocdecSourceDataPacket pkt = {};
+    pkt.flags = ROCDEC_PKT_ENDOFSTREAM;
+    parser.ParseVideoData(&pkt);
+    parser.DestroyParser();
+    return ctx.num_decoded_pics;
+}
+
+void ShowHelpAndExit(const char *option = NULL) {
+    std::cout << "Options:" << std::endl
+    << "-i Input File Path (AVC/HEVC elementary stream) - required" << std::endl;
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+    std::string input_file_path;
+
+    // Parse command-line arguments
+    if (argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_file_path = argv[i];
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+
+    try {
+        std::vector<std::vector<uint8_t>> packets;
+        RocdecBitstreamReaderParams reader_params = {};
+        std::unique_ptr<RocVideoESParser> reader = std::make_unique<RocVideoESParser>(input_file_path.c_str(), &reader_params);
+        rocDecVideoCodec codec_id = reader->GetCodecId();
+        if (codec_id != rocDecVideoCodec_AVC && codec_id != rocDecVideoCodec_HEVC) {
+            std::cerr << "ERROR: unsupported stream type: " << input_file_path << std::endl;
+            return 1;
+        }
+        while (true) {
+            uint8_t *p_pic_data;
+            int pic_size = 0;
+            int64_t pts;
+            if (reader->GetPicData(&p_pic_data, &pic_size, &pts) != ROCDEC_SUCCESS || pic_size <= 0) {
+                break;
+            }
+            packets.emplace_back(p_pic_data, p_pic_data + pic_size);
+        }
+        reader.reset();
+        if (packets.empty()) {
+            std::cerr << "ERROR: no picture data in " << input_file_path << std::endl;
+            return 1;
+        }
+
+        // Payload A: the parameter sets of the first picture. Payload B: a set with the same id as the SPS (HEVC) or PPS (AVC) of A.
+        std::vector<uint8_t> payload_a, payload_b;
+        for (auto &nal_unit : SplitNalUnits(packets[0].data(), packets[0].size())) {
+            if (nal_unit.size() < 6) {
+                continue;
+            }
+            if (codec_id == rocDecVideoCodec_HEVC) {
+                uint32_t nal_unit_type = (nal_unit[3] >> 1) & 0x3F;
+                if (nal_unit_type < NAL_UNIT_VPS || nal_unit_type > NAL_UNIT_PPS) {
+                    continue;
+                }
+                if (nal_unit_type == NAL_UNIT_SPS) {
+                    Parser::BitReader bit_reader(nal_unit.data() + 5, nal_unit.size() - 5, true);
+                    bit_reader.SkipBits(4);  // sps_video_parameter_set_id
+                    uint32_t max_sub_layers_minus1 = bit_reader.ReadBits(3);
+                    bit_reader.SkipBits(1);  // sps_temporal_id_nesting_flag
+                    SkipHevcPtl(bit_reader, max_sub_layers_minus1);
+                    payload_b = MakeBadHevcSps(bit_reader.ReadUe());
+                }
+            } else {
+                uint32_t nal_unit_type = nal_unit[3] & 0x1F;
+                if (nal_unit_type != kAvcNalTypeSeq_Parameter_Set && nal_unit_type != kAvcNalTypePic_Parameter_Set) {
+                    continue;
+                }
+                if (nal_unit_type == kAvcNalTypePic_Parameter_Set) {
+                    Parser::BitReader bit_reader(nal_unit.data() + 4, nal_unit.size() - 4, true);
+                    uint32_t pps_id = bit_reader.ReadUe();
+                    payload_b = MakeBadAvcPps(pps_id, bit_reader.ReadUe());
+                }
+            }
+            payload_a.insert(payload_a.end(), nal_unit.begin(), nal_unit.end());
+        }
+        if (payload_b.empty()) {
+            std::cerr << "ERROR: no parameter sets in the first picture of " << input_file_path << std::endl;
+            return 1;
+        }
+
+        uint64_t num_ref_pics = ParseStream(codec_id, packets, 0);
+        std::vector<std::vector<uint8_t>> test_packets = {payload_a, payload_b, payload_a};
+        test_packets.insert(test_packets.end(), packets.begin(), packets.end());
+        uint64_t num_test_pics = ParseStream(codec_id, test_packets, 3);
+        std::cout << "info: decoded pictures: " << num_test_pics << " (reference: " << num_ref_pics << ")" << std::endl;
+        if (num_ref_pics == 0 || num_test_pics != num_ref_pics) {
+            std::cerr << "ERROR: the parameter set re-sent after a failed parse was not applied" << std::endl;
+            return 1;
+        }
+        std::cout << "info: parameter set cache test passed" << std::endl;
+    } catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1018,6 +1018,10 @@ void RocVideoDecoder::ResetSaveFrameToFile() {
     }
 }
 
+void RocVideoDecoder::SetDisplayStartPts(int64_t pts) {
+    ROCDEC_API_CALL(rocDecParserSetDisplayStartPts(rocdec_parser_, pts));
+}
+
 void RocVideoDecoder::GetDeviceinfo(std::string &device_name, std::string &gcn_arch_name, int &pci_bus_id, int &pci_domain_id, int &pci_device_id) {
     device_name = hip_dev_prop_.name;
     gcn_arch_name = hip_dev_prop_.gcnArchName;
@@ -1037,7 +1041,18 @@ bool RocVideoDecoder::GetOutputSurfaceInfo(OutputSurfaceInfo **surface_info) {
 }
 
 bool RocVideoDecoder::InitHIP(int device_id) {
-    HIP_API_CALL(hipGetDeviceCount(&num_devices_));
+    hipError_t hip_status = hipGetDeviceCount(&num_devices_);
+    if ((hip_status != hipSuccess || num_devices_ < 1) && out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED) {
+        // The null decoder backend needs no GPU when the decoded frames are not mapped
+        const char *backend_name = std::getenv("ROCDEC_DECODER_BACKEND");
+        if (backend_name != nullptr && strcmp(backend_name, "null") == 0) {
+            num_devices_ = 0;
+            memset(&hip_dev_prop_, 0, sizeof(hip_dev_prop_));
+            hip_stream_ = 0;
+            return true;
+        }
+    }
+    HIP_API_CALL(hip_status);
     if (num_devices_ < 1) {
         std::cerr << "ERROR: didn't find any GPU!" << std::endl;
         return false;
@@ -1061,7 +1076,7 @@ double RocVideoDecoder::StopTimer(const std::chrono::_V2::system_clock::time_poi
 }
 
 bool RocVideoDecoder::CodecSupported(int device_id, rocDecVideoCodec codec_id, uint32_t bit_depth) {
-    RocdecDecodeCaps decode_caps;
+    RocdecDecodeCaps decode_caps = {};
     decode_caps.device_id = device_id;
     decode_caps.codec_type = codec_id;
     decode_caps.chroma_format = rocDecVideoChromaFormat_420;
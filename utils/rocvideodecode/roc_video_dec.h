@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include <stdexcept>
 #include <exception>
 #include <cstring>
+#include <cstdlib>
 #include <unordered_map>
 #include <chrono>
 #include <hip/hip_runtime.h>
@@ -373,6 +374,14 @@ class RocVideoDecoder {
          */
         int32_t GetNumOfFlushedFrames() { return num_frames_flushed_during_reconfig_;}
 
+        /**
+         * @brief Function to suppress the output of the frames before a seek target, e.g. when decoding from the previous key frame.
+         *        The suppressed frames are not mapped or copied. See rocDecParserSetDisplayStartPts().
+         *
+         * @param pts - presentation timestamp of the first frame to output
+         */
+        void SetDisplayStartPts(int64_t pts);
+
         /*! \brief Function to wait for the decode completion of the last submitted picture
          */
         void WaitForDecodeCompletion();